@@ -16,6 +16,7 @@ namespace BinaryProtocol {
 #define MSG_ESCAPE_CHAR 0x7D   // Escape character for framing
 #define MSG_ESCAPE_XOR 0x20    // XOR value for escape sequences
 #define JSON_MESSAGE_TYPE 0x01 // JSON message type identifier
+#define BATCH_MESSAGE_TYPE 0x02 // Several JSON messages under one header/CRC
 
 // Legacy compatibility (map old names to new defines)
 #define START_MARKER MSG_START_MARKER
@@ -27,8 +28,15 @@ static const uint32_t MAX_PAYLOAD_SIZE = 4096 * 2; // 8192 bytes
 static const uint8_t HEADER_SIZE = 7; // LENGTH(4) + CRC(2) + TYPE(1)
 static const uint32_t MESSAGE_TIMEOUT_MS = 1000;
 
+static const uint8_t BATCH_RECORD_HEADER_SIZE = 2; // Per-message LENGTH(2)
+
 // Frame format:
 // [0x7E][LENGTH_4_BYTES][CRC_2_BYTES][TYPE_1_BYTE][ESCAPED_PAYLOAD][0x7F]
+//
+// BATCH_MESSAGE_TYPE payload (LENGTH and CRC cover all records):
+// [LEN_2_BYTES][JSON]...[LEN_2_BYTES][JSON]
+// Records are dispatched in order. Frames are never split across a batch, so
+// a single message may be sent as either type.
 
 // =============================================================================
 // ENUMS
@@ -49,6 +57,10 @@ struct ProtocolStatistics {
   uint32_t crcErrors = 0;
   uint32_t timeoutErrors = 0;
   uint32_t bufferOverflowErrors = 0;
+  uint32_t batchesReceived = 0;
+  uint32_t batchedMessagesReceived = 0;
+  uint32_t batchesSent = 0;
+  uint32_t batchedMessagesSent = 0;
 
   void incrementMessagesReceived() { messagesReceived++; }
   void incrementMessagesSent() { messagesSent++; }
@@ -58,6 +70,14 @@ struct ProtocolStatistics {
   void incrementCrcErrors() { crcErrors++; }
   void incrementTimeoutErrors() { timeoutErrors++; }
   void incrementBufferOverflowErrors() { bufferOverflowErrors++; }
+  void addBatchReceived(uint32_t messages) {
+    batchesReceived++;
+    batchedMessagesReceived += messages;
+  }
+  void addBatchSent(uint32_t messages) {
+    batchesSent++;
+    batchedMessagesSent += messages;
+  }
 
   void reset() {
     messagesReceived = 0;
@@ -68,6 +88,10 @@ struct ProtocolStatistics {
     crcErrors = 0;
     timeoutErrors = 0;
     bufferOverflowErrors = 0;
+    batchesReceived = 0;
+    batchedMessagesReceived = 0;
+    batchesSent = 0;
+    batchedMessagesSent = 0;
   }
 };
 
@@ -80,6 +104,10 @@ public:
   static uint16_t calculate(const uint8_t *data, size_t length);
   static uint16_t calculate(const std::vector<uint8_t> &data);
   static uint16_t calculate(const String &data);
+
+  // Continue a running CRC (start from 0xFFFF) - lets a frame be checksummed
+  // while it is being written
+  static uint16_t update(uint16_t crc, const uint8_t *data, size_t length);
 };
 
 // =============================================================================
@@ -96,6 +124,16 @@ public:
   bool encodeMessage(const String &jsonPayload, uint8_t *outputBuffer,
                      size_t bufferSize, size_t &frameLength);
 
+  // Batch encoding - builds one BATCH_MESSAGE_TYPE frame in place:
+  //   beginBatch(buf, size); while (addToBatch(json, len)) {...}
+  //   frameLength = finishBatch();
+  // addToBatch() returns false without writing anything when the message
+  // would not fit, so the caller can start the next frame with it.
+  void beginBatch(uint8_t *outputBuffer, size_t bufferSize);
+  bool addToBatch(const char *json, size_t length);
+  size_t finishBatch(); // Frame length, 0 if nothing was added
+  size_t getBatchCount() const { return batchCount_; }
+
   // Direct transmission (like working SerialBridge)
   bool transmitMessageDirect(const String &jsonPayload,
                              std::function<bool(uint8_t)> writeByteFunc);
@@ -106,6 +144,8 @@ public:
 
   // State and statistics
   ReceiveState getCurrentState() const { return currentState_; }
+  // True once the peer has sent a valid batch frame, i.e. it understands them
+  bool peerSupportsBatches() const { return peerSupportsBatches_; }
   const ProtocolStatistics &getStatistics() const { return statistics_; }
   void resetStatistics() { statistics_.reset(); }
 
@@ -124,6 +164,15 @@ private:
   uint8_t messageType_;
   unsigned long messageStartTime_;
   bool isEscapeNext_;
+  bool peerSupportsBatches_;
+
+  // Batch transmit state (see beginBatch)
+  uint8_t *batchBuffer_;
+  size_t batchCapacity_;
+  size_t batchPosition_;
+  uint32_t batchPayloadLength_;
+  uint16_t batchCrc_;
+  size_t batchCount_;
 
   // Statistics
   ProtocolStatistics statistics_;
@@ -133,7 +182,15 @@ private:
   std::vector<uint8_t> removeEscapeSequences(const std::vector<uint8_t> &data);
   bool processHeader();
   void processPayloadByte(uint8_t byte);
+  bool verifyCompletePayload();
+  bool isValidJsonPayload(const uint8_t *data, size_t length);
   String processCompleteMessage();
+  void processCompleteBatch(std::vector<String> &messages);
+  static size_t escapedLength(const uint8_t *data, size_t length);
+  static size_t writeEscaped(const uint8_t *data, size_t length,
+                             uint8_t *output);
+  static void writeHeader(uint8_t *frame, uint32_t payloadLength, uint16_t crc,
+                          uint8_t type);
   bool isTimeout() const;
 };
 
@@ -367,7 +367,9 @@
     do {                                                                               \
         if (slider) {                                                                  \
             lv_obj_add_event_cb(slider, visual_handler, LV_EVENT_VALUE_CHANGED, NULL); \
+            lv_obj_add_event_cb(slider, change_handler, LV_EVENT_PRESSED, NULL);       \
             lv_obj_add_event_cb(slider, change_handler, LV_EVENT_RELEASED, NULL);      \
+            lv_obj_add_event_cb(slider, change_handler, LV_EVENT_PRESS_LOST, NULL);    \
             ESP_LOGD(TAG, #slider " volume handlers registered");                      \
         } else {                                                                       \
             ESP_LOGW(TAG, #slider " is null - skipping volume setup");                 \
@@ -462,19 +464,19 @@
 // =============================================================================
 
 /**
- * Validate device selection for current tab context
+ * Validate device selection (a DeviceHandle) for current tab context
  */
-#define VALIDATE_DEVICE_SELECTION(device_ptr, tab_name, return_value) \
+#define VALIDATE_DEVICE_SELECTION(device, tab_name, return_value)     \
     do {                                                              \
-        if (!device_ptr) {                                            \
+        if (!state.isValid(device)) {                                 \
             ESP_LOGW(TAG, "No device selected for %s tab", tab_name); \
             return return_value;                                      \
         }                                                             \
     } while (0)
 
-#define VALIDATE_DEVICE_SELECTION_VOID(device_ptr, tab_name)          \
+#define VALIDATE_DEVICE_SELECTION_VOID(device, tab_name)              \
     do {                                                              \
-        if (!device_ptr) {                                            \
+        if (!state.isValid(device)) {                                 \
             ESP_LOGW(TAG, "No device selected for %s tab", tab_name); \
             return;                                                   \
         }                                                             \
@@ -498,7 +500,7 @@
 #define NOTIFY_STATE_CHANGE_IF_DIFFERENT(old_device, new_device, change_type)  \
     do {                                                                       \
         if (old_device != new_device) {                                        \
-            String deviceName = new_device ? new_device->processName : "";     \
+            String deviceName = state.getDeviceName(new_device);               \
             notifyStateChange(AudioStateChangeEvent::change_type(deviceName)); \
         }                                                                      \
     } while (0)
@@ -508,7 +510,7 @@
  */
 #define VALIDATE_BALANCE_DEVICES(device1, device2, return_value)      \
     do {                                                              \
-        if (!device1 || !device2) {                                   \
+        if (!state.isValid(device1) || !state.isValid(device2)) {     \
             ESP_LOGW(TAG, "Balance operation requires both devices"); \
             return return_value;                                      \
         }                                                             \
@@ -516,7 +518,7 @@
 
 #define VALIDATE_BALANCE_DEVICES_VOID(device1, device2)               \
     do {                                                              \
-        if (!device1 || !device2) {                                   \
+        if (!state.isValid(device1) || !state.isValid(device2)) {     \
             ESP_LOGW(TAG, "Balance operation requires both devices"); \
             return;                                                   \
         }                                                             \
@@ -527,9 +529,9 @@
  */
 #define UPDATE_BALANCE_SELECTION(device1_name, device2_name)                        \
     do {                                                                            \
-        AudioLevel* dev1 = state.findDevice(device1_name);                          \
-        AudioLevel* dev2 = state.findDevice(device2_name);                          \
-        if (dev1 && dev2) {                                                         \
+        DeviceHandle dev1 = state.findDevice(device1_name);                         \
+        DeviceHandle dev2 = state.findDevice(device2_name);                         \
+        if (state.isValid(dev1) && state.isValid(dev2)) {                           \
             state.selectedDevice1 = dev1;                                           \
             state.selectedDevice2 = dev2;                                           \
             ESP_LOGI(TAG, "Updated balance selection: %s, %s",                      \
@@ -549,10 +551,12 @@
         float ratio = constrain(balance_ratio, -1.0f, 1.0f);               \
         int volume1 = clampedVolume * (1.0f - ratio) * 0.5f;               \
         int volume2 = clampedVolume * (1.0f + ratio) * 0.5f;               \
-        device1->volume = constrain(volume1, 0, 100);                      \
-        device2->volume = constrain(volume2, 0, 100);                      \
+        SessionTable& sessions = state.currentStatus.sessions;             \
+        sessions.setVolume(device1, volume1);                              \
+        sessions.setVolume(device2, volume2);                              \
         ESP_LOGI(TAG, "Balance distribute: %d -> dev1:%d, dev2:%d",        \
-                 clampedVolume, device1->volume, device2->volume);         \
+                 clampedVolume, sessions.volume(device1),                  \
+                 sessions.volume(device2));                                \
     } while (0)
 
 // =============================================================================
@@ -68,6 +68,48 @@
 #define MESSAGING_MAX_PAYLOAD_LENGTH                                           \
   4096 * 2 // Increased from 2048 to match buffer size
 
+// Request/response correlation (CorrelationEngine)
+#define MESSAGING_CORRELATION_MAX_IN_FLIGHT 32 // Tracked requests at once
+#define MESSAGING_CORRELATION_WHEEL_SLOTS 64   // Deadline wheel buckets
+#define MESSAGING_CORRELATION_TICK_MS 250      // Deadline wheel resolution
+#define MESSAGING_STATUS_REQUEST_TIMEOUT_MS 5000
+#define MESSAGING_ASSET_REQUEST_TIMEOUT_MS 30000
+
+// TX batching (BinaryProtocol BATCH_MESSAGE_TYPE frames)
+// 0 = never batch, 1 = batch once the host has sent a batch frame itself,
+// 2 = always batch (host must understand type 0x02)
+#define MESSAGING_BATCH_TX_MODE 1
+#define MESSAGING_BATCH_MAX_MESSAGES 32 // Messages per batch frame
+
+// Wire capture (WireCapture) - raw serial traffic log on SD for replay
+#define MESSAGING_WIRE_CAPTURE_BUFFER_SIZE (16 * 1024) // x2, double-buffered
+#define MESSAGING_WIRE_CAPTURE_FLUSH_MS 500 // Max delay before data hits SD
+#define MESSAGING_WIRE_CAPTURE_PATH "/capture/wire.ucap"
+
+// Inbound priority scheduling (InboundScheduler)
+#define MESSAGING_INBOUND_QUEUE_DEPTH 24 // Per priority class
+#define MESSAGING_INBOUND_QUEUE_BYTES (32 * 1024) // JSON held per class
+#define MESSAGING_INBOUND_DISPATCH_BUDGET_US 5000 // Per RXTX loop pass
+#define MESSAGING_INBOUND_MAX_STREAK 8 // Higher-class runs before a bulk slot
+#define MESSAGING_INBOUND_MAX_WAIT_MS 250 // Served next once this old
+
+// Live volume streaming while a volume slider is dragged (VolumeStreamer)
+#define MESSAGING_VOLUME_STREAM_HZ 30 // Max SET_VOLUME rate, 0 = on release only
+#define MESSAGING_VOLUME_STREAM_TX_BACKLOG 4 // TX queue depth treated as busy
+#define MESSAGING_VOLUME_INTENT_TIMEOUT_MS 1500 // Unconfirmed SET_VOLUME hold
+
+// Warm-start cache of the last audio state in NVS (AudioStateCache)
+#define MESSAGING_STATE_CACHE_ENABLED 1
+#define MESSAGING_STATE_CACHE_DEBOUNCE_MS 5000 // Quiet time before a save
+#define MESSAGING_STATE_CACHE_MAX_DELAY_MS 60000 // Save even while changing
+
+// Logo prefetching (LogoPrefetcher)
+#define MESSAGING_LOGO_PREFETCH_MAX_IN_FLIGHT 2 // Asset requests outstanding
+#define MESSAGING_LOGO_PREFETCH_RETRY_MS 30000  // After a failed request
+
+// Named volume/mute scenes on SD (SceneStore)
+#define MESSAGING_SCENE_DIR "/scenes" // One <name>.scn file per scene
+
 // =============================================================================
 // SAFE MESSAGING MACROS - Centralized Safety Improvements
 // =============================================================================
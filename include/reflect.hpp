@@ -8,16 +8,47 @@
 
 namespace reflective {
 
-// Helper for static string-keyed field list
-#define REFLECT_DECLARE(...)                    \
-    using Self = std::decay_t<decltype(*this)>; \
-    static constexpr auto _reflect_fields() {   \
-        return std::make_tuple(__VA_ARGS__);    \
+// Helper for static string-keyed field list. `this` is not usable at class
+// scope, so the enclosing type has to be named explicitly.
+#define REFLECT_DECLARE(Type, ...)            \
+    using Self = Type;                        \
+    static constexpr auto _reflect_fields() { \
+        return std::make_tuple(__VA_ARGS__);  \
     }
 
 #define REFLECT_FIELD(field) \
     std::pair<std::string_view, decltype(&Self::field)> { #field, &Self::field }
 
+// Same as REFLECT_FIELD, but with an external (wire) name that differs from
+// the member name
+#define REFLECT_FIELD_AS(field, name) \
+    std::pair<std::string_view, decltype(&Self::field)> { name, &Self::field }
+
+// Compile-time field table, materialized once per type
+template <typename T>
+inline constexpr auto fields_v = T::_reflect_fields();
+
+template <typename T>
+inline constexpr std::size_t field_count_v = std::tuple_size_v<decltype(fields_v<T>)>;
+
+// Detects types declared with REFLECT_DECLARE
+template <typename T, typename = void>
+struct is_reflected : std::false_type {};
+
+template <typename T>
+struct is_reflected<T, std::void_t<decltype(T::_reflect_fields())>> : std::true_type {};
+
+template <typename T>
+inline constexpr bool is_reflected_v = is_reflected<T>::value;
+
+// Calls fn(name, memberPointer) for every declared field, in declaration
+// order. The fold expands at compile time, so there is no lookup loop.
+template <typename T, typename F>
+constexpr void for_each_field(F&& fn) {
+    std::apply([&](const auto&... field) { (fn(field.first, field.second), ...); },
+               fields_v<T>);
+}
+
 // Main template for reflection access
 
 namespace detail {
@@ -0,0 +1,328 @@
+// reflect_codec.hpp
+#pragma once
+
+#include "reflect.hpp"
+#include <ArduinoJson.h>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * Codecs generated from REFLECT_DECLARE field tables.
+ *
+ * Every encoder/decoder here is a template that expands field by field at
+ * compile time (see reflective::for_each_field), so a struct declares its
+ * fields once and gets JSON and binary support without hand-written
+ * extraction code.
+ *
+ * Supported member types:
+ *   - arithmetic types and bool
+ *   - fixed char buffers (char[N]), always NUL-terminated on decode
+ *   - fixed arrays of any supported type (T[N])
+ *   - nested reflected structs
+ *
+ * Missing JSON keys decode to zero / "" / false, matching the
+ * SAFE_JSON_EXTRACT_* defaults.
+ */
+namespace reflective {
+namespace codec {
+
+namespace detail {
+template <typename T>
+struct is_char_buffer : std::false_type {};
+
+template <std::size_t N>
+struct is_char_buffer<char[N]> : std::true_type {};
+
+template <typename T>
+inline constexpr bool is_char_buffer_v = is_char_buffer<T>::value;
+
+template <std::size_t N>
+inline void copyString(char (&dst)[N], const char* src) {
+    if (!src) src = "";
+    strncpy(dst, src, N - 1);
+    dst[N - 1] = '\0';
+}
+
+template <typename T>
+inline constexpr bool is_supported_v =
+    is_reflected_v<T> || std::is_arithmetic_v<T> || std::is_array_v<T>;
+}  // namespace detail
+
+// =============================================================================
+// JSON
+// =============================================================================
+
+template <typename T>
+void encodeFields(JsonObject obj, const T& value);
+
+template <typename T>
+void decodeFields(JsonObjectConst obj, T& value);
+
+// Slot is any ArduinoJson writable reference (JsonVariant, MemberProxy,
+// ElementProxy)
+template <typename Slot, typename T>
+inline void encodeValue(Slot&& slot, const T& value) {
+    static_assert(detail::is_supported_v<T>, "Unsupported reflected member type");
+
+    if constexpr (is_reflected_v<T>) {
+        encodeFields(slot.template to<JsonObject>(), value);
+    } else if constexpr (detail::is_char_buffer_v<T>) {
+        // Cast so ArduinoJson copies the buffer instead of linking it as a
+        // string literal
+        slot.set(static_cast<const char*>(value));
+    } else if constexpr (std::is_array_v<T>) {
+        JsonArray arr = slot.template to<JsonArray>();
+        for (const auto& element : value) {
+            encodeValue(arr.template add<JsonVariant>(), element);
+        }
+    } else {
+        slot.set(value);
+    }
+}
+
+template <typename T>
+inline void decodeValue(JsonVariantConst src, T& value) {
+    static_assert(detail::is_supported_v<T>, "Unsupported reflected member type");
+
+    if constexpr (is_reflected_v<T>) {
+        decodeFields(src.as<JsonObjectConst>(), value);
+    } else if constexpr (detail::is_char_buffer_v<T>) {
+        detail::copyString(value, src.as<const char*>());
+    } else if constexpr (std::is_array_v<T>) {
+        std::size_t i = 0;
+        for (JsonVariantConst element : src.as<JsonArrayConst>()) {
+            if (i >= std::extent_v<T>) break;
+            decodeValue(element, value[i++]);
+        }
+    } else {
+        value = src.as<T>();
+    }
+}
+
+template <typename T>
+inline void encodeFields(JsonObject obj, const T& value) {
+    for_each_field<T>([&](std::string_view name, auto member) {
+        encodeValue(obj[name.data()], value.*member);
+    });
+}
+
+template <typename T>
+inline void decodeFields(JsonObjectConst obj, T& value) {
+    for_each_field<T>([&](std::string_view name, auto member) {
+        decodeValue(obj[name.data()], value.*member);
+    });
+}
+
+// Counted arrays of reflected structs (e.g. sessions[16] + sessionCount)
+template <typename T, std::size_t N>
+inline void encodeArray(JsonArray arr, const T (&items)[N], std::size_t count) {
+    if (count > N) count = N;
+    for (std::size_t i = 0; i < count; i++) {
+        encodeValue(arr.add<JsonVariant>(), items[i]);
+    }
+}
+
+template <typename T, std::size_t N>
+inline std::size_t decodeArray(JsonArrayConst arr, T (&items)[N]) {
+    std::size_t count = 0;
+    for (JsonVariantConst element : arr) {
+        if (count >= N) break;
+        decodeValue(element, items[count++]);
+    }
+    return count;
+}
+
+// =============================================================================
+// BINARY
+// =============================================================================
+// Layout: fields in declaration order, no names or tags.
+//   arithmetic -> raw sizeof(T) bytes (target is little-endian)
+//   bool       -> 1 byte
+//   char[N]    -> uint16 length + bytes (no terminator)
+//   T[N]       -> N encoded elements
+// Use schemaHash<T>() to detect layout changes in persisted data.
+
+struct BinaryWriter {
+    uint8_t* buffer;
+    std::size_t capacity;
+    std::size_t position = 0;
+    bool overflow = false;
+
+    BinaryWriter(uint8_t* buf, std::size_t cap) : buffer(buf), capacity(cap) {}
+
+    void put(const void* data, std::size_t len) {
+        if (overflow || position + len > capacity) {
+            overflow = true;
+            return;
+        }
+        memcpy(buffer + position, data, len);
+        position += len;
+    }
+};
+
+struct BinaryReader {
+    const uint8_t* buffer;
+    std::size_t size;
+    std::size_t position = 0;
+    bool underflow = false;
+
+    BinaryReader(const uint8_t* buf, std::size_t len) : buffer(buf), size(len) {}
+
+    bool get(void* data, std::size_t len) {
+        if (underflow || position + len > size) {
+            underflow = true;
+            return false;
+        }
+        memcpy(data, buffer + position, len);
+        position += len;
+        return true;
+    }
+};
+
+template <typename T>
+inline void writeValue(BinaryWriter& out, const T& value) {
+    static_assert(detail::is_supported_v<T>, "Unsupported reflected member type");
+
+    if constexpr (is_reflected_v<T>) {
+        for_each_field<T>([&](std::string_view, auto member) {
+            writeValue(out, value.*member);
+        });
+    } else if constexpr (detail::is_char_buffer_v<T>) {
+        uint16_t len = static_cast<uint16_t>(strnlen(value, std::extent_v<T> - 1));
+        out.put(&len, sizeof(len));
+        out.put(value, len);
+    } else if constexpr (std::is_array_v<T>) {
+        for (const auto& element : value) writeValue(out, element);
+    } else if constexpr (std::is_same_v<T, bool>) {
+        uint8_t b = value ? 1 : 0;
+        out.put(&b, 1);
+    } else {
+        out.put(&value, sizeof(T));
+    }
+}
+
+template <typename T>
+inline void readValue(BinaryReader& in, T& value) {
+    static_assert(detail::is_supported_v<T>, "Unsupported reflected member type");
+
+    if constexpr (is_reflected_v<T>) {
+        for_each_field<T>([&](std::string_view, auto member) {
+            readValue(in, value.*member);
+        });
+    } else if constexpr (detail::is_char_buffer_v<T>) {
+        uint16_t len = 0;
+        if (!in.get(&len, sizeof(len))) return;
+        std::size_t keep = len < std::extent_v<T> - 1 ? len : std::extent_v<T> - 1;
+        if (!in.get(value, keep)) return;
+        value[keep] = '\0';
+        in.position += len - keep;  // Skip truncated tail
+        if (in.position > in.size) in.underflow = true;
+    } else if constexpr (std::is_array_v<T>) {
+        for (auto& element : value) readValue(in, element);
+    } else if constexpr (std::is_same_v<T, bool>) {
+        uint8_t b = 0;
+        in.get(&b, 1);
+        value = b != 0;
+    } else {
+        in.get(&value, sizeof(T));
+    }
+}
+
+// Returns bytes written, 0 on overflow
+template <typename T>
+inline std::size_t toBinary(const T& value, uint8_t* buffer, std::size_t capacity) {
+    BinaryWriter out(buffer, capacity);
+    writeValue(out, value);
+    return out.overflow ? 0 : out.position;
+}
+
+// Returns bytes consumed, 0 on truncated input
+template <typename T>
+inline std::size_t fromBinary(T& value, const uint8_t* buffer, std::size_t size) {
+    BinaryReader in(buffer, size);
+    readValue(in, value);
+    return in.underflow ? 0 : in.position;
+}
+
+// FNV-1a over field names and member sizes, evaluated at compile time
+template <typename T>
+constexpr uint32_t schemaHash() {
+    uint32_t hash = 2166136261U;
+    auto mix = [&hash](uint32_t byte) {
+        hash ^= byte & 0xFF;
+        hash *= 16777619U;
+    };
+    for_each_field<T>([&](std::string_view name, auto member) {
+        for (char c : name) mix(static_cast<uint8_t>(c));
+        using M = std::remove_reference_t<decltype(std::declval<T&>().*member)>;
+        if constexpr (is_reflected_v<M>) {
+            uint32_t nested = schemaHash<M>();
+            for (int i = 0; i < 4; i++) mix(nested >> (i * 8));
+        } else {
+            mix(sizeof(M));
+            mix(sizeof(M) >> 8);
+        }
+    });
+    return hash;
+}
+
+// =============================================================================
+// CHECKED BLOBS
+// =============================================================================
+// Binary encoding behind a header, for data persisted across firmware
+// versions (NVS, SD). A blob is only decoded if the caller's magic, the
+// schemaHash<T>() of the build that wrote it and the checksum all match.
+
+struct BlobHeader {
+    uint32_t magic;
+    uint32_t schema;
+    uint32_t checksum;  // FNV-1a of the encoded value
+    uint16_t length;
+    uint16_t reserved;
+};
+
+namespace detail {
+inline uint32_t checksum(const uint8_t* data, std::size_t length) {
+    uint32_t hash = 2166136261U;
+    for (std::size_t i = 0; i < length; i++) {
+        hash ^= data[i];
+        hash *= 16777619U;
+    }
+    return hash;
+}
+}  // namespace detail
+
+// Returns the blob size, 0 if it does not fit
+template <typename T>
+inline std::size_t toBlob(const T& value, uint32_t magic, uint8_t* out, std::size_t capacity) {
+    if (!out || capacity <= sizeof(BlobHeader)) return 0;
+    uint8_t* payload = out + sizeof(BlobHeader);
+    std::size_t length = toBinary(value, payload, capacity - sizeof(BlobHeader));
+    if (length == 0 || length > UINT16_MAX) return 0;
+
+    BlobHeader header = {};
+    header.magic = magic;
+    header.schema = schemaHash<T>();
+    header.checksum = detail::checksum(payload, length);
+    header.length = static_cast<uint16_t>(length);
+    memcpy(out, &header, sizeof(header));
+    return sizeof(header) + length;
+}
+
+// Leaves 'value' partly written on a checksum-valid but truncated payload
+template <typename T>
+inline bool fromBlob(T& value, uint32_t magic, const uint8_t* data, std::size_t size) {
+    if (!data || size <= sizeof(BlobHeader)) return false;
+    BlobHeader header;
+    memcpy(&header, data, sizeof(header));
+    const uint8_t* payload = data + sizeof(header);
+    if (header.magic != magic || header.schema != schemaHash<T>() ||
+        header.length != size - sizeof(header) ||
+        header.checksum != detail::checksum(payload, header.length)) {
+        return false;
+    }
+    return fromBinary(value, payload, header.length) == header.length;
+}
+
+}  // namespace codec
+}  // namespace reflective
@@ -0,0 +1,101 @@
+#!/usr/bin/env python3
+"""Inspect wire captures recorded by Messaging::WireCapture.
+
+Capture layout (little-endian, see src/messaging/WireCapture.h):
+    header: b"UMXWCAP" + version byte
+    record: <u32 timestamp_us> <u16 length> <u8 direction> <u8 reserved> bytes
+    direction: 1 = RX (host -> device), 2 = TX (device -> host)
+
+Prints the record counts, sizes and gaps per direction; --dump lists every
+record with a hex preview:
+
+    python3 scripts/wire_replay.py capture.ucap [--dump]
+
+Decoding and timing the RX stream is done by the host replayer, which runs
+the firmware's own framer, scheduler, parser and router:
+
+    pio run -e wire_replay
+    .pio/build/wire_replay/program capture.ucap
+"""
+
+import argparse
+import struct
+import sys
+
+MAGIC = b"UMXWCAP"
+RECORD_HEADER = struct.Struct("<IHBB")
+DIRECTION_RX = 1
+DIRECTION_TX = 2
+DIRECTION_NAMES = {DIRECTION_RX: "RX", DIRECTION_TX: "TX"}
+
+
+def read_capture(path):
+    """Return a list of (timestamp_us, direction, bytes), timestamps unwrapped."""
+    with open(path, "rb") as f:
+        data = f.read()
+
+    if data[:7] != MAGIC:
+        raise ValueError(f"{path}: not a wire capture")
+    if data[7] != 1:
+        raise ValueError(f"{path}: unsupported capture version {data[7]}")
+
+    records = []
+    offset = 8
+    base = 0
+    last = None
+    while offset + RECORD_HEADER.size <= len(data):
+        stamp, length, direction, _ = RECORD_HEADER.unpack_from(data, offset)
+        offset += RECORD_HEADER.size
+        if offset + length > len(data):
+            print(f"warning: truncated record at offset {offset}", file=sys.stderr)
+            break
+        if last is not None and stamp < last:
+            base += 1 << 32  # esp_timer low word wrapped
+        last = stamp
+        records.append((base + stamp, direction, data[offset:offset + length]))
+        offset += length
+    return records
+
+
+def summarise(records):
+    span = (records[-1][0] - records[0][0]) / 1e6 if records else 0.0
+    print(f"{len(records)} records over {span:.3f}s")
+    for direction, name in DIRECTION_NAMES.items():
+        stamps = [r[0] for r in records if r[1] == direction]
+        sizes = [len(r[2]) for r in records if r[1] == direction]
+        if not sizes:
+            print(f"  {name}: none")
+            continue
+        gaps = [b - a for a, b in zip(stamps, stamps[1:])]
+        line = (f"  {name}: {len(sizes)} records, {sum(sizes)} bytes, "
+                f"size {min(sizes)}..{max(sizes)}")
+        if gaps:
+            line += f", gap {min(gaps)}..{max(gaps)}us"
+        print(line)
+
+
+def dump(records):
+    first = records[0][0] if records else 0
+    for stamp, direction, data in records:
+        name = DIRECTION_NAMES.get(direction, f"?{direction}")
+        preview = data[:24].hex(" ")
+        more = " ..." if len(data) > 24 else ""
+        print(f"{(stamp - first) / 1e3:12.3f}ms {name} {len(data):5d}  "
+              f"{preview}{more}")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("capture", help="capture file copied from the SD card")
+    parser.add_argument("--dump", action="store_true",
+                        help="list every record with a hex preview")
+    args = parser.parse_args()
+
+    records = read_capture(args.capture)
+    summarise(records)
+    if args.dump:
+        dump(records)
+
+
+if __name__ == "__main__":
+    main()
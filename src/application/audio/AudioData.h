@@ -1,7 +1,8 @@
 #pragma once
 
 #include "UiEventHandlers.h"
-#include <map>
+#include <Hash.h>
+#include <cstring>
 #include <vector>
 #include <Arduino.h>
 
@@ -29,76 +30,471 @@ struct AudioLevel {
 // Alias for clarity in some contexts
 using AudioDevice = AudioLevel;
 
+// =============================================================================
+// SESSION TABLE
+// =============================================================================
+
+/**
+ * Stable reference to a SessionTable slot
+ * The slot generation is bumped whenever a session is removed, so a handle
+ * taken before its process went away stops resolving even if the slot has
+ * since been reused for another process.
+ */
+struct SessionChanges;
+
+struct DeviceHandle {
+    static const uint8_t INVALID_INDEX = 0xFF;
+
+    uint8_t index = INVALID_INDEX;
+    uint16_t generation = 0;
+
+    bool isNull() const { return index == INVALID_INDEX; }
+
+    bool operator==(const DeviceHandle& other) const {
+        return index == other.index && generation == other.generation;
+    }
+    bool operator!=(const DeviceHandle& other) const { return !(*this == other); }
+};
+
+/**
+ * Fixed-capacity table of audio sessions keyed by process name
+ *
+ * Nothing is allocated after construction. Fields read on every lookup and
+ * render (volume, flags, name hash, generation) are parallel arrays; names
+ * live in per-slot buffers next to their FNV-1a hash, so a lookup compares
+ * integers and only falls back to strncmp on a hash match. A session keeps
+ * its slot for as long as its process is reported, which is what lets
+ * AudioAppState hold DeviceHandles across status updates.
+ *
+ * order[] lists the occupied slots sorted by process name (the iteration
+ * order of the std::map this replaces, and therefore the dropdown order).
+ * Accessors return neutral values for handles that no longer resolve.
+ */
+class SessionTable {
+public:
+    static const uint8_t CAPACITY = 16;  // Message::AudioData::sessions
+    static const size_t NAME_SIZE = 64;
+    static const size_t STATE_SIZE = 32;
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    bool full() const { return count >= CAPACITY; }
+
+    bool isValid(DeviceHandle handle) const {
+        return handle.index < CAPACITY && (flags[handle.index] & FLAG_USED) &&
+               generation[handle.index] == handle.generation;
+    }
+
+    DeviceHandle find(const char* processName) const {
+        if (!processName) return DeviceHandle();
+        uint32_t hash = hashName(processName);
+        for (uint8_t i = 0; i < count; i++) {
+            uint8_t slot = order[i];
+            if (nameHash[slot] == hash &&
+                strncmp(processNames[slot], processName, NAME_SIZE - 1) == 0) {
+                return handleFor(slot);
+            }
+        }
+        return DeviceHandle();
+    }
+
+    // Handle of the session at a position in name order
+    DeviceHandle handleAt(size_t position) const {
+        return position < count ? handleFor(order[position]) : DeviceHandle();
+    }
+
+    // Position in name order (= dropdown option index), -1 if not present
+    int positionOf(DeviceHandle handle) const {
+        if (!isValid(handle)) return -1;
+        for (uint8_t i = 0; i < count; i++) {
+            if (order[i] == handle.index) return i;
+        }
+        return -1;
+    }
+
+    // Insert or update; returns a null handle when the table is full
+    DeviceHandle put(const char* processName, const char* friendlyName, int volume,
+                     bool isMuted, const char* state, unsigned long lastUpdate) {
+        DeviceHandle handle = find(processName);
+        if (handle.isNull()) {
+            handle = insert(processName);
+            if (handle.isNull()) return handle;
+        }
+        uint8_t slot = handle.index;
+        copyName(friendlyNames[slot], friendlyName, NAME_SIZE);
+        copyName(states[slot], state, STATE_SIZE);
+        volumes[slot] = clampVolume(volume);
+        flags[slot] = FLAG_USED | (isMuted ? FLAG_MUTED : 0);
+        lastUpdates[slot] = lastUpdate;
+        return handle;
+    }
+
+    bool remove(DeviceHandle handle) {
+        if (!isValid(handle)) return false;
+        int position = positionOf(handle);
+        memmove(&order[position], &order[position + 1], count - position - 1);
+        count--;
+        membership++;
+        release(handle.index);
+        return true;
+    }
+
+    void clear() {
+        if (count == 0) return;
+        for (uint8_t i = 0; i < count; i++) {
+            release(order[i]);
+        }
+        count = 0;
+        membership++;
+    }
+
+    // Make this table hold exactly the sessions of 'source', writing only
+    // fields that differ. Sessions present in both keep their slot and
+    // generation, so their handles stay valid. Reports what changed if asked.
+    void syncFrom(const SessionTable& source, SessionChanges* changes = nullptr);
+
+    // Bumped whenever a session is added or removed (not on field changes)
+    uint32_t membershipVersion() const { return membership; }
+
+    // Read-only view of one session; resolves through the table, so it is
+    // only as valid as the table it came from
+    class Entry {
+    public:
+        Entry(const SessionTable& table, DeviceHandle handle) : table(&table), device(handle) {}
+
+        DeviceHandle handle() const { return device; }
+        const char* processName() const { return table->processName(device); }
+        const char* friendlyName() const { return table->friendlyName(device); }
+        const char* state() const { return table->state(device); }
+        int volume() const { return table->volume(device); }
+        bool isMuted() const { return table->isMuted(device); }
+        bool isStale() const { return table->isStale(device); }
+        unsigned long lastUpdate() const { return table->lastUpdate(device); }
+
+    private:
+        const SessionTable* table;
+        DeviceHandle device;
+    };
+
+    // Iterates sessions in name order without copying anything:
+    //   for (SessionTable::Entry session : sessions) { ... }
+    class Iterator {
+    public:
+        Iterator(const SessionTable& table, uint8_t position) : table(&table), position(position) {}
+
+        Entry operator*() const { return Entry(*table, table->handleAt(position)); }
+        Iterator& operator++() {
+            position++;
+            return *this;
+        }
+        bool operator!=(const Iterator& other) const { return position != other.position; }
+
+    private:
+        const SessionTable* table;
+        uint8_t position;
+    };
+
+    Iterator begin() const { return Iterator(*this, 0); }
+    Iterator end() const { return Iterator(*this, count); }
+
+    // Process names in name order joined by 'separator' into 'out' (always
+    // terminated); names that do not fit are left out. Returns the length.
+    size_t joinProcessNames(char* out, size_t size, char separator) const {
+        if (!out || size == 0) return 0;
+        size_t length = 0;
+        out[0] = '\0';
+        for (uint8_t i = 0; i < count; i++) {
+            const char* name = processNames[order[i]];
+            size_t nameLength = strlen(name);
+            size_t needed = nameLength + (length > 0 ? 1 : 0);
+            if (length + needed >= size) break;
+            if (length > 0) out[length++] = separator;
+            memcpy(out + length, name, nameLength);
+            length += nameLength;
+            out[length] = '\0';
+        }
+        return length;
+    }
+
+    // Field access
+    const char* processName(DeviceHandle handle) const {
+        return isValid(handle) ? processNames[handle.index] : "";
+    }
+    const char* friendlyName(DeviceHandle handle) const {
+        return isValid(handle) ? friendlyNames[handle.index] : "";
+    }
+    const char* state(DeviceHandle handle) const {
+        return isValid(handle) ? states[handle.index] : "";
+    }
+    int volume(DeviceHandle handle) const {
+        return isValid(handle) ? volumes[handle.index] : 0;
+    }
+    bool isMuted(DeviceHandle handle) const {
+        return isValid(handle) && (flags[handle.index] & FLAG_MUTED);
+    }
+    bool isStale(DeviceHandle handle) const {
+        return isValid(handle) && (flags[handle.index] & FLAG_STALE);
+    }
+    unsigned long lastUpdate(DeviceHandle handle) const {
+        return isValid(handle) ? lastUpdates[handle.index] : 0;
+    }
+
+    void setVolume(DeviceHandle handle, int volume) {
+        if (isValid(handle)) volumes[handle.index] = clampVolume(volume);
+    }
+    void setMuted(DeviceHandle handle, bool muted) { setFlag(handle, FLAG_MUTED, muted); }
+    void setStale(DeviceHandle handle, bool stale) { setFlag(handle, FLAG_STALE, stale); }
+    void setLastUpdate(DeviceHandle handle, unsigned long timestamp) {
+        if (isValid(handle)) lastUpdates[handle.index] = timestamp;
+    }
+
+private:
+    static const uint8_t FLAG_USED = 0x01;
+    static const uint8_t FLAG_MUTED = 0x02;
+    static const uint8_t FLAG_STALE = 0x04;
+
+    // Hot fields
+    uint8_t volumes[CAPACITY] = {};
+    uint8_t flags[CAPACITY] = {};
+    uint16_t generation[CAPACITY] = {};
+    uint32_t nameHash[CAPACITY] = {};
+    uint8_t order[CAPACITY] = {};
+    uint8_t count = 0;
+    uint32_t membership = 0;
+
+    // Cold fields
+    unsigned long lastUpdates[CAPACITY] = {};
+    char processNames[CAPACITY][NAME_SIZE] = {};
+    char friendlyNames[CAPACITY][NAME_SIZE] = {};
+    char states[CAPACITY][STATE_SIZE] = {};
+
+    DeviceHandle handleFor(uint8_t slot) const {
+        DeviceHandle handle;
+        handle.index = slot;
+        handle.generation = generation[slot];
+        return handle;
+    }
+
+    DeviceHandle insert(const char* processName) {
+        if (!processName || full()) return DeviceHandle();
+
+        uint8_t slot = 0;
+        while (flags[slot] & FLAG_USED) slot++;
+
+        copyName(processNames[slot], processName, NAME_SIZE);
+        nameHash[slot] = hashName(processNames[slot]);
+        flags[slot] = FLAG_USED;
+        volumes[slot] = 0;
+        lastUpdates[slot] = 0;
+        friendlyNames[slot][0] = '\0';
+        states[slot][0] = '\0';
+
+        // Keep order[] sorted by name
+        uint8_t position = count;
+        while (position > 0 && strcmp(processNames[order[position - 1]], processNames[slot]) > 0) {
+            order[position] = order[position - 1];
+            position--;
+        }
+        order[position] = slot;
+        count++;
+        membership++;
+        return handleFor(slot);
+    }
+
+    void release(uint8_t slot) {
+        flags[slot] = 0;
+        generation[slot]++;
+        processNames[slot][0] = '\0';
+    }
+
+    void setFlag(DeviceHandle handle, uint8_t flag, bool on) {
+        if (!isValid(handle)) return;
+        if (on) {
+            flags[handle.index] |= flag;
+        } else {
+            flags[handle.index] &= ~flag;
+        }
+    }
+
+    static uint32_t hashName(const char* name) {
+        return Hash::fnv1a(name, strnlen(name, NAME_SIZE - 1));
+    }
+
+    static void copyName(char* destination, const char* source, size_t size) {
+        strncpy(destination, source ? source : "", size - 1);
+        destination[size - 1] = '\0';
+    }
+
+    static uint8_t clampVolume(int volume) {
+        return static_cast<uint8_t>(constrain(volume, 0, 100));
+    }
+};
+
+/**
+ * What SessionTable::syncFrom changed, per slot
+ * Names of removed sessions are kept here because their slots are released.
+ */
+struct SessionChanges {
+    static const uint8_t ADDED = 0x01;
+    static const uint8_t VOLUME = 0x02;
+    static const uint8_t MUTE = 0x04;
+    static const uint8_t INFO = 0x08;  // Friendly name or state
+
+    uint8_t slotChanges[SessionTable::CAPACITY] = {};  // Indexed by DeviceHandle::index
+    uint8_t defaultChanges = 0;                          // Same bits, for the default device
+    uint8_t removedCount = 0;
+    char removedNames[SessionTable::CAPACITY][SessionTable::NAME_SIZE];
+
+    void recordRemoved(const char* processName) {
+        if (removedCount < SessionTable::CAPACITY) {
+            strncpy(removedNames[removedCount], processName, SessionTable::NAME_SIZE - 1);
+            removedNames[removedCount][SessionTable::NAME_SIZE - 1] = '\0';
+            removedCount++;
+        }
+    }
+
+    size_t addedCount() const {
+        size_t total = 0;
+        for (uint8_t changes : slotChanges) {
+            total += (changes & ADDED) != 0;
+        }
+        return total;
+    }
+
+    size_t changedCount() const {
+        size_t total = 0;
+        for (uint8_t changes : slotChanges) {
+            total += changes != 0 && !(changes & ADDED);
+        }
+        return total;
+    }
+
+    bool membershipChanged() const { return removedCount > 0 || addedCount() > 0; }
+    bool empty() const {
+        return removedCount == 0 && defaultChanges == 0 && addedCount() == 0 && changedCount() == 0;
+    }
+};
+
+inline void SessionTable::syncFrom(const SessionTable& source, SessionChanges* changes) {
+    for (int i = count - 1; i >= 0; i--) {
+        uint8_t slot = order[i];
+        if (source.find(processNames[slot]).isNull()) {
+            if (changes) changes->recordRemoved(processNames[slot]);
+            remove(handleFor(slot));
+        }
+    }
+
+    for (uint8_t i = 0; i < source.count; i++) {
+        uint8_t from = source.order[i];
+        uint8_t changed = 0;
+        DeviceHandle handle = find(source.processNames[from]);
+        if (handle.isNull()) {
+            handle = insert(source.processNames[from]);
+            if (handle.isNull()) continue;
+            changed = SessionChanges::ADDED;
+        }
+
+        uint8_t slot = handle.index;
+        if (volumes[slot] != source.volumes[from]) {
+            volumes[slot] = source.volumes[from];
+            changed |= SessionChanges::VOLUME;
+        }
+        if ((flags[slot] ^ source.flags[from]) & FLAG_MUTED) {
+            flags[slot] ^= FLAG_MUTED;
+            changed |= SessionChanges::MUTE;
+        }
+        if (strcmp(friendlyNames[slot], source.friendlyNames[from]) != 0) {
+            copyName(friendlyNames[slot], source.friendlyNames[from], NAME_SIZE);
+            changed |= SessionChanges::INFO;
+        }
+        if (strcmp(states[slot], source.states[from]) != 0) {
+            copyName(states[slot], source.states[from], STATE_SIZE);
+            changed |= SessionChanges::INFO;
+        }
+        flags[slot] = (flags[slot] & ~FLAG_STALE) | (source.flags[from] & FLAG_STALE);
+        lastUpdates[slot] = source.lastUpdates[from];
+
+        if (changes) changes->slotChanges[slot] = changed;
+    }
+}
+
 /**
  * Complete audio system status from external source
- * Uses hash map for efficient device access by name
+ * Sessions live in a fixed-capacity SessionTable (see above)
  */
 struct AudioStatus {
-    std::map<String, AudioLevel> audioDevices;  // Key: processName, Value: AudioLevel
+    SessionTable sessions;
     AudioDevice defaultDevice;
     unsigned long timestamp = 0;
     bool hasDefaultDevice = false;
 
     // Helper methods
     void clear() {
-        audioDevices.clear();
+        sessions.clear();
         defaultDevice = AudioDevice();
         timestamp = 0;
         hasDefaultDevice = false;
     }
 
     bool isEmpty() const {
-        return audioDevices.empty();
+        return sessions.empty();
     }
 
-    AudioLevel* findDevice(const String& processName) {
-        auto it = audioDevices.find(processName);
-        return (it != audioDevices.end()) ? &it->second : nullptr;
-    }
-
-    const AudioLevel* findDevice(const String& processName) const {
-        auto it = audioDevices.find(processName);
-        return (it != audioDevices.end()) ? &it->second : nullptr;
+    DeviceHandle findDevice(const String& processName) const {
+        return sessions.find(processName.c_str());
     }
 
     bool hasDevice(const String& processName) const {
-        return audioDevices.find(processName) != audioDevices.end();
+        return !sessions.find(processName.c_str()).isNull();
     }
 
-    void addOrUpdateDevice(const AudioLevel& device) {
-        audioDevices[device.processName] = device;
+    DeviceHandle addOrUpdateDevice(const AudioLevel& device) {
+        DeviceHandle handle = sessions.put(device.processName.c_str(), device.friendlyName.c_str(),
+                                           device.volume, device.isMuted, device.state.c_str(),
+                                           device.lastUpdate);
+        sessions.setStale(handle, device.stale);
+        return handle;
     }
 
     void removeDevice(const String& processName) {
-        audioDevices.erase(processName);
+        sessions.remove(sessions.find(processName.c_str()));
     }
 
     size_t getDeviceCount() const {
-        return audioDevices.size();
+        return sessions.size();
+    }
+
+    // Materialise one session (cold paths only, allocates Strings)
+    AudioLevel getAudioLevel(DeviceHandle handle) const {
+        AudioLevel level;
+        if (sessions.isValid(handle)) {
+            level.processName = sessions.processName(handle);
+            level.friendlyName = sessions.friendlyName(handle);
+            level.volume = sessions.volume(handle);
+            level.isMuted = sessions.isMuted(handle);
+            level.lastUpdate = sessions.lastUpdate(handle);
+            level.stale = sessions.isStale(handle);
+            level.state = sessions.state(handle);
+        }
+        return level;
     }
 
     // Compatibility methods for existing code that expects vectors
     std::vector<AudioLevel> getAudioLevels() const {
         std::vector<AudioLevel> levels;
-        levels.reserve(audioDevices.size());
-        for (const auto& pair : audioDevices) {
-            levels.push_back(pair.second);
+        levels.reserve(sessions.size());
+        for (size_t i = 0; i < sessions.size(); i++) {
+            levels.push_back(getAudioLevel(sessions.handleAt(i)));
         }
         return levels;
     }
 
     void setAudioLevels(const std::vector<AudioLevel>& levels) {
-        audioDevices.clear();
+        sessions.clear();
         for (const auto& level : levels) {
-            audioDevices[level.processName] = level;
+            addOrUpdateDevice(level);
         }
     }
-
-    // Iterator access for range-based loops
-    auto begin() { return audioDevices.begin(); }
-    auto end() { return audioDevices.end(); }
-    auto begin() const { return audioDevices.begin(); }
-    auto end() const { return audioDevices.end(); }
 };
 
 // =============================================================================
@@ -115,72 +511,71 @@ struct AudioAppState {
     // UI state
     Events::UI::TabState currentTab = Events::UI::TabState::MASTER;
 
-    // Device selections for different tabs (direct pointers to AudioLevel objects in hash map)
-    AudioLevel* primaryAudioDevice = nullptr;    // For master tab - represents the primary/default device
-    AudioLevel* selectedSingleDevice = nullptr;  // For single tab - user-selected individual device
-    AudioLevel* selectedDevice1 = nullptr;       // For balance tab
-    AudioLevel* selectedDevice2 = nullptr;       // For balance tab
+    // Device selections for different tabs (handles into currentStatus.sessions,
+    // they survive status updates for as long as the session exists)
+    DeviceHandle primaryAudioDevice;    // For master tab - represents the primary/default device
+    DeviceHandle selectedSingleDevice;  // For single tab - user-selected individual device
+    DeviceHandle selectedDevice1;       // For balance tab
+    DeviceHandle selectedDevice2;       // For balance tab
 
     // UI interaction flags
 
     // Timing
     unsigned long lastUpdateTime = 0;
 
+    // Bumped by AudioManager every time it publishes the state; never reset,
+    // so a consumer that saw this value has already rendered everything
+    uint32_t version = 0;
+
+    // Restored from AudioStateCache and not yet confirmed by a host status
+    bool fromCache = false;
+
     // Helper methods
     void clear() {
         currentStatus.clear();
+        fromCache = false;
         currentTab = Events::UI::TabState::MASTER;
-        primaryAudioDevice = nullptr;
-        selectedSingleDevice = nullptr;
-        selectedDevice1 = nullptr;
-        selectedDevice2 = nullptr;
+        primaryAudioDevice = DeviceHandle();
+        selectedSingleDevice = DeviceHandle();
+        selectedDevice1 = DeviceHandle();
+        selectedDevice2 = DeviceHandle();
         lastUpdateTime = 0;
     }
 
     bool hasDevices() const {
-        return !currentStatus.audioDevices.empty();
+        return !currentStatus.sessions.empty();
     }
 
-    AudioLevel* findDevice(const String& processName) {
+    DeviceHandle findDevice(const String& processName) const {
         return currentStatus.findDevice(processName);
     }
 
-    const AudioLevel* findDevice(const String& processName) const {
-        return currentStatus.findDevice(processName);
+    bool isValid(DeviceHandle device) const {
+        return currentStatus.sessions.isValid(device);
     }
 
-    const AudioLevel* getCurrentSelectedDevice() const {
-        switch (currentTab) {
-            case Events::UI::TabState::MASTER:
-                // For master tab, use primary device or fallback to system default
-                return primaryAudioDevice ? primaryAudioDevice : (currentStatus.hasDefaultDevice ? &currentStatus.defaultDevice : nullptr);
-            case Events::UI::TabState::SINGLE:
-                return selectedSingleDevice;
-            case Events::UI::TabState::BALANCE:
-                return selectedDevice1;  // Primary device for balance
-            default:
-                return primaryAudioDevice ? primaryAudioDevice : (currentStatus.hasDefaultDevice ? &currentStatus.defaultDevice : nullptr);
-        }
+    String getDeviceName(DeviceHandle device) const {
+        return String(currentStatus.sessions.processName(device));
     }
 
-    AudioLevel* getCurrentSelectedDevice() {
+    // Session selected for the current tab; a null handle in the Master tab
+    // means the system default device (currentStatus.defaultDevice)
+    DeviceHandle getCurrentSelectedDevice() const {
         switch (currentTab) {
-            case Events::UI::TabState::MASTER:
-                // For master tab, use primary device or fallback to system default
-                return primaryAudioDevice ? primaryAudioDevice : (currentStatus.hasDefaultDevice ? &currentStatus.defaultDevice : nullptr);
             case Events::UI::TabState::SINGLE:
                 return selectedSingleDevice;
             case Events::UI::TabState::BALANCE:
                 return selectedDevice1;  // Primary device for balance
+            case Events::UI::TabState::MASTER:
             default:
-                return primaryAudioDevice ? primaryAudioDevice : (currentStatus.hasDefaultDevice ? &currentStatus.defaultDevice : nullptr);
+                return primaryAudioDevice;
         }
     }
 
     String getCurrentSelectedDeviceName() const {
-        const AudioLevel* device = getCurrentSelectedDevice();
-        if (device) {
-            return device->processName;
+        DeviceHandle device = getCurrentSelectedDevice();
+        if (isValid(device)) {
+            return getDeviceName(device);
         }
 
         // If no device selected and we're in Master tab, use default device
@@ -192,10 +587,11 @@ struct AudioAppState {
     }
 
     int getCurrentSelectedVolume() const {
-        const AudioLevel* device = getCurrentSelectedDevice();
-        if (device) {
-            ESP_LOGD("Audio Data", "Current device: %s, volume: %d", device->processName.c_str(), device->volume);
-            return device->volume;
+        DeviceHandle device = getCurrentSelectedDevice();
+        if (isValid(device)) {
+            ESP_LOGD("Audio Data", "Current device: %s, volume: %d",
+                     currentStatus.sessions.processName(device), currentStatus.sessions.volume(device));
+            return currentStatus.sessions.volume(device);
         }
 
         // If no device selected and we're in Master tab, use default device
@@ -210,9 +606,9 @@ struct AudioAppState {
     }
 
     bool isCurrentDeviceMuted() const {
-        const AudioLevel* device = getCurrentSelectedDevice();
-        if (device) {
-            return device->isMuted;
+        DeviceHandle device = getCurrentSelectedDevice();
+        if (isValid(device)) {
+            return currentStatus.sessions.isMuted(device);
         }
 
         // If no device selected and we're in Master tab, use default device
@@ -224,16 +620,16 @@ struct AudioAppState {
     }
 
     bool hasValidSelection() const {
-        return getCurrentSelectedDevice() != nullptr;
+        return isValid(getCurrentSelectedDevice()) ||
+               (currentTab == Events::UI::TabState::MASTER && currentStatus.hasDefaultDevice);
     }
 
-    // Helper to validate device pointers are still valid in current hash map
+    // Drop selections whose session is no longer in the table
     void validateDeviceSelections() {
-        // Check if selected device pointers still exist in our hash map
-        primaryAudioDevice = validateDevicePointer(primaryAudioDevice);
-        selectedSingleDevice = validateDevicePointer(selectedSingleDevice);
-        selectedDevice1 = validateDevicePointer(selectedDevice1);
-        selectedDevice2 = validateDevicePointer(selectedDevice2);
+        primaryAudioDevice = validateDeviceHandle(primaryAudioDevice);
+        selectedSingleDevice = validateDeviceHandle(selectedSingleDevice);
+        selectedDevice1 = validateDeviceHandle(selectedDevice1);
+        selectedDevice2 = validateDeviceHandle(selectedDevice2);
     }
 
     // Tab state queries
@@ -242,13 +638,8 @@ struct AudioAppState {
     bool isInBalanceTab() const { return currentTab == Events::UI::TabState::BALANCE; }
 
    private:
-    // Helper to validate a device pointer still exists in the hash map
-    AudioLevel* validateDevicePointer(AudioLevel* device) {
-        if (!device) return nullptr;
-
-        // Check if device still exists in hash map by looking up its name
-        AudioLevel* found = currentStatus.findDevice(device->processName);
-        return (found == device) ? device : nullptr;  // Only valid if same pointer
+    DeviceHandle validateDeviceHandle(DeviceHandle device) const {
+        return isValid(device) ? device : DeviceHandle();
     }
 
     void updateTimestamp() {
@@ -269,7 +660,11 @@ struct AudioStateChangeEvent {
         SELECTION_CHANGED,
         VOLUME_CHANGED,
         TAB_CHANGED,
-        MUTE_CHANGED
+        MUTE_CHANGED,
+        SESSION_ADDED,
+        SESSION_REMOVED,
+        SESSION_UPDATED,        // Friendly name or state changed
+        DEFAULT_DEVICE_CHANGED  // Default device appeared/went away or was renamed
     };
 
     Type type;
@@ -297,7 +692,67 @@ struct AudioStateChangeEvent {
     static AudioStateChangeEvent muteChanged(const String& device) {
         return {MUTE_CHANGED, device, 0, Events::UI::TabState::MASTER};
     }
+
+    static AudioStateChangeEvent sessionAdded(const String& device) {
+        return {SESSION_ADDED, device, 0, Events::UI::TabState::MASTER};
+    }
+
+    static AudioStateChangeEvent sessionRemoved(const String& device) {
+        return {SESSION_REMOVED, device, 0, Events::UI::TabState::MASTER};
+    }
+
+    static AudioStateChangeEvent sessionUpdated(const String& device) {
+        return {SESSION_UPDATED, device, 0, Events::UI::TabState::MASTER};
+    }
+
+    static AudioStateChangeEvent defaultDeviceChanged() {
+        return {DEFAULT_DEVICE_CHANGED, "", 0, Events::UI::TabState::MASTER};
+    }
 };
 
+/**
+ * Turn a merge result into events, one per changed entry. An empty device
+ * name refers to the default device, as elsewhere in AudioManager.
+ */
+template <typename Emit>
+void forEachChangeEvent(const AudioStatus& status, const SessionChanges& changes, Emit&& emit) {
+    const SessionTable& sessions = status.sessions;
+
+    for (uint8_t i = 0; i < changes.removedCount; i++) {
+        emit(AudioStateChangeEvent::sessionRemoved(changes.removedNames[i]));
+    }
+
+    for (size_t i = 0; i < sessions.size(); i++) {
+        DeviceHandle device = sessions.handleAt(i);
+        uint8_t changed = changes.slotChanges[device.index];
+        if (!changed) continue;
+
+        String name = sessions.processName(device);
+        if (changed & SessionChanges::ADDED) {
+            emit(AudioStateChangeEvent::sessionAdded(name));
+            continue;
+        }
+        if (changed & SessionChanges::VOLUME) {
+            emit(AudioStateChangeEvent::volumeChanged(name, sessions.volume(device)));
+        }
+        if (changed & SessionChanges::MUTE) {
+            emit(AudioStateChangeEvent::muteChanged(name));
+        }
+        if (changed & SessionChanges::INFO) {
+            emit(AudioStateChangeEvent::sessionUpdated(name));
+        }
+    }
+
+    if (changes.defaultChanges & (SessionChanges::ADDED | SessionChanges::INFO)) {
+        emit(AudioStateChangeEvent::defaultDeviceChanged());
+    }
+    if (changes.defaultChanges & SessionChanges::VOLUME) {
+        emit(AudioStateChangeEvent::volumeChanged("", status.defaultDevice.volume));
+    }
+    if (changes.defaultChanges & SessionChanges::MUTE) {
+        emit(AudioStateChangeEvent::muteChanged(""));
+    }
+}
+
 }  // namespace Audio
 }  // namespace Application
@@ -0,0 +1,204 @@
+#include "AudioEventBus.h"
+#include <esp_log.h>
+
+static const char *TAG = "AudioEventBus";
+
+namespace Application {
+namespace Audio {
+
+// =============================================================================
+// SUBSCRIPTION
+// =============================================================================
+
+AudioEventBus::SubscriberId AudioEventBus::subscribe(Callback callback,
+                                                     Delivery delivery) {
+  if (!callback) {
+    return INVALID_SUBSCRIBER;
+  }
+  if (subscriberCount >= MAX_SUBSCRIBERS) {
+    ESP_LOGE(TAG, "Too many subscribers (max %d)", MAX_SUBSCRIBERS);
+    return INVALID_SUBSCRIBER;
+  }
+
+  Subscriber &subscriber = subscribers[subscriberCount];
+  subscriber.callback = callback;
+  subscriber.delivery = delivery;
+  subscriber.count = 0;
+  return subscriberCount++;
+}
+
+void AudioEventBus::clear() {
+  portENTER_CRITICAL(&lock);
+  for (int i = 0; i < subscriberCount; i++) {
+    subscribers[i].count = 0;
+  }
+  portEXIT_CRITICAL(&lock);
+
+  for (int i = 0; i < subscriberCount; i++) {
+    subscribers[i].callback = nullptr;
+  }
+  subscriberCount = 0;
+}
+
+// =============================================================================
+// RAISE / DELIVER
+// =============================================================================
+
+void AudioEventBus::raise(const AudioStateChangeEvent &event) {
+  QueuedEvent queued;
+  queued.type = event.type;
+  queued.volume = event.volume;
+  queued.tab = event.tab;
+  strncpy(queued.deviceName, event.deviceName.c_str(),
+          sizeof(queued.deviceName) - 1);
+  queued.deviceName[sizeof(queued.deviceName) - 1] = '\0';
+
+  portENTER_CRITICAL(&lock);
+  stats.raised++;
+  for (int i = 0; i < subscriberCount; i++) {
+    if (subscribers[i].delivery == Delivery::QUEUED) {
+      enqueue(subscribers[i], queued);
+    }
+  }
+  portEXIT_CRITICAL(&lock);
+
+  for (int i = 0; i < subscriberCount; i++) {
+    if (subscribers[i].delivery == Delivery::IMMEDIATE) {
+      subscribers[i].callback(event);
+      portENTER_CRITICAL(&lock);
+      stats.delivered++;
+      portEXIT_CRITICAL(&lock);
+    }
+  }
+}
+
+size_t AudioEventBus::deliver(SubscriberId id) {
+  if (id < 0 || id >= subscriberCount ||
+      subscribers[id].delivery != Delivery::QUEUED) {
+    return 0;
+  }
+  Subscriber &subscriber = subscribers[id];
+
+  // Take the whole batch; anything raised while it is handled waits for the
+  // next call
+  portENTER_CRITICAL(&lock);
+  uint8_t count = subscriber.count;
+  memcpy(subscriber.delivering, subscriber.queue, count * sizeof(QueuedEvent));
+  subscriber.count = 0;
+  stats.delivered += count;
+  portEXIT_CRITICAL(&lock);
+
+  for (uint8_t i = 0; i < count; i++) {
+    const QueuedEvent &queued = subscriber.delivering[i];
+    AudioStateChangeEvent event{queued.type, String(queued.deviceName),
+                                queued.volume, queued.tab};
+    subscriber.callback(event);
+  }
+  return count;
+}
+
+// Called with the lock held
+void AudioEventBus::enqueue(Subscriber &subscriber, const QueuedEvent &event) {
+  using Type = AudioStateChangeEvent::Type;
+
+  for (uint8_t i = 0; i < subscriber.count; i++) {
+    QueuedEvent &pending = subscriber.queue[i];
+
+    if (event.type == Type::SELECTION_CHANGED &&
+        pending.type == Type::DEVICES_UPDATED) {
+      stats.coalesced++;
+      return;
+    }
+    if (pending.type != event.type) {
+      continue;
+    }
+
+    switch (event.type) {
+    case Type::VOLUME_CHANGED:
+      if (sameDevice(pending, event)) {
+        pending.volume = event.volume;
+        stats.coalesced++;
+        return;
+      }
+      break;
+    case Type::TAB_CHANGED:
+      pending.tab = event.tab;
+      stats.coalesced++;
+      return;
+    case Type::DEVICES_UPDATED:
+      stats.coalesced++;
+      return;
+    default:
+      if (sameDevice(pending, event)) {
+        stats.coalesced++;
+        return;
+      }
+      break;
+    }
+  }
+
+  if (event.type == Type::DEVICES_UPDATED) {
+    uint8_t kept = 0;
+    for (uint8_t i = 0; i < subscriber.count; i++) {
+      if (subscriber.queue[i].type == Type::SELECTION_CHANGED) {
+        stats.coalesced++;
+      } else {
+        subscriber.queue[kept++] = subscriber.queue[i];
+      }
+    }
+    subscriber.count = kept;
+  }
+
+  if (subscriber.count >= QUEUE_DEPTH) {
+    // Too much at once - one full refresh covers all of it
+    stats.overflows++;
+    stats.coalesced += subscriber.count;
+    QueuedEvent &refresh = subscriber.queue[0];
+    refresh.type = Type::DEVICES_UPDATED;
+    refresh.volume = 0;
+    refresh.tab = Events::UI::TabState::MASTER;
+    refresh.deviceName[0] = '\0';
+    subscriber.count = 1;
+    return;
+  }
+
+  subscriber.queue[subscriber.count++] = event;
+}
+
+bool AudioEventBus::sameDevice(const QueuedEvent &a, const QueuedEvent &b) {
+  return strcmp(a.deviceName, b.deviceName) == 0;
+}
+
+// =============================================================================
+// STATUS
+// =============================================================================
+
+size_t AudioEventBus::pendingCount(SubscriberId id) const {
+  if (id < 0 || id >= subscriberCount) {
+    return 0;
+  }
+  portENTER_CRITICAL(&lock);
+  size_t count = subscribers[id].count;
+  portEXIT_CRITICAL(&lock);
+  return count;
+}
+
+AudioEventBus::Stats AudioEventBus::getStats() const {
+  portENTER_CRITICAL(&lock);
+  Stats copy = stats;
+  portEXIT_CRITICAL(&lock);
+  return copy;
+}
+
+String AudioEventBus::getStatus() const {
+  Stats copy = getStats();
+  String status = "Audio Event Bus:\n";
+  status += "- Subscribers: " + String(subscriberCount) + "\n";
+  status += "- Raised " + String(copy.raised) + ", delivered " +
+            String(copy.delivered) + ", coalesced " + String(copy.coalesced) +
+            ", overflows " + String(copy.overflows) + "\n";
+  return status;
+}
+
+} // namespace Audio
+} // namespace Application
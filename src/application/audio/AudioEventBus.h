@@ -0,0 +1,87 @@
+#pragma once
+
+#include "AudioData.h"
+#include <freertos/FreeRTOS.h>
+#include <functional>
+
+namespace Application {
+namespace Audio {
+
+/**
+ * Delivery of AudioStateChangeEvents to subscribers
+ *
+ * IMMEDIATE subscribers are called inline on the task that raised the event
+ * (the old AudioManager behaviour). QUEUED subscribers get a per-subscriber
+ * queue that their own task drains with deliver(), typically once per LVGL
+ * frame, so UI work never runs on the serial task and events raised while
+ * handling an event wait for the next pass instead of recursing.
+ *
+ * While queued, events are coalesced:
+ * - VOLUME_CHANGED for a device already queued updates that entry's volume
+ * - TAB_CHANGED updates the queued tab change
+ * - DEVICES_UPDATED removes queued SELECTION_CHANGED and absorbs later ones
+ * - any other event identical to a queued one (type + device) is dropped
+ * A full queue collapses into a single DEVICES_UPDATED (full refresh).
+ *
+ * raise() may be called from any task; queue access is a short critical
+ * section that copies fixed-size entries, no allocation. Subscribing is
+ * expected during init only.
+ */
+class AudioEventBus {
+public:
+  using Callback = std::function<void(const AudioStateChangeEvent &)>;
+  using SubscriberId = int;
+
+  enum class Delivery { IMMEDIATE, QUEUED };
+
+  static const int MAX_SUBSCRIBERS = 3;
+  static const int QUEUE_DEPTH = 16;
+  static const SubscriberId INVALID_SUBSCRIBER = -1;
+
+  struct Stats {
+    uint32_t raised = 0;
+    uint32_t coalesced = 0; // Merged into or absorbed by a queued event
+    uint32_t delivered = 0; // Callback invocations, all subscribers
+    uint32_t overflows = 0; // Queue collapsed into DEVICES_UPDATED
+  };
+
+  SubscriberId subscribe(Callback callback, Delivery delivery);
+  void clear();
+
+  void raise(const AudioStateChangeEvent &event);
+
+  // Run a QUEUED subscriber's pending events; call from that subscriber's
+  // task. Returns the number delivered.
+  size_t deliver(SubscriberId subscriber);
+
+  size_t pendingCount(SubscriberId subscriber) const;
+  Stats getStats() const;
+  String getStatus() const;
+
+private:
+  struct QueuedEvent {
+    AudioStateChangeEvent::Type type;
+    int volume;
+    Events::UI::TabState tab;
+    char deviceName[SessionTable::NAME_SIZE];
+  };
+
+  struct Subscriber {
+    Callback callback;
+    Delivery delivery = Delivery::IMMEDIATE;
+    QueuedEvent queue[QUEUE_DEPTH];
+    uint8_t count = 0;
+    QueuedEvent delivering[QUEUE_DEPTH]; // Drained copy, owner task only
+  };
+
+  Subscriber subscribers[MAX_SUBSCRIBERS];
+  int subscriberCount = 0;
+  mutable portMUX_TYPE lock = portMUX_INITIALIZER_UNLOCKED;
+  Stats stats;
+
+  void enqueue(Subscriber &subscriber, const QueuedEvent &event);
+  static bool sameDevice(const QueuedEvent &a, const QueuedEvent &b);
+};
+
+} // namespace Audio
+} // namespace Application
@@ -1,11 +1,15 @@
 #include "AudioManager.h"
 #include "../../hardware/DeviceManager.h"
-#include "../../logo/SimpleLogoManager.h"
+#include "../../logo/LogoPrefetcher.h"
+#include "../../messaging/CorrelationEngine.h"
 #include "../../messaging/Message.h"
+#include "../../messaging/SimplifiedSerialEngine.h"
 #include "ManagerMacros.h"
+#include "VolumeStreamer.h"
 #include "ui/ui.h"
 #include <algorithm>
 #include <esp_log.h>
+#include <esp_timer.h>
 
 static const char *TAG = "AudioManager";
 
@@ -22,9 +26,22 @@ bool AudioManager::init() {
 
   ESP_LOGI(TAG, "Initializing AudioManager");
 
-  // Clear state
+  if (!stateMutex) {
+    stateMutex = xSemaphoreCreateRecursiveMutex();
+    if (!stateMutex) {
+      ESP_LOGE(TAG, "Failed to create state mutex");
+      return false;
+    }
+  }
+  StateWriteLock writer(*this);
+
+  // Clear state, then start from the last known one until the host answers
   state.clear();
-  callbacks.clear();
+  events.clear();
+#if MESSAGING_STATE_CACHE_ENABLED
+  AudioStateCache::getInstance().restore(state);
+#endif
+  publishSnapshot();
 
   // Subscribe to audio status updates using BRUTAL messaging
   Messaging::subscribe(
@@ -38,6 +55,13 @@ bool AudioManager::init() {
         ESP_LOGI(TAG, "Origin: %s, Sessions: %d, Reason: %s",
                  msg.deviceId.c_str(), audio.sessionCount, audio.reason);
 
+        // Resolve our pending status request. Pushed updates that do not
+        // echo a request id still satisfy it.
+        auto &correlation = Messaging::CorrelationEngine::getInstance();
+        if (!correlation.complete(audio.originatingRequestId, msg)) {
+          correlation.completeByKey(statusRequestKey(), msg);
+        }
+
         // Create AudioStatus from message data
         AudioStatus status;
         status.timestamp = msg.timestamp;
@@ -46,40 +70,18 @@ bool AudioManager::init() {
         for (int i = 0; i < audio.sessionCount && i < 16; i++) {
           const auto &session = audio.sessions[i];
 
-          AudioLevel level;
-          level.processName = session.processName;
-          level.friendlyName = strlen(session.displayName) > 0
-                                   ? session.displayName
-                                   : session.processName;
-          level.volume = static_cast<int>(session.volume *
-                                          100); // Convert from 0-1 to 0-100
-          level.isMuted = session.isMuted;
-          level.state = session.state;
-          level.lastUpdate = msg.timestamp;
+          const char *friendlyName = strlen(session.displayName) > 0
+                                         ? session.displayName
+                                         : session.processName;
+          int volume = static_cast<int>(session.volume *
+                                        100); // Convert from 0-1 to 0-100
 
-          status.addOrUpdateDevice(level);
+          status.sessions.put(session.processName, friendlyName, volume,
+                              session.isMuted, session.state, msg.timestamp);
 
           ESP_LOGD(TAG, "Added session: %s (ID: %d), volume: %d, muted: %s",
-                   level.processName.c_str(), session.processId, level.volume,
-                   level.isMuted ? "yes" : "no");
-
-          // Auto-request logo for this process if we don't have it
-          if (!level.processName.isEmpty() && 
-              !SimpleLogoManager::getInstance().hasLogo(level.processName)) {
-            ESP_LOGD(TAG, "Auto-requesting logo for session: %s", level.processName.c_str());
-            SimpleLogoManager::getInstance().requestLogo(
-                level.processName,
-                [processName = level.processName](bool success, uint8_t* data, size_t size, const String& error) {
-                  if (success) {
-                    ESP_LOGI("AudioManager", "Auto-received logo for session: %s (%zu bytes)", 
-                             processName.c_str(), size);
-                    if (data) free(data);
-                  } else {
-                    ESP_LOGD("AudioManager", "Auto-request failed for session: %s - %s", 
-                             processName.c_str(), error.c_str());
-                  }
-                });
-          }
+                   session.processName, session.processId, volume,
+                   session.isMuted ? "yes" : "no");
         }
 
         // Set default device info
@@ -100,6 +102,12 @@ bool AudioManager::init() {
                    status.defaultDevice.isMuted ? "yes" : "no");
         }
 
+        // Keep volumes the user just set until the host has applied them.
+        // Reconcile and merge under one lock, so an intent recorded in
+        // between cannot be overwritten by the older reported value.
+        StateWriteLock writer(*this);
+        reconcileVolumeIntents(status, audio.originatingRequestId);
+
         // Process the audio status
         this->onAudioStatusReceived(status);
       });
@@ -115,21 +123,26 @@ void AudioManager::deinit() {
   }
 
   ESP_LOGI(TAG, "Deinitializing AudioManager");
+  StateWriteLock writer(*this);
+
+#if MESSAGING_STATE_CACHE_ENABLED
+  if (!state.fromCache) {
+    AudioStateCache::getInstance().save(state);
+  }
+#endif
 
   // Clear state and callbacks
   state.clear();
-  callbacks.clear();
+  events.clear();
+  publishSnapshot();
 
   initialized = false;
 }
 
 // === STATE ACCESS ===
 
-AudioLevel *AudioManager::getDevice(const String &processName) {
-  return state.findDevice(processName);
-}
-
-const AudioLevel *AudioManager::getDevice(const String &processName) const {
+DeviceHandle AudioManager::getDevice(const String &processName) const {
+  StateWriteLock writer(*this);
   return state.findDevice(processName);
 }
 
@@ -137,87 +150,128 @@ const AudioLevel *AudioManager::getDevice(const String &processName) const {
 
 void AudioManager::onAudioStatusReceived(const AudioStatus &newStatus) {
   REQUIRE_INIT_VOID("AudioManager", initialized, TAG);
+  StateWriteLock writer(*this);
+
+  ESP_LOGD(TAG, "Received audio status with %d devices",
+           newStatus.getDeviceCount());
+
+  // The first status after a warm start confirms or replaces the cached state
+  bool confirmsCache = state.fromCache;
+  state.fromCache = false;
 
-  ESP_LOGI(
-      TAG,
-      "Received audio status with %d devices - triggering reactive updates",
-      newStatus.getDeviceCount());
-
-  // Store current device selections by name (before hash map gets replaced)
-  String currentPrimaryDeviceName =
-      state.primaryAudioDevice ? state.primaryAudioDevice->processName : "";
-  String currentSingleDeviceName =
-      state.selectedSingleDevice ? state.selectedSingleDevice->processName : "";
-  String currentDevice1Name =
-      state.selectedDevice1 ? state.selectedDevice1->processName : "";
-  String currentDevice2Name =
-      state.selectedDevice2 ? state.selectedDevice2->processName : "";
-
-  // Check if this is significantly new data (device count changed)
-  bool significantUpdate =
-      (newStatus.getDeviceCount() != state.currentStatus.getDeviceCount());
-
-  // Update our internal status (this replaces the hash map, invalidating
-  // pointers)
-  state.currentStatus = newStatus;
+  // Merge in place: only entries that differ are written, and sessions that
+  // are still reported keep their slot, so selection handles stay valid
+  SessionChanges changes;
+  state.currentStatus.sessions.syncFrom(newStatus.sessions, &changes);
+  changes.defaultChanges = mergeDefaultDevice(newStatus);
   state.currentStatus.timestamp = Hardware::Device::getMillis();
 
-  // Refresh device pointers to point to new hash map entries
-  refreshDevicePointers(currentPrimaryDeviceName, currentSingleDeviceName,
-                        currentDevice1Name, currentDevice2Name);
+  if (changes.empty()) {
+    ESP_LOGD(TAG, "Audio status unchanged");
+    if (confirmsCache) {
+      // Same as cached, only the stale marks went away
+      notifyStateChange(AudioStateChangeEvent::devicesUpdated());
+    }
+    return;
+  }
+
+  ESP_LOGI(TAG, "Audio status merged: %u added, %u removed, %u changed%s",
+           (unsigned)changes.addedCount(), (unsigned)changes.removedCount,
+           (unsigned)changes.changedCount(),
+           changes.defaultChanges ? ", default device changed" : "");
+
+  bool membershipChanged = changes.membershipChanged();
+  if (changes.removedCount > 0) {
+    state.validateDeviceSelections();
+  }
+
+  // Update timestamp
+  updateTimestamp();
+
+  // Publish once for the whole merge, then notify listeners, one event per
+  // changed entry
+  publishSnapshot();
+  forEachChangeEvent(state.currentStatus, changes,
+                     [this](const AudioStateChangeEvent &event) {
+                       dispatchStateChange(event);
+                     });
 
   // Perform smart auto-selection but only if we don't have valid selections
-  if (!state.hasValidSelection() || significantUpdate) {
+  if (!state.hasValidSelection() || membershipChanged) {
     performSmartAutoSelection();
   }
 
-  // If this was a significant update (new devices appeared/disappeared),
-  // be extra careful about ensuring good selections
-  if (significantUpdate) {
-    ESP_LOGI(TAG,
-             "Significant device update detected - ensuring valid selections");
-
+  // If new devices appeared/disappeared, be extra careful about ensuring
+  // good selections
+  if (membershipChanged) {
     // Ensure we have valid selections for current tab context
     ensureValidSelections();
+    publishSnapshot();
 
     // If we're in a tab that needs selections but still don't have them,
     // this might indicate all devices disappeared - handle gracefully
-    if ((state.isInSingleTab() && !state.selectedSingleDevice) ||
-        (state.isInBalanceTab() &&
-         (!state.selectedDevice1 || !state.selectedDevice2))) {
+    if ((state.isInSingleTab() && !state.isValid(state.selectedSingleDevice)) ||
+        (state.isInBalanceTab() && (!state.isValid(state.selectedDevice1) ||
+                                    !state.isValid(state.selectedDevice2)))) {
       ESP_LOGW(TAG, "No suitable devices available for current tab: %s",
                getTabName(state.currentTab));
     }
-  }
 
-  // Update timestamp
-  updateTimestamp();
+    // Fetch missing logos for the new set of sessions
+    scheduleLogoPrefetch();
+  }
+}
 
-  // Automatically request logos for new processes
-  requestLogosForNewProcesses();
+uint8_t AudioManager::mergeDefaultDevice(const AudioStatus &newStatus) {
+  AudioStatus &current = state.currentStatus;
+  AudioDevice &device = current.defaultDevice;
+  const AudioDevice &incoming = newStatus.defaultDevice;
+  uint8_t changed = 0;
 
-  // Notify listeners
-  notifyStateChange(AudioStateChangeEvent::devicesUpdated());
-
-  ESP_LOGI(TAG, "Reactive audio status processing complete");
+  if (current.hasDefaultDevice != newStatus.hasDefaultDevice) {
+    current.hasDefaultDevice = newStatus.hasDefaultDevice;
+    changed |= SessionChanges::ADDED;
+  }
+  if (device.friendlyName != incoming.friendlyName ||
+      device.state != incoming.state) {
+    device.friendlyName = incoming.friendlyName;
+    device.state = incoming.state;
+    changed |= SessionChanges::INFO;
+  }
+  if (device.volume != incoming.volume) {
+    device.volume = incoming.volume;
+    changed |= SessionChanges::VOLUME;
+  }
+  if (device.isMuted != incoming.isMuted) {
+    device.isMuted = incoming.isMuted;
+    changed |= SessionChanges::MUTE;
+  }
+  device.lastUpdate = incoming.lastUpdate;
+  device.stale = incoming.stale;
+  return changed;
 }
 
 // === USER ACTIONS ===
 
 void AudioManager::selectDevice(const String &deviceName) {
-  AudioLevel *device = state.findDevice(deviceName);
-  if (device) {
+  StateWriteLock writer(*this);
+  DeviceHandle device = state.findDevice(deviceName);
+  if (state.isValid(device)) {
     selectDevice(device);
   } else {
     ESP_LOGW(TAG, "Device not found: %s", deviceName.c_str());
   }
 }
 
-void AudioManager::selectDevice(AudioLevel *device) {
+void AudioManager::selectDevice(DeviceHandle device) {
   REQUIRE_INIT_VOID("AudioManager", initialized, TAG);
-  VALIDATE_PARAM_VOID(device, TAG, "device");
+  StateWriteLock writer(*this);
+  if (!state.isValid(device)) {
+    ESP_LOGW(TAG, "Invalid parameter: device handle is stale");
+    return;
+  }
 
-  AudioLevel *oldSelection = state.getCurrentSelectedDevice();
+  DeviceHandle oldSelection = state.getCurrentSelectedDevice();
 
   // Update selection based on current tab
   switch (state.currentTab) {
@@ -239,16 +293,19 @@ void AudioManager::selectDevice(AudioLevel *device) {
     return;
   }
 
-  ESP_LOGI(TAG, "Selected device: %s in tab: %d", device->processName.c_str(),
+  ESP_LOGI(TAG, "Selected device: %s in tab: %d",
+           state.currentStatus.sessions.processName(device),
            (int)state.currentTab);
 
   // Notify listeners if selection actually changed
   NOTIFY_STATE_CHANGE_IF_DIFFERENT(oldSelection, device, selectionChanged);
+  scheduleLogoPrefetch();
 }
 
 void AudioManager::selectBalanceDevices(const String &device1Name,
                                         const String &device2Name) {
   REQUIRE_INIT_VOID("AudioManager", initialized, TAG);
+  StateWriteLock writer(*this);
 
   if (!state.isInBalanceTab()) {
     ESP_LOGW(TAG, "Can only select balance devices in balance tab");
@@ -256,14 +313,16 @@ void AudioManager::selectBalanceDevices(const String &device1Name,
   }
 
   UPDATE_BALANCE_SELECTION(device1Name, device2Name);
-  NOTIFY_STATE_CHANGE_IF_DIFFERENT(nullptr, state.selectedDevice1,
+  NOTIFY_STATE_CHANGE_IF_DIFFERENT(DeviceHandle(), state.selectedDevice1,
                                    selectionChanged);
+  scheduleLogoPrefetch();
 }
 
 // === NEW BALANCE VOLUME METHODS ===
 
 void AudioManager::setBalanceVolume(int volume, float balance_ratio) {
   REQUIRE_INIT_VOID("AudioManager", initialized, TAG);
+  StateWriteLock writer(*this);
   VALIDATE_BALANCE_DEVICES_VOID(state.selectedDevice1, state.selectedDevice2);
 
   BALANCE_VOLUME_DISTRIBUTE(volume, state.selectedDevice1,
@@ -278,16 +337,18 @@ void AudioManager::setBalanceVolume(int volume, float balance_ratio) {
 void AudioManager::setBalanceDeviceVolumes(int device1Volume,
                                            int device2Volume) {
   REQUIRE_INIT_VOID("AudioManager", initialized, TAG);
+  StateWriteLock writer(*this);
   VALIDATE_BALANCE_DEVICES_VOID(state.selectedDevice1, state.selectedDevice2);
 
-  state.selectedDevice1->volume = constrain(device1Volume, 0, 100);
-  state.selectedDevice2->volume = constrain(device2Volume, 0, 100);
+  SessionTable &sessions = state.currentStatus.sessions;
+  sessions.setVolume(state.selectedDevice1, device1Volume);
+  sessions.setVolume(state.selectedDevice2, device2Volume);
 
   ESP_LOGI(TAG, "Set balance device volumes: %s=%d, %s=%d",
-           state.selectedDevice1->processName.c_str(),
-           state.selectedDevice1->volume,
-           state.selectedDevice2->processName.c_str(),
-           state.selectedDevice2->volume);
+           sessions.processName(state.selectedDevice1),
+           sessions.volume(state.selectedDevice1),
+           sessions.processName(state.selectedDevice2),
+           sessions.volume(state.selectedDevice2));
 
   updateTimestamp();
   notifyStateChange(
@@ -297,14 +358,16 @@ void AudioManager::setBalanceDeviceVolumes(int device1Volume,
 
 void AudioManager::muteBalanceDevices() {
   REQUIRE_INIT_VOID("AudioManager", initialized, TAG);
+  StateWriteLock writer(*this);
   VALIDATE_BALANCE_DEVICES_VOID(state.selectedDevice1, state.selectedDevice2);
 
-  state.selectedDevice1->isMuted = true;
-  state.selectedDevice2->isMuted = true;
+  SessionTable &sessions = state.currentStatus.sessions;
+  sessions.setMuted(state.selectedDevice1, true);
+  sessions.setMuted(state.selectedDevice2, true);
 
   ESP_LOGI(TAG, "Muted balance devices: %s, %s",
-           state.selectedDevice1->processName.c_str(),
-           state.selectedDevice2->processName.c_str());
+           sessions.processName(state.selectedDevice1),
+           sessions.processName(state.selectedDevice2));
 
   updateTimestamp();
   notifyStateChange(AudioStateChangeEvent::muteChanged("balance"));
@@ -313,14 +376,16 @@ void AudioManager::muteBalanceDevices() {
 
 void AudioManager::unmuteBalanceDevices() {
   REQUIRE_INIT_VOID("AudioManager", initialized, TAG);
+  StateWriteLock writer(*this);
   VALIDATE_BALANCE_DEVICES_VOID(state.selectedDevice1, state.selectedDevice2);
 
-  state.selectedDevice1->isMuted = false;
-  state.selectedDevice2->isMuted = false;
+  SessionTable &sessions = state.currentStatus.sessions;
+  sessions.setMuted(state.selectedDevice1, false);
+  sessions.setMuted(state.selectedDevice2, false);
 
   ESP_LOGI(TAG, "Unmuted balance devices: %s, %s",
-           state.selectedDevice1->processName.c_str(),
-           state.selectedDevice2->processName.c_str());
+           sessions.processName(state.selectedDevice1),
+           sessions.processName(state.selectedDevice2));
 
   updateTimestamp();
   notifyStateChange(AudioStateChangeEvent::muteChanged("balance"));
@@ -329,6 +394,7 @@ void AudioManager::unmuteBalanceDevices() {
 
 void AudioManager::setVolumeForCurrentDevice(int volume) {
   REQUIRE_INIT_VOID("AudioManager", initialized, TAG);
+  StateWriteLock writer(*this);
 
   if (state.isInMasterTab()) {
     // Master tab controls the default device directly
@@ -339,13 +405,13 @@ void AudioManager::setVolumeForCurrentDevice(int volume) {
       ESP_LOGW(TAG, "No default device available for master volume control");
     }
   } else if (state.isInSingleTab()) {
-    AudioLevel *currentDevice = state.getCurrentSelectedDevice();
+    DeviceHandle currentDevice = state.getCurrentSelectedDevice();
     VALIDATE_DEVICE_SELECTION_VOID(currentDevice, "Single");
 
+    String deviceName = state.getDeviceName(currentDevice);
     ESP_LOGI(TAG, "%s tab: Setting session device '%s' volume to %d",
-             getTabName(state.currentTab), currentDevice->processName.c_str(),
-             volume);
-    setDeviceVolume(currentDevice->processName, volume);
+             getTabName(state.currentTab), deviceName.c_str(), volume);
+    setDeviceVolume(deviceName, volume);
   } else if (state.isInBalanceTab()) {
     // FIXED: Proper balance volume control
     setBalanceVolume(volume, 0.0f); // Even balance by default
@@ -354,6 +420,7 @@ void AudioManager::setVolumeForCurrentDevice(int volume) {
 
 void AudioManager::setVolumeLocalOnly(int volume) {
   REQUIRE_INIT_VOID("AudioManager", initialized, TAG);
+  StateWriteLock writer(*this);
 
   // Clamp volume
   volume = constrain(volume, 0, 100);
@@ -371,27 +438,25 @@ void AudioManager::setVolumeLocalOnly(int volume) {
       return;
     }
   } else if (state.isInSingleTab()) {
-    AudioLevel *currentDevice = state.getCurrentSelectedDevice();
-    if (currentDevice) {
-      currentDevice->volume = volume;
-      currentDevice->lastUpdate = Hardware::Device::getMillis();
-      currentDevice->stale = false;
+    SessionTable &sessions = state.currentStatus.sessions;
+    DeviceHandle currentDevice = state.getCurrentSelectedDevice();
+    if (state.isValid(currentDevice)) {
+      sessions.setVolume(currentDevice, volume);
+      sessions.setLastUpdate(currentDevice, Hardware::Device::getMillis());
+      sessions.setStale(currentDevice, false);
       ESP_LOGI(TAG, "Updated session device %s volume locally to %d",
-               currentDevice->processName.c_str(), volume);
+               sessions.processName(currentDevice), volume);
     } else {
       ESP_LOGW(TAG, "No device selected for local volume control");
       return;
     }
   } else if (state.isInBalanceTab()) {
     // Update both balance devices locally
-    if (state.selectedDevice1) {
-      state.selectedDevice1->volume = volume;
-      state.selectedDevice1->lastUpdate = Hardware::Device::getMillis();
-    }
-    if (state.selectedDevice2) {
-      state.selectedDevice2->volume = volume;
-      state.selectedDevice2->lastUpdate = Hardware::Device::getMillis();
-    }
+    SessionTable &sessions = state.currentStatus.sessions;
+    sessions.setVolume(state.selectedDevice1, volume);
+    sessions.setLastUpdate(state.selectedDevice1, Hardware::Device::getMillis());
+    sessions.setVolume(state.selectedDevice2, volume);
+    sessions.setLastUpdate(state.selectedDevice2, Hardware::Device::getMillis());
     ESP_LOGI(TAG, "Updated balance devices volume locally to %d", volume);
   }
 
@@ -402,8 +467,81 @@ void AudioManager::setVolumeLocalOnly(int volume) {
   ESP_LOGI(TAG, "Local volume update complete - no Core 1 messaging triggered");
 }
 
+void AudioManager::sendVolumeIntent(const String &processName, int volume) {
+  REQUIRE_INIT_VOID("AudioManager", initialized, TAG);
+
+  volume = constrain(volume, 0, 100);
+  Messaging::Message msg =
+      Messaging::Message::createVolumeChange(processName, volume, "");
+
+  // Show the intended value right away; the host confirms it later. Runs
+  // from the slider's timer on the LVGL task, so it takes the writer lock
+  // like any other change to the state; the event goes out after it.
+  {
+    StateWriteLock writer(*this);
+    volumeIntents.record(processName.c_str(), msg.requestId.c_str(), volume,
+                         Hardware::Device::getMillis());
+    if (processName.isEmpty()) {
+      if (state.currentStatus.hasDefaultDevice) {
+        state.currentStatus.defaultDevice.volume = volume;
+      }
+    } else {
+      state.currentStatus.sessions.setVolume(getDevice(processName), volume);
+    }
+    notifyStateChange(
+        AudioStateChangeEvent::volumeChanged(processName, volume));
+  }
+
+  msg.send();
+}
+
+// Slider drags stream through here; intermediate values wait while the TX
+// queue is backed up
+VolumeStreamer &VolumeStreamer::getInstance() {
+  static VolumeStreamer instance(
+      MESSAGING_VOLUME_STREAM_HZ,
+      [](const String &processName, int volume) {
+        AudioManager::getInstance().sendVolumeIntent(processName, volume);
+      },
+      []() {
+        return Messaging::SerialEngine::getInstance().getTxQueueDepth() >=
+               MESSAGING_VOLUME_STREAM_TX_BACKLOG;
+      });
+  return instance;
+}
+
+void AudioManager::reconcileVolumeIntents(AudioStatus &status,
+                                          const char *originatingRequestId) {
+  uint32_t now = Hardware::Device::getMillis();
+  if (volumeIntents.acknowledge(originatingRequestId, now) |
+      muteIntents.acknowledge(originatingRequestId, now)) {
+    ESP_LOGD(TAG, "Host confirmed request %s", originatingRequestId);
+  }
+
+  SessionTable &sessions = status.sessions;
+  for (SessionTable::Entry session : sessions) {
+    sessions.setVolume(session.handle(),
+                       volumeIntents.reconcile(session.processName(),
+                                               session.volume(), now));
+    sessions.setMuted(session.handle(),
+                      muteIntents.reconcile(session.processName(),
+                                            session.isMuted() ? 1 : 0,
+                                            now) != 0);
+  }
+  if (status.hasDefaultDevice) {
+    status.defaultDevice.volume =
+        volumeIntents.reconcile("", status.defaultDevice.volume, now);
+    status.defaultDevice.isMuted =
+        muteIntents.reconcile("", status.defaultDevice.isMuted ? 1 : 0, now) !=
+        0;
+  }
+  volumeIntents.sweep(now);
+  muteIntents.sweep(now);
+}
+
 void AudioManager::setDeviceVolume(const String &deviceName, int volume) {
   REQUIRE_INIT_VOID("AudioManager", initialized, TAG);
+  StateWriteLock writer(*this);
 
   // Clamp volume
   volume = constrain(volume, 0, 100);
@@ -412,24 +550,23 @@ void AudioManager::setDeviceVolume(const String &deviceName, int volume) {
       deviceName,
       // Non-empty deviceName = update specific session device
       {
-        AudioLevel *device = getDevice(deviceName);
-        if (device) {
-          device->volume = volume;
-          device->lastUpdate = Hardware::Device::getMillis();
-          device->stale = false;
+        SessionTable &sessions = state.currentStatus.sessions;
+        DeviceHandle device = getDevice(deviceName);
+        if (state.isValid(device)) {
+          sessions.setVolume(device, volume);
+          sessions.setLastUpdate(device, Hardware::Device::getMillis());
+          sessions.setStale(device, false);
           ESP_LOGI(TAG, "Updated session device volume: %s = %d",
                    deviceName.c_str(), volume);
         } else {
           // Create new device entry
-          AudioLevel newDevice;
-          newDevice.processName = deviceName;
-          newDevice.friendlyName = deviceName;
-          newDevice.volume = volume;
-          newDevice.lastUpdate = Hardware::Device::getMillis();
-          newDevice.stale = false;
-          newDevice.isMuted = false;
-
-          state.currentStatus.addOrUpdateDevice(newDevice);
+          device = sessions.put(deviceName.c_str(), deviceName.c_str(), volume,
+                                false, "", Hardware::Device::getMillis());
+          if (device.isNull()) {
+            ESP_LOGW(TAG, "Session table full - cannot add device: %s",
+                     deviceName.c_str());
+            return;
+          }
           ESP_LOGI(TAG, "Added new session device: %s = %d", deviceName.c_str(),
                    volume);
         }
@@ -454,9 +591,12 @@ void AudioManager::setDeviceVolume(const String &deviceName, int volume) {
 }
 
 void AudioManager::muteCurrentDevice() {
-  AudioLevel *currentDevice = state.getCurrentSelectedDevice();
-  if (currentDevice) {
-    muteDevice(currentDevice->processName);
+  StateWriteLock writer(*this);
+  DeviceHandle currentDevice = state.getCurrentSelectedDevice();
+  if (state.isValid(currentDevice)) {
+    muteDevice(state.getDeviceName(currentDevice));
+  } else if (state.isInMasterTab() && state.currentStatus.hasDefaultDevice) {
+    muteDevice(""); // Empty string targets the default device
   } else if (state.isInBalanceTab()) {
     muteBalanceDevices();
   } else {
@@ -465,9 +605,12 @@ void AudioManager::muteCurrentDevice() {
 }
 
 void AudioManager::unmuteCurrentDevice() {
-  AudioLevel *currentDevice = state.getCurrentSelectedDevice();
-  if (currentDevice) {
-    unmuteDevice(currentDevice->processName);
+  StateWriteLock writer(*this);
+  DeviceHandle currentDevice = state.getCurrentSelectedDevice();
+  if (state.isValid(currentDevice)) {
+    unmuteDevice(state.getDeviceName(currentDevice));
+  } else if (state.isInMasterTab() && state.currentStatus.hasDefaultDevice) {
+    unmuteDevice(""); // Empty string targets the default device
   } else if (state.isInBalanceTab()) {
     unmuteBalanceDevices();
   } else {
@@ -477,14 +620,15 @@ void AudioManager::unmuteCurrentDevice() {
 
 void AudioManager::muteDevice(const String &deviceName) {
   REQUIRE_INIT_VOID("AudioManager", initialized, TAG);
+  StateWriteLock writer(*this);
 
   EXECUTE_DEVICE_OPERATION(
       deviceName,
       // Non-empty deviceName = mute specific session device
       {
-        AudioLevel *device = getDevice(deviceName);
-        if (device) {
-          device->isMuted = true;
+        DeviceHandle device = getDevice(deviceName);
+        if (state.isValid(device)) {
+          state.currentStatus.sessions.setMuted(device, true);
           ESP_LOGI(TAG, "Muted session device: %s", deviceName.c_str());
         } else {
           ESP_LOGW(TAG, "Session device not found for mute: %s",
@@ -511,14 +655,15 @@ void AudioManager::muteDevice(const String &deviceName) {
 
 void AudioManager::unmuteDevice(const String &deviceName) {
   REQUIRE_INIT_VOID("AudioManager", initialized, TAG);
+  StateWriteLock writer(*this);
 
   EXECUTE_DEVICE_OPERATION(
       deviceName,
       // Non-empty deviceName = unmute specific session device
       {
-        AudioLevel *device = getDevice(deviceName);
-        if (device) {
-          device->isMuted = false;
+        DeviceHandle device = getDevice(deviceName);
+        if (state.isValid(device)) {
+          state.currentStatus.sessions.setMuted(device, false);
           ESP_LOGI(TAG, "Unmuted session device: %s", deviceName.c_str());
         } else {
           ESP_LOGW(TAG, "Session device not found for unmute: %s",
@@ -545,6 +690,7 @@ void AudioManager::unmuteDevice(const String &deviceName) {
 
 void AudioManager::setCurrentTab(Events::UI::TabState tab) {
   REQUIRE_INIT_VOID("AudioManager", initialized, TAG);
+  StateWriteLock writer(*this);
 
   Events::UI::TabState oldTab = state.currentTab;
   state.currentTab = tab;
@@ -554,15 +700,122 @@ void AudioManager::setCurrentTab(Events::UI::TabState tab) {
   if (oldTab != tab) {
     updateTimestamp();
     notifyStateChange(AudioStateChangeEvent::tabChanged(tab));
+    scheduleLogoPrefetch();
+  }
+}
+
+// === SCENES ===
+
+bool AudioManager::applyScene(const Scene &scene) {
+  REQUIRE_INIT("AudioManager", initialized, TAG, false);
+
+  int64_t startUs = esp_timer_get_time();
+  SceneResult result;
+  std::vector<String> commands;
+  {
+    StateWriteLock writer(*this);
+
+    // One transaction: a single snapshot and UI refresh, and the host gets
+    // the usual SET_VOLUME / MUTE_TOGGLE per changed value, together in one
+    // batch frame. Like a slider, each value is an intent until the host
+    // echoes its command, so a status already in flight cannot revert it.
+    uint32_t now = Hardware::Device::getMillis();
+    result = applySceneToStatus(
+        scene, state.currentStatus,
+        [&](const SceneTarget &target, uint8_t changes) {
+          if (changes & SessionChanges::VOLUME) {
+            int volume = target.volume > 100 ? 100 : target.volume;
+            Messaging::Message msg = Messaging::Message::createVolumeChange(
+                target.processName, volume, "");
+            volumeIntents.record(target.processName, msg.requestId.c_str(),
+                                 volume, now);
+            commands.push_back(msg.toJson());
+          }
+          if (changes & SessionChanges::MUTE) {
+            Messaging::Message msg =
+                Messaging::Message::createMuteToggle(target.processName, "");
+            muteIntents.record(target.processName, msg.requestId.c_str(),
+                               target.isMuted ? 1 : 0, now);
+            commands.push_back(msg.toJson());
+          }
+        });
+    if (result.applied == 0) {
+      ESP_LOGI(TAG, "Scene '%s': nothing to change (%u targets not running)",
+               scene.name, (unsigned)result.missing);
+      return false;
+    }
+
+    updateTimestamp();
+    notifyStateChange(AudioStateChangeEvent::devicesUpdated());
   }
+
+  Messaging::sendMessageGroup(commands);
+
+  ESP_LOGI(TAG,
+           "Applied scene '%s': %u changed, %u commands, %u not running, "
+           "%ld us",
+           scene.name, (unsigned)result.applied, (unsigned)commands.size(),
+           (unsigned)result.missing, (long)(esp_timer_get_time() - startUs));
+  return true;
+}
+
+bool AudioManager::applyScene(const String &name) {
+  Scene *scene = new Scene();
+  bool applied = SceneStore::getInstance().load(name.c_str(), *scene) &&
+                 applyScene(*scene);
+  delete scene;
+  return applied;
+}
+
+bool AudioManager::saveScene(const String &name) {
+  REQUIRE_INIT("AudioManager", initialized, TAG, false);
+
+  Scene *scene = new Scene();
+  {
+    StateWriteLock writer(*this);
+    captureScene(state.currentStatus, name.c_str(), *scene);
+  }
+  bool saved = SceneStore::getInstance().save(*scene);
+  delete scene;
+  return saved;
 }
 
 // === EVENT SUBSCRIPTION ===
 
-void AudioManager::subscribeToStateChanges(StateChangeCallback callback) {
-  if (callback) {
-    callbacks.push_back(callback);
+AudioEventBus::SubscriberId
+AudioManager::subscribeToStateChanges(StateChangeCallback callback,
+                                      AudioEventBus::Delivery delivery) {
+  return events.subscribe(callback, delivery);
+}
+
+// === STATE ACCESS ===
+
+void AudioManager::retryStalePublish() {
+  REQUIRE_INIT_VOID("AudioManager", initialized, TAG);
+  if (!snapshotStale.load()) {
+    return;
+  }
+
+  StateWriteLock writer(*this);
+  if (!snapshotStale.load()) {
+    return; // A writer published in the meantime
   }
+  // Listeners may have read the older snapshot when the change was raised
+  notifyStateChange(AudioStateChangeEvent::devicesUpdated());
+  if (!snapshotStale.load()) {
+    ESP_LOGI(TAG, "Published stale snapshot, version %lu",
+             (unsigned long)state.version);
+  }
+}
+
+// === WARM START ===
+
+void AudioManager::persistStateIfDue() {
+#if MESSAGING_STATE_CACHE_ENABLED
+  REQUIRE_INIT_VOID("AudioManager", initialized, TAG);
+  AudioStateCache::getInstance().service(*getSnapshot(),
+                                         Hardware::Device::getMillis());
+#endif
 }
 
 // === EXTERNAL COMMUNICATION ===
@@ -570,46 +823,65 @@ void AudioManager::subscribeToStateChanges(StateChangeCallback callback) {
 void AudioManager::publishStatusUpdate() {
   // Create audio status message using NEW format
   Messaging::Message::AudioData audio;
+  {
+    StateWriteLock writer(*this);
+    fillStatusData(state.currentStatus, audio);
+  }
+
+  // Create and send the message
+  auto msg = Messaging::Message::createAudioStatus(audio, "");
+  Messaging::sendMessage(msg);
+
+  ESP_LOGI(TAG,
+           "Published audio status update - %d sessions, default device: %s",
+           audio.sessionCount, audio.hasDefaultDevice ? "yes" : "no");
+}
+
+void AudioManager::fillStatusData(const AudioStatus &status,
+                                  Messaging::Message::AudioData &audio) {
+  memset(&audio, 0, sizeof(audio));
 
   // Initialize structure
   audio.sessionCount = 0;
   audio.hasDefaultDevice = false;
-  audio.activeSessionCount = state.currentStatus.getDeviceCount();
+  audio.activeSessionCount = status.getDeviceCount();
 
   // Populate sessions array from our current devices
+  const SessionTable &sessions = status.sessions;
   int sessionIndex = 0;
-  for (const auto &devicePair : state.currentStatus.audioDevices) {
+  for (size_t i = 0; i < sessions.size(); i++) {
     if (sessionIndex >= 16)
       break; // Max sessions limit
 
-    const auto &device = devicePair.second;
+    DeviceHandle device = sessions.handleAt(i);
     auto &session = audio.sessions[sessionIndex];
 
     session.processId = 0; // We don't track process IDs locally
-    strncpy(session.processName, device.processName.c_str(),
+    strncpy(session.processName, sessions.processName(device),
             sizeof(session.processName) - 1);
-    strncpy(session.displayName, device.friendlyName.c_str(),
+    strncpy(session.displayName, sessions.friendlyName(device),
             sizeof(session.displayName) - 1);
-    session.volume = device.volume / 100.0f; // Convert from 0-100 to 0-1
-    session.isMuted = device.isMuted;
-    strncpy(session.state, device.state.c_str(), sizeof(session.state) - 1);
+    session.volume =
+        sessions.volume(device) / 100.0f; // Convert from 0-100 to 0-1
+    session.isMuted = sessions.isMuted(device);
+    strncpy(session.state, sessions.state(device), sizeof(session.state) - 1);
 
     sessionIndex++;
   }
   audio.sessionCount = sessionIndex;
 
   // Set default device info
-  if (state.currentStatus.hasDefaultDevice) {
+  if (status.hasDefaultDevice) {
     audio.hasDefaultDevice = true;
     strncpy(audio.defaultDevice.friendlyName,
-            state.currentStatus.defaultDevice.friendlyName.c_str(),
+            status.defaultDevice.friendlyName.c_str(),
             sizeof(audio.defaultDevice.friendlyName) - 1);
-    audio.defaultDevice.volume = state.currentStatus.defaultDevice.volume /
-                                 100.0f; // Convert from 0-100 to 0-1
-    audio.defaultDevice.isMuted = state.currentStatus.defaultDevice.isMuted;
+    audio.defaultDevice.volume =
+        status.defaultDevice.volume / 100.0f; // Convert from 0-100 to 0-1
+    audio.defaultDevice.isMuted = status.defaultDevice.isMuted;
 
     // Parse state back to dataFlow/deviceRole if possible
-    String deviceState = state.currentStatus.defaultDevice.state;
+    String deviceState = status.defaultDevice.state;
     int slashPos = deviceState.indexOf('/');
     if (slashPos >= 0) {
       String dataFlow = deviceState.substring(0, slashPos);
@@ -630,22 +902,31 @@ void AudioManager::publishStatusUpdate() {
   strncpy(audio.reason, "UpdateResponse", sizeof(audio.reason) - 1);
   audio.originatingRequestId[0] = '\0'; // Empty
   audio.originatingDeviceId[0] = '\0';  // Empty
+}
 
-  // Create and send the message
-  auto msg = Messaging::Message::createAudioStatus(audio, "");
-  Messaging::sendMessage(msg);
-
-  ESP_LOGI(TAG,
-           "Published audio status update - %d sessions, default device: %s",
-           audio.sessionCount, audio.hasDefaultDevice ? "yes" : "no");
+uint32_t AudioManager::statusRequestKey() {
+  static const uint32_t key = Messaging::CorrelationEngine::makeKey(
+      Messaging::Message::TYPE_GET_STATUS);
+  return key;
 }
 
 void AudioManager::publishStatusRequest(bool delayed) {
-  // Create and send status request - BRUTAL!
+  // Repeated requests while one is outstanding collapse into it
   auto msg = Messaging::Message::createStatusRequest("");
-  Messaging::sendMessage(msg);
+  uint32_t id = Messaging::CorrelationEngine::getInstance().issue(
+      msg, statusRequestKey(), MESSAGING_STATUS_REQUEST_TIMEOUT_MS,
+      [](Messaging::CorrelationEngine::Outcome outcome,
+         const Messaging::Message *) {
+        if (outcome == Messaging::CorrelationEngine::Outcome::TIMED_OUT) {
+          ESP_LOGW(TAG, "Status request timed out - no response from host");
+        } else if (outcome ==
+                   Messaging::CorrelationEngine::Outcome::REJECTED) {
+          ESP_LOGW(TAG, "Status request not sent - correlation pool full");
+        }
+      });
 
-  ESP_LOGI(TAG, "Published %sstatus request", delayed ? "delayed " : "");
+  ESP_LOGI(TAG, "Published %sstatus request (correlation %lu)",
+           delayed ? "delayed " : "", (unsigned long)id);
 }
 
 // === UTILITY ===
@@ -667,6 +948,7 @@ const char *AudioManager::getTabName(Events::UI::TabState tab) const {
 
 void AudioManager::performSmartAutoSelection() {
   REQUIRE_INIT_VOID("AudioManager", initialized, TAG);
+  StateWriteLock writer(*this);
 
   ESP_LOGI(TAG, "Performing smart auto-selection for tab: %s",
            getTabName(state.currentTab));
@@ -676,7 +958,7 @@ void AudioManager::performSmartAutoSelection() {
 
   // For Single tab: if we have devices but no selection, pick the best one
   if (state.currentTab == Events::UI::TabState::SINGLE &&
-      !state.selectedSingleDevice && state.hasDevices()) {
+      !state.isValid(state.selectedSingleDevice) && state.hasDevices()) {
     String deviceToSelect = findBestDeviceToSelect();
     if (!deviceToSelect.isEmpty()) {
       ESP_LOGI(TAG, "Smart auto-selection: choosing %s for Single tab",
@@ -689,11 +971,11 @@ void AudioManager::performSmartAutoSelection() {
   if (state.currentTab == Events::UI::TabState::BALANCE && state.hasDevices()) {
     bool needsNotification = false;
 
-    if (!state.selectedDevice1) {
+    if (!state.isValid(state.selectedDevice1)) {
       String deviceToSelect = findBestDeviceToSelect();
       if (!deviceToSelect.isEmpty()) {
         state.selectedDevice1 = state.findDevice(deviceToSelect);
-        if (state.selectedDevice1) {
+        if (state.isValid(state.selectedDevice1)) {
           ESP_LOGI(TAG, "Smart auto-selection: choosing %s for Balance device1",
                    deviceToSelect.c_str());
           needsNotification = true;
@@ -701,15 +983,15 @@ void AudioManager::performSmartAutoSelection() {
       }
     }
 
-    if (!state.selectedDevice2) {
+    if (!state.isValid(state.selectedDevice2)) {
       String deviceToSelect = findBestDeviceToSelect();
       // Try to select a different device if possible
       if (!deviceToSelect.isEmpty()) {
-        if (state.selectedDevice1 &&
-            deviceToSelect != state.selectedDevice1->processName) {
+        if (state.isValid(state.selectedDevice1) &&
+            deviceToSelect != state.getDeviceName(state.selectedDevice1)) {
           // Found a different device
           state.selectedDevice2 = state.findDevice(deviceToSelect);
-          if (state.selectedDevice2) {
+          if (state.isValid(state.selectedDevice2)) {
             ESP_LOGI(TAG,
                      "Smart auto-selection: choosing %s for Balance device2",
                      deviceToSelect.c_str());
@@ -718,7 +1000,7 @@ void AudioManager::performSmartAutoSelection() {
         } else {
           // Use the same device for both (better than no selection)
           state.selectedDevice2 = state.selectedDevice1;
-          if (state.selectedDevice2) {
+          if (state.isValid(state.selectedDevice2)) {
             ESP_LOGI(TAG,
                      "Smart auto-selection: using same device %s for both "
                      "Balance devices",
@@ -730,8 +1012,7 @@ void AudioManager::performSmartAutoSelection() {
     }
 
     if (needsNotification) {
-      String device1Name =
-          state.selectedDevice1 ? state.selectedDevice1->processName : "";
+      String device1Name = state.getDeviceName(state.selectedDevice1);
       notifyStateChange(AudioStateChangeEvent::selectionChanged(device1Name));
     }
   }
@@ -742,9 +1023,53 @@ void AudioManager::performSmartAutoSelection() {
 
 // === PRIVATE METHODS ===
 
+// The writer lock keeps the version bump and the copy in line with the
+// mutation that preceded them
+void AudioManager::publishSnapshot() {
+  state.version++;
+  bool published =
+      snapshots.publish([this](AudioAppState &next) { next = state; });
+  snapshotStale.store(!published);
+  if (!published) {
+    ESP_LOGW(TAG, "Snapshot slots all pinned, version %lu not published yet",
+             (unsigned long)state.version);
+  }
+}
+
+// Listeners may read getSnapshot(), so the change is published first
 void AudioManager::notifyStateChange(const AudioStateChangeEvent &event) {
-  for (auto &callback : callbacks) {
-    callback(event);
+  publishSnapshot();
+  dispatchStateChange(event);
+}
+
+void AudioManager::dispatchStateChange(const AudioStateChangeEvent &event) {
+  if (writerDepth > 0) {
+    deferredEvents.push_back(event);
+    return;
+  }
+  events.raise(event);
+}
+
+AudioManager::StateWriteLock::StateWriteLock(AudioManager &manager)
+    : manager(manager) {
+  if (manager.stateMutex) {
+    xSemaphoreTakeRecursive(manager.stateMutex, portMAX_DELAY);
+    manager.writerDepth++;
+  }
+}
+
+AudioManager::StateWriteLock::~StateWriteLock() {
+  if (!manager.stateMutex) {
+    return;
+  }
+  std::vector<AudioStateChangeEvent> raised;
+  if (--manager.writerDepth == 0) {
+    raised.swap(manager.deferredEvents);
+  }
+  xSemaphoreGiveRecursive(manager.stateMutex);
+
+  for (const AudioStateChangeEvent &event : raised) {
+    manager.events.raise(event);
   }
 }
 
@@ -753,11 +1078,11 @@ void AudioManager::autoSelectDeviceIfNeeded() {
 
   // Check if we need to auto-select for Single tab
   if (state.currentTab == Events::UI::TabState::SINGLE &&
-      !state.selectedSingleDevice) {
+      !state.isValid(state.selectedSingleDevice)) {
     String deviceToSelect = findBestDeviceToSelect();
     if (!deviceToSelect.isEmpty()) {
       state.selectedSingleDevice = state.findDevice(deviceToSelect);
-      if (state.selectedSingleDevice) {
+      if (state.isValid(state.selectedSingleDevice)) {
         ESP_LOGI(TAG, "Auto-selected single device: %s",
                  deviceToSelect.c_str());
         notifyStateChange(
@@ -770,11 +1095,11 @@ void AudioManager::autoSelectDeviceIfNeeded() {
   if (state.currentTab == Events::UI::TabState::BALANCE) {
     bool needsSelection = false;
 
-    if (!state.selectedDevice1) {
+    if (!state.isValid(state.selectedDevice1)) {
       String deviceToSelect = findBestDeviceToSelect();
       if (!deviceToSelect.isEmpty()) {
         state.selectedDevice1 = state.findDevice(deviceToSelect);
-        if (state.selectedDevice1) {
+        if (state.isValid(state.selectedDevice1)) {
           ESP_LOGI(TAG, "Auto-selected balance device1: %s",
                    deviceToSelect.c_str());
           needsSelection = true;
@@ -782,13 +1107,13 @@ void AudioManager::autoSelectDeviceIfNeeded() {
       }
     }
 
-    if (!state.selectedDevice2) {
+    if (!state.isValid(state.selectedDevice2)) {
       String deviceToSelect = findBestDeviceToSelect();
       // Try to select a different device than device1
-      if (!deviceToSelect.isEmpty() && state.selectedDevice1 &&
-          deviceToSelect != state.selectedDevice1->processName) {
+      if (!deviceToSelect.isEmpty() && state.isValid(state.selectedDevice1) &&
+          deviceToSelect != state.getDeviceName(state.selectedDevice1)) {
         state.selectedDevice2 = state.findDevice(deviceToSelect);
-        if (state.selectedDevice2) {
+        if (state.isValid(state.selectedDevice2)) {
           ESP_LOGI(TAG, "Auto-selected balance device2: %s",
                    deviceToSelect.c_str());
           needsSelection = true;
@@ -796,7 +1121,7 @@ void AudioManager::autoSelectDeviceIfNeeded() {
       } else if (!deviceToSelect.isEmpty()) {
         // If only one device available, use it for both
         state.selectedDevice2 = state.findDevice(deviceToSelect);
-        if (state.selectedDevice2) {
+        if (state.isValid(state.selectedDevice2)) {
           ESP_LOGI(TAG, "Auto-selected balance device2 (same as device1): %s",
                    deviceToSelect.c_str());
           needsSelection = true;
@@ -805,40 +1130,35 @@ void AudioManager::autoSelectDeviceIfNeeded() {
     }
 
     if (needsSelection) {
-      String device1Name =
-          state.selectedDevice1 ? state.selectedDevice1->processName : "";
+      String device1Name = state.getDeviceName(state.selectedDevice1);
       notifyStateChange(AudioStateChangeEvent::selectionChanged(device1Name));
     }
   }
 }
 
 void AudioManager::markDevicesAsStale() {
-  for (auto &pair : state.currentStatus) {
-    if (!pair.second.stale) {
+  SessionTable &sessions = state.currentStatus.sessions;
+  for (size_t i = 0; i < sessions.size(); i++) {
+    DeviceHandle device = sessions.handleAt(i);
+    if (!sessions.isStale(device)) {
       ESP_LOGI(TAG, "Marking device as stale: %s",
-               pair.second.processName.c_str());
+               sessions.processName(device));
     }
-    pair.second.stale = true;
+    sessions.setStale(device, true);
   }
 }
 
 void AudioManager::updateDeviceFromStatus(const AudioLevel &deviceData) {
-  AudioLevel *existing = getDevice(deviceData.processName);
-  if (existing) {
-    existing->volume = deviceData.volume;
-    existing->isMuted = deviceData.isMuted;
-    existing->friendlyName = deviceData.friendlyName;
-    existing->state = deviceData.state;
-    existing->lastUpdate = Hardware::Device::getMillis();
-    existing->stale = false;
-  } else {
-    // Add new device
-    AudioLevel newDevice = deviceData;
-    newDevice.lastUpdate = Hardware::Device::getMillis();
-    newDevice.stale = false;
-    state.currentStatus.addOrUpdateDevice(newDevice);
+  bool isNew = !state.currentStatus.hasDevice(deviceData.processName);
+
+  // Updates in place, an existing session keeps its slot
+  AudioLevel device = deviceData;
+  device.lastUpdate = Hardware::Device::getMillis();
+  device.stale = false;
+  state.currentStatus.addOrUpdateDevice(device);
 
-    // Refresh pointers if the new device should be selected
+  if (isNew) {
+    // Refresh selections if the new device should be selected
     refreshDevicePointersIfNeeded(deviceData.processName);
   }
 }
@@ -851,13 +1171,14 @@ void AudioManager::refreshDevicePointersIfNeeded(const String &deviceName) {
 
   // This is mainly for cases where we're expecting a device but it wasn't in
   // the hash map yet
-  if (!state.selectedSingleDevice &&
+  if (!state.isValid(state.selectedSingleDevice) &&
       state.currentTab == Events::UI::TabState::SINGLE) {
     // Could auto-select this new device
     autoSelectDeviceIfNeeded();
   }
 
-  if ((!state.selectedDevice1 || !state.selectedDevice2) &&
+  if ((!state.isValid(state.selectedDevice1) ||
+       !state.isValid(state.selectedDevice2)) &&
       state.currentTab == Events::UI::TabState::BALANCE) {
     // Could auto-select this new device for balance
     autoSelectDeviceIfNeeded();
@@ -870,14 +1191,16 @@ String AudioManager::findBestDeviceToSelect() const {
   }
 
   // Look for a non-stale device first
-  for (const auto &pair : state.currentStatus) {
-    if (!pair.second.stale) {
-      return pair.second.processName;
+  const SessionTable &sessions = state.currentStatus.sessions;
+  for (size_t i = 0; i < sessions.size(); i++) {
+    DeviceHandle device = sessions.handleAt(i);
+    if (!sessions.isStale(device)) {
+      return sessions.processName(device);
     }
   }
 
   // If all devices are stale, just pick the first one
-  return state.currentStatus.begin()->second.processName;
+  return sessions.processName(sessions.handleAt(0));
 }
 
 void AudioManager::updateTimestamp() { state.lastUpdateTime = millis(); }
@@ -887,21 +1210,21 @@ void AudioManager::ensureValidSelections() {
   state.validateDeviceSelections();
 
   // If selections are now null, auto-select new devices
-  if (!state.selectedSingleDevice) {
+  if (!state.isValid(state.selectedSingleDevice)) {
     String deviceName = findBestDeviceToSelect();
     if (!deviceName.isEmpty()) {
       state.selectedSingleDevice = state.findDevice(deviceName);
     }
   }
 
-  if (!state.selectedDevice1) {
+  if (!state.isValid(state.selectedDevice1)) {
     String deviceName = findBestDeviceToSelect();
     if (!deviceName.isEmpty()) {
       state.selectedDevice1 = state.findDevice(deviceName);
     }
   }
 
-  if (!state.selectedDevice2) {
+  if (!state.isValid(state.selectedDevice2)) {
     String deviceName = findBestDeviceToSelect();
     if (!deviceName.isEmpty()) {
       state.selectedDevice2 = state.findDevice(deviceName);
@@ -909,149 +1232,21 @@ void AudioManager::ensureValidSelections() {
   }
 }
 
-void AudioManager::refreshDevicePointers(const String &primaryDeviceName,
-                                         const String &singleDeviceName,
-                                         const String &device1Name,
-                                         const String &device2Name) {
-  ESP_LOGI(TAG, "Refreshing device pointers after hash map update");
-
-  // Refresh primary device pointer
-  if (!primaryDeviceName.isEmpty()) {
-    state.primaryAudioDevice = state.findDevice(primaryDeviceName);
-    LOG_DEBUG_IF(state.primaryAudioDevice, TAG,
-                 "Refreshed primary device pointer: %s",
-                 primaryDeviceName.c_str());
-    LOG_WARN_IF(
-        !state.primaryAudioDevice, TAG,
-        "Failed to refresh primary device pointer: %s (device not found)",
-        primaryDeviceName.c_str());
-  } else {
-    state.primaryAudioDevice = nullptr;
-  }
-
-  // Refresh single device pointer
-  if (!singleDeviceName.isEmpty()) {
-    state.selectedSingleDevice = state.findDevice(singleDeviceName);
-    LOG_DEBUG_IF(state.selectedSingleDevice, TAG,
-                 "Refreshed single device pointer: %s",
-                 singleDeviceName.c_str());
-    LOG_WARN_IF(
-        !state.selectedSingleDevice, TAG,
-        "Failed to refresh single device pointer: %s (device not found)",
-        singleDeviceName.c_str());
-  } else {
-    state.selectedSingleDevice = nullptr;
-  }
-
-  // Refresh device1 pointer (balance tab)
-  if (!device1Name.isEmpty()) {
-    state.selectedDevice1 = state.findDevice(device1Name);
-    LOG_DEBUG_IF(state.selectedDevice1, TAG, "Refreshed device1 pointer: %s",
-                 device1Name.c_str());
-    LOG_WARN_IF(!state.selectedDevice1, TAG,
-                "Failed to refresh device1 pointer: %s (device not found)",
-                device1Name.c_str());
-  } else {
-    state.selectedDevice1 = nullptr;
-  }
-
-  // Refresh device2 pointer (balance tab)
-  if (!device2Name.isEmpty()) {
-    state.selectedDevice2 = state.findDevice(device2Name);
-    LOG_DEBUG_IF(state.selectedDevice2, TAG, "Refreshed device2 pointer: %s",
-                 device2Name.c_str());
-    LOG_WARN_IF(!state.selectedDevice2, TAG,
-                "Failed to refresh device2 pointer: %s (device not found)",
-                device2Name.c_str());
-  } else {
-    state.selectedDevice2 = nullptr;
-  }
-}
-
-void AudioManager::requestLogosForNewProcesses() {
-  REQUIRE_INIT_VOID("AudioManager", initialized, TAG);
-
-  unsigned long currentTime = millis();
-  
-  // Check all current audio devices for missing logos
-  for (const auto &devicePair : state.currentStatus.audioDevices) {
-    const AudioLevel &device = devicePair.second;
-    const String &processName = device.processName;
-    
-    // Skip empty process names
-    if (processName.isEmpty()) {
-      continue;
-    }
-    
-    // Check debouncing - don't spam requests for the same process
-    auto it = lastLogoCheckTime.find(processName);
-    if (it != lastLogoCheckTime.end() && 
-        (currentTime - it->second) < LOGO_CHECK_DEBOUNCE_MS) {
-      continue; // Too soon since last check
-    }
-    
-    // Check if logo already exists
-    if (SimpleLogoManager::getInstance().hasLogo(processName)) {
-      continue; // Already have logo
-    }
-    
-    // Request logo for this process
-    ESP_LOGI(TAG, "Auto-requesting logo for new process: %s", processName.c_str());
-    
-    bool requested = SimpleLogoManager::getInstance().requestLogo(
-        processName,
-        [processName](bool success, uint8_t* data, size_t size, const String& error) {
-          if (success) {
-            ESP_LOGI("AudioManager", "Auto-received logo for process: %s (%zu bytes)", 
-                     processName.c_str(), size);
-            // Logo data is automatically saved by the brutal system
-            // Free the data pointer since we don't need it here
-            if (data) free(data);
-          } else {
-            ESP_LOGW("AudioManager", "Auto-request failed for process: %s - %s", 
-                     processName.c_str(), error.c_str());
-          }
-        });
-    
-    // Update debouncing timestamp regardless of success
-    lastLogoCheckTime[processName] = currentTime;
-    
-    LOG_DEBUG_IF(requested, TAG, "Auto logo request submitted for: %s", processName.c_str());
-    LOG_WARN_IF(!requested, TAG, "Auto logo request failed for: %s", processName.c_str());
-  }
-}
-
-void AudioManager::checkSingleProcessLogo(const char *processName) {
-  VALIDATE_PARAM_VOID(processName, TAG, "processName");
-
-  if (strlen(processName) == 0) {
-    return;
-  }
-
-  // Check if logo already exists locally
-  if (SimpleLogoManager::getInstance().hasLogo(processName)) {
-    ESP_LOGD(TAG, "Logo already exists for process: %s", processName);
-    return;
+void AudioManager::scheduleLogoPrefetch() {
+  // This tab's selection, the other selections, then dropdown order;
+  // duplicates keep their first position
+  const SessionTable &sessions = state.currentStatus.sessions;
+  const char *names[4 + SessionTable::CAPACITY];
+  size_t count = 0;
+  names[count++] = sessions.processName(state.getCurrentSelectedDevice());
+  names[count++] = sessions.processName(state.selectedSingleDevice);
+  names[count++] = sessions.processName(state.selectedDevice1);
+  names[count++] = sessions.processName(state.selectedDevice2);
+  for (SessionTable::Entry session : sessions) {
+    names[count++] = session.processName();
   }
-
-  ESP_LOGI(TAG, "Requesting logo for process: %s", processName);
-
-  // Request logo using BRUTAL system
-  bool requested = SimpleLogoManager::getInstance().requestLogo(
-      processName,
-      [processName](bool success, uint8_t* data, size_t size, const String& error) {
-        if (success) {
-          ESP_LOGI(TAG, "Successfully received logo for process: %s (%zu bytes)", processName, size);
-          // Logo data is automatically saved by the brutal system
-          // Free the data pointer since we don't need it here
-          if (data) free(data);
-        } else {
-          ESP_LOGW(TAG, "Failed to receive logo for process: %s - %s", processName, error.c_str());
-        }
-      });
-
-  LOG_DEBUG_IF(requested, TAG, "Logo request submitted for process: %s", processName);
-  LOG_WARN_IF(!requested, TAG, "Failed to submit logo request for process: %s", processName);
+  LogoPrefetcher::getInstance().prioritise(names, count,
+                                           Hardware::Device::getMillis());
 }
 
 } // namespace Audio
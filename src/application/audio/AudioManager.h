@@ -1,7 +1,16 @@
 #pragma once
 
 #include "AudioData.h"
-
+#include "AudioEventBus.h"
+#include "AudioScenes.h"
+#include "AudioStateCache.h"
+#include "SnapshotPublisher.h"
+#include "VolumeIntents.h"
+#include "../../messaging/Message.h"
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <atomic>
 #include <functional>
 #include <map>
 #include <vector>
@@ -14,6 +23,12 @@ namespace Audio {
  * Main audio system manager
  * Consolidates all audio business logic, state management, and external
  * interfaces Single entry point for all audio operations
+ *
+ * The working state is written from the LVGL task (UI actions, the volume
+ * streamer) and the serial task (AUDIO_STATUS). Every public method that
+ * reads or writes it holds one recursive writer lock across the change, the
+ * version bump and the snapshot publish; readers on other tasks use
+ * getSnapshot() and never take it.
  */
 class AudioManager {
 public:
@@ -30,23 +45,45 @@ public:
   bool isInitialized() const { return initialized; }
 
   // === STATE ACCESS ===
+  using Snapshot = SnapshotPublisher<AudioAppState, 4>::Reader;
+
+  // Consistent read-only view of the last published state, safe from any
+  // task/core without locking. Holds the snapshot until it goes out of
+  // scope, so keep it local to one UI update.
+  Snapshot getSnapshot() const { return snapshots.acquire(); }
+  SnapshotPublisher<AudioAppState, 4>::Stats getSnapshotStats() const {
+    return snapshots.getStats();
+  }
+
+  // Publish again if the last change found every slot pinned by readers;
+  // called from the audio task tick
+  void retryStalePublish();
+
+  // Working state, only valid while holding the writer lock (inside
+  // AudioManager's own methods); everything else uses getSnapshot()
   const AudioAppState &getState() const { return state; }
 
-  // Quick accessors
-  Events::UI::TabState getCurrentTab() const { return state.currentTab; }
+  // Quick accessors (read the published snapshot)
+  Events::UI::TabState getCurrentTab() const {
+    return getSnapshot()->currentTab;
+  }
   String getCurrentDevice() const {
-    return state.getCurrentSelectedDeviceName();
+    return getSnapshot()->getCurrentSelectedDeviceName();
+  }
+  int getCurrentVolume() const {
+    return getSnapshot()->getCurrentSelectedVolume();
   }
-  int getCurrentVolume() const { return state.getCurrentSelectedVolume(); }
-  bool isCurrentDeviceMuted() const { return state.isCurrentDeviceMuted(); }
-  bool hasDevices() const { return state.hasDevices(); }
+  bool isCurrentDeviceMuted() const {
+    return getSnapshot()->isCurrentDeviceMuted();
+  }
+  bool hasDevices() const { return getSnapshot()->hasDevices(); }
 
-  // Device queries
+  // Copies every session into Strings; UI code iterates
+  // getSnapshot()->currentStatus.sessions instead
   std::vector<AudioLevel> getAllDevices() const {
-    return state.currentStatus.getAudioLevels();
+    return getSnapshot()->currentStatus.getAudioLevels();
   }
-  AudioLevel *getDevice(const String &processName);
-  const AudioLevel *getDevice(const String &processName) const;
+  DeviceHandle getDevice(const String &processName) const;
 
   // === EXTERNAL DATA INPUT ===
   void onAudioStatusReceived(const AudioStatus &status);
@@ -55,7 +92,7 @@ public:
 
   // Device selection
   void selectDevice(const String &deviceName);
-  void selectDevice(AudioLevel *device);
+  void selectDevice(DeviceHandle device);
   void selectBalanceDevices(const String &device1, const String &device2);
 
   // Volume control
@@ -65,6 +102,13 @@ public:
   // Volume control without messaging (Core 0 safe)
   void setVolumeLocalOnly(int volume);
 
+  // SET_VOLUME from a slider: shown locally at once, and status updates for
+  // that device are held until the host echoes the request (or it times out)
+  void sendVolumeIntent(const String &processName, int volume);
+  String getVolumeIntentStatus() const {
+    return volumeIntents.getStatus() + muteIntents.getStatus("Mute Intents");
+  }
+
   // Balance-specific volume control (NEW)
   void setBalanceVolume(int volume, float balance_ratio = 0.0f);
   void setBalanceDeviceVolumes(int device1Volume, int device2Volume);
@@ -84,16 +128,42 @@ public:
 
   // === UI STATE CONTROL ===
 
+  // === SCENES ===
+  // Apply every target of a scene as one change: one state update, one UI
+  // refresh and one AUDIO_STATUS to the host. Targets that are not running
+  // are skipped. False if nothing was applied.
+  bool applyScene(const Scene &scene);
+  bool applyScene(const String &name);
+  // Store the current volumes and mutes under 'name' (SceneStore)
+  bool saveScene(const String &name);
+
   // === EVENT SUBSCRIPTION ===
-  void subscribeToStateChanges(StateChangeCallback callback);
+  // QUEUED subscribers receive coalesced events when their own task calls
+  // deliverStateChanges() (see AudioEventBus)
+  AudioEventBus::SubscriberId subscribeToStateChanges(
+      StateChangeCallback callback,
+      AudioEventBus::Delivery delivery = AudioEventBus::Delivery::IMMEDIATE);
+  size_t deliverStateChanges(AudioEventBus::SubscriberId subscriber) {
+    return events.deliver(subscriber);
+  }
+  String getEventBusStatus() const { return events.getStatus(); }
+
+  // === WARM START ===
+  // Save the published state to AudioStateCache once it has settled; called
+  // about once a second from the audio task
+  void persistStateIfDue();
 
   // === EXTERNAL COMMUNICATION ===
   void publishStatusUpdate();
+  static void fillStatusData(const AudioStatus &status,
+                             Messaging::Message::AudioData &audio);
   void publishStatusRequest(bool delayed = false);
 
   // === UTILITY ===
   const char *getTabName(Events::UI::TabState tab) const;
-  bool hasValidSelection() const { return state.hasValidSelection(); }
+  bool hasValidSelection() const {
+    return getSnapshot()->hasValidSelection();
+  }
 
   // === SMART BEHAVIOR ===
   void
@@ -108,31 +178,68 @@ private:
   // Internal state
   AudioAppState state;
   bool initialized = false;
-  std::vector<StateChangeCallback> callbacks;
-
-  // Internal operations
+  AudioEventBus events;
+
+  // Serializes the writers of 'state'; recursive, so public methods may
+  // call each other. Created by the first init().
+  SemaphoreHandle_t stateMutex = nullptr;
+  uint8_t writerDepth = 0; // Nested StateWriteLocks of the owning task
+
+  // Events raised by writers, delivered once the lock is free so IMMEDIATE
+  // subscribers never run under it
+  std::vector<AudioStateChangeEvent> deferredEvents;
+
+  // Takes the writer lock from construction to the end of the enclosing
+  // scope. The outermost one releases it and then raises the events its
+  // writers deferred, in order.
+  class StateWriteLock {
+  public:
+    explicit StateWriteLock(AudioManager &manager);
+    // Const readers only serialize against writers and defer nothing; the
+    // singleton itself is never const
+    explicit StateWriteLock(const AudioManager &manager)
+        : StateWriteLock(const_cast<AudioManager &>(manager)) {}
+    ~StateWriteLock();
+    StateWriteLock(const StateWriteLock &) = delete;
+    StateWriteLock &operator=(const StateWriteLock &) = delete;
+
+  private:
+    AudioManager &manager;
+  };
+
+  // Published copies of 'state' for readers on other tasks: the current
+  // one, one being written and up to two pinned by slow readers
+  SnapshotPublisher<AudioAppState, 4> snapshots;
+  // The working state is newer than the published one (publish was skipped)
+  std::atomic<bool> snapshotStale{false};
+
+  // Internal operations (callers hold the writer lock)
+  void publishSnapshot();
   void notifyStateChange(const AudioStateChangeEvent &event);
+  void dispatchStateChange(const AudioStateChangeEvent &event);
   void autoSelectDeviceIfNeeded();
   void markDevicesAsStale();
   void updateDeviceFromStatus(const AudioLevel &device);
   String findBestDeviceToSelect() const;
   void updateTimestamp();
+  uint8_t mergeDefaultDevice(const AudioStatus &newStatus);
 
   // Device management helpers
   void ensureValidSelections();
-  void refreshDevicePointers(const String &primaryDeviceName,
-                             const String &singleDeviceName,
-                             const String &device1Name,
-                             const String &device2Name);
   void refreshDevicePointersIfNeeded(const String &deviceName);
 
-  // Logo checking helpers (moved from MessageCore)
-  void checkSingleProcessLogo(const char *processName);
-  void requestLogosForNewProcesses();
+  // Hand the sessions to LogoPrefetcher, most visible first
+  void scheduleLogoPrefetch();
+
+  // Correlation key shared by all status requests
+  static uint32_t statusRequestKey();
 
-  // Logo request debouncing
-  std::map<String, unsigned long> lastLogoCheckTime;
-  static const unsigned long LOGO_CHECK_DEBOUNCE_MS = 30000; // 30 seconds
+  // Optimistic volume and mute: pending SET_VOLUME / MUTE_TOGGLE commands
+  // per device, mute held as 0/1
+  VolumeIntentTable volumeIntents;
+  VolumeIntentTable muteIntents;
+  void reconcileVolumeIntents(AudioStatus &status,
+                              const char *originatingRequestId);
 };
 
 } // namespace Audio
@@ -0,0 +1,101 @@
+#include "AudioScenes.h"
+#include "../../hardware/SDManager.h"
+#include <esp_log.h>
+
+static const char *TAG = "AudioScenes";
+
+static const char *SCENE_EXTENSION = ".scn";
+
+namespace Application {
+namespace Audio {
+
+SceneStore &SceneStore::getInstance() {
+  static SceneStore instance;
+  return instance;
+}
+
+bool SceneStore::save(const Scene &scene) {
+  if (!isValidName(scene.name)) {
+    ESP_LOGW(TAG, "Invalid scene name '%s'", scene.name);
+    return false;
+  }
+  if (!Hardware::SD::isMounted() ||
+      !Hardware::SD::ensureDirectory(MESSAGING_SCENE_DIR)) {
+    ESP_LOGW(TAG, "SD card unavailable, scene '%s' not saved", scene.name);
+    return false;
+  }
+
+  size_t size = encode(scene, blob, sizeof(blob));
+  if (size == 0) {
+    ESP_LOGE(TAG, "Scene '%s' does not fit the blob", scene.name);
+    return false;
+  }
+
+  Hardware::SD::SDFileResult result = Hardware::SD::writeBinaryFile(
+      pathFor(scene.name).c_str(), blob, size, false);
+  if (!result.success) {
+    ESP_LOGE(TAG, "Failed to save scene '%s': %s", scene.name,
+             result.errorMessage);
+    return false;
+  }
+
+  ESP_LOGI(TAG, "Saved scene '%s' (%u targets, %u bytes)", scene.name,
+           (unsigned)scene.targetCount, (unsigned)size);
+  return true;
+}
+
+bool SceneStore::load(const char *name, Scene &scene) {
+  if (!isValidName(name) || !Hardware::SD::isMounted()) {
+    return false;
+  }
+
+  Hardware::SD::SDFileResult result = Hardware::SD::readFile(
+      pathFor(name).c_str(), reinterpret_cast<char *>(blob), sizeof(blob));
+  if (!result.success) {
+    ESP_LOGW(TAG, "Scene '%s' not found", name);
+    return false;
+  }
+  if (!decode(blob, result.bytesProcessed, scene)) {
+    ESP_LOGW(TAG, "Scene '%s' ignored (%u bytes, stale layout or corrupt)",
+             name, (unsigned)result.bytesProcessed);
+    return false;
+  }
+  return true;
+}
+
+bool SceneStore::remove(const char *name) {
+  if (!isValidName(name) || !Hardware::SD::isMounted()) {
+    return false;
+  }
+  return Hardware::SD::deleteFile(pathFor(name).c_str()).success;
+}
+
+bool SceneStore::list(std::function<void(const char *name)> callback) {
+  if (!Hardware::SD::isMounted() ||
+      !Hardware::SD::directoryExists(MESSAGING_SCENE_DIR)) {
+    return false;
+  }
+
+  size_t extensionLength = strlen(SCENE_EXTENSION);
+  return Hardware::SD::listDirectory(
+      MESSAGING_SCENE_DIR,
+      [&callback, extensionLength](const char *fileName, bool isDir, size_t) {
+        size_t length = strlen(fileName);
+        if (isDir || length <= extensionLength ||
+            length - extensionLength >= Scene::NAME_SIZE ||
+            strcmp(fileName + length - extensionLength, SCENE_EXTENSION) != 0) {
+          return;
+        }
+        char name[Scene::NAME_SIZE];
+        memcpy(name, fileName, length - extensionLength);
+        name[length - extensionLength] = '\0';
+        callback(name);
+      });
+}
+
+String SceneStore::pathFor(const char *name) {
+  return String(MESSAGING_SCENE_DIR) + "/" + name + SCENE_EXTENSION;
+}
+
+} // namespace Audio
+} // namespace Application
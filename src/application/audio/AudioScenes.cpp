@@ -0,0 +1,120 @@
+#include "AudioScenes.h"
+
+namespace Application {
+namespace Audio {
+
+namespace codec = reflective::codec;
+
+static void copyField(char *destination, size_t size, const char *source) {
+  strncpy(destination, source ? source : "", size - 1);
+  destination[size - 1] = '\0';
+}
+
+// =============================================================================
+// STATE
+// =============================================================================
+
+SceneResult applySceneToStatus(const Scene &scene, AudioStatus &status,
+                               const SceneChangeCallback &onChange) {
+  SceneResult result;
+  SessionTable &sessions = status.sessions;
+  uint8_t count = scene.targetCount < Scene::MAX_TARGETS ? scene.targetCount
+                                                         : Scene::MAX_TARGETS;
+
+  for (uint8_t i = 0; i < count; i++) {
+    const SceneTarget &target = scene.targets[i];
+    int volume = target.volume > 100 ? 100 : target.volume;
+    uint8_t changes = 0;
+
+    if (target.processName[0] == '\0') {
+      if (!status.hasDefaultDevice) {
+        result.missing++;
+        continue;
+      }
+      AudioLevel &device = status.defaultDevice;
+      if (device.volume != volume) {
+        changes |= SessionChanges::VOLUME;
+      }
+      if (device.isMuted != target.isMuted) {
+        changes |= SessionChanges::MUTE;
+      }
+      device.volume = volume;
+      device.isMuted = target.isMuted;
+    } else {
+      DeviceHandle device = sessions.find(target.processName);
+      if (device.isNull()) {
+        result.missing++;
+        continue;
+      }
+      if (sessions.volume(device) != volume) {
+        changes |= SessionChanges::VOLUME;
+      }
+      if (sessions.isMuted(device) != target.isMuted) {
+        changes |= SessionChanges::MUTE;
+      }
+      sessions.setVolume(device, volume);
+      sessions.setMuted(device, target.isMuted);
+    }
+
+    if (changes != 0) {
+      result.applied++;
+      if (onChange) {
+        onChange(target, changes);
+      }
+    }
+  }
+  return result;
+}
+
+void captureScene(const AudioStatus &status, const char *name, Scene &scene) {
+  memset(&scene, 0, sizeof(scene));
+  copyField(scene.name, sizeof(scene.name), name);
+
+  for (SessionTable::Entry session : status.sessions) {
+    SceneTarget &target = scene.targets[scene.targetCount++];
+    copyField(target.processName, sizeof(target.processName),
+              session.processName());
+    target.volume = static_cast<uint8_t>(session.volume());
+    target.isMuted = session.isMuted();
+  }
+
+  if (status.hasDefaultDevice) {
+    SceneTarget &target = scene.targets[scene.targetCount++];
+    target.volume =
+        static_cast<uint8_t>(constrain(status.defaultDevice.volume, 0, 100));
+    target.isMuted = status.defaultDevice.isMuted;
+  }
+}
+
+// =============================================================================
+// BLOB FORMAT
+// =============================================================================
+
+bool SceneStore::isValidName(const char *name) {
+  if (!name || name[0] == '\0' || strlen(name) >= Scene::NAME_SIZE) {
+    return false;
+  }
+  for (const char *c = name; *c; c++) {
+    if (!isalnum(static_cast<unsigned char>(*c)) && *c != '-' && *c != '_') {
+      return false;
+    }
+  }
+  return true;
+}
+
+size_t SceneStore::encode(const Scene &scene, uint8_t *out,
+                          size_t capacity) {
+  return codec::toBlob(scene, MAGIC, out, capacity);
+}
+
+bool SceneStore::decode(const uint8_t *data, size_t size, Scene &scene) {
+  memset(&scene, 0, sizeof(scene));
+  if (!codec::fromBlob(scene, MAGIC, data, size)) {
+    return false;
+  }
+  scene.name[sizeof(scene.name) - 1] = '\0';
+  return scene.targetCount <= Scene::MAX_TARGETS;
+}
+
+} // namespace Audio
+} // namespace Application
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "AudioData.h"
+#include <MessagingConfig.h>
+#include <functional>
+#include <reflect_codec.hpp>
+
+namespace Application {
+namespace Audio {
+
+// Volume and mute for one process; the empty name is the default device
+struct SceneTarget {
+  char processName[SessionTable::NAME_SIZE];
+  uint8_t volume;
+  bool isMuted;
+
+  REFLECT_DECLARE(SceneTarget, REFLECT_FIELD(processName),
+                  REFLECT_FIELD(volume), REFLECT_FIELD(isMuted))
+};
+
+struct Scene {
+  static const size_t NAME_SIZE = 32;
+  static const uint8_t MAX_TARGETS = SessionTable::CAPACITY + 1;
+
+  char name[NAME_SIZE];
+  uint8_t targetCount;
+  SceneTarget targets[MAX_TARGETS];
+
+  REFLECT_DECLARE(Scene, REFLECT_FIELD(name), REFLECT_FIELD(targetCount),
+                  REFLECT_FIELD(targets))
+};
+
+struct SceneResult {
+  uint8_t applied = 0; // Targets whose volume or mute changed
+  uint8_t missing = 0; // Targets not present in the status
+};
+
+// Called per changed target with SessionChanges::VOLUME and/or MUTE
+using SceneChangeCallback =
+    std::function<void(const SceneTarget &target, uint8_t changes)>;
+
+// Set every target present in 'status'; no logging, no events, so a whole
+// scene is one state change for the caller
+SceneResult applySceneToStatus(const Scene &scene, AudioStatus &status,
+                               const SceneChangeCallback &onChange = nullptr);
+
+// Current volume and mute of every session and the default device
+void captureScene(const AudioStatus &status, const char *name, Scene &scene);
+
+/**
+ * Named scenes on SD, one reflect_codec checked blob per file
+ * (MESSAGING_SCENE_DIR/<name>.scn). Names are limited to letters, digits,
+ * '-' and '_' so they are valid file names.
+ *
+ * Only called from the UI and serial command paths; the encode buffer is a
+ * member, not a stack array. The SD side is in AudioSceneStore.cpp, so the
+ * blob format and the scene functions above build without storage.
+ */
+class SceneStore {
+public:
+  static const uint32_t MAGIC = 0x53434E55; // "UNCS"
+
+  // Encoded strings carry a u16 length instead of the terminator
+  static const size_t MAX_BLOB_SIZE = sizeof(reflective::codec::BlobHeader) +
+                                      sizeof(Scene) +
+                                      2 * (Scene::MAX_TARGETS + 1);
+
+  static SceneStore &getInstance();
+
+  static bool isValidName(const char *name);
+
+  bool save(const Scene &scene);
+  bool load(const char *name, Scene &scene);
+  bool remove(const char *name);
+
+  // Scene names in directory order; false if the SD card is unavailable
+  bool list(std::function<void(const char *name)> callback);
+
+  // Blob conversion only, no storage access
+  static size_t encode(const Scene &scene, uint8_t *out, size_t capacity);
+  static bool decode(const uint8_t *data, size_t size, Scene &scene);
+
+private:
+  SceneStore() = default;
+  SceneStore(const SceneStore &) = delete;
+  SceneStore &operator=(const SceneStore &) = delete;
+
+  uint8_t blob[MAX_BLOB_SIZE] = {};
+
+  static String pathFor(const char *name);
+};
+
+} // namespace Audio
+} // namespace Application
@@ -0,0 +1,259 @@
+#include "AudioStateCache.h"
+#include <esp_log.h>
+#include <esp_timer.h>
+#include <nvs.h>
+
+static const char *TAG = "AudioStateCache";
+
+static const char *NVS_NAMESPACE = "audio_cache";
+static const char *NVS_STATE_KEY = "state";
+
+namespace Application {
+namespace Audio {
+
+namespace codec = reflective::codec;
+
+AudioStateCache &AudioStateCache::getInstance() {
+  static AudioStateCache instance;
+  return instance;
+}
+
+static void copyField(char *destination, size_t size, const char *source) {
+  strncpy(destination, source ? source : "", size - 1);
+  destination[size - 1] = '\0';
+}
+
+// =============================================================================
+// STORAGE
+// =============================================================================
+
+bool AudioStateCache::restore(AudioAppState &state) {
+  int64_t startUs = esp_timer_get_time();
+
+  nvs_handle_t handle;
+  esp_err_t err = nvs_open(NVS_NAMESPACE, NVS_READONLY, &handle);
+  if (err != ESP_OK) {
+    ESP_LOGI(TAG, "No cached audio state (%s)", esp_err_to_name(err));
+    return false;
+  }
+  size_t size = sizeof(blob);
+  err = nvs_get_blob(handle, NVS_STATE_KEY, blob, &size);
+  nvs_close(handle);
+  if (err != ESP_OK) {
+    ESP_LOGI(TAG, "No cached audio state (%s)", esp_err_to_name(err));
+    return false;
+  }
+
+  if (!decode(blob, size, state)) {
+    ESP_LOGW(TAG, "Cached audio state ignored (%u bytes, stale layout or "
+                  "corrupt)",
+             (unsigned)size);
+    return false;
+  }
+
+  codec::BlobHeader header;
+  memcpy(&header, blob, sizeof(header));
+  storedChecksum = header.checksum;
+  stats.restored = true;
+  stats.blobSize = size;
+  stats.restoreUs = static_cast<uint32_t>(esp_timer_get_time() - startUs);
+  timing.restoredMs = millisSinceBoot();
+
+  ESP_LOGI(TAG, "Restored %u sessions%s from cache in %lu us (%u bytes)",
+           (unsigned)state.currentStatus.sessions.size(),
+           state.currentStatus.hasDefaultDevice ? " + default device" : "",
+           (unsigned long)stats.restoreUs, (unsigned)size);
+  return true;
+}
+
+void AudioStateCache::service(const AudioAppState &state, uint32_t nowMs) {
+  // Nothing new until the host has confirmed what was restored
+  if (state.fromCache) {
+    return;
+  }
+
+  if (state.version != seenVersion) {
+    seenVersion = state.version;
+    if (!dirty) {
+      dirty = true;
+      dirtySinceMs = nowMs;
+    }
+    lastChangeMs = nowMs;
+  }
+
+  if (!dirty || (nowMs - lastChangeMs < MESSAGING_STATE_CACHE_DEBOUNCE_MS &&
+                 nowMs - dirtySinceMs < MESSAGING_STATE_CACHE_MAX_DELAY_MS)) {
+    return;
+  }
+  dirty = false;
+  save(state);
+}
+
+bool AudioStateCache::save(const AudioAppState &state) {
+  size_t size = encode(state, blob, sizeof(blob));
+  if (size == 0) {
+    ESP_LOGE(TAG, "Audio state does not fit the cache blob");
+    stats.errors++;
+    return false;
+  }
+
+  codec::BlobHeader header;
+  memcpy(&header, blob, sizeof(header));
+  if (header.checksum == storedChecksum) {
+    stats.unchanged++;
+    return true;
+  }
+
+  nvs_handle_t handle;
+  esp_err_t err = nvs_open(NVS_NAMESPACE, NVS_READWRITE, &handle);
+  if (err == ESP_OK) {
+    err = nvs_set_blob(handle, NVS_STATE_KEY, blob, size);
+    if (err == ESP_OK) {
+      err = nvs_commit(handle);
+    }
+    nvs_close(handle);
+  }
+  if (err != ESP_OK) {
+    ESP_LOGE(TAG, "Failed to save audio state: %s", esp_err_to_name(err));
+    stats.errors++;
+    return false;
+  }
+
+  storedChecksum = header.checksum;
+  stats.writes++;
+  stats.blobSize = size;
+  ESP_LOGD(TAG, "Saved audio state (%u bytes)", (unsigned)size);
+  return true;
+}
+
+// =============================================================================
+// ENCODING
+// =============================================================================
+
+size_t AudioStateCache::encode(const AudioAppState &state, uint8_t *out,
+                               size_t capacity) {
+  const AudioStatus &status = state.currentStatus;
+  const SessionTable &sessions = status.sessions;
+  memset(&record, 0, sizeof(record));
+
+  for (SessionTable::Entry session : sessions) {
+    CachedSession &cached = record.sessions[record.sessionCount++];
+    copyField(cached.processName, sizeof(cached.processName),
+              session.processName());
+    copyField(cached.friendlyName, sizeof(cached.friendlyName),
+              session.friendlyName());
+    cached.volume = static_cast<uint8_t>(session.volume());
+    cached.isMuted = session.isMuted();
+  }
+
+  record.hasDefaultDevice = status.hasDefaultDevice;
+  if (status.hasDefaultDevice) {
+    copyField(record.defaultDeviceName, sizeof(record.defaultDeviceName),
+              status.defaultDevice.friendlyName.c_str());
+    record.defaultVolume =
+        static_cast<uint8_t>(constrain(status.defaultDevice.volume, 0, 100));
+    record.defaultMuted = status.defaultDevice.isMuted;
+  }
+
+  record.currentTab = static_cast<uint8_t>(state.currentTab);
+  copyField(record.primaryDevice, sizeof(record.primaryDevice),
+            sessions.processName(state.primaryAudioDevice));
+  copyField(record.singleDevice, sizeof(record.singleDevice),
+            sessions.processName(state.selectedSingleDevice));
+  copyField(record.balanceDevice1, sizeof(record.balanceDevice1),
+            sessions.processName(state.selectedDevice1));
+  copyField(record.balanceDevice2, sizeof(record.balanceDevice2),
+            sessions.processName(state.selectedDevice2));
+
+  return codec::toBlob(record, MAGIC, out, capacity);
+}
+
+bool AudioStateCache::decode(const uint8_t *data, size_t size,
+                             AudioAppState &state) {
+  memset(&record, 0, sizeof(record));
+  if (!codec::fromBlob(record, MAGIC, data, size)) {
+    return false;
+  }
+
+  // Everything restored is shown as stale until the host confirms it
+  state.clear();
+  AudioStatus &status = state.currentStatus;
+  SessionTable &sessions = status.sessions;
+  uint8_t count = record.sessionCount < SessionTable::CAPACITY
+                      ? record.sessionCount
+                      : SessionTable::CAPACITY;
+  for (uint8_t i = 0; i < count; i++) {
+    const CachedSession &cached = record.sessions[i];
+    if (cached.processName[0] == '\0') {
+      continue;
+    }
+    DeviceHandle device = sessions.put(cached.processName, cached.friendlyName,
+                                       cached.volume, cached.isMuted, "", 0);
+    sessions.setStale(device, true);
+  }
+
+  status.hasDefaultDevice = record.hasDefaultDevice;
+  if (record.hasDefaultDevice) {
+    status.defaultDevice.friendlyName = record.defaultDeviceName;
+    status.defaultDevice.volume = record.defaultVolume;
+    status.defaultDevice.isMuted = record.defaultMuted;
+    status.defaultDevice.stale = true;
+  }
+
+  if (record.currentTab <= static_cast<uint8_t>(Events::UI::TabState::BALANCE)) {
+    state.currentTab = static_cast<Events::UI::TabState>(record.currentTab);
+  }
+  state.primaryAudioDevice = sessions.find(record.primaryDevice);
+  state.selectedSingleDevice = sessions.find(record.singleDevice);
+  state.selectedDevice1 = sessions.find(record.balanceDevice1);
+  state.selectedDevice2 = sessions.find(record.balanceDevice2);
+  state.fromCache = true;
+  return true;
+}
+
+// =============================================================================
+// BOOT TIMING
+// =============================================================================
+
+void AudioStateCache::noteFrame(const AudioAppState &state) {
+  if (isBootTimingComplete() ||
+      !(state.hasDevices() || state.currentStatus.hasDefaultDevice)) {
+    return;
+  }
+
+  int32_t now = millisSinceBoot();
+  if (timing.firstUsefulFrameMs < 0) {
+    timing.firstUsefulFrameMs = now;
+    timing.usefulFrameFromCache = state.fromCache;
+  }
+  if (!state.fromCache) {
+    timing.firstLiveFrameMs = now;
+    ESP_LOGI(TAG, "First useful frame %ld ms after boot (%s), live data at "
+                  "%ld ms (= without cache)",
+             (long)timing.firstUsefulFrameMs,
+             timing.usefulFrameFromCache ? "cached state" : "no cache",
+             (long)timing.firstLiveFrameMs);
+  }
+}
+
+int32_t AudioStateCache::millisSinceBoot() {
+  return static_cast<int32_t>(esp_timer_get_time() / 1000);
+}
+
+String AudioStateCache::getStatus() const {
+  String status = "Audio State Cache:\n";
+  status += "- Restored: " +
+            (stats.restored ? String(stats.restoreUs) + " us" : String("no")) +
+            ", blob " + String(stats.blobSize) + " bytes\n";
+  status += "- Writes " + String(stats.writes) + ", unchanged " +
+            String(stats.unchanged) + ", errors " + String(stats.errors) +
+            "\n";
+  status += "- First useful frame: " + String(timing.firstUsefulFrameMs) +
+            " ms" + (timing.usefulFrameFromCache ? " (cached)" : "") +
+            ", first live frame: " + String(timing.firstLiveFrameMs) +
+            " ms\n";
+  return status;
+}
+
+} // namespace Audio
+} // namespace Application
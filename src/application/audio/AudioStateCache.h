@@ -0,0 +1,134 @@
+#pragma once
+
+#include "AudioData.h"
+#include <MessagingConfig.h>
+#include <reflect_codec.hpp>
+
+namespace Application {
+namespace Audio {
+
+// Persisted form of AudioAppState: only what the panel needs to draw before
+// the host has answered. Encoded with the reflect_codec binary layout.
+struct CachedSession {
+  char processName[SessionTable::NAME_SIZE];
+  char friendlyName[SessionTable::NAME_SIZE];
+  uint8_t volume;
+  bool isMuted;
+
+  REFLECT_DECLARE(CachedSession, REFLECT_FIELD(processName),
+                  REFLECT_FIELD(friendlyName), REFLECT_FIELD(volume),
+                  REFLECT_FIELD(isMuted))
+};
+
+struct CachedAudioState {
+  CachedSession sessions[SessionTable::CAPACITY];
+  uint8_t sessionCount;
+  bool hasDefaultDevice;
+  char defaultDeviceName[128];
+  uint8_t defaultVolume;
+  bool defaultMuted;
+  uint8_t currentTab;
+  char primaryDevice[SessionTable::NAME_SIZE];
+  char singleDevice[SessionTable::NAME_SIZE];
+  char balanceDevice1[SessionTable::NAME_SIZE];
+  char balanceDevice2[SessionTable::NAME_SIZE];
+
+  REFLECT_DECLARE(CachedAudioState, REFLECT_FIELD(sessions),
+                  REFLECT_FIELD(sessionCount), REFLECT_FIELD(hasDefaultDevice),
+                  REFLECT_FIELD(defaultDeviceName), REFLECT_FIELD(defaultVolume),
+                  REFLECT_FIELD(defaultMuted), REFLECT_FIELD(currentTab),
+                  REFLECT_FIELD(primaryDevice), REFLECT_FIELD(singleDevice),
+                  REFLECT_FIELD(balanceDevice1), REFLECT_FIELD(balanceDevice2))
+};
+
+/**
+ * Warm-start cache of the last known audio state
+ *
+ * The sessions, default device, selections and tab are kept in one NVS blob
+ * so the panel can draw them on the first frame after a reset instead of
+ * staying empty until the host answers the initial status request.
+ *
+ * The blob is a reflect_codec checked blob of CachedAudioState, so one
+ * written by a build with a different layout (schemaHash) or with a bad
+ * checksum is ignored.
+ *
+ * Restored sessions and the default device are marked stale and the state
+ * is flagged fromCache until the first host status confirms it. Saving is
+ * debounced (MESSAGING_STATE_CACHE_DEBOUNCE_MS of quiet, at most
+ * MESSAGING_STATE_CACHE_MAX_DELAY_MS behind) and skipped when the encoded
+ * state matches what is already stored, so a volume drag costs one flash
+ * write at most.
+ *
+ * It also measures boot time to the first useful frame (any device shown)
+ * and to the first frame with live host data, i.e. with and without the
+ * cache.
+ */
+class AudioStateCache {
+public:
+  static const uint32_t MAGIC = 0x53584D55; // "UMXS"
+
+  // Encoded strings carry a u16 length instead of the terminator
+  static const size_t MAX_BLOB_SIZE =
+      sizeof(reflective::codec::BlobHeader) + sizeof(CachedAudioState) +
+      2 * (SessionTable::CAPACITY * 2 + 5);
+
+  struct Stats {
+    bool restored = false;
+    uint32_t restoreUs = 0;
+    uint32_t writes = 0;
+    uint32_t unchanged = 0; // Saves skipped, stored blob already matched
+    uint32_t errors = 0;
+    uint32_t blobSize = 0;
+  };
+
+  // Milliseconds since boot, -1 until reached
+  struct BootTiming {
+    int32_t restoredMs = -1;
+    int32_t firstUsefulFrameMs = -1;
+    int32_t firstLiveFrameMs = -1;
+    bool usefulFrameFromCache = false;
+  };
+
+  static AudioStateCache &getInstance();
+
+  // Load the stored state into 'state'; false if nothing usable is stored
+  bool restore(AudioAppState &state);
+
+  // Save 'state' once it has settled; call periodically from one task
+  void service(const AudioAppState &state, uint32_t nowMs);
+
+  // Save right away (skipped if the stored blob is identical)
+  bool save(const AudioAppState &state);
+
+  // Boot timing; called by the UI once per frame with the state it shows
+  void noteFrame(const AudioAppState &state);
+  bool isBootTimingComplete() const { return timing.firstLiveFrameMs >= 0; }
+
+  // Blob conversion only, no storage access. encode() returns the blob
+  // size, 0 if it does not fit.
+  size_t encode(const AudioAppState &state, uint8_t *out, size_t capacity);
+  bool decode(const uint8_t *data, size_t size, AudioAppState &state);
+
+  Stats getStats() const { return stats; }
+  BootTiming getBootTiming() const { return timing; }
+  String getStatus() const;
+
+private:
+  CachedAudioState record = {};
+  uint8_t blob[MAX_BLOB_SIZE] = {};
+  uint32_t storedChecksum = 0;
+
+  // Debounce
+  uint32_t seenVersion = 0;
+  bool dirty = false;
+  uint32_t dirtySinceMs = 0;
+  uint32_t lastChangeMs = 0;
+
+  Stats stats;
+  BootTiming timing;
+
+  static int32_t millisSinceBoot();
+};
+
+} // namespace Audio
+} // namespace Application
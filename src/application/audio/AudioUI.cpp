@@ -1,9 +1,11 @@
 #include "AudioUI.h"
-#include "../../logo/SimpleLogoManager.h"
+#include "../../core/FrameScheduler.h"
+#include "VolumeStreamer.h"
 #include "UiEventHandlers.h"
 #include "ui/screens/ui_screenMain.h"
 #include "VolumeWidgetMacros.h"
 #include <esp_log.h>
+#include <esp_timer.h>
 #include <ui/ui.h>
 
 static const char *TAG = "AudioUI";
@@ -24,11 +26,26 @@ bool AudioUI::init() {
 
   ESP_LOGI(TAG, "Initializing AudioUI");
 
-  // Subscribe to state changes from AudioManager
-  AudioManager::getInstance().subscribeToStateChanges(
+  // Subscribe to state changes from AudioManager. Events are queued and
+  // coalesced, then handled here on the LVGL task once per frame.
+  eventSubscription = AudioManager::getInstance().subscribeToStateChanges(
       [this](const AudioStateChangeEvent &event) {
         onAudioStateChanged(event);
-      });
+      },
+      AudioEventBus::Delivery::QUEUED);
+  if (eventSubscription == AudioEventBus::INVALID_SUBSCRIBER) {
+    ESP_LOGE(TAG, "Failed to subscribe to audio state changes");
+    return false;
+  }
+
+  eventTimer = lv_timer_create(deliverStateChanges, LV_DEF_REFR_PERIOD, this);
+  if (!eventTimer) {
+    ESP_LOGE(TAG, "Failed to create audio event timer");
+    return false;
+  }
+  // AudioManager may already hold the warm-start state, restored before we
+  // subscribed; the first pass draws it
+  bindings.invalidate();
 
   initialized = true;
   ESP_LOGI(TAG, "AudioUI initialized successfully");
@@ -41,6 +58,10 @@ void AudioUI::deinit() {
   }
 
   ESP_LOGI(TAG, "Deinitializing AudioUI");
+  if (eventTimer) {
+    lv_timer_delete(eventTimer);
+    eventTimer = nullptr;
+  }
   initialized = false;
 }
 
@@ -62,12 +83,6 @@ void AudioUI::onVolumeSliderChanged(int volume) {
   // Immediately update the UI to show the new volume
   // This provides instant feedback even before server confirmation
   LVGLMessageHandler::updateCurrentTabVolume(volume);
-
-  // Also update the master device label if we're in master tab
-  if (AudioManager::getInstance().getCurrentTab() ==
-      Events::UI::TabState::MASTER) {
-    updateDefaultDeviceLabel();
-  }
 }
 
 void AudioUI::onVolumeSliderDragging(int volume) {
@@ -91,27 +106,21 @@ void AudioUI::onDeviceDropdownChanged(lv_obj_t *dropdown,
   ESP_LOGI(TAG, "Device dropdown changed to: %s", deviceName.c_str());
 
   // Handle different dropdowns based on current tab
-  const auto &state = AudioManager::getInstance().getState();
+  auto snapshot = AudioManager::getInstance().getSnapshot();
+  const AudioAppState &state = *snapshot;
 
   if (state.isInBalanceTab()) {
     // For balance tab, handle dual selection
     if (dropdown == ui_selectAudioDevice1) {
-      String device2Name =
-          state.selectedDevice2 ? state.selectedDevice2->processName : "";
+      String device2Name = state.getDeviceName(state.selectedDevice2);
       AudioManager::getInstance().selectBalanceDevices(deviceName, device2Name);
     } else if (dropdown == ui_selectAudioDevice2) {
-      String device1Name =
-          state.selectedDevice1 ? state.selectedDevice1->processName : "";
+      String device1Name = state.getDeviceName(state.selectedDevice1);
       AudioManager::getInstance().selectBalanceDevices(device1Name, deviceName);
     }
   } else {
-    // For single/master tabs
+    // For single/master tabs; the logo follows through its binding
     AudioManager::getInstance().selectDevice(deviceName);
-
-    // Update logo if we're on the Single tab
-    if (state.isInSingleTab()) {
-      updateSingleTabLogo();
-    }
   }
 }
 
@@ -133,11 +142,8 @@ void AudioUI::onTabChanged(Events::UI::TabState newTab) {
   AudioManager &audioManager = AudioManager::getInstance();
   audioManager.performSmartAutoSelection();
 
-  // Force a comprehensive UI refresh for the new tab context
+  // Render the new tab context right away
   refreshAllUI();
-
-  // Update logo display for debugging
-  updateSingleTabLogo();
 }
 
 void AudioUI::onMuteButtonPressed() {
@@ -188,7 +194,8 @@ lv_obj_t *AudioUI::getCurrentVolumeSlider() const {
     return nullptr;
   }
 
-  const auto &state = AudioManager::getInstance().getState();
+  auto snapshot = AudioManager::getInstance().getSnapshot();
+  const AudioAppState &state = *snapshot;
 
   switch (state.currentTab) {
   case Events::UI::TabState::MASTER:
@@ -211,212 +218,55 @@ void AudioUI::refreshAllUI() {
     return;
   }
 
-  ESP_LOGD(TAG, "Refreshing all UI elements");
-
-  updateDeviceSelectors();
-  updateVolumeDisplay();
-  updateDefaultDeviceLabel();
-  updateMuteButtons();
-  updateTabVisibility();
+  // Only widgets whose bound value changed are touched; the per-frame pass
+  // then finds the state already rendered
+  auto snapshot = AudioManager::getInstance().getSnapshot();
+  bindings.sync(*snapshot, VolumeStreamer::getInstance().isDragging());
 }
 
-void AudioUI::updateVolumeDisplay() {
-  if (!initialized) {
-    return;
-  }
-
-  const auto &state = AudioManager::getInstance().getState();
-  int currentVolume = state.getCurrentSelectedVolume();
-
-  // Update the volume slider directly (uncommented to show current volume)
-  lv_obj_t *slider = getCurrentVolumeSlider();
-  if (slider) {
-    VOLUME_WIDGET_SET_VALUE(slider, currentVolume);
-    ESP_LOGD(TAG, "Set %s tab slider to volume: %d",
-             AudioManager::getInstance().getTabName(state.currentTab),
-             currentVolume);
-  } else {
-    ESP_LOGW(TAG, "No slider found for current tab: %s",
-             AudioManager::getInstance().getTabName(state.currentTab));
-  }
-
-  // Use message handler for thread-safe UI updates (labels, etc.)
-  LVGLMessageHandler::updateCurrentTabVolume(currentVolume);
+String AudioUI::getStatus() const { return bindings.getStatus(); }
 
-  ESP_LOGD(TAG, "Updated %s tab volume display to: %d",
-           AudioManager::getInstance().getTabName(state.currentTab),
-           currentVolume);
-}
-
-void AudioUI::updateDeviceSelectors() {
-  if (!initialized) {
-    return;
-  }
-
-  const auto &devices = AudioManager::getInstance().getAllDevices();
-
-  // Update dropdown options
-  updateDropdownOptions(devices);
+// === PRIVATE METHODS ===
 
-  ESP_LOGD(TAG, "Updated device selectors with %d devices", devices.size());
-}
+void AudioUI::deliverStateChanges(lv_timer_t *timer) {
+  AudioUI *self = static_cast<AudioUI *>(lv_timer_get_user_data(timer));
 
-void AudioUI::updateDefaultDeviceLabel() {
-  if (!initialized) {
+  // Events stay queued (and coalesce) until a frame has budget for them
+  if (!FrameScheduler::hasBudget(FrameScheduler::WORK_AUDIO_UI)) {
+    FrameScheduler::defer(FrameScheduler::WORK_AUDIO_UI);
     return;
   }
+  int64_t startUs = esp_timer_get_time();
+  AudioManager::getInstance().deliverStateChanges(self->eventSubscription);
 
-  const auto &state = AudioManager::getInstance().getState();
+  // The one render pass of this frame, after every event has been handled
+  auto snapshot = AudioManager::getInstance().getSnapshot();
+  self->bindings.sync(*snapshot, VolumeStreamer::getInstance().isDragging());
+  FrameScheduler::charge(FrameScheduler::WORK_AUDIO_UI,
+                         static_cast<uint32_t>(esp_timer_get_time() - startUs));
 
-  if (state.currentStatus.hasDefaultDevice) {
-    LVGLMessageHandler::updateMasterDevice(
-        state.currentStatus.defaultDevice.friendlyName.c_str());
-    ESP_LOGD(TAG, "Updated default device label: %s",
-             state.currentStatus.defaultDevice.friendlyName.c_str());
+  AudioStateCache &cache = AudioStateCache::getInstance();
+  if (!cache.isBootTimingComplete()) {
+    cache.noteFrame(*snapshot);
   }
 }
 
-void AudioUI::updateMuteButtons() {
-  if (!initialized) {
-    return;
-  }
-
-  // This could be expanded to update mute button states
-  // For now, mute state is handled implicitly through volume display
-  ESP_LOGD(TAG, "Updated mute buttons");
-}
-
-// === PRIVATE METHODS ===
-
+// Widgets are rendered from the state by the bindings once per frame; only
+// reactions that change the state itself are left here
 void AudioUI::onAudioStateChanged(const AudioStateChangeEvent &event) {
-  ESP_LOGI(
-      TAG,
-      "Handling audio state change event: %d - triggering reactive UI updates",
-      (int)event.type);
-
-  switch (event.type) {
-  case AudioStateChangeEvent::DEVICES_UPDATED:
-    ESP_LOGD(TAG, "Devices updated - comprehensive UI refresh");
-    updateDeviceSelectors();
-    updateVolumeDisplay();
-    updateDefaultDeviceLabel();
-    // Also trigger smart auto-selection since device list changed
-    AudioManager::getInstance().performSmartAutoSelection();
-    break;
-
-  case AudioStateChangeEvent::SELECTION_CHANGED:
-    ESP_LOGI(TAG, "Device selection changed - updating UI");
-    updateDropdownSelections();
-    updateVolumeDisplay();
-    updateSingleTabLogo(); // Update logo for debugging
-    break;
-
-  case AudioStateChangeEvent::VOLUME_CHANGED:
-    ESP_LOGI(TAG, "Volume changed - updating display with immediate feedback");
-    updateVolumeDisplay();
-    break;
-
-  case AudioStateChangeEvent::TAB_CHANGED:
-    ESP_LOGD(TAG, "Tab changed - full reactive UI refresh");
-    refreshAllUI();
-    // Tab changes are already handled comprehensively in onTabChanged
-    break;
-
-  case AudioStateChangeEvent::MUTE_CHANGED:
-    ESP_LOGI(TAG, "Mute state changed - updating UI and labels");
-    updateMuteButtons();
-    updateDefaultDeviceLabel();
-    updateVolumeDisplay(); // Mute might affect volume display
-    break;
-  }
-
-  ESP_LOGD(TAG, "Reactive state change handling complete");
-}
-
-void AudioUI::updateDropdownOptions(const std::vector<AudioLevel> &devices) {
-  // Build options string for dropdowns (LVGL format:
-  // "Option1\nOption2\nOption3")
-  String optionsString = "";
-  if (devices.empty()) {
-    optionsString = "-"; // Default option when no devices
-  } else {
-    for (size_t i = 0; i < devices.size(); i++) {
-      if (i > 0) {
-        optionsString += "\n";
-      }
-      optionsString += devices[i].processName;
-    }
-  }
-
-  // Update all dropdown widgets with new options
-  if (ui_selectAudioDevice) {
-    lv_dropdown_set_options(ui_selectAudioDevice, optionsString.c_str());
-  }
-  if (ui_selectAudioDevice1) {
-    lv_dropdown_set_options(ui_selectAudioDevice1, optionsString.c_str());
-  }
-  if (ui_selectAudioDevice2) {
-    lv_dropdown_set_options(ui_selectAudioDevice2, optionsString.c_str());
-  }
-
-  // Restore selections after updating options
-  updateDropdownSelections();
-}
-
-void AudioUI::updateDropdownSelections() {
-  const auto &state = AudioManager::getInstance().getState();
-  const auto devices = state.currentStatus.getAudioLevels();
+  ESP_LOGD(TAG, "Audio state change event: %d", (int)event.type);
 
-  // Helper lambda to find device index in options
-  auto findDeviceIndex = [devices](const String &deviceName) -> int {
-    for (size_t i = 0; i < devices.size(); i++) {
-      if (devices[i].processName == deviceName) {
-        return i;
-      }
+  if (event.type == AudioStateChangeEvent::DEVICES_UPDATED) {
+    if (AudioManager::getInstance().getSnapshot()->version ==
+        bindings.syncedVersion()) {
+      ESP_LOGD(TAG, "Devices updated - state already rendered");
+      return;
     }
-    return 0; // Default to first option
-  };
-
-  // Update main dropdown based on current tab
-  if (ui_selectAudioDevice) {
-    if (state.isInMasterTab() && state.primaryAudioDevice) {
-      int index = findDeviceIndex(state.primaryAudioDevice->processName);
-      lv_dropdown_set_selected(ui_selectAudioDevice, index);
-    } else if (state.isInSingleTab() && state.selectedSingleDevice) {
-      int index = findDeviceIndex(state.selectedSingleDevice->processName);
-      lv_dropdown_set_selected(ui_selectAudioDevice, index);
-    }
-  }
-
-  // Update balance dropdowns
-  if (ui_selectAudioDevice1 && state.selectedDevice1) {
-    int index = findDeviceIndex(state.selectedDevice1->processName);
-    lv_dropdown_set_selected(ui_selectAudioDevice1, index);
-  }
-
-  if (ui_selectAudioDevice2 && state.selectedDevice2) {
-    int index = findDeviceIndex(state.selectedDevice2->processName);
-    lv_dropdown_set_selected(ui_selectAudioDevice2, index);
-  }
-}
-
-void AudioUI::updateVolumeSlider() {
-  const auto &state = AudioManager::getInstance().getState();
-  lv_obj_t *slider = getCurrentVolumeSlider();
-
-  if (slider) {
-    int currentVolume = state.getCurrentSelectedVolume();
-    VOLUME_WIDGET_SET_VALUE(slider, currentVolume);
+    // The device list changed, selections may need filling in
+    AudioManager::getInstance().performSmartAutoSelection();
   }
 }
 
-void AudioUI::updateTabVisibility() {
-  // This could be expanded to show/hide different UI elements based on the
-  // current tab For now, the tab-specific UI is handled by the LVGL tab view
-  // itself
-  ESP_LOGD(TAG, "Updated tab visibility");
-}
-
 lv_obj_t *AudioUI::getDropdownForTab(Events::UI::TabState tab) const {
   switch (tab) {
   case Events::UI::TabState::MASTER:
@@ -436,14 +286,13 @@ void AudioUI::setDropdownSelection(lv_obj_t *dropdown,
     return;
   }
 
-  const auto &devices = AudioManager::getInstance().getAllDevices();
+  auto snapshot = AudioManager::getInstance().getSnapshot();
+  const SessionTable &sessions = snapshot->currentStatus.sessions;
 
   // Find device index
-  for (size_t i = 0; i < devices.size(); i++) {
-    if (devices[i].processName == deviceName) {
-      lv_dropdown_set_selected(dropdown, i);
-      break;
-    }
+  int position = sessions.positionOf(sessions.find(deviceName.c_str()));
+  if (position >= 0) {
+    lv_dropdown_set_selected(dropdown, position);
   }
 }
 
@@ -453,88 +302,18 @@ int AudioUI::findDeviceIndexInDropdown(lv_obj_t *dropdown,
     return 0;
   }
 
-  const auto &devices = AudioManager::getInstance().getAllDevices();
+  auto snapshot = AudioManager::getInstance().getSnapshot();
+  const SessionTable &sessions = snapshot->currentStatus.sessions;
 
-  for (size_t i = 0; i < devices.size(); i++) {
-    if (devices[i].processName == deviceName) {
-      return i;
-    }
-  }
-
-  return 0; // Default to first option
+  int position = sessions.positionOf(sessions.find(deviceName.c_str()));
+  return position >= 0 ? position : 0; // Default to first option
 }
 
 String AudioUI::getCurrentTabName() const {
-  const auto &state = AudioManager::getInstance().getState();
+  auto snapshot = AudioManager::getInstance().getSnapshot();
+  const AudioAppState &state = *snapshot;
   return AudioManager::getInstance().getTabName(state.currentTab);
 }
 
-void AudioUI::updateSingleTabLogo() {
-  if (!initialized || !ui_img) {
-    return;
-  }
-
-  const auto &state = AudioManager::getInstance().getState();
-
-  // Only update if we're on the Single tab
-  if (!state.isInSingleTab()) {
-    lv_obj_add_flag(ui_img, LV_OBJ_FLAG_HIDDEN);
-    // Ensure transparency is maintained when hidden
-    lv_obj_set_style_bg_opa(ui_img, LV_OPA_TRANSP,
-                            LV_PART_MAIN | LV_STATE_DEFAULT);
-    return;
-  }
-
-  // Get currently selected device on Single tab
-  if (!state.selectedSingleDevice) {
-    ESP_LOGD(TAG, "No device selected on Single tab - hiding logo");
-    lv_obj_add_flag(ui_img, LV_OBJ_FLAG_HIDDEN);
-    // Ensure transparency is maintained when hidden
-    lv_obj_set_style_bg_opa(ui_img, LV_OPA_TRANSP,
-                            LV_PART_MAIN | LV_STATE_DEFAULT);
-    return;
-  }
-
-  String processName = state.selectedSingleDevice->processName;
-  ESP_LOGI(TAG, "Updating Single tab logo for process: %s",
-           processName.c_str());
-
-  // Get logo path from SimpleLogoManager
-  if (SimpleLogoManager::getInstance().hasLogo(processName)) {
-    String logoPath = SimpleLogoManager::getInstance().getLVGLPath(processName);
-
-    ESP_LOGW(TAG, "Found logo for %s at: %s", processName.c_str(),
-             logoPath.c_str());
-
-    // Set the logo image source
-    lv_img_set_src(ui_img, logoPath.c_str());
-
-    // Configure image display properties
-    lv_obj_set_size(ui_img, LV_SIZE_CONTENT,
-                    LV_SIZE_CONTENT); // Auto size to content
-
-    // Enable auto-scaling if the image is too large
-    lv_image_set_scale(ui_img, 256); // Scale to fit (256 = 100% scale)
-
-    // Remove white background to enable transparency
-    lv_obj_set_style_bg_opa(ui_img, LV_OPA_TRANSP,
-                            LV_PART_MAIN | LV_STATE_DEFAULT);
-
-    // Make sure the image object itself is properly sized and positioned
-    lv_obj_center(ui_img); // Center the image in its parent
-
-    // Show the image
-    lv_obj_remove_flag(ui_img, LV_OBJ_FLAG_HIDDEN);
-
-    ESP_LOGI(TAG, "Logo configured and displayed for %s", processName.c_str());
-  } else {
-    ESP_LOGD(TAG, "No logo found for %s - hiding image", processName.c_str());
-    lv_obj_add_flag(ui_img, LV_OBJ_FLAG_HIDDEN);
-    // Ensure transparency is maintained when hidden
-    lv_obj_set_style_bg_opa(ui_img, LV_OPA_TRANSP,
-                            LV_PART_MAIN | LV_STATE_DEFAULT);
-  }
-}
-
 } // namespace Audio
 } // namespace Application
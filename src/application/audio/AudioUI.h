@@ -2,6 +2,7 @@
 
 #include "../ui/LVGLMessageHandler.h"
 #include "AudioManager.h"
+#include "UIBindings.h"
 #include <lvgl.h>
 
 namespace Application {
@@ -43,13 +44,13 @@ public:
   lv_obj_t *getCurrentVolumeSlider() const;
 
   // === UI UPDATE TRIGGERS ===
-  void refreshAllUI(); // Full UI refresh
-  void updateVolumeDisplay();
-  void updateDeviceSelectors();
-  void updateDefaultDeviceLabel();
-  void updateMuteButtons();
+  // Render pass now instead of at the next frame (changed widgets only)
+  void refreshAllUI();
   void initializeVolumeSliders(); // Initialize sliders to prevent garbage values
 
+  // Setter calls and invalidated areas of the render passes
+  String getStatus() const;
+
 private:
   AudioUI() = default;
   ~AudioUI() = default;
@@ -59,14 +60,17 @@ private:
   // Internal state
   bool initialized = false;
 
-  // State change handler from AudioManager
-  void onAudioStateChanged(const AudioStateChangeEvent &event);
+  // Widgets bound to the state, synced once per frame
+  UIBindings bindings;
 
-  // UI update methods
-  void updateDropdownOptions(const std::vector<AudioLevel> &devices);
-  void updateDropdownSelections();
-  void updateVolumeSlider();
-  void updateTabVisibility();
+  // State change handler from AudioManager, run on the LVGL task by a
+  // per-frame timer that drains the queued subscription and then runs the
+  // binding pass
+  AudioEventBus::SubscriberId eventSubscription =
+      AudioEventBus::INVALID_SUBSCRIBER;
+  lv_timer_t *eventTimer = nullptr;
+  static void deliverStateChanges(lv_timer_t *timer);
+  void onAudioStateChanged(const AudioStateChangeEvent &event);
 
   // UI widget helpers
   lv_obj_t *getDropdownForTab(Events::UI::TabState tab) const;
@@ -74,9 +78,6 @@ private:
   int findDeviceIndexInDropdown(lv_obj_t *dropdown,
                                 const String &deviceName) const;
 
-  // Logo display for debugging
-  void updateSingleTabLogo();
-
   // Utility methods
   String getCurrentTabName() const;
 };
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <Hash.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace Application {
+namespace Audio {
+
+/**
+ * Option list of the device dropdowns, kept in step by diffing
+ *
+ * Holds the name hashes of the options currently shown. update() takes the
+ * new names in display order and reports the inserts and removals that turn
+ * the shown list into the new one, each with the position it applies at
+ * when applied in the order reported. Unchanged sessions cost a hash
+ * compare each and produce nothing, so a status that only moves volumes
+ * leaves the dropdowns alone and a new session is one insert.
+ *
+ * Names are hashed with FNV-1a over at most NAME_SIZE - 1 characters; two
+ * names with equal hashes count as the same option.
+ */
+template <size_t CAPACITY, size_t NAME_SIZE = 64> class DeviceListModel {
+public:
+  enum class Op : uint8_t { INSERT, REMOVE };
+
+  struct Changes {
+    uint16_t inserted = 0;
+    uint16_t removed = 0;
+
+    bool empty() const { return inserted == 0 && removed == 0; }
+  };
+
+  size_t size() const { return count; }
+
+  void clear() { count = 0; }
+
+  // 'apply(op, position, name)' is called once per change, in order; name
+  // is null for removals. Names beyond CAPACITY are ignored.
+  template <typename Apply>
+  Changes update(const char *const *names, size_t newCount, Apply &&apply) {
+    if (newCount > CAPACITY) {
+      newCount = CAPACITY;
+    }
+    for (size_t j = 0; j < newCount; j++) {
+      scratch[j] = hashName(names[j]);
+    }
+
+    // Invariant: the shown list is scratch[0..j) followed by hashes[i..count)
+    Changes changes;
+    size_t i = 0;
+    size_t j = 0;
+    while (i < count || j < newCount) {
+      if (i < count && j < newCount && hashes[i] == scratch[j]) {
+        i++;
+        j++;
+      } else if (i < count && !contains(scratch, newCount, hashes[i])) {
+        apply(Op::REMOVE, j, static_cast<const char *>(nullptr));
+        changes.removed++;
+        i++;
+      } else if (j < newCount) {
+        apply(Op::INSERT, j, names[j]);
+        changes.inserted++;
+        j++;
+      } else {
+        // Shown twice (hash collision) or out of order: drop the leftover
+        apply(Op::REMOVE, j, static_cast<const char *>(nullptr));
+        changes.removed++;
+        i++;
+      }
+    }
+
+    memcpy(hashes, scratch, newCount * sizeof(uint32_t));
+    count = newCount;
+    return changes;
+  }
+
+private:
+  uint32_t hashes[CAPACITY] = {};
+  uint32_t scratch[CAPACITY] = {};
+  size_t count = 0;
+
+  static uint32_t hashName(const char *name) {
+    return name ? Hash::fnv1a(name, strnlen(name, NAME_SIZE - 1)) : 0;
+  }
+
+  static bool contains(const uint32_t *list, size_t size, uint32_t hash) {
+    for (size_t k = 0; k < size; k++) {
+      if (list[k] == hash) {
+        return true;
+      }
+    }
+    return false;
+  }
+};
+
+} // namespace Audio
+} // namespace Application
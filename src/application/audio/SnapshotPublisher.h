@@ -0,0 +1,134 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace Application {
+namespace Audio {
+
+/**
+ * Lock-free single-value publication across tasks/cores
+ *
+ * The writer fills a free slot with the next immutable value and makes it
+ * current with one atomic pointer store. Readers pin the current slot with
+ * a reference count, re-check that it is still current and then read it in
+ * place - no copy and no lock.
+ *
+ * Single writer: publish() calls must be serialized by the caller, and the
+ * value 'fill' copies from must not change while it runs (AudioManager holds
+ * its state writer lock across the mutation, the version bump and the
+ * publish). Readers on any task then never see a half-written value.
+ *
+ * Reclamation: a slot is only refilled when it is neither current nor
+ * pinned. Pinning re-validates against the current pointer after the
+ * increment, so a reader that raced with reuse simply retries. With SLOTS
+ * >= 3 the writer finds a free slot as long as at most SLOTS - 2 readers
+ * hold an outdated value; otherwise the publish is skipped and counted, and
+ * the next publish carries the change.
+ */
+template <typename T, int SLOTS = 3> class SnapshotPublisher {
+  static_assert(SLOTS >= 3, "need current + one being written + one pinned");
+
+  struct Slot {
+    T value;
+    std::atomic<uint32_t> readers{0};
+  };
+
+public:
+  // Pins one published value for as long as it lives; keep it short
+  class Reader {
+  public:
+    Reader() = default;
+    explicit Reader(Slot *slot) : slot(slot) {}
+    Reader(Reader &&other) noexcept : slot(other.slot) { other.slot = nullptr; }
+    Reader &operator=(Reader &&other) noexcept {
+      if (this != &other) {
+        release();
+        slot = other.slot;
+        other.slot = nullptr;
+      }
+      return *this;
+    }
+    Reader(const Reader &) = delete;
+    Reader &operator=(const Reader &) = delete;
+    ~Reader() { release(); }
+
+    const T &operator*() const { return slot->value; }
+    const T *operator->() const { return &slot->value; }
+
+  private:
+    Slot *slot = nullptr;
+
+    void release() {
+      if (slot) {
+        slot->readers.fetch_sub(1);
+        slot = nullptr;
+      }
+    }
+  };
+
+  struct Stats {
+    uint32_t published = 0;
+    uint32_t skipped = 0;       // No free slot, all pinned by readers
+    uint32_t readerRetries = 0; // Pinned a slot that was replaced meanwhile
+  };
+
+  // A default-constructed value is current from the start, so acquire()
+  // always returns something readable
+  SnapshotPublisher() { current.store(&slots[0]); }
+
+  Reader acquire() const {
+    while (true) {
+      Slot *slot = current.load();
+      slot->readers.fetch_add(1);
+      if (current.load() == slot) {
+        return Reader(slot);
+      }
+      slot->readers.fetch_sub(1);
+      readerRetries.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  // fill(T &next) writes the complete next value. Returns false if every
+  // other slot was pinned and nothing was published.
+  template <typename Fill> bool publish(Fill &&fill) {
+    Slot *slot = freeSlot();
+    if (!slot) {
+      skipped.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    fill(slot->value);
+    current.store(slot);
+    published.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  Stats getStats() const {
+    Stats stats;
+    stats.published = published.load(std::memory_order_relaxed);
+    stats.skipped = skipped.load(std::memory_order_relaxed);
+    stats.readerRetries = readerRetries.load(std::memory_order_relaxed);
+    return stats;
+  }
+
+private:
+  Slot slots[SLOTS];
+  std::atomic<Slot *> current{nullptr};
+
+  std::atomic<uint32_t> published{0};
+  std::atomic<uint32_t> skipped{0};
+  mutable std::atomic<uint32_t> readerRetries{0};
+
+  Slot *freeSlot() {
+    Slot *active = current.load();
+    for (Slot &slot : slots) {
+      if (&slot != active && slot.readers.load() == 0) {
+        return &slot;
+      }
+    }
+    return nullptr;
+  }
+};
+
+} // namespace Audio
+} // namespace Application
@@ -0,0 +1,361 @@
+#include "UIBindings.h"
+#include "../../logo/LogoPrefetcher.h"
+#include "../../logo/SimpleLogoManager.h"
+#include "VolumeWidgetMacros.h"
+#include <esp_log.h>
+#include <ui/ui.h>
+
+static const char *TAG = "UIBindings";
+
+namespace Application {
+namespace Audio {
+
+// Selector result for "leave the widget as it is"
+static const int32_t LEAVE = INT32_MIN;
+
+// Counted for every display refresh area LVGL records
+static uint32_t invalidatedAreas = 0;
+static bool invalidateHooked = false;
+
+static void onInvalidateArea(lv_event_t *e) { invalidatedAreas++; }
+
+static void hookInvalidations() {
+  lv_display_t *display = lv_display_get_default();
+  if (invalidateHooked || !display) {
+    return;
+  }
+  lv_display_add_event_cb(display, onInvalidateArea, LV_EVENT_INVALIDATE_AREA,
+                          nullptr);
+  invalidateHooked = true;
+}
+
+void UIBindings::invalidate() {
+  for (Rendered &binding : rendered) {
+    binding.valid = false;
+  }
+  // A rebuilt screen has empty dropdowns, so the options start over too
+  deviceList.clear();
+  pending = true;
+}
+
+// =============================================================================
+// SYNC PASS
+// =============================================================================
+
+uint32_t UIBindings::sync(const AudioAppState &state, bool dragging) {
+  uint32_t logoVersion = LogoPrefetcher::getInstance().presenceVersion();
+  if (!pending && state.version == renderedVersion &&
+      logoVersion == renderedLogoVersion) {
+    stats.skipped++;
+    return 0;
+  }
+  hookInvalidations();
+
+  renderedVersion = state.version;
+  renderedLogoVersion = logoVersion;
+  pending = false;
+  uint32_t invalidatedBefore = invalidatedAreas;
+  uint32_t setters = 0;
+
+  for (uint8_t i = 0; i < BINDING_COUNT; i++) {
+    BindingId id = static_cast<BindingId>(i);
+    stats.fullRefreshCalls += fullRefreshCost(id);
+
+    // Written once the finger is off the slider
+    if (dragging && isSlider(id)) {
+      rendered[id].valid = false;
+      pending = true;
+      continue;
+    }
+
+    int32_t value = select(id, state);
+    if (value == LEAVE ||
+        (rendered[id].valid && rendered[id].value == value)) {
+      continue;
+    }
+    setters += render(id, state, value);
+    rendered[id].valid = true;
+    rendered[id].value = value;
+  }
+
+  uint32_t invalidated = invalidatedAreas - invalidatedBefore;
+  stats.passes++;
+  stats.setterCalls += setters;
+  stats.invalidatedAreas += invalidated;
+  if (setters > stats.maxSetterCalls) {
+    stats.maxSetterCalls = setters;
+  }
+  if (invalidated > stats.maxInvalidatedAreas) {
+    stats.maxInvalidatedAreas = invalidated;
+  }
+
+  if (setters > 0) {
+    ESP_LOGD(TAG, "State version %lu: %lu setter calls, %lu areas invalidated",
+             (unsigned long)state.version, (unsigned long)setters,
+             (unsigned long)invalidated);
+  }
+  return setters;
+}
+
+// =============================================================================
+// SELECTORS
+// =============================================================================
+
+int32_t UIBindings::select(BindingId id, const AudioAppState &state) {
+  const SessionTable &sessions = state.currentStatus.sessions;
+
+  switch (id) {
+  case DROPDOWN_OPTIONS:
+    return static_cast<int32_t>(sessions.membershipVersion());
+
+  // Options are listed in table order, so a session's position is its
+  // option index; an unselected dropdown keeps what it shows
+  case MAIN_SELECTION: {
+    DeviceHandle device = state.isInMasterTab()   ? state.primaryAudioDevice
+                          : state.isInSingleTab() ? state.selectedSingleDevice
+                                                  : DeviceHandle();
+    int position = sessions.positionOf(device);
+    return position >= 0 ? position : LEAVE;
+  }
+  case BALANCE1_SELECTION: {
+    int position = sessions.positionOf(state.selectedDevice1);
+    return position >= 0 ? position : LEAVE;
+  }
+  case BALANCE2_SELECTION: {
+    int position = sessions.positionOf(state.selectedDevice2);
+    return position >= 0 ? position : LEAVE;
+  }
+
+  // Each tab's slider follows its own selection, the Master tab falls back
+  // to the default device
+  case MASTER_VOLUME:
+    if (state.isValid(state.primaryAudioDevice)) {
+      return sessions.volume(state.primaryAudioDevice);
+    }
+    return state.currentStatus.hasDefaultDevice
+               ? state.currentStatus.defaultDevice.volume
+               : 0;
+  case SINGLE_VOLUME:
+    return sessions.volume(state.selectedSingleDevice);
+  case BALANCE_VOLUME:
+    return sessions.volume(state.selectedDevice1);
+
+  case DEFAULT_DEVICE_LABEL: {
+    if (!state.currentStatus.hasDefaultDevice) {
+      return LEAVE;
+    }
+    const String &name = state.currentStatus.defaultDevice.friendlyName;
+    return static_cast<int32_t>(Hash::fnv1a(name.c_str(), name.length()));
+  }
+
+  // Hidden outside the Single tab and without a selection; whether the
+  // logo is on SD is part of the value, so a logo saved later is shown
+  case SINGLE_LOGO: {
+    if (!state.isInSingleTab()) {
+      return -1;
+    }
+    DeviceHandle device = state.selectedSingleDevice;
+    if (!state.isValid(device)) {
+      return 0;
+    }
+    bool present =
+        LogoPrefetcher::getInstance().hasLogo(sessions.processName(device));
+    return ((device.index << 16 | device.generation) << 1 | present) + 1;
+  }
+
+  default:
+    return LEAVE;
+  }
+}
+
+// =============================================================================
+// RENDERERS
+// =============================================================================
+
+static uint32_t setVolume(lv_obj_t *slider, lv_obj_t *label, int volume) {
+  uint32_t setters = 0;
+  if (slider) {
+    VOLUME_WIDGET_SET_VALUE(slider, volume);
+    setters++;
+  }
+  if (label) {
+    char volumeText[16];
+    snprintf(volumeText, sizeof(volumeText), "%d%%", volume);
+    lv_label_set_text(label, volumeText);
+    setters++;
+  }
+  return setters;
+}
+
+static uint32_t setSelection(lv_obj_t *dropdown, int32_t position) {
+  if (!dropdown) {
+    return 0;
+  }
+  lv_dropdown_set_selected(dropdown, position);
+  return 1;
+}
+
+static uint32_t hideLogo() {
+  lv_obj_add_flag(ui_img, LV_OBJ_FLAG_HIDDEN);
+  // Ensure transparency is maintained when hidden
+  lv_obj_set_style_bg_opa(ui_img, LV_OPA_TRANSP,
+                          LV_PART_MAIN | LV_STATE_DEFAULT);
+  return 2;
+}
+
+static uint32_t showLogo(const char *processName) {
+  // Presence is known from prefetching, no SD access here
+  if (!LogoPrefetcher::getInstance().hasLogo(processName)) {
+    ESP_LOGD(TAG, "No logo found for %s - hiding image", processName);
+    return hideLogo();
+  }
+
+  String logoPath = SimpleLogoManager::getInstance().getLVGLPath(processName);
+  ESP_LOGI(TAG, "Showing logo for %s from %s", processName, logoPath.c_str());
+
+  lv_img_set_src(ui_img, logoPath.c_str());
+  // Auto size to content at 100% scale (256), centred and transparent
+  lv_obj_set_size(ui_img, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
+  lv_image_set_scale(ui_img, 256);
+  lv_obj_set_style_bg_opa(ui_img, LV_OPA_TRANSP,
+                          LV_PART_MAIN | LV_STATE_DEFAULT);
+  lv_obj_center(ui_img);
+  lv_obj_remove_flag(ui_img, LV_OBJ_FLAG_HIDDEN);
+  return 6;
+}
+
+uint32_t UIBindings::render(BindingId id, const AudioAppState &state,
+                            int32_t value) {
+  const SessionTable &sessions = state.currentStatus.sessions;
+
+  switch (id) {
+  case DROPDOWN_OPTIONS: {
+    const char *names[SessionTable::CAPACITY];
+    size_t count = 0;
+    for (SessionTable::Entry session : sessions) {
+      names[count++] = session.processName();
+    }
+
+    // New sessions are inserted in place; a removal (LVGL cannot drop one
+    // option) or an empty list (the "-" placeholder) rebuilds the options
+    struct Insert {
+      uint32_t position;
+      const char *name;
+    } inserts[SessionTable::CAPACITY];
+    size_t insertCount = 0;
+    bool wasEmpty = deviceList.size() == 0;
+    DeviceList::Changes changes = deviceList.update(
+        names, count,
+        [&](DeviceList::Op op, size_t position, const char *name) {
+          if (op == DeviceList::Op::INSERT && insertCount < SessionTable::CAPACITY) {
+            inserts[insertCount++] = {static_cast<uint32_t>(position), name};
+          }
+        });
+    bool rebuild = wasEmpty || count == 0 || changes.removed > 0;
+
+    uint32_t setters = 0;
+    for (lv_obj_t *dropdown :
+         {ui_selectAudioDevice, ui_selectAudioDevice1, ui_selectAudioDevice2}) {
+      if (!dropdown) {
+        continue;
+      }
+      if (rebuild) {
+        if (count == 0) {
+          strcpy(dropdownOptions, "-"); // Default option when no devices
+        } else {
+          sessions.joinProcessNames(dropdownOptions, sizeof(dropdownOptions), '\n');
+        }
+        lv_dropdown_set_options(dropdown, dropdownOptions);
+        setters++;
+        continue;
+      }
+      for (size_t k = 0; k < insertCount; k++) {
+        lv_dropdown_add_option(dropdown, inserts[k].name, inserts[k].position);
+        setters++;
+      }
+    }
+    // New options shift or reset the selected index
+    rendered[MAIN_SELECTION].valid = false;
+    rendered[BALANCE1_SELECTION].valid = false;
+    rendered[BALANCE2_SELECTION].valid = false;
+    ESP_LOGD(TAG, "Device selectors: %u inserted, %u removed%s (%u devices)",
+             (unsigned)changes.inserted, (unsigned)changes.removed,
+             rebuild ? ", rebuilt" : "", (unsigned)count);
+    return setters;
+  }
+
+  case MAIN_SELECTION:
+    return setSelection(ui_selectAudioDevice, value);
+  case BALANCE1_SELECTION:
+    return setSelection(ui_selectAudioDevice1, value);
+  case BALANCE2_SELECTION:
+    return setSelection(ui_selectAudioDevice2, value);
+
+  case MASTER_VOLUME:
+    return setVolume(ui_primaryVolumeSlider, ui_lblPrimaryVolumeSlider, value);
+  case SINGLE_VOLUME:
+    return setVolume(ui_singleVolumeSlider, ui_lblSingleVolumeSlider, value);
+  case BALANCE_VOLUME:
+    return setVolume(ui_balanceVolumeSlider, ui_lblBalanceVolumeSlider, value);
+
+  case DEFAULT_DEVICE_LABEL:
+    if (!ui_lblPrimaryAudioDeviceValue) {
+      return 0;
+    }
+    lv_label_set_text(ui_lblPrimaryAudioDeviceValue,
+                      state.currentStatus.defaultDevice.friendlyName.c_str());
+    return 1;
+
+  case SINGLE_LOGO:
+    if (!ui_img) {
+      return 0;
+    }
+    return value > 0
+               ? showLogo(sessions.processName(state.selectedSingleDevice))
+               : hideLogo();
+
+  default:
+    return 0;
+  }
+}
+
+// Setters the imperative refresh called for a binding whether or not its
+// value had changed
+uint32_t UIBindings::fullRefreshCost(BindingId id) {
+  switch (id) {
+  case DROPDOWN_OPTIONS:
+    return 3;
+  case MASTER_VOLUME:
+  case SINGLE_VOLUME:
+  case BALANCE_VOLUME:
+  case SINGLE_LOGO:
+    return 2;
+  default:
+    return 1;
+  }
+}
+
+bool UIBindings::isSlider(BindingId id) {
+  return id == MASTER_VOLUME || id == SINGLE_VOLUME || id == BALANCE_VOLUME;
+}
+
+String UIBindings::getStatus() const {
+  uint32_t averageSetters = stats.passes ? stats.setterCalls / stats.passes : 0;
+  uint32_t averageAreas =
+      stats.passes ? stats.invalidatedAreas / stats.passes : 0;
+
+  String status = "UI Bindings:\n";
+  status += "- Passes " + String(stats.passes) + ", skipped (state unchanged) " +
+            String(stats.skipped) + "\n";
+  status += "- Setter calls " + String(stats.setterCalls) + " (full refresh: " +
+            String(stats.fullRefreshCalls) + "), avg " +
+            String(averageSetters) + " max " + String(stats.maxSetterCalls) +
+            " per pass\n";
+  status += "- Invalidated areas " + String(stats.invalidatedAreas) + ", avg " +
+            String(averageAreas) + " max " +
+            String(stats.maxInvalidatedAreas) + " per pass\n";
+  return status;
+}
+
+} // namespace Audio
+} // namespace Application
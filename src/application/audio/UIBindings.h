@@ -0,0 +1,95 @@
+#pragma once
+
+#include "AudioData.h"
+#include "DeviceListModel.h"
+#include <lvgl.h>
+
+namespace Application {
+namespace Audio {
+
+/**
+ * Retained-mode binding of the audio widgets to AudioAppState
+ *
+ * Every bound widget (volume sliders and their labels, dropdown options and
+ * selections, default device label, Single tab logo) has a selector that
+ * reduces the state to one value (a volume, an option index, a name hash)
+ * and remembers the value it last rendered. sync() runs once per frame on
+ * the LVGL task: it returns at once when AudioAppState::version has not
+ * moved, otherwise it calls LVGL setters only for the bindings whose value
+ * changed. The Single tab logo also depends on the logo prefetcher, so a
+ * logo saved after its session was shown triggers a pass too. Dropdown options are keyed by the session table membership
+ * version and diffed through a DeviceListModel, so they only change when
+ * sessions come or go, and a new session is inserted in place.
+ *
+ * Sliders and volume labels are left alone while the user drags, and
+ * written once after the drag ends.
+ *
+ * Per pass it counts the LVGL setter calls made, the calls a full refresh
+ * of every bound widget would have made (what the imperative updates did),
+ * and the areas LVGL invalidated meanwhile.
+ */
+class UIBindings {
+public:
+  struct Stats {
+    uint32_t passes = 0;           // sync() calls that looked at the state
+    uint32_t skipped = 0;          // sync() calls with nothing new
+    uint32_t setterCalls = 0;      // LVGL setters called
+    uint32_t fullRefreshCalls = 0; // Setters a full refresh would have called
+    uint32_t invalidatedAreas = 0; // LV_EVENT_INVALIDATE_AREA during passes
+    uint32_t maxSetterCalls = 0;   // Worst single pass
+    uint32_t maxInvalidatedAreas = 0;
+  };
+
+  // Render everything on the next pass (screen rebuilt, first frame)
+  void invalidate();
+
+  // Bring the widgets in line with 'state'; 'dragging' holds back the
+  // sliders. Returns the number of setter calls made.
+  uint32_t sync(const AudioAppState &state, bool dragging);
+
+  // Version of the last state seen by sync()
+  uint32_t syncedVersion() const { return renderedVersion; }
+
+  Stats getStats() const { return stats; }
+  String getStatus() const;
+
+private:
+  enum BindingId : uint8_t {
+    DROPDOWN_OPTIONS, // Must precede the selections, it resets them
+    MAIN_SELECTION,
+    BALANCE1_SELECTION,
+    BALANCE2_SELECTION,
+    MASTER_VOLUME,
+    SINGLE_VOLUME,
+    BALANCE_VOLUME,
+    DEFAULT_DEVICE_LABEL,
+    SINGLE_LOGO,
+    BINDING_COUNT
+  };
+
+  struct Rendered {
+    bool valid = false;
+    int32_t value = 0;
+  };
+
+  Rendered rendered[BINDING_COUNT];
+  uint32_t renderedVersion = 0;
+  uint32_t renderedLogoVersion = 0; // LogoPrefetcher::presenceVersion()
+  bool pending = true; // A binding was held back or invalidated
+
+  // Options shown in the dropdowns; diffed so new sessions are inserted
+  // and only removals rebuild ("a\nb\nc", joined in place)
+  using DeviceList = DeviceListModel<SessionTable::CAPACITY, SessionTable::NAME_SIZE>;
+  DeviceList deviceList;
+  char dropdownOptions[SessionTable::CAPACITY * SessionTable::NAME_SIZE];
+
+  Stats stats;
+
+  static int32_t select(BindingId id, const AudioAppState &state);
+  uint32_t render(BindingId id, const AudioAppState &state, int32_t value);
+  static uint32_t fullRefreshCost(BindingId id);
+  static bool isSlider(BindingId id);
+};
+
+} // namespace Audio
+} // namespace Application
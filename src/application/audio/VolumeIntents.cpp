@@ -0,0 +1,166 @@
+#include "VolumeIntents.h"
+
+namespace Application {
+namespace Audio {
+
+void VolumeIntentTable::record(const char *device, const char *requestId,
+                               int volume, uint32_t nowMs) {
+  portENTER_CRITICAL(&lock);
+  Intent *intent = findLocked(device);
+  if (!intent) {
+    // Free slot, or the oldest one if all are taken
+    intent = &intents[0];
+    for (Intent &candidate : intents) {
+      if (!candidate.used) {
+        intent = &candidate;
+        break;
+      }
+      if (candidate.sentAtMs < intent->sentAtMs) {
+        intent = &candidate;
+      }
+    }
+    strncpy(intent->device, device ? device : "", sizeof(intent->device) - 1);
+    intent->device[sizeof(intent->device) - 1] = '\0';
+  }
+
+  intent->used = true;
+  intent->acknowledged = false;
+  intent->volume = volume;
+  intent->sentAtMs = nowMs;
+  strncpy(intent->requestId, requestId ? requestId : "",
+          sizeof(intent->requestId) - 1);
+  intent->requestId[sizeof(intent->requestId) - 1] = '\0';
+  stats.recorded++;
+  portEXIT_CRITICAL(&lock);
+}
+
+bool VolumeIntentTable::acknowledge(const char *originatingRequestId,
+                                    uint32_t nowMs) {
+  if (!originatingRequestId || originatingRequestId[0] == '\0') {
+    return false;
+  }
+
+  bool found = false;
+  portENTER_CRITICAL(&lock);
+  for (Intent &intent : intents) {
+    if (intent.used && !intent.acknowledged &&
+        strcmp(intent.requestId, originatingRequestId) == 0) {
+      intent.acknowledged = true;
+      uint32_t latency = nowMs - intent.sentAtMs;
+      stats.acknowledged++;
+      stats.latencyCount++;
+      stats.latencyTotalMs += latency;
+      if (latency > stats.latencyMaxMs) {
+        stats.latencyMaxMs = latency;
+      }
+      found = true;
+    }
+  }
+  portEXIT_CRITICAL(&lock);
+  return found;
+}
+
+int VolumeIntentTable::reconcile(const char *device, int reportedVolume,
+                                 uint32_t nowMs) {
+  int volume = reportedVolume;
+
+  portENTER_CRITICAL(&lock);
+  Intent *intent = findLocked(device);
+  if (intent) {
+    if (intent->acknowledged) {
+      endLocked(*intent, reportedVolume);
+    } else if (nowMs - intent->sentAtMs >= timeoutMs) {
+      stats.timeouts++;
+      endLocked(*intent, reportedVolume);
+    } else {
+      // Status predates our command - keep showing what the user set
+      if (reportedVolume != intent->volume) {
+        stats.held++;
+      }
+      volume = intent->volume;
+    }
+  }
+  portEXIT_CRITICAL(&lock);
+  return volume;
+}
+
+void VolumeIntentTable::sweep(uint32_t nowMs) {
+  portENTER_CRITICAL(&lock);
+  for (Intent &intent : intents) {
+    if (!intent.used) {
+      continue;
+    }
+    if (intent.acknowledged) {
+      intent.used = false;
+    } else if (nowMs - intent.sentAtMs >= timeoutMs) {
+      stats.timeouts++;
+      intent.used = false;
+    }
+  }
+  portEXIT_CRITICAL(&lock);
+}
+
+bool VolumeIntentTable::hasPending(const char *device) const {
+  portENTER_CRITICAL(&lock);
+  bool pending = const_cast<VolumeIntentTable *>(this)->findLocked(device);
+  portEXIT_CRITICAL(&lock);
+  return pending;
+}
+
+size_t VolumeIntentTable::size() const {
+  size_t count = 0;
+  portENTER_CRITICAL(&lock);
+  for (const Intent &intent : intents) {
+    count += intent.used;
+  }
+  portEXIT_CRITICAL(&lock);
+  return count;
+}
+
+VolumeIntentTable::Stats VolumeIntentTable::getStats() const {
+  portENTER_CRITICAL(&lock);
+  Stats copy = stats;
+  portEXIT_CRITICAL(&lock);
+  return copy;
+}
+
+String VolumeIntentTable::getStatus(const char *title) const {
+  Stats copy = getStats();
+  uint32_t average =
+      copy.latencyCount ? copy.latencyTotalMs / copy.latencyCount : 0;
+  String status = String(title) + ":\n";
+  status += "- Pending: " + String((unsigned)size()) + ", recorded " +
+            String(copy.recorded) + ", acknowledged " +
+            String(copy.acknowledged) + ", timed out " + String(copy.timeouts) +
+            "\n";
+  status += "- Perceived latency avg " + String(average) + "ms max " +
+            String(copy.latencyMaxMs) + "ms\n";
+  status += "- Stale volumes held " + String(copy.held) + ", jump-backs " +
+            String(copy.jumpBacks) + "\n";
+  return status;
+}
+
+// =============================================================================
+// PRIVATE
+// =============================================================================
+
+// *Locked helpers run with the lock held
+VolumeIntentTable::Intent *VolumeIntentTable::findLocked(const char *device) {
+  const char *name = device ? device : "";
+  for (Intent &intent : intents) {
+    if (intent.used && strcmp(intent.device, name) == 0) {
+      return &intent;
+    }
+  }
+  return nullptr;
+}
+
+void VolumeIntentTable::endLocked(Intent &intent, int hostVolume) {
+  if (hostVolume != intent.volume) {
+    stats.jumpBacks++;
+  }
+  intent.used = false;
+}
+
+} // namespace Audio
+} // namespace Application
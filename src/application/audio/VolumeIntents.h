@@ -0,0 +1,90 @@
+#pragma once
+
+#include "AudioData.h"
+#include <MessagingConfig.h>
+#include <freertos/FreeRTOS.h>
+
+namespace Application {
+namespace Audio {
+
+/**
+ * Volume changes sent to the host and not yet confirmed
+ *
+ * Each SET_VOLUME the device sends is recorded here with its requestId. An
+ * AUDIO_STATUS may have been generated before the host applied that
+ * command, so while a device has an unconfirmed intent its reported volume
+ * is replaced by the intended one. The intent ends when a status echoes the
+ * requestId (originatingRequestId) or after
+ * MESSAGING_VOLUME_INTENT_TIMEOUT_MS; from then on the host value is taken
+ * as is.
+ *
+ * One intent per device: a newer send replaces the older one, and only the
+ * newest requestId confirms. The default device uses the empty name. A
+ * scene records one intent per command it sends, each under that
+ * command's requestId. AudioManager keeps a second table for mute, with
+ * 0/1 as the value.
+ *
+ * record() runs on the UI task, acknowledge()/reconcile() on the serial
+ * task; both only touch fixed arrays under a short critical section.
+ */
+class VolumeIntentTable {
+public:
+  // A scene sets every session and the default device at once
+  static const int CAPACITY = SessionTable::CAPACITY + 1;
+
+  struct Stats {
+    uint32_t recorded = 0;
+    uint32_t acknowledged = 0;
+    uint32_t timeouts = 0;
+    uint32_t held = 0;      // Status volumes replaced by a pending intent
+    uint32_t jumpBacks = 0; // Host value differed from the intent once it ended
+    uint32_t latencyCount = 0;
+    uint32_t latencyTotalMs = 0; // Send to echo, acknowledged intents only
+    uint32_t latencyMaxMs = 0;
+  };
+
+  explicit VolumeIntentTable(
+      uint32_t timeoutMs = MESSAGING_VOLUME_INTENT_TIMEOUT_MS)
+      : timeoutMs(timeoutMs) {}
+
+  void record(const char *device, const char *requestId, int volume,
+              uint32_t nowMs);
+
+  // Mark the intents with this requestId as confirmed by the current status
+  bool acknowledge(const char *originatingRequestId, uint32_t nowMs);
+
+  // Volume to apply for 'device' given the reported one. Confirmed and
+  // expired intents end here.
+  int reconcile(const char *device, int reportedVolume, uint32_t nowMs);
+
+  // Drop confirmed intents and expire timed-out ones, including those of
+  // devices the status no longer reports (after reconcile() has seen the
+  // whole status)
+  void sweep(uint32_t nowMs);
+
+  bool hasPending(const char *device) const;
+  size_t size() const;
+  Stats getStats() const;
+  String getStatus(const char *title = "Volume Intents") const;
+
+private:
+  struct Intent {
+    bool used = false;
+    bool acknowledged = false;
+    int volume = 0;
+    uint32_t sentAtMs = 0;
+    char device[SessionTable::NAME_SIZE] = {};
+    char requestId[64] = {};
+  };
+
+  Intent intents[CAPACITY];
+  uint32_t timeoutMs;
+  Stats stats;
+  mutable portMUX_TYPE lock = portMUX_INITIALIZER_UNLOCKED;
+
+  Intent *findLocked(const char *device);
+  void endLocked(Intent &intent, int hostVolume);
+};
+
+} // namespace Audio
+} // namespace Application
@@ -0,0 +1,116 @@
+#include "VolumeStreamer.h"
+#include <esp_log.h>
+
+static const char *TAG = "VolumeStreamer";
+
+namespace Application {
+namespace Audio {
+
+// A rate of 0 disables streaming: only the value the drag ends on is sent
+VolumeStreamer::VolumeStreamer(uint32_t maxRateHz, Sender sender,
+                               LinkBusy linkBusy)
+    : sender(std::move(sender)), linkBusy(std::move(linkBusy)),
+      intervalUs(maxRateHz ? 1000000 / maxRateHz : 0) {}
+
+// =============================================================================
+// DRAG LIFECYCLE
+// =============================================================================
+
+// The rate bound runs from the last send, not from the start of the drag
+void VolumeStreamer::begin(const String &device, int volume, int64_t) {
+  processName = device;
+  dragging = true;
+  pending = false;
+  finalPending = false;
+  // The slider starts at the current volume, no need to echo it back
+  lastSentVolume = volume;
+  stats.drags++;
+  ESP_LOGD(TAG, "Drag started on '%s' at %d", processName.c_str(), volume);
+}
+
+void VolumeStreamer::update(int volume, int64_t nowUs) {
+  if (!dragging) {
+    return;
+  }
+  offer(volume);
+  trySend(nowUs);
+}
+
+void VolumeStreamer::end(int volume, int64_t nowUs) {
+  if (!dragging) {
+    return;
+  }
+  dragging = false;
+  offer(volume);
+  finalPending = pending;
+  trySend(nowUs);
+
+  ESP_LOGI(TAG, "Drag ended at %d: %lu sent, %lu suppressed so far%s", volume,
+           (unsigned long)stats.sent, (unsigned long)stats.suppressed,
+           pending ? " (final value due shortly)" : "");
+}
+
+void VolumeStreamer::poll(int64_t nowUs) { trySend(nowUs); }
+
+uint32_t VolumeStreamer::msUntilDue(int64_t nowUs) const {
+  int64_t remaining = lastSentAt + intervalUs - nowUs;
+  return remaining > 0 ? static_cast<uint32_t>((remaining + 999) / 1000) : 0;
+}
+
+// =============================================================================
+// SENDING
+// =============================================================================
+
+void VolumeStreamer::offer(int volume) {
+  if (pending) {
+    if (volume == pendingVolume) {
+      return;
+    }
+    stats.suppressed++;
+  } else if (volume == lastSentVolume) {
+    return;
+  }
+
+  stats.offered++;
+  pendingVolume = volume;
+  pending = volume != lastSentVolume;
+}
+
+void VolumeStreamer::trySend(int64_t nowUs) {
+  if (!pending || nowUs - lastSentAt < intervalUs) {
+    return;
+  }
+  // Streaming off: hold everything until the drag ends
+  if (intervalUs == 0 && !finalPending) {
+    return;
+  }
+
+  // Intermediate values wait for the link; the final one must go out
+  if (!finalPending && linkBusy && linkBusy()) {
+    stats.linkBusy++;
+    return;
+  }
+
+  sender(processName, pendingVolume);
+  stats.sent++;
+  lastSentVolume = pendingVolume;
+  lastSentAt = nowUs;
+  pending = false;
+  finalPending = false;
+}
+
+String VolumeStreamer::getStatus() const {
+  String status = "Volume Streamer:\n";
+  status += "- Rate limit: " +
+            (intervalUs ? String((long)(1000000 / intervalUs)) + " Hz"
+                       : String("off, send on release")) +
+            "\n";
+  status += "- Drags: " + String(stats.drags) + ", values " +
+            String(stats.offered) + ", sent " + String(stats.sent) +
+            ", suppressed " + String(stats.suppressed) + ", link busy " +
+            String(stats.linkBusy) + "\n";
+  return status;
+}
+
+} // namespace Audio
+} // namespace Application
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <Arduino.h>
+#include <MessagingConfig.h>
+#include <functional>
+
+namespace Application {
+namespace Audio {
+
+/**
+ * Rate-bounded SET_VOLUME sender for slider drags
+ *
+ * While a volume slider is dragged every new value is offered here; at most
+ * one is sent per interval (MESSAGING_VOLUME_STREAM_HZ) and values replaced
+ * before their turn are dropped. While the TX link is saturated the newest
+ * value is held back rather than queued behind older ones. The value the
+ * drag ends on is always sent, once its interval is due, even on a busy
+ * link.
+ *
+ * Time is passed in (esp_timer microseconds) so the unit tests can drive a
+ * simulated drag. poll() must run while hasPending() is true; the UI does
+ * that from an LVGL timer. Not thread safe: LVGL task only.
+ */
+class VolumeStreamer {
+public:
+  using Sender = std::function<void(const String &processName, int volume)>;
+  using LinkBusy = std::function<bool()>;
+
+  struct Stats {
+    uint32_t drags = 0;
+    uint32_t offered = 0;    // Distinct values seen during drags
+    uint32_t sent = 0;       // SET_VOLUME messages handed to the sender
+    uint32_t suppressed = 0; // Replaced by a newer value before being sent
+    uint32_t linkBusy = 0;   // Sends postponed because the link was busy
+  };
+
+  // Defined in AudioManager.cpp, which owns the send path it feeds
+  static VolumeStreamer &getInstance();
+
+  // Standalone instances are only used by the unit tests
+  VolumeStreamer(uint32_t maxRateHz, Sender sender, LinkBusy linkBusy);
+
+  void begin(const String &processName, int volume, int64_t nowUs);
+  void update(int volume, int64_t nowUs);
+  void end(int volume, int64_t nowUs);
+  void poll(int64_t nowUs);
+
+  bool isDragging() const { return dragging; }
+  bool hasPending() const { return pending; }
+
+  // Time until poll() can send the pending value, 0 if due
+  uint32_t msUntilDue(int64_t nowUs) const;
+  uint32_t getIntervalMs() const { return intervalUs / 1000; }
+
+  const Stats &getStats() const { return stats; }
+  String getStatus() const;
+
+private:
+  Sender sender;
+  LinkBusy linkBusy;
+  int64_t intervalUs;
+
+  String processName;
+  bool dragging = false;
+  bool pending = false;
+  bool finalPending = false; // The drag ended on the pending value
+  int pendingVolume = 0;
+  int lastSentVolume = -1;
+  int64_t lastSentAt = 0;
+
+  Stats stats;
+
+  void offer(int volume);
+  void trySend(int64_t nowUs);
+};
+
+} // namespace Audio
+} // namespace Application
@@ -23,6 +23,7 @@
  */
 
 #include "LVGLMessageHandler.h"
+#include "../../core/FrameScheduler.h"
 #include "../../core/TaskManager.h"
 #include "BootManager.h"
 #include "../../hardware/SDManager.h"
@@ -33,12 +34,13 @@
 #include "BuildInfo.h"
 #include "dialogs/UniversalDialog.h"
 #include "VolumeWidgetMacros.h"
+#include <Hash.h>
 #include <cstring>
 #include <map>
 #include <esp_log.h>
+#include <esp_timer.h>
 #include <lvgl.h>
 #include <ui/ui.h>
-#include <functional>
 #include <unordered_map>
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
@@ -67,11 +69,8 @@ namespace Application {
 namespace LVGLMessageHandler {
 static const char *TAG = "LVGLMessageHandler";
 
-// PERFORMANCE: Message handler callback type
-using MessageHandler = std::function<void(const LVGLMessage_t *)>;
-
-// PERFORMANCE: Single message type to handler mapping for O(1) lookup
-static std::unordered_map<int, MessageHandler> messageHandlers;
+// PERFORMANCE: Plain function pointer, the dispatch table is built at compile time
+using MessageHandler = void (*)(const LVGLMessage_t *);
 
 // PERFORMANCE: Message type names for debugging - static array for O(1) lookup
 static const char *messageTypeNames[] = {
@@ -94,6 +93,8 @@ static const char *messageTypeNames[] = {
     [MSG_FORMAT_SD_PROGRESS] = "FORMAT_SD_PROGRESS",
     [MSG_FORMAT_SD_COMPLETE] = "FORMAT_SD_COMPLETE",
 };
+static_assert(sizeof(messageTypeNames) / sizeof(messageTypeNames[0]) == NUM_OF_MSGS,
+              "Every message type needs a name");
 
 // PERFORMANCE: O(1) message type name lookup
 static const char *getMessageTypeName(int messageType) {
@@ -103,28 +104,149 @@ static const char *getMessageTypeName(int messageType) {
     return "UNKNOWN";
 }
 
-// PERFORMANCE: Fast volume extraction using function pointers
-using VolumeExtractor = int (*)(const LVGLMessage_t *);
+// =============================================================================
+// PAYLOAD POOL
+// =============================================================================
+
+#define LVGL_PAYLOAD_POOL_SIZE 8  // Large payloads in flight at once
+
+typedef union {
+    StateOverviewPayload overview;
+    DeviceNamesPayload names;
+    TextPayload text;
+} PayloadData;
+
+typedef struct {
+    bool used;
+    uint8_t generation;  // Bumped on release, stale handles stop matching
+    PayloadData data;
+} PayloadSlot;
+
+static PayloadSlot payloadSlots[LVGL_PAYLOAD_POOL_SIZE];
+static QueueStats stats;
+static HandlerTiming handlerTimings[NUM_OF_MSGS];
+static portMUX_TYPE poolLock = portMUX_INITIALIZER_UNLOCKED;  // Slots and stats
+
+// Claim a slot for the sender to fill before the message is sent
+static PayloadData *acquirePayload(PayloadHandle *handle) {
+    PayloadData *data = NULL;
+    portENTER_CRITICAL(&poolLock);
+    for (int i = 0; i < LVGL_PAYLOAD_POOL_SIZE; i++) {
+        if (!payloadSlots[i].used) {
+            payloadSlots[i].used = true;
+            *handle = (PayloadHandle)(i | (payloadSlots[i].generation << 8));
+            data = &payloadSlots[i].data;
+            break;
+        }
+    }
+    if (!data) {
+        stats.poolExhausted++;
+    }
+    portEXIT_CRITICAL(&poolLock);
 
-static int extractMasterVolume(const LVGLMessage_t *msg) { return msg->data.master_volume.volume; }
-static int extractSingleVolume(const LVGLMessage_t *msg) { return msg->data.single_volume.volume; }
-static int extractBalanceVolume(const LVGLMessage_t *msg) { return msg->data.balance_volume.volume; }
+    if (!data) {
+        ESP_LOGW(TAG, "Payload pool exhausted, dropping message");
+    }
+    return data;
+}
 
-static std::unordered_map<int, VolumeExtractor> volumeExtractors = {
-    {MSG_UPDATE_MASTER_VOLUME, extractMasterVolume},
-    {MSG_UPDATE_SINGLE_VOLUME, extractSingleVolume},
-    {MSG_UPDATE_BALANCE_VOLUME, extractBalanceVolume}};
+// Read in place on the LVGL task, between receive and release
+static const PayloadData *payloadData(PayloadHandle handle) {
+    uint8_t index = handle & 0xFF;
+    if (handle == NO_PAYLOAD || index >= LVGL_PAYLOAD_POOL_SIZE) {
+        return NULL;
+    }
+    const PayloadSlot &slot = payloadSlots[index];
+    return slot.used && slot.generation == (handle >> 8) ? &slot.data : NULL;
+}
 
-// PERFORMANCE: Fast volume update function
-static inline void updateVolumeSlider(lv_obj_t *slider, const LVGLMessage_t *msg) {
-    if (!slider) return;
+static void releasePayload(PayloadHandle handle) {
+    uint8_t index = handle & 0xFF;
+    if (handle == NO_PAYLOAD || index >= LVGL_PAYLOAD_POOL_SIZE) {
+        return;
+    }
+    portENTER_CRITICAL(&poolLock);
+    PayloadSlot &slot = payloadSlots[index];
+    if (slot.used && slot.generation == (handle >> 8)) {
+        slot.used = false;
+        slot.generation++;
+    }
+    portEXIT_CRITICAL(&poolLock);
+}
 
-    auto extractor = volumeExtractors.find(msg->type);
-    if (extractor != volumeExtractors.end()) {
-        int volume = extractor->second(msg);
-        VOLUME_WIDGET_SET_VALUE(slider, volume);
-        lv_obj_send_event(slider, LV_EVENT_VALUE_CHANGED, NULL);
+static void copyText(char *destination, size_t size, const char *source) {
+    strncpy(destination, source ? source : "", size - 1);
+    destination[size - 1] = '\0';
+}
+
+// =============================================================================
+// MAILBOXES
+// =============================================================================
+
+// Idempotent updates keep only their latest value: one slot per type, a
+// newer send overwrites the pending one and each is rendered at most once
+// per timer pass. Everything else is an ordered command and goes through
+// the FIFO queue.
+static LVGLMessage_t mailbox[NUM_OF_MSGS];
+static bool mailboxPending[NUM_OF_MSGS];
+
+static bool isMailboxType(LVGLMessageType_t type) {
+    switch (type) {
+        case MSG_UPDATE_FPS_DISPLAY:
+        case MSG_UPDATE_BUILD_TIME_DISPLAY:
+        case MSG_UPDATE_MASTER_VOLUME:
+        case MSG_UPDATE_SINGLE_VOLUME:
+        case MSG_UPDATE_BALANCE_VOLUME:
+        case MSG_UPDATE_MASTER_DEVICE:
+        case MSG_UPDATE_SINGLE_DEVICE:
+        case MSG_UPDATE_BALANCE_DEVICES:
+        case MSG_UPDATE_SD_STATUS:
+            return true;
+        default:
+            return false;
+    }
+}
+
+static void postToMailbox(const LVGLMessage_t *message) {
+    PayloadHandle replaced = NO_PAYLOAD;
+    portENTER_CRITICAL(&poolLock);
+    if (mailboxPending[message->type]) {
+        replaced = mailbox[message->type].payload;
+        stats.coalesced++;
+    }
+    mailbox[message->type] = *message;
+    mailboxPending[message->type] = true;
+    stats.sent++;
+    portEXIT_CRITICAL(&poolLock);
+
+    releasePayload(replaced);
+}
+
+static bool takeFromMailbox(int type, LVGLMessage_t *message) {
+    portENTER_CRITICAL(&poolLock);
+    bool pending = mailboxPending[type];
+    if (pending) {
+        *message = mailbox[type];
+        mailboxPending[type] = false;
     }
+    portEXIT_CRITICAL(&poolLock);
+    return pending;
+}
+
+static LVGLMessage_t makeMessage(LVGLMessageType_t type) {
+    LVGLMessage_t message;
+    memset(&message, 0, sizeof(message));
+    message.type = type;
+    message.payload = NO_PAYLOAD;
+    return message;
+}
+
+// PERFORMANCE: Fast volume update function, each handler passes its own field
+static inline void updateVolumeSlider(lv_obj_t *slider, int volume) {
+    if (!slider) return;
+
+    VOLUME_WIDGET_SET_VALUE(slider, volume);
+    lv_obj_send_event(slider, LV_EVENT_VALUE_CHANGED, NULL);
 }
 static void handleFpsDisplay(const LVGLMessage_t *msg) {
     if (ui_lblFPS) {
@@ -138,20 +260,21 @@ static void handleFpsDisplay(const LVGLMessage_t *msg) {
 }
 
 static void handleMasterVolume(const LVGLMessage_t *msg) {
-    updateVolumeSlider(ui_primaryVolumeSlider, msg);
+    updateVolumeSlider(ui_primaryVolumeSlider, msg->data.master_volume.volume);
 }
 
 static void handleSingleVolume(const LVGLMessage_t *msg) {
-    updateVolumeSlider(ui_singleVolumeSlider, msg);
+    updateVolumeSlider(ui_singleVolumeSlider, msg->data.single_volume.volume);
 }
 
 static void handleBalanceVolume(const LVGLMessage_t *msg) {
-    updateVolumeSlider(ui_balanceVolumeSlider, msg);
+    updateVolumeSlider(ui_balanceVolumeSlider, msg->data.balance_volume.volume);
 }
 
 static void handleMasterDevice(const LVGLMessage_t *msg) {
-    if (ui_lblPrimaryAudioDeviceValue) {
-        lv_label_set_text(ui_lblPrimaryAudioDeviceValue, msg->data.master_device.device_name);
+    const PayloadData *payload = payloadData(msg->payload);
+    if (ui_lblPrimaryAudioDeviceValue && payload) {
+        lv_label_set_text(ui_lblPrimaryAudioDeviceValue, payload->names.device1_name);
     }
 }
 
@@ -164,12 +287,18 @@ static void handleBuildTimeDisplay(const LVGLMessage_t *msg) {
 // PERFORMANCE: Complex message handlers
 
 static void handleSingleDevice(const LVGLMessage_t *msg) {
-    ESP_LOGI(TAG, "Single device update requested: %s", msg->data.single_device.device_name);
+    const PayloadData *payload = payloadData(msg->payload);
+    if (payload) {
+        ESP_LOGI(TAG, "Single device update requested: %s", payload->names.device1_name);
+    }
 }
 
 static void handleBalanceDevices(const LVGLMessage_t *msg) {
-    const auto &data = msg->data.balance_devices;
-    ESP_LOGI(TAG, "Balance devices update requested: %s, %s", data.device1_name, data.device2_name);
+    const PayloadData *payload = payloadData(msg->payload);
+    if (payload) {
+        ESP_LOGI(TAG, "Balance devices update requested: %s, %s", payload->names.device1_name,
+                 payload->names.device2_name);
+    }
 }
 
 static void handleScreenChange(const LVGLMessage_t *msg) {
@@ -184,319 +313,372 @@ static void handleRequestData(const LVGLMessage_t *msg) {
     ESP_LOGI(TAG, "Data request triggered from UI");
 }
 
-static void handleShowStateOverview(const LVGLMessage_t *msg) {
-    ESP_LOGI(TAG, "Settings: Showing comprehensive system overview");
+// The overview is built on first open and afterwards only hidden and shown.
+// Each text label remembers the hash of the text it shows, so a refresh
+// writes (and invalidates) only the labels whose text changed.
+typedef enum {
+    OVERVIEW_SYSTEM,
+    OVERVIEW_NETWORK,
+    OVERVIEW_AUDIO,
+    OVERVIEW_LABEL_COUNT
+} OverviewLabel;
+
+struct OverviewText {
+    bool valid = false;
+    uint32_t hash = 0;
+};
+
+static OverviewText overviewText[OVERVIEW_LABEL_COUNT];
+static OverviewStats overviewStats;  // Written by the LVGL task only
+
+static bool isStateOverviewBuilt(void) {
+    return state_overlay && lv_obj_is_valid(state_overlay);
+}
 
-    // Clean up any existing overlay first
-    if (state_overlay && lv_obj_is_valid(state_overlay)) {
-        lv_obj_del(state_overlay);
-        state_overlay = NULL;
+static bool isStateOverviewShown(void) {
+    return isStateOverviewBuilt() && !lv_obj_has_flag(state_overlay, LV_OBJ_FLAG_HIDDEN);
+}
+
+static void setOverviewText(OverviewLabel field, lv_obj_t *label, const char *text) {
+    if (!label || !lv_obj_is_valid(label)) {
+        return;
+    }
+    OverviewText &shown = overviewText[field];
+    uint32_t hash = Hash::fnv1a(text, strlen(text));
+    if (shown.valid && shown.hash == hash) {
+        overviewStats.labelsUnchanged++;
+        return;
+    }
+    lv_label_set_text(label, text);
+    shown.valid = true;
+    shown.hash = hash;
+    overviewStats.labelWrites++;
+}
+
+static void buildStateOverview(lv_obj_t *currentScreen) {
+    // Create main overlay container - larger for comprehensive info
+    state_overlay = lv_obj_create(currentScreen);
+    lv_obj_set_size(state_overlay, 700, 450);
+    lv_obj_set_align(state_overlay, LV_ALIGN_CENTER);
+
+    // Style the overlay
+    lv_obj_set_style_bg_color(state_overlay, lv_color_hex(0x001122), LV_PART_MAIN);
+    lv_obj_set_style_bg_opa(state_overlay, 250, LV_PART_MAIN);
+    lv_obj_set_style_border_color(state_overlay, lv_color_hex(0x0088FF), LV_PART_MAIN);
+    lv_obj_set_style_border_width(state_overlay, 3, LV_PART_MAIN);
+    lv_obj_set_style_radius(state_overlay, 20, LV_PART_MAIN);
+    lv_obj_set_style_shadow_width(state_overlay, 30, LV_PART_MAIN);
+    lv_obj_set_style_shadow_opa(state_overlay, 150, LV_PART_MAIN);
+
+    // Create title label
+    lv_obj_t *title_label = lv_label_create(state_overlay);
+    lv_label_set_text(title_label, "SYSTEM OVERVIEW");
+    lv_obj_set_align(title_label, LV_ALIGN_TOP_MID);
+    lv_obj_set_y(title_label, 15);
+    lv_obj_set_style_text_color(title_label, lv_color_hex(0x00CCFF), LV_PART_MAIN);
+    lv_obj_set_style_text_font(title_label, &lv_font_montserrat_16, LV_PART_MAIN);
+
+    // Create close button
+    lv_obj_t *close_btn = lv_btn_create(state_overlay);
+    lv_obj_set_size(close_btn, 70, 35);
+    lv_obj_set_align(close_btn, LV_ALIGN_TOP_RIGHT);
+    lv_obj_set_pos(close_btn, -15, 10);
+    lv_obj_set_style_bg_color(close_btn, lv_color_hex(0xFF3333), LV_PART_MAIN);
+
+    lv_obj_t *close_label = lv_label_create(close_btn);
+    lv_label_set_text(close_label, "CLOSE");
+    lv_obj_center(close_label);
+    lv_obj_set_style_text_color(close_label, lv_color_white(), LV_PART_MAIN);
+
+    // Add click event to close button
+    lv_obj_add_event_cb(close_btn, [](lv_event_t *e) {
+        if (lv_event_get_code(e) == LV_EVENT_CLICKED) {
+            hideStateOverview();
+        } }, LV_EVENT_CLICKED, NULL);
+
+    // Create three-column layout
+    lv_obj_t *main_container = lv_obj_create(state_overlay);
+    lv_obj_remove_style_all(main_container);
+    lv_obj_set_size(main_container, 670, 350);
+    lv_obj_set_align(main_container, LV_ALIGN_CENTER);
+    lv_obj_set_y(main_container, 15);
+    lv_obj_set_flex_flow(main_container, LV_FLEX_FLOW_ROW);
+    lv_obj_set_flex_align(main_container, LV_FLEX_ALIGN_SPACE_BETWEEN, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_START);
+
+    // Left Column - System Information
+    lv_obj_t *left_col = lv_obj_create(main_container);
+    lv_obj_set_size(left_col, 200, 340);
+    lv_obj_set_style_bg_color(left_col, lv_color_hex(0x002244), LV_PART_MAIN);
+    lv_obj_set_style_border_width(left_col, 1, LV_PART_MAIN);
+    lv_obj_set_style_border_color(left_col, lv_color_hex(0x0066AA), LV_PART_MAIN);
+    lv_obj_set_style_radius(left_col, 10, LV_PART_MAIN);
+
+    lv_obj_t *sys_title = lv_label_create(left_col);
+    lv_label_set_text(sys_title, "SYSTEM");
+    lv_obj_set_align(sys_title, LV_ALIGN_TOP_MID);
+    lv_obj_set_y(sys_title, 10);
+    lv_obj_set_style_text_color(sys_title, lv_color_hex(0x00FF88), LV_PART_MAIN);
+    lv_obj_set_style_text_font(sys_title, &lv_font_montserrat_14, LV_PART_MAIN);
+
+    state_system_label = lv_label_create(left_col);
+    lv_obj_set_align(state_system_label, LV_ALIGN_TOP_LEFT);
+    lv_obj_set_pos(state_system_label, 10, 40);
+    lv_obj_set_size(state_system_label, 180, 280);
+    lv_obj_set_style_text_color(state_system_label, lv_color_white(), LV_PART_MAIN);
+    lv_obj_set_style_text_font(state_system_label, &lv_font_montserrat_12, LV_PART_MAIN);
+    lv_label_set_long_mode(state_system_label, LV_LABEL_LONG_WRAP);
+
+    // Middle Column - Network & Connectivity
+    lv_obj_t *mid_col = lv_obj_create(main_container);
+    lv_obj_set_size(mid_col, 200, 340);
+    lv_obj_set_style_bg_color(mid_col, lv_color_hex(0x002244), LV_PART_MAIN);
+    lv_obj_set_style_border_width(mid_col, 1, LV_PART_MAIN);
+    lv_obj_set_style_border_color(mid_col, lv_color_hex(0x0066AA), LV_PART_MAIN);
+    lv_obj_set_style_radius(mid_col, 10, LV_PART_MAIN);
+
+    lv_obj_t *net_title = lv_label_create(mid_col);
+    lv_label_set_text(net_title, "NETWORK");
+    lv_obj_set_align(net_title, LV_ALIGN_TOP_MID);
+    lv_obj_set_y(net_title, 10);
+    lv_obj_set_style_text_color(net_title, lv_color_hex(0x00FF88), LV_PART_MAIN);
+    lv_obj_set_style_text_font(net_title, &lv_font_montserrat_14, LV_PART_MAIN);
+
+    state_network_label = lv_label_create(mid_col);
+    lv_obj_set_align(state_network_label, LV_ALIGN_TOP_LEFT);
+    lv_obj_set_pos(state_network_label, 10, 40);
+    lv_obj_set_size(state_network_label, 180, 280);
+    lv_obj_set_style_text_color(state_network_label, lv_color_white(), LV_PART_MAIN);
+    lv_obj_set_style_text_font(state_network_label, &lv_font_montserrat_12, LV_PART_MAIN);
+    lv_label_set_long_mode(state_network_label, LV_LABEL_LONG_WRAP);
+
+    // Right Column - Audio & Actions
+    lv_obj_t *right_col = lv_obj_create(main_container);
+    lv_obj_set_size(right_col, 240, 340);
+    lv_obj_set_style_bg_color(right_col, lv_color_hex(0x002244), LV_PART_MAIN);
+    lv_obj_set_style_border_width(right_col, 1, LV_PART_MAIN);
+    lv_obj_set_style_border_color(right_col, lv_color_hex(0x0066AA), LV_PART_MAIN);
+    lv_obj_set_style_radius(right_col, 10, LV_PART_MAIN);
+
+    lv_obj_t *audio_title = lv_label_create(right_col);
+    lv_label_set_text(audio_title, "AUDIO & ACTIONS");
+    lv_obj_set_align(audio_title, LV_ALIGN_TOP_MID);
+    lv_obj_set_y(audio_title, 10);
+    lv_obj_set_style_text_color(audio_title, lv_color_hex(0x00FF88), LV_PART_MAIN);
+    lv_obj_set_style_text_font(audio_title, &lv_font_montserrat_14, LV_PART_MAIN);
+
+    state_audio_label = lv_label_create(right_col);
+    lv_obj_set_align(state_audio_label, LV_ALIGN_TOP_LEFT);
+    lv_obj_set_pos(state_audio_label, 10, 40);
+    lv_obj_set_size(state_audio_label, 220, 150);  // Reduced to make room for 4 buttons
+    lv_obj_set_style_text_color(state_audio_label, lv_color_white(), LV_PART_MAIN);
+    lv_obj_set_style_text_font(state_audio_label, &lv_font_montserrat_12, LV_PART_MAIN);
+    lv_label_set_long_mode(state_audio_label, LV_LABEL_LONG_WRAP);
+
+    // Action buttons in right column (expanded for 4 buttons)
+    lv_obj_t *actions_container = lv_obj_create(right_col);
+    lv_obj_remove_style_all(actions_container);
+    lv_obj_set_size(actions_container, 220, 140);  // Increased height for 4 buttons
+    lv_obj_set_align(actions_container, LV_ALIGN_BOTTOM_MID);
+    lv_obj_set_y(actions_container, -10);
+    lv_obj_set_flex_flow(actions_container, LV_FLEX_FLOW_COLUMN);
+    lv_obj_set_flex_align(actions_container, LV_FLEX_ALIGN_SPACE_EVENLY, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
+
+    // FORMAT SD button
+    lv_obj_t *format_sd_btn = lv_btn_create(actions_container);
+    lv_obj_set_size(format_sd_btn, 200, 32);  // Standardized for 4 buttons
+    lv_obj_set_style_bg_color(format_sd_btn, lv_color_hex(0xFF6600), LV_PART_MAIN);
+
+    lv_obj_t *format_label = lv_label_create(format_sd_btn);
+    lv_label_set_text(format_label, "FORMAT SD CARD");
+    lv_obj_center(format_label);
+    lv_obj_set_style_text_color(format_label, lv_color_white(), LV_PART_MAIN);
+    lv_obj_set_style_text_font(format_label, &lv_font_montserrat_12, LV_PART_MAIN);
+
+    lv_obj_add_event_cb(format_sd_btn, [](lv_event_t *e) {
+        if (lv_event_get_code(e) == LV_EVENT_CLICKED) {
+            ESP_LOGI(TAG, "FORMAT SD button clicked");
+            requestSDFormat();
+        } }, LV_EVENT_CLICKED, NULL);
+
+    // Restart button
+    lv_obj_t *restart_btn = lv_btn_create(actions_container);
+    lv_obj_set_size(restart_btn, 200, 32);  // Standardized for 4 buttons
+    lv_obj_set_style_bg_color(restart_btn, lv_color_hex(0xFF3366), LV_PART_MAIN);
+
+    lv_obj_t *restart_label = lv_label_create(restart_btn);
+    lv_label_set_text(restart_label, "RESTART SYSTEM");
+    lv_obj_center(restart_label);
+    lv_obj_set_style_text_color(restart_label, lv_color_white(), LV_PART_MAIN);
+    lv_obj_set_style_text_font(restart_label, &lv_font_montserrat_12, LV_PART_MAIN);
+
+    lv_obj_add_event_cb(restart_btn, [](lv_event_t *e) {
+        if (lv_event_get_code(e) == LV_EVENT_CLICKED) {
+            ESP_LOGI(TAG, "RESTART button clicked - restarting in 2 seconds");
+            hideStateOverview();
+            vTaskDelay(pdMS_TO_TICKS(2000));
+            esp_restart();
+        } }, LV_EVENT_CLICKED, NULL);
+
+    // Refresh button
+    lv_obj_t *refresh_btn = lv_btn_create(actions_container);
+    lv_obj_set_size(refresh_btn, 200, 32);  // Standardized for 4 buttons
+    lv_obj_set_style_bg_color(refresh_btn, lv_color_hex(0x00AA66), LV_PART_MAIN);
+
+    lv_obj_t *refresh_label = lv_label_create(refresh_btn);
+    lv_label_set_text(refresh_label, "REFRESH DATA");
+    lv_obj_center(refresh_label);
+    lv_obj_set_style_text_color(refresh_label, lv_color_white(), LV_PART_MAIN);
+    lv_obj_set_style_text_font(refresh_label, &lv_font_montserrat_12, LV_PART_MAIN);
+
+    lv_obj_add_event_cb(refresh_btn, [](lv_event_t *e) {
+        if (lv_event_get_code(e) == LV_EVENT_CLICKED) {
+            ESP_LOGI(TAG, "REFRESH button clicked - updating overview");
+            updateStateOverview();
+        } }, LV_EVENT_CLICKED, NULL);
+
+    for (OverviewText &shown : overviewText) {
+        shown.valid = false;
     }
+}
 
-    // Create the comprehensive system overview overlay
+static void handleShowStateOverview(const LVGLMessage_t *msg) {
     lv_obj_t *currentScreen = lv_scr_act();
-    if (currentScreen) {
-        // Create main overlay container - larger for comprehensive info
-        state_overlay = lv_obj_create(currentScreen);
-        lv_obj_set_size(state_overlay, 700, 450);
-        lv_obj_set_align(state_overlay, LV_ALIGN_CENTER);
-
-        // Style the overlay
-        lv_obj_set_style_bg_color(state_overlay, lv_color_hex(0x001122), LV_PART_MAIN);
-        lv_obj_set_style_bg_opa(state_overlay, 250, LV_PART_MAIN);
-        lv_obj_set_style_border_color(state_overlay, lv_color_hex(0x0088FF), LV_PART_MAIN);
-        lv_obj_set_style_border_width(state_overlay, 3, LV_PART_MAIN);
-        lv_obj_set_style_radius(state_overlay, 20, LV_PART_MAIN);
-        lv_obj_set_style_shadow_width(state_overlay, 30, LV_PART_MAIN);
-        lv_obj_set_style_shadow_opa(state_overlay, 150, LV_PART_MAIN);
-
-        // Create title label
-        lv_obj_t *title_label = lv_label_create(state_overlay);
-        lv_label_set_text(title_label, "SYSTEM OVERVIEW");
-        lv_obj_set_align(title_label, LV_ALIGN_TOP_MID);
-        lv_obj_set_y(title_label, 15);
-        lv_obj_set_style_text_color(title_label, lv_color_hex(0x00CCFF), LV_PART_MAIN);
-        lv_obj_set_style_text_font(title_label, &lv_font_montserrat_16, LV_PART_MAIN);
-
-        // Create close button
-        lv_obj_t *close_btn = lv_btn_create(state_overlay);
-        lv_obj_set_size(close_btn, 70, 35);
-        lv_obj_set_align(close_btn, LV_ALIGN_TOP_RIGHT);
-        lv_obj_set_pos(close_btn, -15, 10);
-        lv_obj_set_style_bg_color(close_btn, lv_color_hex(0xFF3333), LV_PART_MAIN);
-
-        lv_obj_t *close_label = lv_label_create(close_btn);
-        lv_label_set_text(close_label, "CLOSE");
-        lv_obj_center(close_label);
-        lv_obj_set_style_text_color(close_label, lv_color_white(), LV_PART_MAIN);
-
-        // Add click event to close button
-        lv_obj_add_event_cb(close_btn, [](lv_event_t *e) {
-            if (lv_event_get_code(e) == LV_EVENT_CLICKED) {
-                hideStateOverview();
-            } }, LV_EVENT_CLICKED, NULL);
-
-        // Create three-column layout
-        lv_obj_t *main_container = lv_obj_create(state_overlay);
-        lv_obj_remove_style_all(main_container);
-        lv_obj_set_size(main_container, 670, 350);
-        lv_obj_set_align(main_container, LV_ALIGN_CENTER);
-        lv_obj_set_y(main_container, 15);
-        lv_obj_set_flex_flow(main_container, LV_FLEX_FLOW_ROW);
-        lv_obj_set_flex_align(main_container, LV_FLEX_ALIGN_SPACE_BETWEEN, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_START);
-
-        // Left Column - System Information
-        lv_obj_t *left_col = lv_obj_create(main_container);
-        lv_obj_set_size(left_col, 200, 340);
-        lv_obj_set_style_bg_color(left_col, lv_color_hex(0x002244), LV_PART_MAIN);
-        lv_obj_set_style_border_width(left_col, 1, LV_PART_MAIN);
-        lv_obj_set_style_border_color(left_col, lv_color_hex(0x0066AA), LV_PART_MAIN);
-        lv_obj_set_style_radius(left_col, 10, LV_PART_MAIN);
-
-        lv_obj_t *sys_title = lv_label_create(left_col);
-        lv_label_set_text(sys_title, "SYSTEM");
-        lv_obj_set_align(sys_title, LV_ALIGN_TOP_MID);
-        lv_obj_set_y(sys_title, 10);
-        lv_obj_set_style_text_color(sys_title, lv_color_hex(0x00FF88), LV_PART_MAIN);
-        lv_obj_set_style_text_font(sys_title, &lv_font_montserrat_14, LV_PART_MAIN);
-
-        state_system_label = lv_label_create(left_col);
-        lv_obj_set_align(state_system_label, LV_ALIGN_TOP_LEFT);
-        lv_obj_set_pos(state_system_label, 10, 40);
-        lv_obj_set_size(state_system_label, 180, 280);
-        lv_obj_set_style_text_color(state_system_label, lv_color_white(), LV_PART_MAIN);
-        lv_obj_set_style_text_font(state_system_label, &lv_font_montserrat_12, LV_PART_MAIN);
-        lv_label_set_long_mode(state_system_label, LV_LABEL_LONG_WRAP);
-
-        // Middle Column - Network & Connectivity
-        lv_obj_t *mid_col = lv_obj_create(main_container);
-        lv_obj_set_size(mid_col, 200, 340);
-        lv_obj_set_style_bg_color(mid_col, lv_color_hex(0x002244), LV_PART_MAIN);
-        lv_obj_set_style_border_width(mid_col, 1, LV_PART_MAIN);
-        lv_obj_set_style_border_color(mid_col, lv_color_hex(0x0066AA), LV_PART_MAIN);
-        lv_obj_set_style_radius(mid_col, 10, LV_PART_MAIN);
-
-        lv_obj_t *net_title = lv_label_create(mid_col);
-        lv_label_set_text(net_title, "NETWORK");
-        lv_obj_set_align(net_title, LV_ALIGN_TOP_MID);
-        lv_obj_set_y(net_title, 10);
-        lv_obj_set_style_text_color(net_title, lv_color_hex(0x00FF88), LV_PART_MAIN);
-        lv_obj_set_style_text_font(net_title, &lv_font_montserrat_14, LV_PART_MAIN);
-
-        state_network_label = lv_label_create(mid_col);
-        lv_obj_set_align(state_network_label, LV_ALIGN_TOP_LEFT);
-        lv_obj_set_pos(state_network_label, 10, 40);
-        lv_obj_set_size(state_network_label, 180, 280);
-        lv_obj_set_style_text_color(state_network_label, lv_color_white(), LV_PART_MAIN);
-        lv_obj_set_style_text_font(state_network_label, &lv_font_montserrat_12, LV_PART_MAIN);
-        lv_label_set_long_mode(state_network_label, LV_LABEL_LONG_WRAP);
-
-        // Right Column - Audio & Actions
-        lv_obj_t *right_col = lv_obj_create(main_container);
-        lv_obj_set_size(right_col, 240, 340);
-        lv_obj_set_style_bg_color(right_col, lv_color_hex(0x002244), LV_PART_MAIN);
-        lv_obj_set_style_border_width(right_col, 1, LV_PART_MAIN);
-        lv_obj_set_style_border_color(right_col, lv_color_hex(0x0066AA), LV_PART_MAIN);
-        lv_obj_set_style_radius(right_col, 10, LV_PART_MAIN);
-
-        lv_obj_t *audio_title = lv_label_create(right_col);
-        lv_label_set_text(audio_title, "AUDIO & ACTIONS");
-        lv_obj_set_align(audio_title, LV_ALIGN_TOP_MID);
-        lv_obj_set_y(audio_title, 10);
-        lv_obj_set_style_text_color(audio_title, lv_color_hex(0x00FF88), LV_PART_MAIN);
-        lv_obj_set_style_text_font(audio_title, &lv_font_montserrat_14, LV_PART_MAIN);
-
-        state_audio_label = lv_label_create(right_col);
-        lv_obj_set_align(state_audio_label, LV_ALIGN_TOP_LEFT);
-        lv_obj_set_pos(state_audio_label, 10, 40);
-        lv_obj_set_size(state_audio_label, 220, 150);  // Reduced to make room for 4 buttons
-        lv_obj_set_style_text_color(state_audio_label, lv_color_white(), LV_PART_MAIN);
-        lv_obj_set_style_text_font(state_audio_label, &lv_font_montserrat_12, LV_PART_MAIN);
-        lv_label_set_long_mode(state_audio_label, LV_LABEL_LONG_WRAP);
-
-        // Action buttons in right column (expanded for 4 buttons)
-        lv_obj_t *actions_container = lv_obj_create(right_col);
-        lv_obj_remove_style_all(actions_container);
-        lv_obj_set_size(actions_container, 220, 140);  // Increased height for 4 buttons
-        lv_obj_set_align(actions_container, LV_ALIGN_BOTTOM_MID);
-        lv_obj_set_y(actions_container, -10);
-        lv_obj_set_flex_flow(actions_container, LV_FLEX_FLOW_COLUMN);
-        lv_obj_set_flex_align(actions_container, LV_FLEX_ALIGN_SPACE_EVENLY, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
-
-        // FORMAT SD button
-        lv_obj_t *format_sd_btn = lv_btn_create(actions_container);
-        lv_obj_set_size(format_sd_btn, 200, 32);  // Standardized for 4 buttons
-        lv_obj_set_style_bg_color(format_sd_btn, lv_color_hex(0xFF6600), LV_PART_MAIN);
-
-        lv_obj_t *format_label = lv_label_create(format_sd_btn);
-        lv_label_set_text(format_label, "FORMAT SD CARD");
-        lv_obj_center(format_label);
-        lv_obj_set_style_text_color(format_label, lv_color_white(), LV_PART_MAIN);
-        lv_obj_set_style_text_font(format_label, &lv_font_montserrat_12, LV_PART_MAIN);
-
-        lv_obj_add_event_cb(format_sd_btn, [](lv_event_t *e) {
-            if (lv_event_get_code(e) == LV_EVENT_CLICKED) {
-                ESP_LOGI(TAG, "FORMAT SD button clicked");
-                requestSDFormat();
-            } }, LV_EVENT_CLICKED, NULL);
-
-        // Restart button
-        lv_obj_t *restart_btn = lv_btn_create(actions_container);
-        lv_obj_set_size(restart_btn, 200, 32);  // Standardized for 4 buttons
-        lv_obj_set_style_bg_color(restart_btn, lv_color_hex(0xFF3366), LV_PART_MAIN);
-
-        lv_obj_t *restart_label = lv_label_create(restart_btn);
-        lv_label_set_text(restart_label, "RESTART SYSTEM");
-        lv_obj_center(restart_label);
-        lv_obj_set_style_text_color(restart_label, lv_color_white(), LV_PART_MAIN);
-        lv_obj_set_style_text_font(restart_label, &lv_font_montserrat_12, LV_PART_MAIN);
-
-        lv_obj_add_event_cb(restart_btn, [](lv_event_t *e) {
-            if (lv_event_get_code(e) == LV_EVENT_CLICKED) {
-                ESP_LOGI(TAG, "RESTART button clicked - restarting in 2 seconds");
-                hideStateOverview();
-                vTaskDelay(pdMS_TO_TICKS(2000));
-                esp_restart();
-            } }, LV_EVENT_CLICKED, NULL);
-
-        // Refresh button
-        lv_obj_t *refresh_btn = lv_btn_create(actions_container);
-        lv_obj_set_size(refresh_btn, 200, 32);  // Standardized for 4 buttons
-        lv_obj_set_style_bg_color(refresh_btn, lv_color_hex(0x00AA66), LV_PART_MAIN);
-
-        lv_obj_t *refresh_label = lv_label_create(refresh_btn);
-        lv_label_set_text(refresh_label, "REFRESH DATA");
-        lv_obj_center(refresh_label);
-        lv_obj_set_style_text_color(refresh_label, lv_color_white(), LV_PART_MAIN);
-        lv_obj_set_style_text_font(refresh_label, &lv_font_montserrat_12, LV_PART_MAIN);
-
-        lv_obj_add_event_cb(refresh_btn, [](lv_event_t *e) {
-            if (lv_event_get_code(e) == LV_EVENT_CLICKED) {
-                ESP_LOGI(TAG, "REFRESH button clicked - updating overview");
-                updateStateOverview();
-            } }, LV_EVENT_CLICKED, NULL);
-
-        ESP_LOGI(TAG, "Settings: Comprehensive system overview created successfully");
-
-        // Trigger immediate update of the state data
-        updateStateOverview();
-    } else {
+    if (!currentScreen) {
         ESP_LOGE(TAG, "Settings: No current screen available for state overlay");
+        return;
     }
+
+    int64_t startUs = esp_timer_get_time();
+    bool build = !isStateOverviewBuilt();
+    if (build) {
+        buildStateOverview(currentScreen);
+    } else if (lv_obj_get_parent(state_overlay) != currentScreen) {
+        lv_obj_set_parent(state_overlay, currentScreen);
+    }
+    lv_obj_move_foreground(state_overlay);
+    lv_obj_remove_flag(state_overlay, LV_OBJ_FLAG_HIDDEN);
+    uint32_t openUs = (uint32_t)(esp_timer_get_time() - startUs);
+
+    if (build) {
+        overviewStats.builds++;
+        overviewStats.buildUs = openUs;
+    } else {
+        overviewStats.reopens++;
+        overviewStats.reopenUs += openUs;
+        if (openUs > overviewStats.maxReopenUs) {
+            overviewStats.maxReopenUs = openUs;
+        }
+    }
+    ESP_LOGI(TAG, "Settings: System overview %s in %lu us", build ? "built" : "shown",
+             (unsigned long)openUs);
+
+    // Trigger immediate update of the state data
+    updateStateOverview();
 }
 
 static void handleUpdateStateOverview(const LVGLMessage_t *msg) {
-    if (!state_overlay || !lv_obj_is_valid(state_overlay)) {
-        ESP_LOGW(TAG, "Settings: Update requested but no state overlay exists");
+    // A hidden overview is brought up to date when it is shown again
+    if (!isStateOverviewShown()) {
+        ESP_LOGD(TAG, "Settings: Update ignored, state overlay not shown");
+        return;
+    }
+    const PayloadData *payload = payloadData(msg->payload);
+    if (!payload) {
         return;
     }
 
-    const auto &data = msg->data.state_overview;
-    ESP_LOGI(TAG, "Settings: Updating state overview with current system data");
+    const StateOverviewPayload &data = payload->overview;
+    static char text[512];
+    overviewStats.refreshes++;
 
     // Update system information
-    if (state_system_label && lv_obj_is_valid(state_system_label)) {
-        static char system_text[512];
-        uint32_t uptimeMinutes = data.uptime_ms / 60000;
-        uint32_t uptimeHours = uptimeMinutes / 60;
-        uint32_t uptime_display_min = uptimeMinutes % 60;
-
-        snprintf(system_text, sizeof(system_text),
-                 "Memory:\n"
-                 "  Free Heap: %u KB\n"
-                 "  Free PSRAM: %u KB\n\n"
-                 "Performance:\n"
-                 "  CPU Freq: %u MHz\n"
-                 "  Uptime: %uh %um\n\n"
-                 "Storage:\n"
-                 "  SD Card Status: Available\n"
-                 "  Format Support: Yes\n\n"
-                 "Hardware:\n"
-                 "  Touch: Responsive\n"
-                 "  Display: Active",
-                 data.free_heap / 1024,
-                 data.free_psram / 1024,
-                 data.cpu_freq,
-                 uptimeHours, uptime_display_min);
-        lv_label_set_text(state_system_label, system_text);
-    }
+    uint32_t uptimeMinutes = data.uptime_ms / 60000;
+    uint32_t uptimeHours = uptimeMinutes / 60;
+    uint32_t uptime_display_min = uptimeMinutes % 60;
+
+    snprintf(text, sizeof(text),
+             "Memory:\n"
+             "  Free Heap: %u KB\n"
+             "  Free PSRAM: %u KB\n\n"
+             "Performance:\n"
+             "  CPU Freq: %u MHz\n"
+             "  Uptime: %uh %um\n\n"
+             "Storage:\n"
+             "  SD Card Status: Available\n"
+             "  Format Support: Yes\n\n"
+             "Hardware:\n"
+             "  Touch: Responsive\n"
+             "  Display: Active",
+             data.free_heap / 1024,
+             data.free_psram / 1024,
+             data.cpu_freq,
+             uptimeHours, uptime_display_min);
+    setOverviewText(OVERVIEW_SYSTEM, state_system_label, text);
 
     // Update network information
-    if (state_network_label && lv_obj_is_valid(state_network_label)) {
-        static char network_text[512];
-        const char *signal_strength = "Unknown";
-        if (data.wifi_rssi > -50)
-            signal_strength = "Excellent";
-        else if (data.wifi_rssi > -60)
-            signal_strength = "Good";
-        else if (data.wifi_rssi > -70)
-            signal_strength = "Fair";
-        else if (data.wifi_rssi > -80)
-            signal_strength = "Poor";
-        else
-            signal_strength = "Very Poor";
-
-        snprintf(network_text, sizeof(network_text),
-                 "WiFi Connection:\n"
-                 "  Status: %s\n"
-                 "  Signal: %s\n"
-                 "  RSSI: %d dBm\n\n"
-                 "Network:\n"
-                 "  IP Address: %s\n\n"
-                 "Services:\n"
-                 "  Serial: Active\n"
-                 "  Network: Not Available\n\n"
-                 "Protocol:\n"
-                 "  Message Bus: Active\n"
-                 "  Audio Streaming: OK",
-                 data.wifi_status, signal_strength, data.wifi_rssi,
-                 data.ip_address);
-        lv_label_set_text(state_network_label, network_text);
-    }
+    const char *signal_strength = "Unknown";
+    if (data.wifi_rssi > -50)
+        signal_strength = "Excellent";
+    else if (data.wifi_rssi > -60)
+        signal_strength = "Good";
+    else if (data.wifi_rssi > -70)
+        signal_strength = "Fair";
+    else if (data.wifi_rssi > -80)
+        signal_strength = "Poor";
+    else
+        signal_strength = "Very Poor";
+
+    snprintf(text, sizeof(text),
+             "WiFi Connection:\n"
+             "  Status: %s\n"
+             "  Signal: %s\n"
+             "  RSSI: %d dBm\n\n"
+             "Network:\n"
+             "  IP Address: %s\n\n"
+             "Services:\n"
+             "  Serial: Active\n"
+             "  Network: Not Available\n\n"
+             "Protocol:\n"
+             "  Message Bus: Active\n"
+             "  Audio Streaming: OK",
+             data.wifi_status, signal_strength, data.wifi_rssi,
+             data.ip_address);
+    setOverviewText(OVERVIEW_NETWORK, state_network_label, text);
 
     // Update audio information
-    if (state_audio_label && lv_obj_is_valid(state_audio_label)) {
-        static char audio_text[512];
-        const char *mute_indicator = data.main_device_muted ? " [MUTED]" : "";
-
-        snprintf(audio_text, sizeof(audio_text),
-                 "Current Tab: %s\n\n"
-                 "Primary Device:\n"
-                 "  Name: %s\n"
-                 "  Volume: %d%%%s\n\n"
-                 "Balance Mode:\n"
-                 "  Device 1: %s\n"
-                 "  Volume 1: %d%%%s\n"
-                 "  Device 2: %s\n"
-                 "  Volume 2: %d%%%s\n\n"
-                 "System Actions:\n"
-                 "  FORMAT SD: Erase all data\n"
-                 "  RESTART: Reboot device\n"
-                 "  REFRESH: Update info",
-                 data.current_tab,
-                 data.main_device, data.main_device_volume, mute_indicator,
-                 data.balance_device1, data.balance_device1_volume,
-                 data.balance_device1_muted ? " [MUTED]" : "",
-                 data.balance_device2, data.balance_device2_volume,
-                 data.balance_device2_muted ? " [MUTED]" : "");
-        lv_label_set_text(state_audio_label, audio_text);
-    }
-
-    ESP_LOGI(TAG, "Settings: State overview updated successfully");
+    const char *mute_indicator = data.main_device_muted ? " [MUTED]" : "";
+
+    snprintf(text, sizeof(text),
+             "Current Tab: %s\n\n"
+             "Primary Device:\n"
+             "  Name: %s\n"
+             "  Volume: %d%%%s\n\n"
+             "Balance Mode:\n"
+             "  Device 1: %s\n"
+             "  Volume 1: %d%%%s\n"
+             "  Device 2: %s\n"
+             "  Volume 2: %d%%%s\n\n"
+             "System Actions:\n"
+             "  FORMAT SD: Erase all data\n"
+             "  RESTART: Reboot device\n"
+             "  REFRESH: Update info",
+             data.current_tab,
+             data.main_device, data.main_device_volume, mute_indicator,
+             data.balance_device1, data.balance_device1_volume,
+             data.balance_device1_muted ? " [MUTED]" : "",
+             data.balance_device2, data.balance_device2_volume,
+             data.balance_device2_muted ? " [MUTED]" : "");
+    setOverviewText(OVERVIEW_AUDIO, state_audio_label, text);
 }
 
 static void handleHideStateOverview(const LVGLMessage_t *msg) {
     ESP_LOGI(TAG, "Settings: Hiding state overview overlay");
 
-    if (state_overlay && lv_obj_is_valid(state_overlay)) {
-        lv_obj_del(state_overlay);
-        state_overlay = NULL;
-        state_system_label = NULL;
-        state_network_label = NULL;
-        state_audio_label = NULL;
-        ESP_LOGI(TAG, "Settings: State overview overlay hidden successfully");
+    // Kept for the next open, which then only has to unhide it
+    if (isStateOverviewShown()) {
+        lv_obj_add_flag(state_overlay, LV_OBJ_FLAG_HIDDEN);
     } else {
-        ESP_LOGW(TAG, "Settings: Hide requested but no state overlay exists");
+        ESP_LOGW(TAG, "Settings: Hide requested but no state overlay shown");
     }
 }
 
@@ -549,17 +731,24 @@ static void handleFormatSDConfirm(const LVGLMessage_t *msg) {
     updateSDFormatProgress(5, "Starting format operation...");
 }
 
+static const char *formatText(const LVGLMessage_t *msg) {
+    const PayloadData *payload = payloadData(msg->payload);
+    return payload ? payload->text.text : "";
+}
+
 static void handleFormatSDProgress(const LVGLMessage_t *msg) {
     const auto &data = msg->data.sd_format;
-    ESP_LOGI(TAG, "SD Format: Progress update - %d%% - %s", data.progress, data.message);
+    const char *text = formatText(msg);
+    ESP_LOGI(TAG, "SD Format: Progress update - %d%% - %s", data.progress, text);
 
     // Update progress using Universal Dialog system
-    UI::Dialog::UniversalDialog::updateProgress(data.progress, data.message);
+    UI::Dialog::UniversalDialog::updateProgress(data.progress, text);
 }
 
 static void handleFormatSDComplete(const LVGLMessage_t *msg) {
     const auto &data = msg->data.sd_format;
-    ESP_LOGI(TAG, "SD Format: Complete - Success: %s - %s", data.success ? "YES" : "NO", data.message);
+    const char *text = formatText(msg);
+    ESP_LOGI(TAG, "SD Format: Complete - Success: %s - %s", data.success ? "YES" : "NO", text);
 
     // Close the progress dialog and show completion status
     UI::Dialog::UniversalDialog::closeDialog();
@@ -568,13 +757,13 @@ static void handleFormatSDComplete(const LVGLMessage_t *msg) {
     if (data.success) {
         UI::Dialog::UniversalDialog::showInfo(
             "Format Complete",
-            data.message,
+            text,
             nullptr,
             UI::Dialog::DialogSize::MEDIUM);
     } else {
         UI::Dialog::UniversalDialog::showError(
             "Format Failed",
-            data.message,
+            text,
             nullptr,
             UI::Dialog::DialogSize::MEDIUM);
     }
@@ -660,31 +849,69 @@ static void sdFormatTask(void *parameter) {
     vTaskDelete(NULL);
 }
 
-// PERFORMANCE: Initialize message handler mappings - single O(1) lookup
-static void initializeMessageHandlers() {
-    messageHandlers = {
-        {MSG_UPDATE_FPS_DISPLAY, handleFpsDisplay},
-        {MSG_UPDATE_BUILD_TIME_DISPLAY, handleBuildTimeDisplay},
-        {MSG_UPDATE_MASTER_VOLUME, handleMasterVolume},
-        {MSG_UPDATE_SINGLE_VOLUME, handleSingleVolume},
-        {MSG_UPDATE_BALANCE_VOLUME, handleBalanceVolume},
-        {MSG_UPDATE_MASTER_DEVICE, handleMasterDevice},
-
-        // Complex message handlers
-        {MSG_UPDATE_SINGLE_DEVICE, handleSingleDevice},
-        {MSG_UPDATE_BALANCE_DEVICES, handleBalanceDevices},
-        {MSG_SCREEN_CHANGE, handleScreenChange},
-        {MSG_REQUEST_DATA, handleRequestData},
-        {MSG_SHOW_STATE_OVERVIEW, handleShowStateOverview},
-        {MSG_UPDATE_STATE_OVERVIEW, handleUpdateStateOverview},
-        {MSG_HIDE_STATE_OVERVIEW, handleHideStateOverview},
-        {MSG_FORMAT_SD_REQUEST, handleFormatSDRequest},
-        {MSG_FORMAT_SD_CONFIRM, handleFormatSDConfirm},
-        {MSG_FORMAT_SD_PROGRESS, handleFormatSDProgress},
-        {MSG_FORMAT_SD_COMPLETE, handleFormatSDComplete},
-    };
+// =============================================================================
+// DISPATCH TABLE
+// =============================================================================
+
+struct HandlerEntry {
+    LVGLMessageType_t type;
+    MessageHandler handler;
+};
+
+// Every message type with its handler; MSG_UPDATE_SD_STATUS has no widget yet
+static constexpr HandlerEntry handlerEntries[] = {
+    {MSG_UPDATE_FPS_DISPLAY, handleFpsDisplay},
+    {MSG_UPDATE_BUILD_TIME_DISPLAY, handleBuildTimeDisplay},
+    {MSG_SCREEN_CHANGE, handleScreenChange},
+    {MSG_REQUEST_DATA, handleRequestData},
+    {MSG_UPDATE_MASTER_VOLUME, handleMasterVolume},
+    {MSG_UPDATE_SINGLE_VOLUME, handleSingleVolume},
+    {MSG_UPDATE_BALANCE_VOLUME, handleBalanceVolume},
+    {MSG_UPDATE_MASTER_DEVICE, handleMasterDevice},
+    {MSG_UPDATE_SINGLE_DEVICE, handleSingleDevice},
+    {MSG_UPDATE_BALANCE_DEVICES, handleBalanceDevices},
+    {MSG_SHOW_STATE_OVERVIEW, handleShowStateOverview},
+    {MSG_UPDATE_STATE_OVERVIEW, handleUpdateStateOverview},
+    {MSG_HIDE_STATE_OVERVIEW, handleHideStateOverview},
+    {MSG_UPDATE_SD_STATUS, nullptr},
+    {MSG_FORMAT_SD_REQUEST, handleFormatSDRequest},
+    {MSG_FORMAT_SD_CONFIRM, handleFormatSDConfirm},
+    {MSG_FORMAT_SD_PROGRESS, handleFormatSDProgress},
+    {MSG_FORMAT_SD_COMPLETE, handleFormatSDComplete},
+};
+
+// True if every message type is listed exactly once
+static constexpr bool coversEveryType() {
+    int seen[NUM_OF_MSGS] = {};
+    for (const HandlerEntry &entry : handlerEntries) {
+        if (entry.type >= NUM_OF_MSGS || seen[entry.type]++) {
+            return false;
+        }
+    }
+    for (int count : seen) {
+        if (count != 1) {
+            return false;
+        }
+    }
+    return true;
+}
+static_assert(coversEveryType(), "handlerEntries must list every LVGLMessageType_t exactly once");
+
+struct HandlerTable {
+    MessageHandler handlers[NUM_OF_MSGS];
+};
+
+static constexpr HandlerTable buildHandlerTable() {
+    HandlerTable table = {};
+    for (const HandlerEntry &entry : handlerEntries) {
+        table.handlers[entry.type] = entry.handler;
+    }
+    return table;
 }
 
+// PERFORMANCE: Indexed by LVGLMessageType_t, one load and an indirect call
+static constexpr HandlerTable messageHandlers = buildHandlerTable();
+
 // Queue handle
 QueueHandle_t lvglMessageQueue = NULL;
 
@@ -694,9 +921,6 @@ QueueHandle_t lvglMessageQueue = NULL;
 bool init(void) {
     ESP_LOGI(TAG, "Initializing LVGL Message Handler");
 
-    // PERFORMANCE: Initialize message handler mappings
-    initializeMessageHandlers();
-
     // Create message queue
     lvglMessageQueue =
         xQueueCreate(LVGL_MESSAGE_QUEUE_SIZE, sizeof(LVGLMessage_t));
@@ -741,21 +965,138 @@ void deinit(void) {
     }
 }
 
+// Takes over the message's payload: released here if the message is dropped
 bool sendMessage(const LVGLMessage_t *message) {
-    if (lvglMessageQueue == NULL || message == NULL) {
+    if (message == NULL || message->type >= NUM_OF_MSGS) {
+        return false;
+    }
+    if (isMailboxType(message->type)) {
+        postToMailbox(message);
+        return true;
+    }
+    if (lvglMessageQueue == NULL) {
+        releasePayload(message->payload);
         return false;
     }
 
     // Send message with no blocking (timeout = 0)
-    if (xQueueSend(lvglMessageQueue, message, 0) != pdTRUE) {
+    bool queued = xQueueSend(lvglMessageQueue, message, 0) == pdTRUE;
+    portENTER_CRITICAL(&poolLock);
+    if (queued) {
+        stats.sent++;
+    } else {
+        stats.dropped++;
+    }
+    portEXIT_CRITICAL(&poolLock);
+
+    if (!queued) {
         ESP_LOGW(TAG, "Message queue full, dropping message type %d",
                  message->type);
+        releasePayload(message->payload);
         return false;
     }
-
     return true;
 }
 
+QueueStats getStats(void) {
+    portENTER_CRITICAL(&poolLock);
+    QueueStats copy = stats;
+    portEXIT_CRITICAL(&poolLock);
+    return copy;
+}
+
+HandlerTiming getHandlerTiming(LVGLMessageType_t type) {
+    HandlerTiming copy;
+    if ((unsigned)type >= NUM_OF_MSGS) {
+        return copy;
+    }
+    portENTER_CRITICAL(&poolLock);
+    copy = handlerTimings[type];
+    portEXIT_CRITICAL(&poolLock);
+    return copy;
+}
+
+OverviewStats getOverviewStats(void) {
+    return overviewStats;
+}
+
+String getStatus(void) {
+    QueueStats copy = getStats();
+    int slotsInUse = 0;
+    portENTER_CRITICAL(&poolLock);
+    for (const PayloadSlot &slot : payloadSlots) {
+        slotsInUse += slot.used;
+    }
+    portEXIT_CRITICAL(&poolLock);
+
+    uint32_t average = copy.processed ? (uint32_t)(copy.processingUs / copy.processed) : 0;
+    String status = "LVGL Messages:\n";
+    status += "- Queue " + String(LVGL_MESSAGE_QUEUE_SIZE) + " x " +
+              String((unsigned)sizeof(LVGLMessage_t)) + " B = " +
+              String((unsigned)(LVGL_MESSAGE_QUEUE_SIZE * sizeof(LVGLMessage_t))) +
+              " B, payload pool " + String(LVGL_PAYLOAD_POOL_SIZE) + " x " +
+              String((unsigned)sizeof(PayloadSlot)) + " B (" + String(slotsInUse) +
+              " in use)\n";
+    status += "- Copied per message: " + String((unsigned)(2 * sizeof(LVGLMessage_t))) +
+              " B (payloads are written once and read in place)\n";
+    status += "- Sent " + String(copy.sent) + ", dropped " + String(copy.dropped) +
+              ", pool exhausted " + String(copy.poolExhausted) + "\n";
+    status += "- Mailboxes: " + String(copy.mailboxDelivered) + " rendered, " +
+              String(copy.coalesced) + " coalesced (overwritten before render)\n";
+    status += "- Processing avg " + String(average) + " us max " +
+              String(copy.maxProcessingUs) + " us per message (" +
+              String(copy.processed) + " handled)\n";
+    for (int type = 0; type < NUM_OF_MSGS; type++) {
+        HandlerTiming timing = getHandlerTiming((LVGLMessageType_t)type);
+        if (timing.count == 0) {
+            continue;
+        }
+        status += "  " + String(getMessageTypeName(type)) + ": " + String(timing.count) +
+                  " x avg " + String((uint32_t)(timing.totalUs / timing.count)) +
+                  " us max " + String(timing.maxUs) + " us\n";
+    }
+
+    OverviewStats overview = getOverviewStats();
+    uint32_t averageReopen = overview.reopens ? overview.reopenUs / overview.reopens : 0;
+    status += "- State overview: built " + String(overview.builds) + " x (" +
+              String(overview.buildUs) + " us), reopened " + String(overview.reopens) +
+              " x avg " + String(averageReopen) + " us max " +
+              String(overview.maxReopenUs) + " us\n";
+    status += "- State overview refreshes " + String(overview.refreshes) + ": " +
+              String(overview.labelWrites) + " label writes, " +
+              String(overview.labelsUnchanged) + " unchanged\n";
+    return status;
+}
+
+// Run one message's handler, then release its payload
+static void dispatchMessage(const LVGLMessage_t *message) {
+    int64_t handlerStart = esp_timer_get_time();
+
+    // sendMessage only accepts types below NUM_OF_MSGS
+    MessageHandler handler = messageHandlers.handlers[message->type];
+    if (handler) {
+        handler(message);
+    } else {
+        ESP_LOGD(TAG, "Unhandled message type: %d", message->type);
+    }
+    releasePayload(message->payload);
+
+    uint32_t handlerUs = (uint32_t)(esp_timer_get_time() - handlerStart);
+    HandlerTiming &timing = handlerTimings[message->type];
+    portENTER_CRITICAL(&poolLock);
+    stats.processed++;
+    stats.processingUs += handlerUs;
+    if (handlerUs > stats.maxProcessingUs) {
+        stats.maxProcessingUs = handlerUs;
+    }
+    timing.count++;
+    timing.totalUs += handlerUs;
+    if (handlerUs > timing.maxUs) {
+        timing.maxUs = handlerUs;
+    }
+    portEXIT_CRITICAL(&poolLock);
+}
+
 void processMessageQueue(lv_timer_t *timer) {
     // CRITICAL: Don't process UI updates during rendering to prevent corruption
     // TODO: Fix lv_disp_t incomplete type issue
@@ -765,108 +1106,74 @@ void processMessageQueue(lv_timer_t *timer) {
     // }
 
     LVGLMessage_t message;
-
-    // OPTIMIZED: Adaptive message processing based on queue size and system load
-    int messagesProcessed = 0;
-    uint32_t processing_start = millis();
-
-    // Dynamic processing limits based on queue size
-    uxQueueMessagesWaiting(lvglMessageQueue);
+    int64_t passStart = esp_timer_get_time();
     int queueSize = uxQueueMessagesWaiting(lvglMessageQueue);
-    int maxMessages;
-    uint32_t maxProcessingTime;
-
-    if (queueSize > 64) {
-        // Emergency mode: High queue size
-        maxMessages = 15;
-        maxProcessingTime = 50;  // 50ms max
-        ESP_LOGW(TAG, "Message queue overloaded (%d messages), entering emergency processing", queueSize);
-    } else if (queueSize > 32) {
-        // High load mode
-        maxMessages = 10;
-        maxProcessingTime = 35;
-    } else if (queueSize > 16) {
-        // Medium load mode
-        maxMessages = 8;
-        maxProcessingTime = 25;
-    } else {
-        // Normal mode
-        maxMessages = 5;
-        maxProcessingTime = 20;
-    }
 
-    // Process available messages with adaptive limits
-    while (messagesProcessed < maxMessages &&
-           (millis() - processing_start) < maxProcessingTime &&
-           xQueueReceive(lvglMessageQueue, &message, 0) == pdTRUE) {
-        messagesProcessed++;
-
-        // PERFORMANCE: Single O(1) hash map lookup - no more double lookups!
-        auto handler = messageHandlers.find(message.type);
-        if (handler != messageHandlers.end()) {
-            handler->second(&message);
-        } else {
-            ESP_LOGD(TAG, "Unhandled message type: %d", message.type);
+    // Latest values first: each pending key renders once, however many
+    // updates arrived since the last pass. Starts where the last pass ran
+    // out of budget so no key is starved.
+    static int nextMailbox = 0;
+    int mailboxesDelivered = 0;
+    for (int scanned = 0; scanned < NUM_OF_MSGS; scanned++) {
+        if (!FrameScheduler::hasBudget(FrameScheduler::WORK_MESSAGES)) {
+            FrameScheduler::defer(FrameScheduler::WORK_MESSAGES);
+            break;
+        }
+        int type = nextMailbox;
+        nextMailbox = (nextMailbox + 1) % NUM_OF_MSGS;
+        if (takeFromMailbox(type, &message)) {
+            int64_t start = esp_timer_get_time();
+            dispatchMessage(&message);
+            FrameScheduler::charge(FrameScheduler::WORK_MESSAGES,
+                                   (uint32_t)(esp_timer_get_time() - start));
+            mailboxesDelivered++;
         }
     }
-
-    // OPTIMIZED: Performance monitoring and queue health reporting
-    uint32_t processingTime = millis() - processing_start;
-    if (processingTime > 30 || messagesProcessed >= maxMessages) {
-        ESP_LOGD(TAG, "Processed %d messages in %ums (queue: %d→%d)",
-                 messagesProcessed, processingTime, queueSize, uxQueueMessagesWaiting(lvglMessageQueue));
+    if (mailboxesDelivered > 0) {
+        portENTER_CRITICAL(&poolLock);
+        stats.mailboxDelivered += mailboxesDelivered;
+        portEXIT_CRITICAL(&poolLock);
     }
 
-    // OPTIMIZED: Queue overflow protection
-    if (uxQueueMessagesWaiting(lvglMessageQueue) > 100) {
-        ESP_LOGW(TAG, "Message queue critically full (%d), purging old messages",
-                 uxQueueMessagesWaiting(lvglMessageQueue));
-
-        // Track message type distribution during purge
-        int messageTypeCounts[32] = {0};  // Assuming we have less than 32 message types
-        int totalPurged = 0;
-
-        // Purge some old messages to prevent complete overflow
-        LVGLMessage_t dummyMessage;
-        for (int i = 0; i < 20 && xQueueReceive(lvglMessageQueue, &dummyMessage, 0) == pdTRUE; i++) {
-            // Track the message type
-            if (dummyMessage.type < 32) {
-                messageTypeCounts[dummyMessage.type]++;
-            }
-            totalPurged++;
+    // Ordered commands within what is left of the frame's message budget.
+    // Nothing is purged, everything left waits for the next frame.
+    int messagesProcessed = 0;
+    while (uxQueueMessagesWaiting(lvglMessageQueue) > 0) {
+        if (!FrameScheduler::hasBudget(FrameScheduler::WORK_MESSAGES)) {
+            FrameScheduler::defer(FrameScheduler::WORK_MESSAGES);
+            break;
         }
-
-        // Log the distribution of purged message types
-        if (totalPurged > 0) {
-            ESP_LOGW(TAG, "Purged %d messages. Distribution:", totalPurged);
-            for (int i = 0; i < 32; i++) {
-                if (messageTypeCounts[i] > 0) {
-                    const char *msgTypeName = getMessageTypeName(i);
-                    ESP_LOGW(TAG, "  Type %d (%s): %d messages (%.1f%%)",
-                             i, msgTypeName, messageTypeCounts[i],
-                             (messageTypeCounts[i] * 100.0f) / totalPurged);
-                }
-            }
+        if (xQueueReceive(lvglMessageQueue, &message, 0) != pdTRUE) {
+            break;
         }
+        int64_t start = esp_timer_get_time();
+        dispatchMessage(&message);
+        FrameScheduler::charge(FrameScheduler::WORK_MESSAGES,
+                               (uint32_t)(esp_timer_get_time() - start));
+        messagesProcessed++;
+    }
+
+    uint32_t processingUs = (uint32_t)(esp_timer_get_time() - passStart);
+    if (processingUs > UI_BUDGET_MESSAGES_US) {
+        ESP_LOGD(TAG, "Processed %d mailboxes + %d messages in %lu us (queue: %d→%d)",
+                 mailboxesDelivered, messagesProcessed, (unsigned long)processingUs,
+                 queueSize, uxQueueMessagesWaiting(lvglMessageQueue));
     }
 }
 
 bool updateFpsDisplay(float fps) {
-    LVGLMessage_t message;
-    message.type = MSG_UPDATE_FPS_DISPLAY;
+    LVGLMessage_t message = makeMessage(MSG_UPDATE_FPS_DISPLAY);
     message.data.fps_display.fps = fps;
     return sendMessage(&message);
 }
 
 bool updateBuildTimeDisplay() {
-    LVGLMessage_t message;
-    message.type = MSG_UPDATE_BUILD_TIME_DISPLAY;
+    LVGLMessage_t message = makeMessage(MSG_UPDATE_BUILD_TIME_DISPLAY);
     return sendMessage(&message);
 }
 
 bool changeScreen(void *screen, int anim_type, int time, int delay) {
-    LVGLMessage_t message;
-    message.type = MSG_SCREEN_CHANGE;
+    LVGLMessage_t message = makeMessage(MSG_SCREEN_CHANGE);
     message.data.screen_change.screen = screen;
     message.data.screen_change.anim_type = anim_type;
     message.data.screen_change.time = time;
@@ -876,82 +1183,46 @@ bool changeScreen(void *screen, int anim_type, int time, int delay) {
 
 // Tab-specific volume update functions
 bool updateMasterVolume(int volume) {
-    LVGLMessage_t message;
-    message.type = MSG_UPDATE_MASTER_VOLUME;
+    LVGLMessage_t message = makeMessage(MSG_UPDATE_MASTER_VOLUME);
     message.data.master_volume.volume = volume;
     return sendMessage(&message);
 }
 
 bool updateSingleVolume(int volume) {
-    LVGLMessage_t message;
-    message.type = MSG_UPDATE_SINGLE_VOLUME;
+    LVGLMessage_t message = makeMessage(MSG_UPDATE_SINGLE_VOLUME);
     message.data.single_volume.volume = volume;
     return sendMessage(&message);
 }
 
 bool updateBalanceVolume(int volume) {
-    LVGLMessage_t message;
-    message.type = MSG_UPDATE_BALANCE_VOLUME;
+    LVGLMessage_t message = makeMessage(MSG_UPDATE_BALANCE_VOLUME);
     message.data.balance_volume.volume = volume;
     return sendMessage(&message);
 }
 
-// Tab-specific device update functions
-bool updateMasterDevice(const char *device_name) {
-    LVGLMessage_t message;
-    message.type = MSG_UPDATE_MASTER_DEVICE;
-
-    // Safely copy device name string
-    if (device_name) {
-        strncpy(message.data.master_device.device_name, device_name,
-                sizeof(message.data.master_device.device_name) - 1);
-        message.data.master_device.device_name[sizeof(message.data.master_device.device_name) - 1] = '\0';
-    } else {
-        message.data.master_device.device_name[0] = '\0';
+// Tab-specific device update functions - names go through the payload pool
+static bool sendDeviceNames(LVGLMessageType_t type, const char *device1_name,
+                            const char *device2_name) {
+    LVGLMessage_t message = makeMessage(type);
+    PayloadData *payload = acquirePayload(&message.payload);
+    if (!payload) {
+        return false;
     }
-
+    copyText(payload->names.device1_name, sizeof(payload->names.device1_name), device1_name);
+    copyText(payload->names.device2_name, sizeof(payload->names.device2_name), device2_name);
     return sendMessage(&message);
 }
 
-bool updateSingleDevice(const char *device_name) {
-    LVGLMessage_t message;
-    message.type = MSG_UPDATE_SINGLE_DEVICE;
-
-    // Safely copy device name string
-    if (device_name) {
-        strncpy(message.data.single_device.device_name, device_name,
-                sizeof(message.data.single_device.device_name) - 1);
-        message.data.single_device.device_name[sizeof(message.data.single_device.device_name) - 1] = '\0';
-    } else {
-        message.data.single_device.device_name[0] = '\0';
-    }
+bool updateMasterDevice(const char *device_name) {
+    return sendDeviceNames(MSG_UPDATE_MASTER_DEVICE, device_name, NULL);
+}
 
-    return sendMessage(&message);
+bool updateSingleDevice(const char *device_name) {
+    return sendDeviceNames(MSG_UPDATE_SINGLE_DEVICE, device_name, NULL);
 }
 
 bool updateBalanceDevices(const char *device1_name, const char *device2_name) {
-    LVGLMessage_t message;
-    message.type = MSG_UPDATE_BALANCE_DEVICES;
-
-    // Safely copy device1 name string
-    if (device1_name) {
-        strncpy(message.data.balance_devices.device1_name, device1_name,
-                sizeof(message.data.balance_devices.device1_name) - 1);
-        message.data.balance_devices.device1_name[sizeof(message.data.balance_devices.device1_name) - 1] = '\0';
-    } else {
-        message.data.balance_devices.device1_name[0] = '\0';
-    }
-
-    // Safely copy device2 name string
-    if (device2_name) {
-        strncpy(message.data.balance_devices.device2_name, device2_name,
-                sizeof(message.data.balance_devices.device2_name) - 1);
-        message.data.balance_devices.device2_name[sizeof(message.data.balance_devices.device2_name) - 1] = '\0';
-    } else {
-        message.data.balance_devices.device2_name[0] = '\0';
-    }
-
-    return sendMessage(&message);
+    return sendDeviceNames(MSG_UPDATE_BALANCE_DEVICES, device1_name, device2_name);
 }
 
 // PERFORMANCE: Tab volume update function pointers for O(1) lookup
@@ -984,154 +1255,249 @@ bool updateCurrentTabVolume(int volume) {
 
 // Helper functions for state overview
 bool showStateOverview(void) {
-    LVGLMessage_t message;
-    message.type = MSG_SHOW_STATE_OVERVIEW;
+    LVGLMessage_t message = makeMessage(MSG_SHOW_STATE_OVERVIEW);
     return sendMessage(&message);
 }
 
 bool updateStateOverview(void) {
-    LVGLMessage_t message;
-    message.type = MSG_UPDATE_STATE_OVERVIEW;
+    LVGLMessage_t message = makeMessage(MSG_UPDATE_STATE_OVERVIEW);
+    PayloadData *payload = acquirePayload(&message.payload);
+    if (!payload) {
+        return false;
+    }
+    StateOverviewPayload &data = payload->overview;
 
     // Collect current system state
-    message.data.state_overview.free_heap = Hardware::Device::getFreeHeap();
-    message.data.state_overview.free_psram = Hardware::Device::getPsramSize();
-    message.data.state_overview.cpu_freq = Hardware::Device::getCpuFrequency();
-    message.data.state_overview.uptime_ms = Hardware::Device::getMillis();
+    data.free_heap = Hardware::Device::getFreeHeap();
+    data.free_psram = Hardware::Device::getPsramSize();
+    data.cpu_freq = Hardware::Device::getCpuFrequency();
+    data.uptime_ms = Hardware::Device::getMillis();
 
     // Network status - Network-free mode
-    strncpy(message.data.state_overview.wifi_status, "Network-Free Mode",
-            sizeof(message.data.state_overview.wifi_status) - 1);
-    message.data.state_overview.wifi_status[sizeof(message.data.state_overview.wifi_status) - 1] = '\0';
+    copyText(data.wifi_status, sizeof(data.wifi_status), "Network-Free Mode");
 
-    message.data.state_overview.wifi_rssi = 0;  // No WiFi in network-free mode
+    data.wifi_rssi = 0;  // No WiFi in network-free mode
 
-    strncpy(message.data.state_overview.ip_address, "N/A (Network-Free)",
-            sizeof(message.data.state_overview.ip_address) - 1);
-    message.data.state_overview.ip_address[sizeof(message.data.state_overview.ip_address) - 1] = '\0';
+    copyText(data.ip_address, sizeof(data.ip_address), "N/A (Network-Free)");
 
     // Collect audio state
     Application::Audio::AudioManager &audioManager = Application::Audio::AudioManager::getInstance();
-    const auto &audioState = audioManager.getState();
+    auto snapshot = audioManager.getSnapshot();
+    const auto &audioState = *snapshot;
+    const auto &sessions = audioState.currentStatus.sessions;
 
-    const char *tabName = audioManager.getTabName(audioManager.getCurrentTab());
-    strncpy(message.data.state_overview.current_tab, tabName,
-            sizeof(message.data.state_overview.current_tab) - 1);
-    message.data.state_overview.current_tab[sizeof(message.data.state_overview.current_tab) - 1] = '\0';
+    const char *tabName = audioManager.getTabName(audioState.currentTab);
+    copyText(data.current_tab, sizeof(data.current_tab), tabName);
 
     // Main device (Master/Single tab)
-    if (audioState.selectedDevice1) {
-        strncpy(message.data.state_overview.main_device, audioState.selectedDevice1->processName.c_str(),
-                sizeof(message.data.state_overview.main_device) - 1);
-        message.data.state_overview.main_device[sizeof(message.data.state_overview.main_device) - 1] = '\0';
-        message.data.state_overview.main_device_volume = audioState.selectedDevice1->volume;
-        message.data.state_overview.main_device_muted = audioState.selectedDevice1->isMuted;
+    if (audioState.isValid(audioState.selectedDevice1)) {
+        copyText(data.main_device, sizeof(data.main_device), sessions.processName(audioState.selectedDevice1));
+        data.main_device_volume = sessions.volume(audioState.selectedDevice1);
+        data.main_device_muted = sessions.isMuted(audioState.selectedDevice1);
     } else {
-        strcpy(message.data.state_overview.main_device, "None");
-        message.data.state_overview.main_device_volume = 0;
-        message.data.state_overview.main_device_muted = false;
+        copyText(data.main_device, sizeof(data.main_device), "None");
+        data.main_device_volume = 0;
+        data.main_device_muted = false;
     }
 
     // Balance devices
-    if (audioState.selectedDevice1) {
-        strncpy(message.data.state_overview.balance_device1, audioState.selectedDevice1->processName.c_str(),
-                sizeof(message.data.state_overview.balance_device1) - 1);
-        message.data.state_overview.balance_device1[sizeof(message.data.state_overview.balance_device1) - 1] = '\0';
-        message.data.state_overview.balance_device1_volume = audioState.selectedDevice1->volume;
-        message.data.state_overview.balance_device1_muted = audioState.selectedDevice1->isMuted;
+    if (audioState.isValid(audioState.selectedDevice1)) {
+        copyText(data.balance_device1, sizeof(data.balance_device1), sessions.processName(audioState.selectedDevice1));
+        data.balance_device1_volume = sessions.volume(audioState.selectedDevice1);
+        data.balance_device1_muted = sessions.isMuted(audioState.selectedDevice1);
     } else {
-        strcpy(message.data.state_overview.balance_device1, "None");
-        message.data.state_overview.balance_device1_volume = 0;
-        message.data.state_overview.balance_device1_muted = false;
+        copyText(data.balance_device1, sizeof(data.balance_device1), "None");
+        data.balance_device1_volume = 0;
+        data.balance_device1_muted = false;
     }
 
-    if (audioState.selectedDevice2) {
-        strncpy(message.data.state_overview.balance_device2, audioState.selectedDevice2->processName.c_str(),
-                sizeof(message.data.state_overview.balance_device2) - 1);
-        message.data.state_overview.balance_device2[sizeof(message.data.state_overview.balance_device2) - 1] = '\0';
-        message.data.state_overview.balance_device2_volume = audioState.selectedDevice2->volume;
-        message.data.state_overview.balance_device2_muted = audioState.selectedDevice2->isMuted;
+    if (audioState.isValid(audioState.selectedDevice2)) {
+        copyText(data.balance_device2, sizeof(data.balance_device2), sessions.processName(audioState.selectedDevice2));
+        data.balance_device2_volume = sessions.volume(audioState.selectedDevice2);
+        data.balance_device2_muted = sessions.isMuted(audioState.selectedDevice2);
     } else {
-        strcpy(message.data.state_overview.balance_device2, "None");
-        message.data.state_overview.balance_device2_volume = 0;
-        message.data.state_overview.balance_device2_muted = false;
+        copyText(data.balance_device2, sizeof(data.balance_device2), "None");
+        data.balance_device2_volume = 0;
+        data.balance_device2_muted = false;
     }
 
-    // Legacy compatibility fields (use main device data)
-    strncpy(message.data.state_overview.selected_device, message.data.state_overview.main_device,
-            sizeof(message.data.state_overview.selected_device) - 1);
-    message.data.state_overview.current_volume = message.data.state_overview.main_device_volume;
-    message.data.state_overview.is_muted = message.data.state_overview.main_device_muted;
-
     return sendMessage(&message);
 }
 
 bool hideStateOverview(void) {
     ESP_LOGI(TAG, "State Overlay: hideStateOverview() called - sending hide message");
-    LVGLMessage_t message;
-    message.type = MSG_HIDE_STATE_OVERVIEW;
+    LVGLMessage_t message = makeMessage(MSG_HIDE_STATE_OVERVIEW);
     return sendMessage(&message);
 }
 
 bool updateSDStatus(const char *status, bool mounted, uint64_t total_mb, uint64_t used_mb, uint8_t card_type) {
-    LVGLMessage_t message;
-    message.type = MSG_UPDATE_SD_STATUS;
+    LVGLMessage_t message = makeMessage(MSG_UPDATE_SD_STATUS);
     message.data.sd_status.status = status;
     message.data.sd_status.mounted = mounted;
-    message.data.sd_status.total_mb = total_mb;
-    message.data.sd_status.used_mb = used_mb;
+    message.data.sd_status.total_mb = (uint32_t)total_mb;
+    message.data.sd_status.used_mb = (uint32_t)used_mb;
     message.data.sd_status.card_type = card_type;
     return sendMessage(&message);
 }
 
 // Helper functions for SD format operations
 bool requestSDFormat(void) {
-    LVGLMessage_t message;
-    message.type = MSG_FORMAT_SD_REQUEST;
+    LVGLMessage_t message = makeMessage(MSG_FORMAT_SD_REQUEST);
     return sendMessage(&message);
 }
 
 bool confirmSDFormat(void) {
-    LVGLMessage_t message;
-    message.type = MSG_FORMAT_SD_CONFIRM;
+    LVGLMessage_t message = makeMessage(MSG_FORMAT_SD_CONFIRM);
     return sendMessage(&message);
 }
 
-bool updateSDFormatProgress(uint8_t progress, const char *msg) {
-    LVGLMessage_t message;
-    message.type = MSG_FORMAT_SD_PROGRESS;
+static bool sendFormatStatus(LVGLMessageType_t type, bool in_progress, bool success,
+                             uint8_t progress, const char *text) {
+    LVGLMessage_t message = makeMessage(type);
+    message.data.sd_format.in_progress = in_progress;
+    message.data.sd_format.success = success;
     message.data.sd_format.progress = progress;
-    message.data.sd_format.in_progress = true;
 
-    // Safely copy message string
-    if (msg) {
-        strncpy(message.data.sd_format.message, msg,
-                sizeof(message.data.sd_format.message) - 1);
-        message.data.sd_format.message[sizeof(message.data.sd_format.message) - 1] = '\0';
-    } else {
-        message.data.sd_format.message[0] = '\0';
+    PayloadData *payload = acquirePayload(&message.payload);
+    if (!payload) {
+        return false;
     }
-
+    copyText(payload->text.text, sizeof(payload->text.text), text);
     return sendMessage(&message);
 }
 
+bool updateSDFormatProgress(uint8_t progress, const char *msg) {
+    return sendFormatStatus(MSG_FORMAT_SD_PROGRESS, true, false, progress, msg);
+}
+
 bool completeSDFormat(bool success, const char *msg) {
-    LVGLMessage_t message;
-    message.type = MSG_FORMAT_SD_COMPLETE;
-    message.data.sd_format.success = success;
-    message.data.sd_format.in_progress = false;
-    message.data.sd_format.progress = success ? 100 : 0;
-
-    // Safely copy message string
-    if (msg) {
-        strncpy(message.data.sd_format.message, msg,
-                sizeof(message.data.sd_format.message) - 1);
-        message.data.sd_format.message[sizeof(message.data.sd_format.message) - 1] = '\0';
-    } else {
-        message.data.sd_format.message[0] = '\0';
+    return sendFormatStatus(MSG_FORMAT_SD_COMPLETE, false, success, success ? 100 : 0, msg);
+}
+
+// =============================================================================
+// SELF TEST
+// =============================================================================
+
+static int pendingMailboxes() {
+    int pending = 0;
+    portENTER_CRITICAL(&poolLock);
+    for (bool slot : mailboxPending) {
+        pending += slot;
     }
+    portEXIT_CRITICAL(&poolLock);
+    return pending;
+}
 
-    return sendMessage(&message);
+bool runMailboxStressTest(void) {
+    const int ROUNDS = 500;
+    const int KEYS_PER_ROUND = 6;
+
+    // Flood with what is already on screen so the test leaves no trace
+    int masterVolume = 0, singleVolume = 0, balanceVolume = 0;
+    char deviceName[64] = "";
+    if (!Application::TaskManager::lvglTryLock(500)) {
+        ESP_LOGE(TAG, "Mailbox stress: LVGL busy, not run");
+        return false;
+    }
+    masterVolume = ui_primaryVolumeSlider ? VOLUME_WIDGET_GET_VALUE(ui_primaryVolumeSlider) : 0;
+    singleVolume = ui_singleVolumeSlider ? VOLUME_WIDGET_GET_VALUE(ui_singleVolumeSlider) : 0;
+    balanceVolume = ui_balanceVolumeSlider ? VOLUME_WIDGET_GET_VALUE(ui_balanceVolumeSlider) : 0;
+    if (ui_lblPrimaryAudioDeviceValue) {
+        copyText(deviceName, sizeof(deviceName), lv_label_get_text(ui_lblPrimaryAudioDeviceValue));
+    }
+    Application::TaskManager::lvglUnlock();
+
+    QueueStats before = getStats();
+    FrameScheduler::Stats framesBefore = FrameScheduler::getStats();
+    int64_t startUs = esp_timer_get_time();
+    int failedSends = 0;
+    for (int round = 0; round < ROUNDS; round++) {
+        failedSends += !updateMasterVolume(masterVolume);
+        failedSends += !updateSingleVolume(singleVolume);
+        failedSends += !updateBalanceVolume(balanceVolume);
+        failedSends += !updateMasterDevice(deviceName);
+        failedSends += !updateFpsDisplay(0.0f);
+        failedSends += !updateSDStatus("stress", false, 0, 0, 0);
+        // Let the UI timer run now and then, as a real burst would
+        if (round % 50 == 49) {
+            vTaskDelay(pdMS_TO_TICKS(5));
+        }
+    }
+    uint32_t floodUs = (uint32_t)(esp_timer_get_time() - startUs);
+
+    // Drain: every key renders once more at most
+    for (int waited = 0; waited < 100 && pendingMailboxes() > 0; waited++) {
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+    QueueStats after = getStats();
+    FrameScheduler::Stats framesAfter = FrameScheduler::getStats();
+    const FrameScheduler::WorkStats &messagesBefore = framesBefore.work[FrameScheduler::WORK_MESSAGES];
+    const FrameScheduler::WorkStats &messagesAfter = framesAfter.work[FrameScheduler::WORK_MESSAGES];
+
+    uint32_t sent = ROUNDS * KEYS_PER_ROUND;
+    uint32_t coalesced = after.coalesced - before.coalesced;
+    uint32_t rendered = after.mailboxDelivered - before.mailboxDelivered;
+    uint32_t dropped = after.dropped - before.dropped;
+    uint32_t exhausted = after.poolExhausted - before.poolExhausted;
+
+    // Other tasks may post in the meantime, so the books balance at least
+    // for our own sends
+    bool passed = failedSends == 0 && dropped == 0 && exhausted == 0 &&
+                  pendingMailboxes() == 0 && coalesced + rendered >= sent &&
+                  rendered < sent / 10;
+
+    ESP_LOGI(TAG, "Mailbox stress: %lu updates in %lu us -> %lu rendered, %lu coalesced, "
+                  "%lu dropped, %lu pool exhausted, %d failed sends: %s",
+             (unsigned long)sent, (unsigned long)floodUs, (unsigned long)rendered,
+             (unsigned long)coalesced, (unsigned long)dropped, (unsigned long)exhausted,
+             failedSends, passed ? "PASS" : "FAIL");
+    ESP_LOGI(TAG, "Mailbox stress: %lu frames, %lu message budget overruns, %lu deferred, "
+                  "%lu task passes over a frame",
+             (unsigned long)(framesAfter.frames - framesBefore.frames),
+             (unsigned long)(messagesAfter.overruns - messagesBefore.overruns),
+             (unsigned long)(messagesAfter.deferrals - messagesBefore.deferrals),
+             (unsigned long)(framesAfter.longFrames - framesBefore.longFrames));
+    return passed;
+}
+
+bool runStateOverviewBenchmark(void) {
+    const int CYCLES = 5;
+    const int REFRESHES_PER_OPEN = 4;
+
+    OverviewStats before = getOverviewStats();
+    int failedSends = 0;
+    for (int cycle = 0; cycle < CYCLES; cycle++) {
+        failedSends += !showStateOverview();
+        vTaskDelay(pdMS_TO_TICKS(100));
+        for (int refresh = 0; refresh < REFRESHES_PER_OPEN; refresh++) {
+            failedSends += !updateStateOverview();
+            vTaskDelay(pdMS_TO_TICKS(50));
+        }
+        failedSends += !hideStateOverview();
+        vTaskDelay(pdMS_TO_TICKS(100));
+    }
+    OverviewStats after = getOverviewStats();
+
+    uint32_t builds = after.builds - before.builds;
+    uint32_t reopens = after.reopens - before.reopens;
+    uint32_t refreshes = after.refreshes - before.refreshes;
+    uint32_t writes = after.labelWrites - before.labelWrites;
+    uint32_t unchanged = after.labelsUnchanged - before.labelsUnchanged;
+    uint32_t averageReopen = reopens ? (after.reopenUs - before.reopenUs) / reopens : 0;
+
+    // Rebuilt on every open and every label rewritten on every refresh before
+    bool passed = failedSends == 0 && builds <= 1 && builds + reopens == CYCLES &&
+                  writes < refreshes * OVERVIEW_LABEL_COUNT;
+
+    ESP_LOGI(TAG, "Overview bench: %d opens -> %lu built (%lu us), %lu reopened avg %lu us",
+             CYCLES, (unsigned long)builds, (unsigned long)after.buildUs,
+             (unsigned long)reopens, (unsigned long)averageReopen);
+    ESP_LOGI(TAG, "Overview bench: %lu refreshes -> %lu label writes (every label: %lu), "
+                  "%lu unchanged, %d failed sends: %s",
+             (unsigned long)refreshes, (unsigned long)writes,
+             (unsigned long)(refreshes * OVERVIEW_LABEL_COUNT), (unsigned long)unchanged,
+             failedSends, passed ? "PASS" : "FAIL");
+    return passed;
 }
 
 }  // namespace LVGLMessageHandler
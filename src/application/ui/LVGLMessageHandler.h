@@ -45,9 +45,47 @@ typedef enum {
     NUM_OF_MSGS
 } LVGLMessageType_t;
 
-// Message data structures
+// Payloads too large for a queue item (names, overview data, text) are
+// written once into a slot of a small pool and travel as a handle. The
+// handler reads them in place and the slot is released after handling.
+typedef uint16_t PayloadHandle;  // Slot index, generation in the high byte
+static const PayloadHandle NO_PAYLOAD = 0xFFFF;
+
+typedef struct {
+    uint32_t free_heap;
+    uint32_t free_psram;
+    uint32_t cpu_freq;
+    uint32_t uptime_ms;
+    char wifi_status[32];
+    int wifi_rssi;
+    char ip_address[16];
+    char current_tab[16];
+    // Selected devices for all tabs
+    char main_device[64];  // Master/Single tab device
+    int main_device_volume;
+    bool main_device_muted;
+    char balance_device1[64];  // Balance tab device 1
+    int balance_device1_volume;
+    bool balance_device1_muted;
+    char balance_device2[64];  // Balance tab device 2
+    int balance_device2_volume;
+    bool balance_device2_muted;
+} StateOverviewPayload;
+
+typedef struct {
+    char device1_name[64];
+    char device2_name[64];  // Balance devices only
+} DeviceNamesPayload;
+
+typedef struct {
+    char text[256];
+} TextPayload;
+
+// Message data structures - keep every member small, a queue item is
+// copied twice per message
 typedef struct {
     LVGLMessageType_t type;
+    PayloadHandle payload;  // NO_PAYLOAD unless the type carries one
     union {
         struct {
             const char *status;
@@ -80,19 +118,8 @@ typedef struct {
             int volume;
         } balance_volume;
 
-        // Tab-specific device update data
-        struct {
-            char device_name[64];
-        } master_device;
-
-        struct {
-            char device_name[64];
-        } single_device;
-
-        struct {
-            char device1_name[64];
-            char device2_name[64];
-        } balance_devices;
+        // Device updates (MSG_UPDATE_*_DEVICE) carry a DeviceNamesPayload,
+        // MSG_UPDATE_STATE_OVERVIEW a StateOverviewPayload
 
         struct {
             void *screen;
@@ -101,56 +128,55 @@ typedef struct {
             int delay;
         } screen_change;
 
-        // State overview data
-        struct {
-            uint32_t free_heap;
-            uint32_t free_psram;
-            uint32_t cpu_freq;
-            uint32_t uptime_ms;
-            char wifi_status[32];
-            int wifi_rssi;
-            char ip_address[16];
-            char current_tab[16];
-            // Selected devices for all tabs
-            char main_device[64];  // Master/Single tab device
-            int main_device_volume;
-            bool main_device_muted;
-            char balance_device1[64];  // Balance tab device 1
-            int balance_device1_volume;
-            bool balance_device1_muted;
-            char balance_device2[64];  // Balance tab device 2
-            int balance_device2_volume;
-            bool balance_device2_muted;
-            // Legacy for compatibility
-            char selected_device[64];
-            int current_volume;
-            bool is_muted;
-        } state_overview;
-
         // SD card status data
         struct {
             const char *status;
             bool mounted;
-            uint64_t total_mb;
-            uint64_t used_mb;
             uint8_t card_type;
+            uint32_t total_mb;
+            uint32_t used_mb;
         } sd_status;
 
-        // SD card format data
+        // SD card format data, the message text is a TextPayload
         struct {
             bool in_progress;
             bool success;
             uint8_t progress;
-            char message[64];
         } sd_format;
-
-        // Debug UI log data
-        struct {
-            char message[256];
-        } debug_ui_log;
     } data;
 } LVGLMessage_t;
 
+struct QueueStats {
+    uint32_t sent = 0;
+    uint32_t dropped = 0;       // Queue full
+    uint32_t poolExhausted = 0; // No payload slot free
+    uint32_t coalesced = 0;     // Mailbox values overwritten before render
+    uint32_t mailboxDelivered = 0;  // Mailbox values rendered
+    uint32_t processed = 0;
+    uint64_t processingUs = 0;  // Handler time, all messages
+    uint32_t maxProcessingUs = 0;
+};
+
+// Handler time per message type
+struct HandlerTiming {
+    uint32_t count = 0;
+    uint32_t maxUs = 0;
+    uint64_t totalUs = 0;
+};
+
+// State overview open and refresh costs. Opening builds the overlay the
+// first time only; a refresh writes only the labels whose text changed.
+struct OverviewStats {
+    uint32_t builds = 0;
+    uint32_t buildUs = 0;          // Last build, what every open used to cost
+    uint32_t reopens = 0;          // Opens that only unhid the overlay
+    uint32_t reopenUs = 0;
+    uint32_t maxReopenUs = 0;
+    uint32_t refreshes = 0;        // Updates rendered while shown
+    uint32_t labelWrites = 0;
+    uint32_t labelsUnchanged = 0;  // Writes skipped, same text
+};
+
 // Queue handle
 extern QueueHandle_t lvglMessageQueue;
 
@@ -158,6 +184,10 @@ extern QueueHandle_t lvglMessageQueue;
 bool init(void);
 void deinit(void);
 bool sendMessage(const LVGLMessage_t *message);
+QueueStats getStats(void);
+HandlerTiming getHandlerTiming(LVGLMessageType_t type);
+OverviewStats getOverviewStats(void);
+String getStatus(void);
 void processMessageQueue(lv_timer_t *timer);
 void processComplexMessage(const LVGLMessage_t *message);
 
@@ -195,8 +225,15 @@ bool confirmSDFormat(void);
 bool updateSDFormatProgress(uint8_t progress, const char *message);
 bool completeSDFormat(bool success, const char *message);
 
-// Helper function for debug UI logging
-bool sendDebugUILog(const char *message);
+// Self test: floods every mailbox with the values already on screen and
+// checks that nothing is dropped and each key renders once per pass. Waits
+// on the LVGL task, so call it from another task.
+bool runMailboxStressTest(void);
+
+// Self test: opens, refreshes and closes the state overview a few times and
+// reports open latency and label writes against building it every time.
+// Takes the LVGL lock, so call it from another task.
+bool runStateOverviewBenchmark(void);
 
 }  // namespace LVGLMessageHandler
 }  // namespace Application
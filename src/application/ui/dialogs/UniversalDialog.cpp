@@ -1,8 +1,11 @@
 #include "UniversalDialog.h"
 #include "ManagerMacros.h"
 #include "UIConstants.h"
+#include "../../../core/TaskManager.h"
 #include <esp_log.h>
+#include <esp_timer.h>
 #include <Arduino.h>
+#include <cstring>
 
 static const char* TAG = "UniversalDialog";
 
@@ -86,21 +89,93 @@ static void getDialogDimensions(DialogSize size, int* width, int* height) {
     }
 }
 
-lv_obj_t* UniversalDialog::createOverlay(lv_obj_t* parent) {
-    if (!parent) {
-        parent = lv_scr_act();
+// =============================================================================
+// SKELETON POOL
+// =============================================================================
+
+// One skeleton per kind of dialog; sizes and themes are only style
+// properties, so they are applied to the skeleton instead of having one each
+enum SkeletonKind {
+    SKELETON_MESSAGE,   // Info, warning, error, confirm, custom
+    SKELETON_PROGRESS,
+    SKELETON_INPUT,
+    SKELETON_COUNT
+};
+
+static const size_t MAX_DIALOG_BUTTONS = 3;
+
+struct DialogButtonSlot {
+    lv_obj_t* button = nullptr;
+    lv_obj_t* label = nullptr;
+    std::function<void()> callback;
+
+    // Colors applied, restyled only when a show asks for others
+    bool styled = false;
+    uint32_t background = 0;
+    uint32_t text = 0;
+};
+
+struct UniversalDialog::Skeleton {
+    int kind = SKELETON_MESSAGE;
+    lv_obj_t* overlay = nullptr;
+    lv_obj_t* dialog = nullptr;
+    lv_obj_t* title = nullptr;
+    lv_obj_t* message = nullptr;  // Message, progress status or input prompt
+    lv_obj_t* progressBar = nullptr;
+    lv_obj_t* inputField = nullptr;
+    DialogButtonSlot buttons[MAX_DIALOG_BUTTONS];
+
+    // Applied to the widgets, restyled only when a show asks for another
+    bool styled = false;
+    DialogSize size = DialogSize::MEDIUM;
+    DialogTheme theme = DialogTheme::LIGHT;
+    bool modal = true;
+};
+
+UniversalDialog::Skeleton UniversalDialog::skeletons[SKELETON_COUNT];
+UniversalDialog::Skeleton* UniversalDialog::currentSkeleton = nullptr;
+
+static DialogStats stats;
+static int64_t openStartUs = 0;
+static int32_t openStartHeap = 0;
+static bool openBuilt = false;
+
+static int32_t lvglHeapUsed() {
+    lv_mem_monitor_t monitor;
+    lv_mem_monitor(&monitor);
+    return (int32_t)(monitor.total_size - monitor.free_size);
+}
+
+// Label text is copied into the LVGL heap, so unchanged text is left alone
+static bool setText(lv_obj_t* label, const char* text) {
+    if (strcmp(lv_label_get_text(label), text) == 0) {
+        return false;
     }
+    lv_label_set_text(label, text);
+    return true;
+}
 
-    lv_obj_t* overlay = lv_obj_create(parent);
-    LVGL_SET_SIZE_POS(overlay, LV_PCT(100), LV_PCT(100), 0, 0);
-
-    // Modal background styling
-    if (modalBackground) {
-        lv_obj_set_style_bg_color(overlay, HEX(0x000000), LV_PART_MAIN);
-        lv_obj_set_style_bg_opa(overlay, 128, LV_PART_MAIN);
+static void setVisible(lv_obj_t* obj, bool visible) {
+    if (visible) {
+        lv_obj_remove_flag(obj, LV_OBJ_FLAG_HIDDEN);
     } else {
-        lv_obj_set_style_bg_opa(overlay, LV_OPA_TRANSP, LV_PART_MAIN);
+        lv_obj_add_flag(obj, LV_OBJ_FLAG_HIDDEN);
     }
+}
+
+static void onButtonClicked(lv_event_t* e) {
+    DialogButtonSlot* slot = static_cast<DialogButtonSlot*>(lv_event_get_user_data(e));
+    // Copied: the callback usually closes this dialog or shows the next one
+    // in the same skeleton, which replaces the slot's callback
+    std::function<void()> callback = slot->callback;
+    if (callback) {
+        callback();
+    }
+}
+
+lv_obj_t* UniversalDialog::createOverlay(lv_obj_t* parent) {
+    lv_obj_t* overlay = lv_obj_create(parent);
+    LVGL_SET_SIZE_POS(overlay, LV_PCT(100), LV_PCT(100), 0, 0);
 
     lv_obj_set_style_border_width(overlay, 0, LV_PART_MAIN);
     lv_obj_set_style_radius(overlay, 0, LV_PART_MAIN);
@@ -109,15 +184,11 @@ lv_obj_t* UniversalDialog::createOverlay(lv_obj_t* parent) {
     return overlay;
 }
 
-lv_obj_t* UniversalDialog::createDialogContainer(lv_obj_t* parent, DialogSize size, DialogTheme theme) {
-    int width, height;
-    getDialogDimensions(size, &width, &height);
-
+lv_obj_t* UniversalDialog::createDialogContainer(lv_obj_t* parent) {
     lv_obj_t* dialog = lv_obj_create(parent);
-    LVGL_SET_SIZE_ALIGN(dialog, width, height, LV_ALIGN_CENTER);
+    lv_obj_set_align(dialog, LV_ALIGN_CENTER);
 
     // Modern dialog styling with shadows and rounded corners using new approach
-    applyTheme(dialog, theme);
     lv_obj_set_style_radius(dialog, 16, LV_PART_MAIN);
     lv_obj_set_style_shadow_width(dialog, 20, LV_PART_MAIN);
     lv_obj_set_style_shadow_color(dialog, HEX(0x000000), LV_PART_MAIN);
@@ -130,29 +201,25 @@ lv_obj_t* UniversalDialog::createDialogContainer(lv_obj_t* parent, DialogSize si
     return dialog;
 }
 
-lv_obj_t* UniversalDialog::createTitle(lv_obj_t* parent, const String& title, DialogTheme theme) {
+lv_obj_t* UniversalDialog::createTitle(lv_obj_t* parent) {
     lv_obj_t* titleLabel = lv_label_create(parent);
-    lv_label_set_text(titleLabel, title.c_str());
+    lv_label_set_text(titleLabel, "");
     lv_obj_set_align(titleLabel, LV_ALIGN_TOP_MID);
     lv_obj_set_y(titleLabel, 0);
 
-    // Title styling with theme-based color - simplified approach
     lv_obj_set_style_text_font(titleLabel, &lv_font_montserrat_18, LV_PART_MAIN);
-    lv_obj_set_style_text_color(titleLabel, getThemeColor(theme, false), LV_PART_MAIN);
     lv_obj_set_style_text_align(titleLabel, LV_TEXT_ALIGN_CENTER, LV_PART_MAIN);
 
     return titleLabel;
 }
 
-lv_obj_t* UniversalDialog::createMessage(lv_obj_t* parent, const String& message, DialogTheme theme) {
+lv_obj_t* UniversalDialog::createMessage(lv_obj_t* parent) {
     lv_obj_t* messageLabel = lv_label_create(parent);
-    lv_label_set_text(messageLabel, message.c_str());
+    lv_label_set_text(messageLabel, "");
     lv_obj_set_align(messageLabel, LV_ALIGN_CENTER);
     lv_obj_set_y(messageLabel, -20);
 
-    // Message styling with theme-based color - simplified approach
     lv_obj_set_style_text_font(messageLabel, &lv_font_montserrat_14, LV_PART_MAIN);
-    lv_obj_set_style_text_color(messageLabel, getThemeColor(theme, false), LV_PART_MAIN);
     lv_obj_set_style_text_align(messageLabel, LV_TEXT_ALIGN_CENTER, LV_PART_MAIN);
     lv_label_set_long_mode(messageLabel, LV_LABEL_LONG_WRAP);
     lv_obj_set_width(messageLabel, LV_PCT(90));
@@ -160,54 +227,7 @@ lv_obj_t* UniversalDialog::createMessage(lv_obj_t* parent, const String& message
     return messageLabel;
 }
 
-// Static callback registry to avoid memory management issues
-namespace {
-    struct CallbackRegistry {
-        static std::vector<std::function<void()>> callbacks;
-        static std::vector<bool> callbackValid;
-
-        static size_t registerCallback(const std::function<void()>& callback) {
-            // Find an empty slot
-            for (size_t i = 0; i < callbackValid.size(); i++) {
-                if (!callbackValid[i]) {
-                    callbacks[i] = callback;
-                    callbackValid[i] = true;
-                    return i;
-                }
-            }
-
-            // No empty slot, add new one
-            size_t index = callbacks.size();
-            callbacks.push_back(callback);
-            callbackValid.push_back(true);
-            return index;
-        }
-
-        static void unregisterCallback(size_t index) {
-            if (index < callbackValid.size()) {
-                callbackValid[index] = false;
-            }
-        }
-
-        static bool executeCallback(size_t index) {
-            if (index < callbacks.size() && callbackValid[index]) {
-                callbacks[index]();
-                callbackValid[index] = false; // Auto-cleanup after execution
-                return true;
-            }
-            return false;
-        }
-
-        static void cleanup() {
-            std::fill(callbackValid.begin(), callbackValid.end(), false);
-        }
-    };
-
-    std::vector<std::function<void()>> CallbackRegistry::callbacks;
-    std::vector<bool> CallbackRegistry::callbackValid;
-}
-
-lv_obj_t* UniversalDialog::createButtonPanel(lv_obj_t* parent, const std::vector<DialogButton>& buttons) {
+lv_obj_t* UniversalDialog::createButtonPanel(lv_obj_t* parent, Skeleton& skeleton) {
     lv_obj_t* panel = lv_obj_create(parent);
     LVGL_SET_SIZE_ALIGN(panel, LV_PCT(100), 60, LV_ALIGN_BOTTOM_MID);
     lv_obj_set_y(panel, 0);
@@ -219,125 +239,214 @@ lv_obj_t* UniversalDialog::createButtonPanel(lv_obj_t* parent, const std::vector
     LVGL_SETUP_FLEX_CONTAINER(panel, LV_FLEX_FLOW_ROW,
                               LV_FLEX_ALIGN_SPACE_EVENLY, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
 
-    // Create buttons
-    for (const auto& buttonConfig : buttons) {
-        lv_obj_t* btn = lv_btn_create(panel);
-        lv_obj_set_size(btn, 100, 40);
+    // Hidden buttons, shown and styled by setButtons()
+    for (DialogButtonSlot& slot : skeleton.buttons) {
+        slot.button = lv_btn_create(panel);
+        lv_obj_set_size(slot.button, 100, 40);
+        lv_obj_add_flag(slot.button, LV_OBJ_FLAG_HIDDEN);
 
-        // Use new button styling based on properties
-        if (buttonConfig.isDefault) {
-            // Primary button styling
-            switch (buttonConfig.theme) {
-                case DialogTheme::SUCCESS:
-                    LVGL_STYLE_BUTTON(btn, 0x28A745, 0xFFFFFF);
-                    break;
-                case DialogTheme::ERROR:
-                    LVGL_STYLE_BUTTON(btn, 0xDC3545, 0xFFFFFF);
-                    break;
-                case DialogTheme::WARNING:
-                    LVGL_STYLE_BUTTON(btn, 0xFFC107, 0x000000);
-                    break;
-                default:
-                    LVGL_STYLE_BUTTON(btn, 0x007BFF, 0xFFFFFF);
-                    break;
-            }
-        } else {
-            // Secondary button styling
-            LVGL_STYLE_BUTTON(btn, 0x6C757D, 0xFFFFFF);
-        }
+        slot.label = lv_label_create(slot.button);
+        lv_label_set_text(slot.label, "");
+        lv_obj_center(slot.label);
+        LVGL_STYLE_LABEL(slot.label, &lv_font_montserrat_14, 0xFFFFFF, LV_TEXT_ALIGN_CENTER);
 
-        // Button label
-        lv_obj_t* label = lv_label_create(btn);
-        lv_label_set_text(label, buttonConfig.text.c_str());
-        lv_obj_center(label);
-        LVGL_STYLE_LABEL(label, &lv_font_montserrat_14, 0xFFFFFF, LV_TEXT_ALIGN_CENTER);
-
-        // Store callback using registry system
-        size_t callbackIndex = CallbackRegistry::registerCallback(buttonConfig.callback);
-        lv_obj_set_user_data(btn, (void*)callbackIndex);
-
-        lv_obj_add_event_cb(btn, [](lv_event_t* e) {
-            if (lv_event_get_code(e) == LV_EVENT_CLICKED) {
-                size_t callbackIndex = (size_t)lv_obj_get_user_data((lv_obj_t *)lv_event_get_target(e));
-                CallbackRegistry::executeCallback(callbackIndex);
-            } }, LV_EVENT_CLICKED, nullptr);
+        lv_obj_add_event_cb(slot.button, onButtonClicked, LV_EVENT_CLICKED, &slot);
     }
 
     return panel;
 }
 
-lv_obj_t* UniversalDialog::createProgressSection(lv_obj_t* parent, const ProgressConfig& config) {
+lv_obj_t* UniversalDialog::createProgressSection(lv_obj_t* parent, Skeleton& skeleton) {
     // Progress bar
-    currentProgressBar = lv_bar_create(parent);
-    LVGL_SET_SIZE_ALIGN(currentProgressBar, LV_PCT(80), 20, LV_ALIGN_CENTER);
-    lv_obj_set_y(currentProgressBar, -10);
+    skeleton.progressBar = lv_bar_create(parent);
+    LVGL_SET_SIZE_ALIGN(skeleton.progressBar, LV_PCT(80), 20, LV_ALIGN_CENTER);
+    lv_obj_set_y(skeleton.progressBar, -10);
 
     // Use new progress bar styling macro
-    LVGL_STYLE_PROGRESS_BAR(currentProgressBar, 0xE9ECEF, 0x007BFF);
-
-    // Set initial value
-    lv_bar_set_range(currentProgressBar, 0, config.max);
-    if (config.indeterminate) {
-        lv_bar_set_value(currentProgressBar, 50, LV_ANIM_ON);
-        // TODO: Add indeterminate animation
-    } else {
-        lv_bar_set_value(currentProgressBar, config.value, LV_ANIM_OFF);
-    }
+    LVGL_STYLE_PROGRESS_BAR(skeleton.progressBar, 0xE9ECEF, 0x007BFF);
 
     // Status label
-    currentStatusLabel = lv_label_create(parent);
-    lv_label_set_text(currentStatusLabel, config.message.c_str());
-    lv_obj_set_align(currentStatusLabel, LV_ALIGN_CENTER);
-    lv_obj_set_y(currentStatusLabel, 20);
-    LVGL_STYLE_LABEL(currentStatusLabel, &lv_font_montserrat_12, 0x000000, LV_TEXT_ALIGN_CENTER);
-    lv_label_set_long_mode(currentStatusLabel, LV_LABEL_LONG_WRAP);
-    lv_obj_set_width(currentStatusLabel, LV_PCT(90));
+    skeleton.message = lv_label_create(parent);
+    lv_label_set_text(skeleton.message, "");
+    lv_obj_set_align(skeleton.message, LV_ALIGN_CENTER);
+    lv_obj_set_y(skeleton.message, 20);
+    LVGL_STYLE_LABEL(skeleton.message, &lv_font_montserrat_12, 0x000000, LV_TEXT_ALIGN_CENTER);
+    lv_label_set_long_mode(skeleton.message, LV_LABEL_LONG_WRAP);
+    lv_obj_set_width(skeleton.message, LV_PCT(90));
 
-    return currentProgressBar;
+    return skeleton.progressBar;
 }
 
-lv_obj_t* UniversalDialog::createInputSection(lv_obj_t* parent, const InputConfig& config) {
+lv_obj_t* UniversalDialog::createInputSection(lv_obj_t* parent, Skeleton& skeleton) {
     // Input label
-    lv_obj_t* inputLabel = lv_label_create(parent);
-    lv_label_set_text(inputLabel, config.message.c_str());
-    lv_obj_set_align(inputLabel, LV_ALIGN_CENTER);
-    lv_obj_set_y(inputLabel, -40);
-    LVGL_STYLE_LABEL(inputLabel, &lv_font_montserrat_14, 0x000000, LV_TEXT_ALIGN_CENTER);
-
-    // Input field
-    if (config.multiline) {
-        currentInputField = lv_textarea_create(parent);
-        LVGL_SET_SIZE_ALIGN(currentInputField, LV_PCT(80), 100, LV_ALIGN_CENTER);
-    } else {
-        currentInputField = lv_textarea_create(parent);
-        LVGL_SET_SIZE_ALIGN(currentInputField, LV_PCT(80), 40, LV_ALIGN_CENTER);
-        lv_textarea_set_one_line(currentInputField, true);
+    skeleton.message = lv_label_create(parent);
+    lv_label_set_text(skeleton.message, "");
+    lv_obj_set_align(skeleton.message, LV_ALIGN_CENTER);
+    lv_obj_set_y(skeleton.message, -40);
+    LVGL_STYLE_LABEL(skeleton.message, &lv_font_montserrat_14, 0x000000, LV_TEXT_ALIGN_CENTER);
+
+    // Input field, one line until a show asks for multiline
+    skeleton.inputField = lv_textarea_create(parent);
+    LVGL_SET_SIZE_ALIGN(skeleton.inputField, LV_PCT(80), 40, LV_ALIGN_CENTER);
+    lv_textarea_set_one_line(skeleton.inputField, true);
+    lv_obj_set_y(skeleton.inputField, 0);
+
+    // Use new input field styling macro
+    LVGL_STYLE_INPUT_FIELD(skeleton.inputField, 0xFFFFFF, 0xCED4DA, 0x007BFF);
+
+    return skeleton.inputField;
+}
+
+void UniversalDialog::buildSkeleton(Skeleton& skeleton, lv_obj_t* screen) {
+    skeleton.overlay = createOverlay(screen);
+    skeleton.dialog = createDialogContainer(skeleton.overlay);
+    skeleton.title = createTitle(skeleton.dialog);
+
+    switch (skeleton.kind) {
+        case SKELETON_PROGRESS:
+            createProgressSection(skeleton.dialog, skeleton);
+            break;
+        case SKELETON_INPUT:
+            createInputSection(skeleton.dialog, skeleton);
+            break;
+        default:
+            skeleton.message = createMessage(skeleton.dialog);
+            break;
     }
 
-    lv_obj_set_y(currentInputField, 0);
+    createButtonPanel(skeleton.dialog, skeleton);
+    lv_obj_add_flag(skeleton.overlay, LV_OBJ_FLAG_HIDDEN);
+    skeleton.styled = false;
+    for (DialogButtonSlot& slot : skeleton.buttons) {
+        slot.styled = false;
+    }
+}
 
-    // Use new input field styling macro
-    LVGL_STYLE_INPUT_FIELD(currentInputField, 0xFFFFFF, 0xCED4DA, 0x007BFF);
+UniversalDialog::Skeleton& UniversalDialog::acquireSkeleton(int kind, DialogSize size, DialogTheme theme) {
+    closeDialog(false);  // Close any existing dialog
+
+    openStartHeap = lvglHeapUsed();
+    openStartUs = esp_timer_get_time();
+
+    Skeleton& skeleton = skeletons[kind];
+    skeleton.kind = kind;
 
-    // Set placeholder and default value
-    if (!config.placeholder.isEmpty()) {
-        lv_textarea_set_placeholder_text(currentInputField, config.placeholder.c_str());
+    // Built on first use, and again if the screen it lived on was deleted
+    lv_obj_t* screen = lv_scr_act();
+    openBuilt = !skeleton.overlay || !lv_obj_is_valid(skeleton.overlay);
+    if (openBuilt) {
+        buildSkeleton(skeleton, screen);
+    } else if (lv_obj_get_parent(skeleton.overlay) != screen) {
+        lv_obj_set_parent(skeleton.overlay, screen);
     }
-    if (!config.defaultValue.isEmpty()) {
-        lv_textarea_set_text(currentInputField, config.defaultValue.c_str());
+
+    if (!skeleton.styled || skeleton.modal != modalBackground) {
+        // Modal background styling
+        if (modalBackground) {
+            lv_obj_set_style_bg_color(skeleton.overlay, HEX(0x000000), LV_PART_MAIN);
+            lv_obj_set_style_bg_opa(skeleton.overlay, 128, LV_PART_MAIN);
+        } else {
+            lv_obj_set_style_bg_opa(skeleton.overlay, LV_OPA_TRANSP, LV_PART_MAIN);
+        }
+        skeleton.modal = modalBackground;
     }
+    if (!skeleton.styled || skeleton.size != size) {
+        int width, height;
+        getDialogDimensions(size, &width, &height);
+        lv_obj_set_size(skeleton.dialog, width, height);
+        skeleton.size = size;
+    }
+    if (!skeleton.styled || skeleton.theme != theme) {
+        applyTheme(skeleton.dialog, theme);
+        lv_obj_set_style_text_color(skeleton.title, getThemeColor(theme, false), LV_PART_MAIN);
+        if (skeleton.kind == SKELETON_MESSAGE) {
+            lv_obj_set_style_text_color(skeleton.message, getThemeColor(theme, false), LV_PART_MAIN);
+        }
+        skeleton.theme = theme;
+    }
+    skeleton.styled = true;
+
+    return skeleton;
+}
 
-    // Password mode
-    if (config.isPassword) {
-        lv_textarea_set_password_mode(currentInputField, true);
+void UniversalDialog::setButtons(Skeleton& skeleton, const std::vector<DialogButton>& buttons) {
+    if (buttons.size() > MAX_DIALOG_BUTTONS) {
+        ESP_LOGW(TAG, "Dialog has %u buttons, only %u shown", (unsigned)buttons.size(),
+                 (unsigned)MAX_DIALOG_BUTTONS);
     }
 
-    // Max length
-    if (config.maxLength > 0) {
-        lv_textarea_set_max_length(currentInputField, config.maxLength);
+    for (size_t i = 0; i < MAX_DIALOG_BUTTONS; i++) {
+        DialogButtonSlot& slot = skeleton.buttons[i];
+        if (i >= buttons.size()) {
+            slot.callback = nullptr;
+            lv_obj_add_flag(slot.button, LV_OBJ_FLAG_HIDDEN);
+            continue;
+        }
+        const DialogButton& buttonConfig = buttons[i];
+
+        // Primary buttons follow their theme, secondary ones are grey
+        uint32_t background = 0x6C757D;
+        uint32_t text = 0xFFFFFF;
+        if (buttonConfig.isDefault) {
+            switch (buttonConfig.theme) {
+                case DialogTheme::SUCCESS:
+                    background = 0x28A745;
+                    break;
+                case DialogTheme::ERROR:
+                    background = 0xDC3545;
+                    break;
+                case DialogTheme::WARNING:
+                    background = 0xFFC107;
+                    text = 0x000000;
+                    break;
+                default:
+                    background = 0x007BFF;
+                    break;
+            }
+        }
+        if (!slot.styled || slot.background != background || slot.text != text) {
+            LVGL_STYLE_BUTTON(slot.button, background, text);
+            slot.styled = true;
+            slot.background = background;
+            slot.text = text;
+        }
+
+        setText(slot.label, buttonConfig.text.c_str());
+        slot.callback = buttonConfig.callback;
+        lv_obj_remove_flag(slot.button, LV_OBJ_FLAG_HIDDEN);
     }
+}
 
-    return currentInputField;
+void UniversalDialog::present(Skeleton& skeleton) {
+    lv_obj_move_foreground(skeleton.overlay);
+    lv_obj_remove_flag(skeleton.overlay, LV_OBJ_FLAG_HIDDEN);
+
+    currentSkeleton = &skeleton;
+    currentOverlay = skeleton.overlay;
+    currentDialog = skeleton.dialog;
+    currentProgressBar = skeleton.progressBar;
+    currentStatusLabel = skeleton.kind == SKELETON_PROGRESS ? skeleton.message : nullptr;
+    currentInputField = skeleton.inputField;
+
+    uint32_t openUs = (uint32_t)(esp_timer_get_time() - openStartUs);
+    int32_t heapBytes = lvglHeapUsed() - openStartHeap;
+    stats.opens++;
+    stats.lastOpenHeapBytes = heapBytes;
+    if (openBuilt) {
+        stats.builds++;
+        stats.buildOpenUs = openUs;
+    } else {
+        stats.pooledOpens++;
+        stats.pooledOpenUs += openUs;
+        if (openUs > stats.maxPooledOpenUs) {
+            stats.maxPooledOpenUs = openUs;
+        }
+        if (heapBytes > stats.maxPooledOpenHeapBytes) {
+            stats.maxPooledOpenHeapBytes = heapBytes;
+        }
+    }
+    ESP_LOGD(TAG, "Dialog visible in %lu us (%s), %ld B LVGL heap", (unsigned long)openUs,
+             openBuilt ? "built" : "pooled", (long)heapBytes);
 }
 
 // Public interface implementations
@@ -391,38 +500,45 @@ void UniversalDialog::showConfirm(const String& title, const String& message, st
 
 // Progress dialog
 void UniversalDialog::showProgress(const ProgressConfig& config, DialogSize size) {
-    closeDialog(false);  // Close any existing dialog
-
-    currentOverlay = createOverlay(lv_scr_act());
-    currentDialog = createDialogContainer(currentOverlay, size, DialogTheme::LIGHT);
+    Skeleton& skeleton = acquireSkeleton(SKELETON_PROGRESS, size, DialogTheme::LIGHT);
 
     // Title
-    if (!config.title.isEmpty()) {
-        createTitle(currentDialog, config.title, DialogTheme::LIGHT);
-    }
+    setText(skeleton.title, config.title.c_str());
+    setVisible(skeleton.title, !config.title.isEmpty());
 
     // Progress section
-    createProgressSection(currentDialog, config);
+    lv_bar_set_range(skeleton.progressBar, 0, config.max);
+    if (config.indeterminate) {
+        lv_bar_set_value(skeleton.progressBar, 50, LV_ANIM_OFF);
+        // TODO: Add indeterminate animation
+    } else {
+        lv_bar_set_value(skeleton.progressBar, config.value, LV_ANIM_OFF);
+    }
+    setText(skeleton.message, config.message.c_str());
 
     // Cancel button if cancellable
+    std::vector<DialogButton> buttons;
     if (config.cancellable && config.cancelCallback) {
-        std::vector<DialogButton> buttons;
         buttons.emplace_back("Cancel", [config]() {
             closeDialog();
             if (config.cancelCallback) config.cancelCallback();
         });
-        createButtonPanel(currentDialog, buttons);
     }
+    setButtons(skeleton, buttons);
 
+    present(skeleton);
     ESP_LOGI(TAG, "Progress dialog shown: %s", config.title.c_str());
 }
 
+// Touches only the bar and the status label, and those only on a change
 void UniversalDialog::updateProgress(int value, const String& message) {
-    if (currentProgressBar) {
+    stats.progressUpdates++;
+    if (currentProgressBar && lv_bar_get_value(currentProgressBar) != value) {
         lv_bar_set_value(currentProgressBar, value, LV_ANIM_ON);
+        stats.progressWrites++;
     }
-    if (currentStatusLabel && !message.isEmpty()) {
-        lv_label_set_text(currentStatusLabel, message.c_str());
+    if (currentStatusLabel && !message.isEmpty() && setText(currentStatusLabel, message.c_str())) {
+        stats.progressWrites++;
     }
 }
 
@@ -446,18 +562,23 @@ void UniversalDialog::setProgressIndeterminate(bool indeterminate) {
 
 // Input dialog
 void UniversalDialog::showInput(const InputConfig& config, DialogSize size) {
-    closeDialog(false);  // Close any existing dialog
-
-    currentOverlay = createOverlay(lv_scr_act());
-    currentDialog = createDialogContainer(currentOverlay, size, DialogTheme::LIGHT);
+    Skeleton& skeleton = acquireSkeleton(SKELETON_INPUT, size, DialogTheme::LIGHT);
 
     // Title
-    if (!config.title.isEmpty()) {
-        createTitle(currentDialog, config.title, DialogTheme::LIGHT);
-    }
+    setText(skeleton.title, config.title.c_str());
+    setVisible(skeleton.title, !config.title.isEmpty());
 
     // Input section
-    createInputSection(currentDialog, config);
+    setText(skeleton.message, config.message.c_str());
+    lv_obj_t* field = skeleton.inputField;
+    if (lv_textarea_get_one_line(field) == config.multiline) {
+        lv_textarea_set_one_line(field, !config.multiline);
+        lv_obj_set_height(field, config.multiline ? 100 : 40);
+    }
+    lv_textarea_set_placeholder_text(field, config.placeholder.c_str());
+    lv_textarea_set_text(field, config.defaultValue.c_str());
+    lv_textarea_set_password_mode(field, config.isPassword);
+    lv_textarea_set_max_length(field, config.maxLength > 0 ? config.maxLength : 0);  // 0: no limit
 
     // Buttons
     std::vector<DialogButton> buttons;
@@ -474,32 +595,27 @@ void UniversalDialog::showInput(const InputConfig& config, DialogSize size) {
         if (config.onCancel) config.onCancel();
     });
 
-    createButtonPanel(currentDialog, buttons);
+    setButtons(skeleton, buttons);
 
+    present(skeleton);
     ESP_LOGI(TAG, "Input dialog shown: %s", config.title.c_str());
 }
 
 void UniversalDialog::showCustom(const String& title, const String& message, const std::vector<DialogButton>& buttons, DialogTheme theme, DialogSize size) {
-    closeDialog(false);  // Close any existing dialog
-
-    currentOverlay = createOverlay(lv_scr_act());
-    currentDialog = createDialogContainer(currentOverlay, size, theme);
+    Skeleton& skeleton = acquireSkeleton(SKELETON_MESSAGE, size, theme);
 
     // Title
-    if (!title.isEmpty()) {
-        createTitle(currentDialog, title, theme);
-    }
+    setText(skeleton.title, title.c_str());
+    setVisible(skeleton.title, !title.isEmpty());
 
     // Message
-    if (!message.isEmpty()) {
-        createMessage(currentDialog, message, theme);
-    }
+    setText(skeleton.message, message.c_str());
+    setVisible(skeleton.message, !message.isEmpty());
 
     // Buttons
-    if (!buttons.empty()) {
-        createButtonPanel(currentDialog, buttons);
-    }
+    setButtons(skeleton, buttons);
 
+    present(skeleton);
     ESP_LOGI(TAG, "Custom dialog shown: %s", title.c_str());
 }
 
@@ -516,43 +632,29 @@ void UniversalDialog::showQuickSuccess(const String& message) {
     showInfo("Success", message, nullptr, DialogSize::SMALL);
 }
 
-// Helper function to clean up button callbacks
-static void cleanupButtonCallbacks(lv_obj_t* parent) {
-    if (!parent) return;
-
-    // Find all buttons in the parent and unregister their callbacks
-    uint32_t childCount = lv_obj_get_child_cnt(parent);
-    for (uint32_t i = 0; i < childCount; i++) {
-        lv_obj_t* child = lv_obj_get_child(parent, i);
-        if (child) {
-            // Check if this is a button (has user data with callback index)
-            void* userData = lv_obj_get_user_data(child);
-            if (userData) {
-                size_t callbackIndex = (size_t)userData;
-                CallbackRegistry::unregisterCallback(callbackIndex);
-                lv_obj_set_user_data(child, nullptr);
-            }
-            // Recursively clean up children of this child
-            cleanupButtonCallbacks(child);
-        }
-    }
-}
-
 // Dialog management
 bool UniversalDialog::isDialogOpen() {
     return currentDialog != nullptr && lv_obj_is_valid(currentDialog);
 }
 
+// The skeleton is hidden and kept for the next dialog of its kind
 void UniversalDialog::closeDialog(bool animated) {
-    if (!currentDialog || !lv_obj_is_valid(currentDialog)) {
+    if (!currentSkeleton) {
         return;
     }
+    Skeleton& skeleton = *currentSkeleton;
 
-    // Clean up button callbacks before deleting the dialog
-    if (currentOverlay && lv_obj_is_valid(currentOverlay)) {
-        cleanupButtonCallbacks(currentOverlay);
-        lv_obj_del(currentOverlay);
+    if (skeleton.overlay && lv_obj_is_valid(skeleton.overlay)) {
+        if (skeleton.progressBar) {
+            lv_anim_delete(skeleton.progressBar, nullptr);
+        }
+        lv_obj_add_flag(skeleton.overlay, LV_OBJ_FLAG_HIDDEN);
+    }
+    // Releases what the callbacks captured; a running one works on a copy
+    for (DialogButtonSlot& slot : skeleton.buttons) {
+        slot.callback = nullptr;
     }
+    currentSkeleton = nullptr;
     currentDialog = nullptr;
     currentOverlay = nullptr;
     currentProgressBar = nullptr;
@@ -565,7 +667,6 @@ void UniversalDialog::closeDialog(bool animated) {
 void UniversalDialog::closeAll() {
     closeDialog(false);
     DialogManager::closeAllDialogs();
-    CallbackRegistry::cleanup(); // Clean up all callbacks when closing all dialogs
 }
 
 // Global settings
@@ -581,6 +682,138 @@ void UniversalDialog::setModalBackground(bool modal) {
     modalBackground = modal;
 }
 
+// =============================================================================
+// STATISTICS AND SELF TEST
+// =============================================================================
+
+DialogStats UniversalDialog::getStats() {
+    return stats;
+}
+
+String UniversalDialog::getStatus() {
+    uint32_t averagePooled = stats.pooledOpens ? stats.pooledOpenUs / stats.pooledOpens : 0;
+    String status = "Dialogs:\n";
+    status += "- Opens " + String(stats.opens) + ": built " + String(stats.builds) +
+              " (last " + String(stats.buildOpenUs) + " us), pooled " +
+              String(stats.pooledOpens) + " avg " + String(averagePooled) + " us max " +
+              String(stats.maxPooledOpenUs) + " us\n";
+    status += "- LVGL heap per open: last " + String(stats.lastOpenHeapBytes) +
+              " B, pooled max " + String(stats.maxPooledOpenHeapBytes) + " B\n";
+    status += "- Progress updates " + String(stats.progressUpdates) + ": " +
+              String(stats.progressWrites) + " bar/label writes\n";
+    return status;
+}
+
+bool UniversalDialog::runPoolBenchmark() {
+    const int CYCLES = 5;
+    const int PROGRESS_UPDATES = 20;
+
+    if (!Application::TaskManager::lvglTryLock(500)) {
+        ESP_LOGE(TAG, "Dialog bench: LVGL busy, not run");
+        return false;
+    }
+    bool dialogOpen = isDialogOpen();
+    Application::TaskManager::lvglUnlock();
+    if (dialogOpen) {
+        ESP_LOGW(TAG, "Dialog bench: a dialog is open, not run");
+        return false;
+    }
+
+    DialogStats before = getStats();
+    uint32_t pooledBuilds = 0;
+    int32_t firstCycleHeap = 0;
+    int32_t maxCycleHeap = 0;  // Cycles after the first, other UI work included
+
+    for (int cycle = 0; cycle < CYCLES; cycle++) {
+        if (!Application::TaskManager::lvglTryLock(500)) {
+            ESP_LOGE(TAG, "Dialog bench: LVGL busy, stopped");
+            return false;
+        }
+        int32_t heapBefore = lvglHeapUsed();
+        uint32_t buildsBefore = stats.builds;
+        Application::TaskManager::lvglUnlock();
+
+        for (int kind = 0; kind < SKELETON_COUNT; kind++) {
+            if (!Application::TaskManager::lvglTryLock(500)) {
+                ESP_LOGE(TAG, "Dialog bench: LVGL busy, stopped");
+                return false;
+            }
+            if (kind == SKELETON_PROGRESS) {
+                ProgressConfig progress;
+                progress.title = "DIALOG TEST";
+                progress.message = "Starting...";
+                showProgress(progress, DialogSize::MEDIUM);
+            } else if (kind == SKELETON_INPUT) {
+                InputConfig input;
+                input.title = "DIALOG TEST";
+                input.message = "Pooled input dialog";
+                input.placeholder = "Nothing to enter";
+                showInput(input, DialogSize::MEDIUM);
+            } else {
+                showConfirm("DIALOG TEST", "Pooled message dialog", []() {});
+            }
+            Application::TaskManager::lvglUnlock();
+            vTaskDelay(pdMS_TO_TICKS(50));  // Rendered
+
+            // Progress as a format reports it: every step moves the bar,
+            // the text changes now and then
+            for (int step = 0; kind == SKELETON_PROGRESS && step < PROGRESS_UPDATES; step++) {
+                if (Application::TaskManager::lvglTryLock(100)) {
+                    updateProgress(step * 100 / PROGRESS_UPDATES,
+                                   step < PROGRESS_UPDATES / 2 ? "Working..." : "Finishing...");
+                    Application::TaskManager::lvglUnlock();
+                }
+                vTaskDelay(pdMS_TO_TICKS(10));
+            }
+
+            if (Application::TaskManager::lvglTryLock(500)) {
+                closeDialog(false);
+                Application::TaskManager::lvglUnlock();
+            }
+            vTaskDelay(pdMS_TO_TICKS(20));
+        }
+
+        if (!Application::TaskManager::lvglTryLock(500)) {
+            ESP_LOGE(TAG, "Dialog bench: LVGL busy, stopped");
+            return false;
+        }
+        int32_t cycleHeap = lvglHeapUsed() - heapBefore;
+        uint32_t builds = stats.builds - buildsBefore;
+        Application::TaskManager::lvglUnlock();
+
+        if (cycle == 0) {
+            firstCycleHeap = cycleHeap;
+        } else {
+            pooledBuilds += builds;
+            if (cycleHeap > maxCycleHeap) {
+                maxCycleHeap = cycleHeap;
+            }
+        }
+    }
+    DialogStats after = getStats();
+
+    uint32_t pooledOpens = after.pooledOpens - before.pooledOpens;
+    uint32_t averagePooled = pooledOpens ? (after.pooledOpenUs - before.pooledOpenUs) / pooledOpens : 0;
+    uint32_t updates = after.progressUpdates - before.progressUpdates;
+    uint32_t writes = after.progressWrites - before.progressWrites;
+
+    // Before, every update set both the bar and the label
+    bool passed = pooledBuilds == 0 && writes < updates * 2;
+
+    ESP_LOGI(TAG, "Dialog bench: %lu opens, %lu built (last %lu us), %lu pooled avg %lu us max %lu us",
+             (unsigned long)(after.opens - before.opens), (unsigned long)(after.builds - before.builds),
+             (unsigned long)after.buildOpenUs, (unsigned long)pooledOpens,
+             (unsigned long)averagePooled, (unsigned long)after.maxPooledOpenUs);
+    ESP_LOGI(TAG, "Dialog bench: LVGL heap per open/close cycle of all kinds: first %ld B (skeletons), "
+                  "then max %ld B; pooled open max %ld B",
+             (long)firstCycleHeap, (long)maxCycleHeap, (long)after.maxPooledOpenHeapBytes);
+    ESP_LOGI(TAG, "Dialog bench: %lu progress updates -> %lu writes (both every time: %lu), "
+                  "%lu builds after the first cycle: %s",
+             (unsigned long)updates, (unsigned long)writes, (unsigned long)(updates * 2),
+             (unsigned long)pooledBuilds, passed ? "PASS" : "FAIL");
+    return passed;
+}
+
 // Dialog Manager implementation
 void DialogManager::registerDialog(UniversalDialog* dialog) {
     activeDialogs.push_back(dialog);
@@ -74,27 +74,55 @@ struct InputConfig {
     std::function<void()> onCancel = nullptr;
 };
 
+// Pooled dialog skeletons: how long opens take and what they cost the LVGL heap
+struct DialogStats {
+    uint32_t opens = 0;
+    uint32_t builds = 0;           // Skeletons created (first open of a kind)
+    uint32_t buildOpenUs = 0;      // Last open that built, what every open used to cost
+    uint32_t pooledOpens = 0;      // Opens that reconfigured a pooled skeleton
+    uint32_t pooledOpenUs = 0;     // All pooled opens
+    uint32_t maxPooledOpenUs = 0;
+    int32_t lastOpenHeapBytes = 0;     // LVGL heap taken by the last open
+    int32_t maxPooledOpenHeapBytes = 0;
+    uint32_t progressUpdates = 0;
+    uint32_t progressWrites = 0;   // Bar and label setters those updates called
+};
+
 // Main Universal Dialog class
+//
+// Dialogs are not created per call: each kind (message, progress, input) has
+// one skeleton that is built on its first use and then reconfigured, shown
+// and hidden again. Only one dialog is open at a time.
 class UniversalDialog {
    private:
+    struct Skeleton;
+
     static lv_obj_t* currentDialog;
     static lv_obj_t* currentOverlay;
     static lv_obj_t* currentProgressBar;
     static lv_obj_t* currentStatusLabel;
     static lv_obj_t* currentInputField;
+    static Skeleton* currentSkeleton;
+    static Skeleton skeletons[];  // One per kind, built on first use
 
     // Theme color schemes
     static lv_color_t getThemeColor(DialogTheme theme, bool isBackground = false);
     static void applyTheme(lv_obj_t* obj, DialogTheme theme);
 
-    // Dialog creation helpers
+    // Skeleton creation helpers, run once per skeleton
     static lv_obj_t* createOverlay(lv_obj_t* parent);
-    static lv_obj_t* createDialogContainer(lv_obj_t* parent, DialogSize size, DialogTheme theme);
-    static lv_obj_t* createTitle(lv_obj_t* parent, const String& title, DialogTheme theme);
-    static lv_obj_t* createMessage(lv_obj_t* parent, const String& message, DialogTheme theme);
-    static lv_obj_t* createButtonPanel(lv_obj_t* parent, const std::vector<DialogButton>& buttons);
-    static lv_obj_t* createProgressSection(lv_obj_t* parent, const ProgressConfig& config);
-    static lv_obj_t* createInputSection(lv_obj_t* parent, const InputConfig& config);
+    static lv_obj_t* createDialogContainer(lv_obj_t* parent);
+    static lv_obj_t* createTitle(lv_obj_t* parent);
+    static lv_obj_t* createMessage(lv_obj_t* parent);
+    static lv_obj_t* createButtonPanel(lv_obj_t* parent, Skeleton& skeleton);
+    static lv_obj_t* createProgressSection(lv_obj_t* parent, Skeleton& skeleton);
+    static lv_obj_t* createInputSection(lv_obj_t* parent, Skeleton& skeleton);
+    static void buildSkeleton(Skeleton& skeleton, lv_obj_t* screen);
+
+    // Pool helpers: take a skeleton and style it, set its content, show it
+    static Skeleton& acquireSkeleton(int kind, DialogSize size, DialogTheme theme);
+    static void setButtons(Skeleton& skeleton, const std::vector<DialogButton>& buttons);
+    static void present(Skeleton& skeleton);
 
     // Animation helpers
     static void animateIn(lv_obj_t* dialog);
@@ -148,6 +176,15 @@ class UniversalDialog {
     static void setDefaultTheme(DialogTheme theme);
     static void setAnimationEnabled(bool enabled);
     static void setModalBackground(bool modal);
+
+    // Open timings and LVGL heap use
+    static DialogStats getStats();
+    static String getStatus();
+
+    // Self test: opens and closes every kind of dialog a few times (takes the
+    // LVGL lock, so call it from another task) and checks that pooled opens
+    // build nothing and leave no LVGL heap behind
+    static bool runPoolBenchmark();
 };
 
 // Dialog manager for automatic cleanup and management
@@ -0,0 +1,390 @@
+#include "InvalidationTrace.h"
+
+#if UI_INVALIDATION_TRACE_ENABLED
+
+#include <esp_log.h>
+#include <esp_timer.h>
+#include <algorithm>
+#include <ui/ui.h>
+
+static const char *TAG = "InvalidationTrace";
+
+namespace Application {
+namespace InvalidationTrace {
+
+// =============================================================================
+// RECORDING
+// =============================================================================
+
+struct ObjectEntry {
+    lv_obj_t *obj = nullptr;  // nullptr: the "other" row
+    bool deleted = false;     // obj is gone, its address may be reused
+    uint32_t invalidations = 0;
+    uint64_t areaPx = 0;
+    uint64_t renderUs = 0;  // Estimated, share of the frames it was in
+    uint32_t framePx = 0;   // Invalidated in the frame being rendered
+};
+
+struct Totals {
+    uint32_t invalidations = 0;
+    uint64_t areaPx = 0;
+    uint32_t frames = 0;      // Frames that rendered something
+    uint32_t skippedFrames = 0;  // Also repainted the heat map, not timed
+    uint64_t renderUs = 0;    // LV_EVENT_RENDER_START to LV_EVENT_RENDER_READY
+    uint32_t maxRenderUs = 0;
+    uint64_t refreshUs = 0;   // Whole refresh including flush
+};
+
+static const int GRID_COLUMNS = (DISPLAY_WIDTH + UI_INVALIDATION_TRACE_CELL_PX - 1) / UI_INVALIDATION_TRACE_CELL_PX;
+static const int GRID_ROWS = (DISPLAY_HEIGHT + UI_INVALIDATION_TRACE_CELL_PX - 1) / UI_INVALIDATION_TRACE_CELL_PX;
+
+static bool running = false;
+static bool hooked = false;
+static bool ignoring = false;  // Heat-map repaints
+static bool overlayInFrame = false;
+static ObjectEntry objects[UI_INVALIDATION_TRACE_OBJECTS];
+static ObjectEntry other;
+static uint16_t objectCount = 0;
+static uint32_t heat[GRID_ROWS][GRID_COLUMNS];
+static Totals totals;
+static int64_t refreshStartUs = 0;
+static int64_t renderStartUs = 0;
+static uint32_t frameRenderUs = 0;
+static uint32_t framePx = 0;
+
+static lv_obj_t *heatMap = nullptr;
+static lv_timer_t *heatMapTimer = nullptr;
+
+// Deepest visible object whose drawn area holds 'area', topmost child first
+static lv_obj_t *findOwner(lv_obj_t *parent, const lv_area_t *area) {
+    uint32_t count = lv_obj_get_child_count(parent);
+    for (int32_t i = (int32_t)count - 1; i >= 0; i--) {
+        lv_obj_t *child = lv_obj_get_child(parent, i);
+        if (child == heatMap || lv_obj_has_flag(child, LV_OBJ_FLAG_HIDDEN)) {
+            continue;
+        }
+        lv_area_t coords;
+        lv_obj_get_coords(child, &coords);
+        int32_t ext = lv_obj_get_ext_draw_size(child);
+        lv_area_increase(&coords, ext, ext);
+        if (lv_area_is_in(area, &coords, 0)) {
+            return findOwner(child, area);
+        }
+    }
+    return parent;
+}
+
+// Keeps the counts of a deleted object, and keeps a new object created at
+// the same address out of its row
+static void onObjectDeleted(lv_event_t *e) {
+    lv_obj_t *obj = static_cast<lv_obj_t *>(lv_event_get_target(e));
+    for (uint16_t i = 0; i < objectCount; i++) {
+        if (objects[i].obj == obj) {
+            objects[i].deleted = true;
+        }
+    }
+}
+
+static ObjectEntry &entryFor(lv_obj_t *obj) {
+    for (uint16_t i = 0; i < objectCount; i++) {
+        if (objects[i].obj == obj && !objects[i].deleted) {
+            return objects[i];
+        }
+    }
+    if (objectCount < UI_INVALIDATION_TRACE_OBJECTS) {
+        objects[objectCount].obj = obj;
+        lv_obj_add_event_cb(obj, onObjectDeleted, LV_EVENT_DELETE, nullptr);
+        return objects[objectCount++];
+    }
+    return other;
+}
+
+static void addHeat(const lv_area_t *area) {
+    int firstColumn = std::max<int>(area->x1 / UI_INVALIDATION_TRACE_CELL_PX, 0);
+    int lastColumn = std::min<int>(area->x2 / UI_INVALIDATION_TRACE_CELL_PX, GRID_COLUMNS - 1);
+    int firstRow = std::max<int>(area->y1 / UI_INVALIDATION_TRACE_CELL_PX, 0);
+    int lastRow = std::min<int>(area->y2 / UI_INVALIDATION_TRACE_CELL_PX, GRID_ROWS - 1);
+    for (int row = firstRow; row <= lastRow; row++) {
+        for (int column = firstColumn; column <= lastColumn; column++) {
+            heat[row][column]++;
+        }
+    }
+}
+
+static void onInvalidateArea(lv_event_t *e) {
+    const lv_area_t *area = static_cast<const lv_area_t *>(lv_event_get_param(e));
+    if (ignoring) {
+        overlayInFrame = true;
+        return;
+    }
+    if (!running || !area) {
+        return;
+    }
+    lv_display_t *display = static_cast<lv_display_t *>(lv_event_get_current_target(e));
+    lv_obj_t *owner = findOwner(lv_display_get_layer_top(display), area);
+    if (owner == lv_display_get_layer_top(display)) {
+        owner = findOwner(lv_display_get_screen_active(display), area);
+    }
+
+    uint32_t px = lv_area_get_size(area);
+    ObjectEntry &entry = entryFor(owner);
+    entry.invalidations++;
+    entry.areaPx += px;
+    entry.framePx += px;
+    framePx += px;
+    totals.invalidations++;
+    totals.areaPx += px;
+    addHeat(area);
+}
+
+static void onRefreshStart(lv_event_t *e) {
+    refreshStartUs = esp_timer_get_time();
+    frameRenderUs = 0;
+}
+
+static void onRenderStart(lv_event_t *e) {
+    renderStartUs = esp_timer_get_time();
+}
+
+static void onRenderReady(lv_event_t *e) {
+    frameRenderUs += (uint32_t)(esp_timer_get_time() - renderStartUs);
+}
+
+// Charge the frame to the objects that asked for it. A frame that also
+// repainted the heat map is not timed at all: the overlay's share cannot be
+// told apart from theirs.
+static void onRefreshReady(lv_event_t *e) {
+    bool skip = overlayInFrame;
+    overlayInFrame = false;
+    if (!running || framePx == 0) {
+        return;
+    }
+    if (skip) {
+        totals.skippedFrames++;
+        for (uint16_t i = 0; i < objectCount; i++) {
+            objects[i].framePx = 0;
+        }
+        other.framePx = 0;
+        framePx = 0;
+        return;
+    }
+    totals.frames++;
+    totals.renderUs += frameRenderUs;
+    totals.refreshUs += (uint32_t)(esp_timer_get_time() - refreshStartUs);
+    if (frameRenderUs > totals.maxRenderUs) {
+        totals.maxRenderUs = frameRenderUs;
+    }
+    for (uint16_t i = 0; i <= objectCount; i++) {
+        ObjectEntry &entry = i < objectCount ? objects[i] : other;
+        if (entry.framePx) {
+            entry.renderUs += (uint64_t)frameRenderUs * entry.framePx / framePx;
+            entry.framePx = 0;
+        }
+    }
+    framePx = 0;
+}
+
+static bool hookDisplay(void) {
+    lv_display_t *display = lv_display_get_default();
+    if (!display) {
+        return false;
+    }
+    if (!hooked) {
+        lv_display_add_event_cb(display, onInvalidateArea, LV_EVENT_INVALIDATE_AREA, nullptr);
+        lv_display_add_event_cb(display, onRefreshStart, LV_EVENT_REFR_START, nullptr);
+        lv_display_add_event_cb(display, onRenderStart, LV_EVENT_RENDER_START, nullptr);
+        lv_display_add_event_cb(display, onRenderReady, LV_EVENT_RENDER_READY, nullptr);
+        lv_display_add_event_cb(display, onRefreshReady, LV_EVENT_REFR_READY, nullptr);
+        hooked = true;
+    }
+    return true;
+}
+
+void start(void) {
+    if (!hookDisplay()) {
+        ESP_LOGW(TAG, "No display, not started");
+        return;
+    }
+    for (uint16_t i = 0; i < objectCount; i++) {
+        if (objects[i].obj && !objects[i].deleted) {
+            lv_obj_remove_event_cb(objects[i].obj, onObjectDeleted);
+        }
+    }
+    objectCount = 0;
+    for (ObjectEntry &entry : objects) {
+        entry = ObjectEntry();
+    }
+    other = ObjectEntry();
+    memset(heat, 0, sizeof(heat));
+    totals = Totals();
+    framePx = 0;
+    running = true;
+    ESP_LOGI(TAG, "Recording invalidations");
+}
+
+void stop(void) {
+    running = false;
+    ESP_LOGI(TAG, "Stopped after %lu invalidations, %lu frames", (unsigned long)totals.invalidations,
+             (unsigned long)totals.frames);
+}
+
+bool isRunning(void) {
+    return running;
+}
+
+// =============================================================================
+// HEAT-MAP OVERLAY
+// =============================================================================
+
+static void onDrawHeatMap(lv_event_t *e) {
+    uint32_t hottest = 0;
+    for (int row = 0; row < GRID_ROWS; row++) {
+        for (int column = 0; column < GRID_COLUMNS; column++) {
+            hottest = std::max(hottest, heat[row][column]);
+        }
+    }
+    if (hottest == 0) {
+        return;
+    }
+
+    lv_layer_t *layer = lv_event_get_layer(e);
+    lv_draw_rect_dsc_t cell;
+    lv_draw_rect_dsc_init(&cell);
+    cell.bg_color = lv_color_hex(0xFF2000);
+    for (int row = 0; row < GRID_ROWS; row++) {
+        for (int column = 0; column < GRID_COLUMNS; column++) {
+            if (heat[row][column] == 0) {
+                continue;
+            }
+            cell.bg_opa = (lv_opa_t)(40 + 160 * heat[row][column] / hottest);
+            lv_area_t area = {
+                (int32_t)(column * UI_INVALIDATION_TRACE_CELL_PX),
+                (int32_t)(row * UI_INVALIDATION_TRACE_CELL_PX),
+                (int32_t)((column + 1) * UI_INVALIDATION_TRACE_CELL_PX - 1),
+                (int32_t)((row + 1) * UI_INVALIDATION_TRACE_CELL_PX - 1)};
+            lv_draw_rect(layer, &cell, &area);
+        }
+    }
+}
+
+static void repaintHeatMap(lv_timer_t *timer) {
+    if (!heatMap) {
+        return;
+    }
+    ignoring = true;
+    lv_obj_invalidate(heatMap);
+    ignoring = false;
+}
+
+void showHeatMap(bool show) {
+    if (show == isHeatMapShown()) {
+        return;
+    }
+    ignoring = true;
+    if (show) {
+        heatMap = lv_obj_create(lv_layer_top());
+        lv_obj_remove_style_all(heatMap);
+        lv_obj_set_size(heatMap, LV_PCT(100), LV_PCT(100));
+        lv_obj_remove_flag(heatMap, LV_OBJ_FLAG_CLICKABLE);
+        lv_obj_remove_flag(heatMap, LV_OBJ_FLAG_SCROLLABLE);
+        lv_obj_add_event_cb(heatMap, onDrawHeatMap, LV_EVENT_DRAW_MAIN, nullptr);
+        heatMapTimer = lv_timer_create(repaintHeatMap, UI_INVALIDATION_TRACE_HEATMAP_MS, nullptr);
+    } else {
+        lv_timer_delete(heatMapTimer);
+        lv_obj_delete(heatMap);
+        heatMapTimer = nullptr;
+        heatMap = nullptr;
+    }
+    ignoring = false;
+}
+
+bool isHeatMapShown(void) {
+    return heatMap != nullptr;
+}
+
+// =============================================================================
+// REPORT
+// =============================================================================
+
+// The generated screens name their widgets only through these globals
+static const char *widgetName(lv_obj_t *obj) {
+    static const struct {
+        lv_obj_t **widget;
+        const char *name;
+    } names[] = {
+        {&ui_screenMain, "ui_screenMain"},
+        {&ui_tabsModeSwitch, "ui_tabsModeSwitch"},
+        {&ui_primaryVolumeSlider, "ui_primaryVolumeSlider"},
+        {&ui_lblPrimaryVolumeSlider, "ui_lblPrimaryVolumeSlider"},
+        {&ui_singleVolumeSlider, "ui_singleVolumeSlider"},
+        {&ui_lblSingleVolumeSlider, "ui_lblSingleVolumeSlider"},
+        {&ui_balanceVolumeSlider, "ui_balanceVolumeSlider"},
+        {&ui_lblBalanceVolumeSlider, "ui_lblBalanceVolumeSlider"},
+        {&ui_selectAudioDevice, "ui_selectAudioDevice"},
+        {&ui_selectAudioDevice1, "ui_selectAudioDevice1"},
+        {&ui_selectAudioDevice2, "ui_selectAudioDevice2"},
+        {&ui_lblPrimaryAudioDeviceValue, "ui_lblPrimaryAudioDeviceValue"},
+        {&ui_lblFPS, "ui_lblFPS"},
+        {&ui_lblBuildTimeValue, "ui_lblBuildTimeValue"},
+        {&ui_statusView, "ui_statusView"},
+        {&ui_img, "ui_img"},
+    };
+    for (const auto &entry : names) {
+        if (*entry.widget == obj) {
+            return entry.name;
+        }
+    }
+    return nullptr;
+}
+
+static String describe(const ObjectEntry &entry) {
+    lv_obj_t *obj = entry.obj;
+    if (!obj) {
+        return "(other objects)";
+    }
+    if (entry.deleted) {
+        return "(deleted)";
+    }
+    const char *name = widgetName(obj);
+    const lv_obj_class_t *objClass = lv_obj_get_class(obj);
+    lv_area_t coords;
+    lv_obj_get_coords(obj, &coords);
+    return String(name ? name : (objClass && objClass->name ? objClass->name : "obj")) + " " +
+           String(lv_area_get_width(&coords)) + "x" + String(lv_area_get_height(&coords)) + "@" +
+           String(coords.x1) + "," + String(coords.y1);
+}
+
+String getReport(void) {
+    ObjectEntry *ranked[UI_INVALIDATION_TRACE_OBJECTS + 1];
+    uint16_t count = 0;
+    for (uint16_t i = 0; i < objectCount; i++) {
+        ranked[count++] = &objects[i];
+    }
+    if (other.invalidations) {
+        ranked[count++] = &other;
+    }
+    std::sort(ranked, ranked + count,
+              [](const ObjectEntry *a, const ObjectEntry *b) { return a->areaPx > b->areaPx; });
+
+    uint32_t averageUs = totals.frames ? (uint32_t)(totals.renderUs / totals.frames) : 0;
+    String report = "Invalidation trace" + String(running ? " (recording)" : "") + ":\n";
+    report += "- " + String(totals.invalidations) + " invalidations, " +
+              String((uint32_t)(totals.areaPx / 1000)) + " kpx, " + String(totals.frames) +
+              " frames, render avg " + String(averageUs) + " us max " +
+              String(totals.maxRenderUs) + " us, refresh " +
+              String((uint32_t)(totals.refreshUs / 1000)) + " ms total, " +
+              String(totals.skippedFrames) + " frames with the heat map not timed\n";
+    for (uint16_t i = 0; i < count && i < UI_INVALIDATION_TRACE_REPORT_ROWS; i++) {
+        const ObjectEntry &entry = *ranked[i];
+        uint32_t share = totals.areaPx ? (uint32_t)(entry.areaPx * 100 / totals.areaPx) : 0;
+        report += String(i + 1) + ". " + describe(entry) + ": " + String(entry.invalidations) +
+                  " x, " + String((uint32_t)(entry.areaPx / 1000)) + " kpx (" + String(share) +
+                  "%), ~" + String((uint32_t)(entry.renderUs / 1000)) + " ms render\n";
+    }
+    return report;
+}
+
+}  // namespace InvalidationTrace
+}  // namespace Application
+
+#endif  // UI_INVALIDATION_TRACE_ENABLED
@@ -0,0 +1,53 @@
+#ifndef INVALIDATION_TRACE_H
+#define INVALIDATION_TRACE_H
+
+#include <Arduino.h>
+#include <lvgl.h>
+
+// Instrumentation of LVGL redraws, off in normal builds. Enable with
+// -D UI_INVALIDATION_TRACE_ENABLED=1; when 0 nothing below is compiled
+// and no LVGL event is hooked.
+#ifndef UI_INVALIDATION_TRACE_ENABLED
+#define UI_INVALIDATION_TRACE_ENABLED 0
+#endif
+
+#if UI_INVALIDATION_TRACE_ENABLED
+
+namespace Application {
+namespace InvalidationTrace {
+
+// =============================================================================
+// INVALIDATION TRACE
+// =============================================================================
+
+#define UI_INVALIDATION_TRACE_OBJECTS 48       // Objects tracked, the rest count as "other"
+#define UI_INVALIDATION_TRACE_CELL_PX 40       // Heat-map cell size
+#define UI_INVALIDATION_TRACE_REPORT_ROWS 16   // Objects listed in the report
+#define UI_INVALIDATION_TRACE_HEATMAP_MS 1000  // Heat-map repaint period
+
+// Every invalidated area is charged to the deepest visible object that
+// contains it (top layer first, then the active screen), and to the
+// heat-map cells it covers. A frame's render time is split between the
+// objects by their share of its invalidated pixels.
+//
+// All functions run on the LVGL task or under the LVGL lock.
+
+// Clear the counters and start recording
+void start(void);
+void stop(void);
+bool isRunning(void);
+
+// Translucent overlay on the top layer, hotter cells more opaque red. Its
+// own repaints are not recorded.
+void showHeatMap(bool show);
+bool isHeatMapShown(void);
+
+// Objects ranked by invalidated pixels, with counts and estimated render time
+String getReport(void);
+
+}  // namespace InvalidationTrace
+}  // namespace Application
+
+#endif  // UI_INVALIDATION_TRACE_ENABLED
+
+#endif  // INVALIDATION_TRACE_H
@@ -0,0 +1,328 @@
+#include "UIBenchmark.h"
+#include "../../../core/TaskManager.h"
+#include "../LVGLMessageHandler.h"
+#include "../dialogs/UniversalDialog.h"
+#include "VolumeWidgetMacros.h"
+#include <esp_log.h>
+#include <esp_timer.h>
+#include <ui/ui.h>
+
+static const char *TAG = "UIBenchmark";
+
+namespace Application {
+namespace UIBenchmark {
+
+// Tabs of ui_tabsModeSwitch
+static const uint32_t TAB_MASTER = 0;
+static const uint32_t TAB_SINGLE = 1;
+
+// =============================================================================
+// FRAME RECORDING
+// =============================================================================
+
+// Written by the display events on the LVGL task, read and reset under the
+// LVGL lock
+static bool recording = false;
+static bool eventsHooked = false;
+static int64_t frameStartUs = 0;
+static uint32_t pendingAreaPx = 0;
+static ScenarioResult current;
+static int32_t memStart = 0;
+
+static void onInvalidateArea(lv_event_t *e) {
+    const lv_area_t *area = static_cast<const lv_area_t *>(lv_event_get_param(e));
+    if (recording && area) {
+        pendingAreaPx += lv_area_get_size(area);
+    }
+}
+
+static void onRefreshStart(lv_event_t *e) {
+    frameStartUs = esp_timer_get_time();
+}
+
+// Invalidations made by the refresh's own layout pass belong to its frame
+static void onRefreshReady(lv_event_t *e) {
+    if (!recording || pendingAreaPx == 0) {
+        return;
+    }
+    uint32_t renderUs = (uint32_t)(esp_timer_get_time() - frameStartUs);
+    current.frames++;
+    current.renderUs += renderUs;
+    if (renderUs > current.maxRenderUs) {
+        current.maxRenderUs = renderUs;
+    }
+    current.areaPx += pendingAreaPx;
+    if (pendingAreaPx > current.maxAreaPx) {
+        current.maxAreaPx = pendingAreaPx;
+    }
+    pendingAreaPx = 0;
+}
+
+static bool hookDisplayEvents(void) {
+    lv_display_t *display = lv_display_get_default();
+    if (!display) {
+        return false;
+    }
+    if (!eventsHooked) {
+        lv_display_add_event_cb(display, onInvalidateArea, LV_EVENT_INVALIDATE_AREA, nullptr);
+        lv_display_add_event_cb(display, onRefreshStart, LV_EVENT_REFR_START, nullptr);
+        lv_display_add_event_cb(display, onRefreshReady, LV_EVENT_REFR_READY, nullptr);
+        eventsHooked = true;
+    }
+    return true;
+}
+
+static int32_t lvglHeapUsed(void) {
+    lv_mem_monitor_t monitor;
+    lv_mem_monitor(&monitor);
+    return (int32_t)(monitor.total_size - monitor.free_size);
+}
+
+static void sampleMemory(void) {
+    int32_t used = lvglHeapUsed() - memStart;
+    if (used > current.memPeakBytes) {
+        current.memPeakBytes = used;
+    }
+}
+
+// =============================================================================
+// SCENARIOS
+// =============================================================================
+
+// Every scenario puts back what it changed; widgets are set directly, which
+// sends no VALUE_CHANGED, so the host never sees the benchmark
+struct Scenario {
+    const char *name;
+    int steps;
+    int param;
+    void (*setup)(int param);
+    void (*step)(int index, int param);
+    void (*teardown)(int param);
+};
+
+static uint32_t savedTab = 0;
+
+static void saveTab(int param) {
+    savedTab = lv_tabview_get_tab_active(ui_tabsModeSwitch);
+}
+
+static void restoreTab(int param) {
+    lv_tabview_set_active(ui_tabsModeSwitch, savedTab, LV_ANIM_OFF);
+}
+
+static void switchTab(int index, int param) {
+    uint32_t tabs = lv_tabview_get_tab_count(ui_tabsModeSwitch);
+    lv_tabview_set_active(ui_tabsModeSwitch, tabs ? index % tabs : 0, LV_ANIM_OFF);
+}
+
+// Dropdown rebuilds alternate between 'param' made-up devices and the
+// options shown before
+static String savedOptions[3];
+static uint32_t savedSelected[3];
+static char benchOptions[64 * 20];
+
+static lv_obj_t *benchDropdown(int index) {
+    lv_obj_t *dropdowns[] = {ui_selectAudioDevice, ui_selectAudioDevice1, ui_selectAudioDevice2};
+    return dropdowns[index];
+}
+
+static void saveDropdowns(int param) {
+    saveTab(param);
+    lv_tabview_set_active(ui_tabsModeSwitch, TAB_SINGLE, LV_ANIM_OFF);
+    for (int i = 0; i < 3; i++) {
+        lv_obj_t *dropdown = benchDropdown(i);
+        savedOptions[i] = dropdown ? lv_dropdown_get_options(dropdown) : "";
+        savedSelected[i] = dropdown ? lv_dropdown_get_selected(dropdown) : 0;
+    }
+
+    size_t length = 0;
+    benchOptions[0] = '\0';
+    for (int device = 0; device < param; device++) {
+        length += snprintf(benchOptions + length, sizeof(benchOptions) - length,
+                           "%sbench_device_%02d.exe", device ? "\n" : "", device);
+        if (length >= sizeof(benchOptions)) {
+            break;
+        }
+    }
+}
+
+static void rebuildDropdowns(int index, int param) {
+    for (int i = 0; i < 3; i++) {
+        lv_obj_t *dropdown = benchDropdown(i);
+        if (dropdown) {
+            lv_dropdown_set_options(dropdown, index % 2 ? savedOptions[i].c_str() : benchOptions);
+        }
+    }
+}
+
+static void restoreDropdowns(int param) {
+    for (int i = 0; i < 3; i++) {
+        lv_obj_t *dropdown = benchDropdown(i);
+        if (dropdown) {
+            lv_dropdown_set_options(dropdown, savedOptions[i].c_str());
+            lv_dropdown_set_selected(dropdown, savedSelected[i]);
+            savedOptions[i] = "";
+        }
+    }
+    restoreTab(param);
+}
+
+// Volume scrubs move the Master slider and its label as a drag would
+static int savedVolume = 0;
+
+static void setBenchVolume(int volume) {
+    VOLUME_WIDGET_SET_VALUE(ui_primaryVolumeSlider, volume);
+    if (ui_lblPrimaryVolumeSlider) {
+        char volumeText[16];
+        snprintf(volumeText, sizeof(volumeText), "%d%%", volume);
+        lv_label_set_text(ui_lblPrimaryVolumeSlider, volumeText);
+    }
+}
+
+static void saveVolume(int param) {
+    saveTab(param);
+    lv_tabview_set_active(ui_tabsModeSwitch, TAB_MASTER, LV_ANIM_OFF);
+    savedVolume = VOLUME_WIDGET_GET_VALUE(ui_primaryVolumeSlider);
+}
+
+static void scrubVolume(int index, int param) {
+    // Up and down in 'param' steps
+    int position = index % (2 * param);
+    int volume = position < param ? position * 100 / param : (2 * param - position) * 100 / param;
+    setBenchVolume(volume);
+}
+
+static void restoreVolume(int param) {
+    setBenchVolume(savedVolume);
+    restoreTab(param);
+}
+
+// Overlays open on even steps and close on odd ones
+static void noSetup(int param) {}
+
+static void toggleOverview(int index, int param) {
+    if (index % 2 == 0) {
+        LVGLMessageHandler::showStateOverview();
+    } else {
+        LVGLMessageHandler::hideStateOverview();
+    }
+}
+
+static void toggleDialog(int index, int param) {
+    if (index % 2 == 0) {
+        UI::Dialog::UniversalDialog::showInfo("UI BENCHMARK", "Dialog open/close scenario");
+    } else {
+        UI::Dialog::UniversalDialog::closeDialog(false);
+    }
+}
+
+static void closeBenchDialog(int param) {
+    UI::Dialog::UniversalDialog::closeDialog(false);
+}
+
+static const Scenario scenarios[] = {
+    {"tabs", 12, 0, saveTab, switchTab, restoreTab},
+    {"dropdown4", 8, 4, saveDropdowns, rebuildDropdowns, restoreDropdowns},
+    {"dropdown16", 8, 16, saveDropdowns, rebuildDropdowns, restoreDropdowns},
+    {"dropdown32", 8, 32, saveDropdowns, rebuildDropdowns, restoreDropdowns},
+    {"volume", 40, 20, saveVolume, scrubVolume, restoreVolume},
+    {"overview", 8, 0, noSetup, toggleOverview, noSetup},
+    {"dialog", 8, 0, noSetup, toggleDialog, closeBenchDialog},
+};
+
+// =============================================================================
+// RUNNER
+// =============================================================================
+
+static bool runScenario(const Scenario &scenario, ScenarioResult &result) {
+    result = ScenarioResult();
+    result.name = scenario.name;
+    vTaskDelay(pdMS_TO_TICKS(UI_BENCH_SETTLE_MS));
+    if (!TaskManager::lvglTryLock(500)) {
+        return false;
+    }
+    current = ScenarioResult();
+    current.name = scenario.name;
+    memStart = lvglHeapUsed();
+    pendingAreaPx = 0;
+    scenario.setup(scenario.param);
+    recording = true;
+    TaskManager::lvglUnlock();
+
+    for (int step = 0; step < scenario.steps; step++) {
+        if (!TaskManager::lvglTryLock(500)) {
+            break;
+        }
+        scenario.step(step, scenario.param);
+        current.steps++;
+        sampleMemory();
+        TaskManager::lvglUnlock();
+        vTaskDelay(pdMS_TO_TICKS(UI_BENCH_STEP_MS));
+    }
+
+    // The teardown always runs, the UI must end up as it was
+    while (!TaskManager::lvglTryLock(500)) {
+        ESP_LOGW(TAG, "%s: waiting for LVGL to tear down", scenario.name);
+    }
+    recording = false;
+    scenario.teardown(scenario.param);
+    TaskManager::lvglUnlock();
+    vTaskDelay(pdMS_TO_TICKS(UI_BENCH_STEP_MS));
+
+    if (TaskManager::lvglTryLock(500)) {
+        current.memAfterBytes = lvglHeapUsed() - memStart;
+        TaskManager::lvglUnlock();
+    }
+    result = current;
+    return result.steps == (uint32_t)scenario.steps;
+}
+
+bool runScenarios(std::vector<ScenarioResult> *results) {
+    if (!TaskManager::lvglTryLock(500)) {
+        ESP_LOGE(TAG, "LVGL busy, not run");
+        return false;
+    }
+    bool ready = hookDisplayEvents() && ui_tabsModeSwitch && lv_scr_act() == ui_screenMain &&
+                 !UI::Dialog::UniversalDialog::isDialogOpen();
+    lv_display_t *display = lv_display_get_default();
+    uint32_t screenPx = display ? lv_display_get_horizontal_resolution(display) *
+                                      lv_display_get_vertical_resolution(display)
+                                : 1;
+    TaskManager::lvglUnlock();
+    if (!ready) {
+        ESP_LOGW(TAG, "Needs the main screen without an open dialog, not run");
+        return false;
+    }
+
+    if (results) {
+        results->clear();
+    }
+    bool completed = true;
+    int64_t startUs = esp_timer_get_time();
+    for (const Scenario &scenario : scenarios) {
+        ScenarioResult result;
+        if (!runScenario(scenario, result)) {
+            ESP_LOGW(TAG, "%s: LVGL busy, ran %lu of %d steps", scenario.name,
+                     (unsigned long)result.steps, scenario.steps);
+            completed = false;
+        }
+        uint32_t averageUs = result.frames ? (uint32_t)(result.renderUs / result.frames) : 0;
+        uint32_t averagePx = result.frames ? (uint32_t)(result.areaPx / result.frames) : 0;
+        ESP_LOGI(TAG, "UIBENCH %s steps=%lu frames=%lu render_avg_us=%lu render_max_us=%lu "
+                      "area_avg_px=%lu area_max_px=%lu area_max_pct=%lu mem_peak_b=%ld mem_after_b=%ld",
+                 result.name, (unsigned long)result.steps, (unsigned long)result.frames,
+                 (unsigned long)averageUs, (unsigned long)result.maxRenderUs,
+                 (unsigned long)averagePx, (unsigned long)result.maxAreaPx,
+                 (unsigned long)((uint64_t)result.maxAreaPx * 100 / screenPx),
+                 (long)result.memPeakBytes, (long)result.memAfterBytes);
+        if (results) {
+            results->push_back(result);
+        }
+    }
+    ESP_LOGI(TAG, "UIBENCH done in %lu ms%s", (unsigned long)((esp_timer_get_time() - startUs) / 1000),
+             completed ? "" : " (incomplete)");
+    return completed;
+}
+
+}  // namespace UIBenchmark
+}  // namespace Application
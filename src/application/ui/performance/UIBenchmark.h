@@ -0,0 +1,43 @@
+#ifndef UI_BENCHMARK_H
+#define UI_BENCHMARK_H
+
+#include <Arduino.h>
+#include <lvgl.h>
+#include <vector>
+
+namespace Application {
+namespace UIBenchmark {
+
+// =============================================================================
+// RENDER BENCHMARK
+// =============================================================================
+
+// Each scenario step is one UI change made under the LVGL lock; the LVGL
+// task then gets this long to lay out, render and flush it
+#define UI_BENCH_STEP_MS 80
+#define UI_BENCH_SETTLE_MS 200  // Before a scenario, so earlier work is not counted
+
+// What the display did while a scenario ran. Only frames that had something
+// to redraw are counted.
+struct ScenarioResult {
+    const char *name = "";
+    uint32_t steps = 0;
+    uint32_t frames = 0;
+    uint64_t renderUs = 0;    // LV_EVENT_REFR_START to LV_EVENT_REFR_READY
+    uint32_t maxRenderUs = 0;
+    uint64_t areaPx = 0;      // Invalidated pixels, overlaps counted twice
+    uint32_t maxAreaPx = 0;   // Most in one frame
+    int32_t memPeakBytes = 0;   // LVGL heap in use at the peak, above the start
+    int32_t memAfterBytes = 0;  // LVGL heap left in use after the teardown
+};
+
+// Runs every scenario on the main screen of the real UI and logs one
+// "UIBENCH" line per scenario, meant to be diffed between builds. Takes the
+// LVGL lock step by step, so call it from another task. Also fills
+// 'results', if given, with one entry per scenario.
+bool runScenarios(std::vector<ScenarioResult> *results = nullptr);
+
+}  // namespace UIBenchmark
+}  // namespace Application
+
+#endif  // UI_BENCHMARK_H
@@ -0,0 +1,130 @@
+#include "FrameScheduler.h"
+#include <esp_log.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+static const char *TAG = "FrameScheduler";
+
+namespace Application {
+namespace FrameScheduler {
+
+static_assert(UI_BUDGET_MESSAGES_US + UI_BUDGET_AUDIO_UI_US + UI_BUDGET_HOUSEKEEPING_US <
+                  UI_FRAME_TARGET_US,
+              "Work budgets must leave room for rendering within the frame");
+
+static const uint32_t budgets[WORK_COUNT] = {
+    UI_BUDGET_MESSAGES_US,
+    UI_BUDGET_AUDIO_UI_US,
+    UI_BUDGET_HOUSEKEEPING_US,
+};
+
+static const char *workNames[WORK_COUNT] = {
+    "Messages",
+    "Audio UI",
+    "Housekeeping",
+};
+
+// Only touched by lvglTask; getStats() copies are for debug output
+static Stats stats;
+static int64_t frameStartUs = 0;
+static int64_t passStartUs = 0;
+static uint32_t spentThisFrame[WORK_COUNT];
+static bool overranThisFrame[WORK_COUNT];
+static bool deferredThisFrame[WORK_COUNT];
+
+// =============================================================================
+// FRAMES
+// =============================================================================
+
+static void closeFrame(void) {
+    for (int work = 0; work < WORK_COUNT; work++) {
+        WorkStats &workStats = stats.work[work];
+        workStats.spentUs += spentThisFrame[work];
+        if (spentThisFrame[work] > workStats.maxFrameUs) {
+            workStats.maxFrameUs = spentThisFrame[work];
+        }
+        workStats.overruns += overranThisFrame[work];
+        workStats.deferrals += deferredThisFrame[work];
+
+        spentThisFrame[work] = 0;
+        overranThisFrame[work] = false;
+        deferredThisFrame[work] = false;
+    }
+    stats.frames++;
+}
+
+void beginPass(void) {
+    passStartUs = esp_timer_get_time();
+    if (frameStartUs == 0) {
+        frameStartUs = passStartUs;
+        return;
+    }
+    if (passStartUs - frameStartUs >= UI_FRAME_TARGET_US) {
+        closeFrame();
+        frameStartUs = passStartUs;
+    }
+}
+
+uint32_t endPass(void) {
+    uint32_t passUs = (uint32_t)(esp_timer_get_time() - passStartUs);
+    if (passUs > stats.maxPassUs) {
+        stats.maxPassUs = passUs;
+    }
+    if (passUs > UI_FRAME_TARGET_US) {
+        stats.longFrames++;
+        ESP_LOGD(TAG, "lvglTask pass took %lu us (frame %d us)", (unsigned long)passUs,
+                 UI_FRAME_TARGET_US);
+    }
+
+    uint32_t passMs = passUs / 1000;
+    uint32_t sleepMs = passMs < UI_TASK_PERIOD_MS ? UI_TASK_PERIOD_MS - passMs : 0;
+    return sleepMs > portTICK_PERIOD_MS ? sleepMs : portTICK_PERIOD_MS;
+}
+
+// =============================================================================
+// BUDGETS
+// =============================================================================
+
+bool hasBudget(Work work) {
+    return spentThisFrame[work] < budgets[work];
+}
+
+void charge(Work work, uint32_t us) {
+    spentThisFrame[work] += us;
+    if (spentThisFrame[work] > budgets[work]) {
+        overranThisFrame[work] = true;
+    }
+}
+
+void defer(Work work) {
+    deferredThisFrame[work] = true;
+}
+
+Stats getStats(void) {
+    Stats copy = stats;
+    for (int work = 0; work < WORK_COUNT; work++) {
+        copy.work[work].budgetUs = budgets[work];
+    }
+    return copy;
+}
+
+String getStatus(void) {
+    Stats copy = getStats();
+    String status = "Frame Scheduler:\n";
+    status += "- Frame " + String(UI_FRAME_TARGET_US) + " us, " + String(copy.frames) +
+              " frames, longest task pass " + String(copy.maxPassUs) + " us (" +
+              String(copy.longFrames) + " over a frame)\n";
+    for (int work = 0; work < WORK_COUNT; work++) {
+        const WorkStats &workStats = copy.work[work];
+        uint32_t average = copy.frames ? (uint32_t)(workStats.spentUs / copy.frames) : 0;
+        status += "  " + String(workNames[work]) + ": budget " + String(workStats.budgetUs) +
+                  " us, avg " + String(average) + " max " + String(workStats.maxFrameUs) +
+                  " us/frame, " + String(workStats.overruns) + " overruns, " +
+                  String(workStats.deferrals) + " deferred\n";
+    }
+    return status;
+}
+
+}  // namespace FrameScheduler
+}  // namespace Application
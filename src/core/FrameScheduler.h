@@ -0,0 +1,69 @@
+#ifndef FRAME_SCHEDULER_H
+#define FRAME_SCHEDULER_H
+
+#include <Arduino.h>
+#include <lvgl.h>
+
+namespace Application {
+namespace FrameScheduler {
+
+// =============================================================================
+// FRAME BUDGETS
+// =============================================================================
+
+// One frame is one LVGL refresh period. Each kind of UI-side work gets a
+// share of it; what does not fit waits for the next frame instead of
+// holding up rendering and touch input.
+#define UI_FRAME_TARGET_US (LV_DEF_REFR_PERIOD * 1000)
+#define UI_BUDGET_MESSAGES_US 8000      // LVGL message mailboxes and queue
+#define UI_BUDGET_AUDIO_UI_US 6000      // Audio state events and binding pass
+#define UI_BUDGET_HOUSEKEEPING_US 2000  // Display stats, LED
+#define UI_TASK_PERIOD_MS 10            // lvglTask pass, keeps touch responsive
+
+typedef enum {
+    WORK_MESSAGES,
+    WORK_AUDIO_UI,
+    WORK_HOUSEKEEPING,
+    WORK_COUNT
+} Work;
+
+struct WorkStats {
+    uint32_t budgetUs = 0;
+    uint64_t spentUs = 0;     // All frames
+    uint32_t maxFrameUs = 0;  // Most spent in one frame
+    uint32_t overruns = 0;    // Frames that went past the budget
+    uint32_t deferrals = 0;   // Frames that left work for later
+};
+
+struct Stats {
+    uint32_t frames = 0;
+    uint32_t longFrames = 0;  // Task passes longer than a whole frame
+    uint32_t maxPassUs = 0;   // Longest lvglTask pass
+    WorkStats work[WORK_COUNT];
+};
+
+// Called by lvglTask at the start of every pass; opens a new frame once the
+// previous one has lasted UI_FRAME_TARGET_US
+void beginPass(void);
+
+// Called by lvglTask at the end of every pass; returns how long to sleep to
+// hold the UI_TASK_PERIOD_MS cadence (at least one tick for other tasks)
+uint32_t endPass(void);
+
+// True while 'work' has budget left in this frame. Work that finds none
+// should stay queued and call defer().
+bool hasBudget(Work work);
+
+// Account time spent on 'work' in this frame
+void charge(Work work, uint32_t us);
+
+// Note that 'work' was left for a later frame
+void defer(Work work);
+
+Stats getStats(void);
+String getStatus(void);
+
+}  // namespace FrameScheduler
+}  // namespace Application
+
+#endif  // FRAME_SCHEDULER_H
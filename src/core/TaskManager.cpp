@@ -1,10 +1,12 @@
 #include "TaskManager.h"
+#include "FrameScheduler.h"
 #include "../application/audio/AudioUI.h"
 #include "../application/ui/LVGLMessageHandler.h"
 #include "../display/DisplayManager.h"
-#include "../logo/SimpleLogoManager.h"
+#include "../logo/LogoPrefetcher.h"
 #include "../messaging/SimplifiedSerialEngine.h"
 #include <esp_log.h>
+#include <esp_timer.h>
 #include <ui/ui.h>
 
 static const char *TAG = "TaskManager";
@@ -203,6 +205,7 @@ void lvglTask(void *parameter) {
     unsigned long lastLedUpdate = 0;
 
     while (tasksRunning) {
+        FrameScheduler::beginPass();
         uint32_t lvgl_start = millis();
 
         // Update LVGL tick system
@@ -232,23 +235,34 @@ void lvglTask(void *parameter) {
             ESP_LOGD(TAG, "LVGL processing: %ums", lvgl_duration);
         }
 
-        // Periodic operations
+        // Periodic operations, moved to a later frame when this one is spent
         uint32_t currentTime = millis();
+        int64_t housekeepingStart = esp_timer_get_time();
         if (currentTime - lastDisplayUpdate >= 2000) {
-            Display::update();
-            lastDisplayUpdate = currentTime;
+            if (FrameScheduler::hasBudget(FrameScheduler::WORK_HOUSEKEEPING)) {
+                Display::update();
+                lastDisplayUpdate = currentTime;
+            } else {
+                FrameScheduler::defer(FrameScheduler::WORK_HOUSEKEEPING);
+            }
         }
 
 #ifdef BOARD_HAS_RGB_LED
         if (currentTime - lastLedUpdate >= 5000) {
-            Hardware::Device::ledCycleColors();
-            lastLedUpdate = currentTime;
+            if (FrameScheduler::hasBudget(FrameScheduler::WORK_HOUSEKEEPING)) {
+                Hardware::Device::ledCycleColors();
+                lastLedUpdate = currentTime;
+            } else {
+                FrameScheduler::defer(FrameScheduler::WORK_HOUSEKEEPING);
+            }
         }
 #endif
+        FrameScheduler::charge(FrameScheduler::WORK_HOUSEKEEPING,
+                               (uint32_t)(esp_timer_get_time() - housekeepingStart));
 
-        // Fixed delay for consistent touch responsiveness
-        // Touch processing requires regular LVGL timer handling
-        vTaskDelay(pdMS_TO_TICKS(10));
+        // Regular passes for touch responsiveness: sleep what is left of
+        // the period (touch processing requires regular LVGL timer handling)
+        vTaskDelay(pdMS_TO_TICKS(FrameScheduler::endPass()));
     }
 
     ESP_LOGI(TAG, "LVGL Task ended");
@@ -295,6 +309,15 @@ void audioTask(void *parameter) {
             lastFpsUpdate = currentTime;
         }
 
+        // A change whose snapshot could not be published goes out now
+        Application::Audio::AudioManager::getInstance().retryStalePublish();
+
+        // Keep the warm-start cache up to date (debounced inside)
+        Application::Audio::AudioManager::getInstance().persistStateIfDue();
+
+        // Failed logo requests fall due for a retry with nothing else going on
+        LogoPrefetcher::getInstance().pump(currentTime);
+
         // Commented out insanely spammy FULL UI updates
         // // Update audio UI (with mutex protection and additional safety check)
         // if (lvglTryLock(10)) {
@@ -309,9 +332,6 @@ void audioTask(void *parameter) {
         //     lvglUnlock();
         // }
 
-        // Update logo manager (with safety check)
-        SimpleLogoManager::getInstance().update();
-
         // Sleep for 1 second
         vTaskDelayUntil(&lastWakeTime, pdMS_TO_TICKS(1000));
     }
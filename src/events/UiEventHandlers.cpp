@@ -1,6 +1,7 @@
 #include "UiEventHandlers.h"
 #include "../application/audio/AudioManager.h"
 #include "../application/audio/AudioUI.h"
+#include "../application/audio/VolumeStreamer.h"
 #include "../application/ui/LVGLMessageHandler.h"
 #include "../messaging/Message.h"
 #include "../messaging/SimplifiedSerialEngine.h"
@@ -11,6 +12,7 @@
 #include <ArduinoJson.h>
 #include <esp32_smartdisplay.h>
 #include <esp_log.h>
+#include <esp_timer.h>
 #include <ui/ui.h>
 
 // Helper function to get event name for debugging
@@ -146,13 +148,15 @@ void audioDeviceDropdownChangedHandler(lv_event_t *e) {
   // intelligently auto-select device2
   Application::Audio::AudioManager &audioManager =
       Application::Audio::AudioManager::getInstance();
-  if (audioManager.getCurrentTab() == Events::UI::TabState::BALANCE) {
+  auto snapshot = audioManager.getSnapshot();
+  const auto &audioState = *snapshot;
+  if (audioState.currentTab == Events::UI::TabState::BALANCE) {
     if (dropdown == ui_selectAudioDevice1 &&
-        !audioManager.getState().selectedDevice2) {
+        !audioState.isValid(audioState.selectedDevice2)) {
       ESP_LOGI(TAG, "Balance device1 selected - auto-selecting device2");
       audioManager.performSmartAutoSelection();
     } else if (dropdown == ui_selectAudioDevice2 &&
-               !audioManager.getState().selectedDevice1) {
+               !audioState.isValid(audioState.selectedDevice1)) {
       ESP_LOGI(TAG, "Balance device2 selected - auto-selecting device1");
       audioManager.performSmartAutoSelection();
     }
@@ -161,6 +165,33 @@ void audioDeviceDropdownChangedHandler(lv_event_t *e) {
   // Note: Status will be updated when the server processes the selection change
 }
 
+// Sends the volume value held back by the streamer's rate limit once it is
+// due; pauses itself when nothing is left
+static lv_timer_t *volumeStreamTimer = nullptr;
+
+static void volumeStreamTimerCallback(lv_timer_t *timer) {
+  auto &streamer = Application::Audio::VolumeStreamer::getInstance();
+  streamer.poll(esp_timer_get_time());
+  if (!streamer.hasPending()) {
+    lv_timer_pause(timer);
+  }
+}
+
+static void scheduleVolumeStreamPoll() {
+  auto &streamer = Application::Audio::VolumeStreamer::getInstance();
+  if (!streamer.hasPending()) {
+    return;
+  }
+  uint32_t periodMs = streamer.getIntervalMs() ? streamer.getIntervalMs() : 1;
+  if (!volumeStreamTimer) {
+    volumeStreamTimer =
+        lv_timer_create(volumeStreamTimerCallback, periodMs, nullptr);
+  }
+  lv_timer_set_period(volumeStreamTimer, periodMs);
+  lv_timer_reset(volumeStreamTimer);
+  lv_timer_resume(volumeStreamTimer);
+}
+
 // Volume arc visual handler - updates labels in real-time during dragging
 void volumeArcVisualHandler(lv_event_t *e) {
   ON_EVENT(LV_EVENT_VALUE_CHANGED);
@@ -181,26 +212,35 @@ void volumeArcVisualHandler(lv_event_t *e) {
     lv_label_set_text(ui_lblBalanceVolumeSlider, volumeText);
   }
 
+  // Stream the value to the PC while dragging (rate limited)
+  Application::Audio::VolumeStreamer::getInstance().update(
+      volume, esp_timer_get_time());
+  scheduleVolumeStreamPoll();
+
   ESP_LOGD(TAG, "Volume arc visual update: %d", volume);
 }
 
-// Volume arc change handler - only processes actual volume changes on release
+// Volume arc change handler - starts a drag on press and delivers the final
+// value on release
 void volumeArcChangedHandler(lv_event_t *e) {
-  ON_EVENT(LV_EVENT_RELEASED);
-
+  lv_event_code_t code = lv_event_get_code(e);
   lv_obj_t *arc = GET_UI_WIDGET();
-
-  // Get the arc value
   int volume = VOLUME_WIDGET_GET_VALUE(arc);
+  auto &streamer = Application::Audio::VolumeStreamer::getInstance();
 
-  UI_LOG("UIEventHandlers", "Volume arc released - processing volume: %d",
-         volume);
-  auto &audioManager = Application::Audio::AudioManager::getInstance();
-  String processName; // can be left empty for default device
-  if (audioManager.getCurrentTab() != TabState::MASTER) {
-    processName = audioManager.getCurrentDevice();
+  if (code == LV_EVENT_PRESSED) {
+    auto &audioManager = Application::Audio::AudioManager::getInstance();
+    String processName; // can be left empty for default device
+    if (audioManager.getCurrentTab() != TabState::MASTER) {
+      processName = audioManager.getCurrentDevice();
+    }
+    streamer.begin(processName, volume, esp_timer_get_time());
+  } else if (code == LV_EVENT_RELEASED || code == LV_EVENT_PRESS_LOST) {
+    UI_LOG("UIEventHandlers", "Volume arc released - processing volume: %d",
+           volume);
+    streamer.end(volume, esp_timer_get_time());
+    scheduleVolumeStreamPoll();
   }
-  Messaging::Message::createVolumeChange(processName, volume, "").send();
 }
 
 // Tab switch event handler
@@ -0,0 +1,266 @@
+#include "LogoPrefetcher.h"
+#include <Hash.h>
+#include <esp_log.h>
+
+static const char *TAG = "LogoPrefetcher";
+
+LogoPrefetcher::LogoPrefetcher(Probe probe, Fetch fetch, int maxInFlight,
+                               uint32_t retryMs)
+    : probe(std::move(probe)), fetch(std::move(fetch)),
+      maxInFlight(maxInFlight > 0 ? maxInFlight : 1), retryMs(retryMs) {}
+
+// =============================================================================
+// SCHEDULING
+// =============================================================================
+
+void LogoPrefetcher::prioritise(const char *const *processNames, size_t count,
+                                uint32_t nowMs) {
+    portENTER_CRITICAL(&lock);
+    for (Entry &entry : entries) {
+        entry.priority = NOT_WANTED;
+    }
+    for (size_t i = 0; i < count; i++) {
+        const char *name = processNames[i];
+        if (!name || name[0] == '\0') {
+            continue;
+        }
+        uint32_t hash = hashName(name);
+        Entry *entry = findLocked(name, hash);
+        if (!entry) {
+            entry = insertLocked(name, hash, nowMs);
+        }
+        if (entry && entry->priority == NOT_WANTED) {
+            entry->priority = i < NOT_WANTED ? static_cast<uint8_t>(i) : NOT_WANTED - 1;
+        }
+    }
+    portEXIT_CRITICAL(&lock);
+
+    pump(nowMs);
+}
+
+void LogoPrefetcher::pump(uint32_t nowMs) {
+    // Completions arriving while we are in here are picked up by this loop
+    portENTER_CRITICAL(&lock);
+    if (pumping) {
+        portEXIT_CRITICAL(&lock);
+        return;
+    }
+    pumping = true;
+    portEXIT_CRITICAL(&lock);
+
+    while (true) {
+        char name[sizeof(Entry::processName)];
+        uint32_t hash = 0;
+        bool probing = false;
+
+        portENTER_CRITICAL(&lock);
+        Entry *entry = nextLocked(nowMs, inFlight < maxInFlight);
+        if (entry) {
+            memcpy(name, entry->processName, sizeof(name));
+            hash = entry->nameHash;
+            probing = entry->state == State::UNCHECKED;
+            entry->state = probing ? State::PROBING : State::IN_FLIGHT;
+            inFlight += probing ? 0 : 1;
+        } else {
+            pumping = false;
+        }
+        portEXIT_CRITICAL(&lock);
+
+        if (!entry) {
+            break;
+        }
+
+        if (probing) {
+            // Presence only - the file is never read here
+            bool present = probe(name);
+            portENTER_CRITICAL(&lock);
+            stats.probes++;
+            Entry *probed = findLocked(name, hash);
+            if (probed) {
+                probed->state = present ? State::PRESENT : State::MISSING;
+                presence++;
+            }
+            stats.hits += present;
+            portEXIT_CRITICAL(&lock);
+            continue;
+        }
+
+        ESP_LOGI(TAG, "Requesting logo for %s", name);
+        fetch(name, [this, processName = String(name)](bool success, uint32_t doneMs) {
+            onFetched(processName.c_str(), success, doneMs);
+        });
+    }
+}
+
+void LogoPrefetcher::onFetched(const char *processName, bool success,
+                               uint32_t nowMs) {
+    uint32_t latency = 0;
+    portENTER_CRITICAL(&lock);
+    inFlight--;
+    Entry *entry = findLocked(processName, hashName(processName));
+    if (entry && success) {
+        entry->state = State::PRESENT;
+        presence++;
+        latency = nowMs - entry->wantedAtMs;
+        stats.fetched++;
+        stats.timeToLogoCount++;
+        stats.timeToLogoTotalMs += latency;
+        if (latency > stats.timeToLogoMaxMs) {
+            stats.timeToLogoMaxMs = latency;
+        }
+    } else if (entry) {
+        entry->state = State::FAILED;
+        entry->retryAtMs = nowMs + retryMs;
+        stats.failures++;
+    }
+    portEXIT_CRITICAL(&lock);
+
+    if (success) {
+        ESP_LOGI(TAG, "Logo for %s ready %lu ms after it was wanted", processName,
+                 (unsigned long)latency);
+    }
+    pump(nowMs);
+}
+
+// =============================================================================
+// QUERIES
+// =============================================================================
+
+bool LogoPrefetcher::hasLogo(const char *processName) {
+    if (!processName || processName[0] == '\0') {
+        return false;
+    }
+
+    portENTER_CRITICAL(&lock);
+    Entry *entry = findLocked(processName, hashName(processName));
+    State state = entry ? entry->state : State::UNCHECKED;
+    portEXIT_CRITICAL(&lock);
+
+    // Not checked yet reads as missing; the prefetcher's probe settles it
+    // and bumps the presence version, so callers never wait on SD
+    return state == State::PRESENT;
+}
+
+uint32_t LogoPrefetcher::presenceVersion() const {
+    portENTER_CRITICAL(&lock);
+    uint32_t version = presence;
+    portEXIT_CRITICAL(&lock);
+    return version;
+}
+
+size_t LogoPrefetcher::queueLength() const {
+    uint32_t now = millis();
+    size_t count = 0;
+    portENTER_CRITICAL(&lock);
+    for (const Entry &entry : entries) {
+        count += isQueued(entry, now);
+    }
+    portEXIT_CRITICAL(&lock);
+    return count;
+}
+
+size_t LogoPrefetcher::inFlightCount() const {
+    portENTER_CRITICAL(&lock);
+    size_t count = inFlight;
+    portEXIT_CRITICAL(&lock);
+    return count;
+}
+
+LogoPrefetcher::Stats LogoPrefetcher::getStats() const {
+    portENTER_CRITICAL(&lock);
+    Stats copy = stats;
+    portEXIT_CRITICAL(&lock);
+    return copy;
+}
+
+String LogoPrefetcher::getStatus() const {
+    Stats copy = getStats();
+    uint32_t hitRate = copy.probes ? copy.hits * 100 / copy.probes : 0;
+    uint32_t average =
+        copy.timeToLogoCount ? copy.timeToLogoTotalMs / copy.timeToLogoCount : 0;
+
+    String status = "Logo Prefetcher:\n";
+    status += "- Queued: " + String((unsigned)queueLength()) + ", in flight " +
+              String((unsigned)inFlightCount()) + "/" + String(maxInFlight) + "\n";
+    status += "- SD checks " + String(copy.probes) + ", hits " + String(copy.hits) +
+              " (" + String(hitRate) + "%), fetched " + String(copy.fetched) +
+              ", failed " + String(copy.failures) + "\n";
+    status += "- Time to logo avg " + String(average) + "ms max " +
+              String(copy.timeToLogoMaxMs) + "ms\n";
+    return status;
+}
+
+// =============================================================================
+// PRIVATE
+// =============================================================================
+
+// *Locked helpers run with the lock held
+LogoPrefetcher::Entry *LogoPrefetcher::findLocked(const char *processName,
+                                                  uint32_t hash) {
+    for (Entry &entry : entries) {
+        if (entry.used && entry.nameHash == hash &&
+            strncmp(entry.processName, processName, sizeof(entry.processName) - 1) == 0) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+LogoPrefetcher::Entry *LogoPrefetcher::insertLocked(const char *processName,
+                                                    uint32_t hash, uint32_t nowMs) {
+    // A free slot, else one that is neither wanted nor busy
+    Entry *slot = nullptr;
+    for (Entry &entry : entries) {
+        if (!entry.used) {
+            slot = &entry;
+            break;
+        }
+        if (!slot && entry.priority == NOT_WANTED && entry.state != State::PROBING &&
+            entry.state != State::IN_FLIGHT) {
+            slot = &entry;
+        }
+    }
+    if (!slot) {
+        return nullptr;
+    }
+
+    *slot = Entry();
+    slot->used = true;
+    slot->nameHash = hash;
+    slot->wantedAtMs = nowMs;
+    strncpy(slot->processName, processName, sizeof(slot->processName) - 1);
+    return slot;
+}
+
+LogoPrefetcher::Entry *LogoPrefetcher::nextLocked(uint32_t nowMs, bool canFetch) {
+    Entry *best = nullptr;
+    for (Entry &entry : entries) {
+        if (!isQueued(entry, nowMs) ||
+            (entry.state != State::UNCHECKED && !canFetch)) {
+            continue;
+        }
+        if (!best || entry.priority < best->priority) {
+            best = &entry;
+        }
+    }
+    return best;
+}
+
+uint32_t LogoPrefetcher::hashName(const char *processName) {
+    return Hash::fnv1a(processName, strnlen(processName, sizeof(Entry::processName) - 1));
+}
+
+bool LogoPrefetcher::isQueued(const Entry &entry, uint32_t nowMs) {
+    if (!entry.used || entry.priority == NOT_WANTED) {
+        return false;
+    }
+    switch (entry.state) {
+    case State::UNCHECKED:
+    case State::MISSING:
+        return true;
+    case State::FAILED:
+        return static_cast<int32_t>(nowMs - entry.retryAtMs) >= 0;
+    default:
+        return false;
+    }
+}
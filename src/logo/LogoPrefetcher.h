@@ -0,0 +1,105 @@
+#pragma once
+
+#include <Arduino.h>
+#include <MessagingConfig.h>
+#include <freertos/FreeRTOS.h>
+#include <functional>
+
+/**
+ * LOGO PREFETCHER
+ *
+ * One queue for every logo the UI may need. Callers hand over the process
+ * names they want in visibility order (the selected device first, then
+ * dropdown order) with prioritise(); each process is known once, so
+ * repeated status updates do not repeat SD checks or requests.
+ *
+ * Per process: presence on SD is checked once (fileExists, the file is
+ * never read), missing logos are requested highest priority first with at
+ * most MESSAGING_LOGO_PREFETCH_MAX_IN_FLIGHT requests outstanding, and a
+ * failed request is retried after MESSAGING_LOGO_PREFETCH_RETRY_MS. The
+ * audio task pumps once a second, so a retry falls due even when no status
+ * update or completion comes along.
+ *
+ * The table is guarded by a short critical section; SD and messaging calls
+ * happen outside it, and only one task pumps at a time, so prioritise() and
+ * request completions may come from any task.
+ */
+class LogoPrefetcher {
+public:
+    // Presence check and fetch are injected so the unit tests can run
+    // without SD or a host. Fetch reports completion through 'done', possibly inline.
+    using Probe = std::function<bool(const char* processName)>;
+    using Done = std::function<void(bool success, uint32_t nowMs)>;
+    using Fetch = std::function<void(const char* processName, Done done)>;
+
+    static const int CAPACITY = 32;
+    static const uint8_t NOT_WANTED = 0xFF;
+
+    struct Stats {
+        uint32_t probes = 0;       // SD presence checks
+        uint32_t hits = 0;         // Logo already on SD
+        uint32_t fetched = 0;      // Requested and saved
+        uint32_t failures = 0;     // Requests that failed or timed out
+        uint32_t timeToLogoCount = 0;  // Wanted -> saved, fetched logos only
+        uint32_t timeToLogoTotalMs = 0;
+        uint32_t timeToLogoMaxMs = 0;
+    };
+
+    // Defined in SimpleLogoManager.cpp, which supplies the probe and fetch
+    static LogoPrefetcher& getInstance();
+
+    // Standalone instances are only used by the unit tests
+    LogoPrefetcher(Probe probe, Fetch fetch, int maxInFlight, uint32_t retryMs);
+
+    // Processes currently worth a logo, most visible first. Anything not
+    // listed keeps its known state but is not fetched. Starts work.
+    void prioritise(const char* const* processNames, size_t count, uint32_t nowMs);
+
+    // Start queued work up to the in-flight cap
+    void pump(uint32_t nowMs);
+
+    // Known presence, never touches SD: false until the process has been
+    // checked by pump()
+    bool hasLogo(const char* processName);
+
+    // Bumped whenever a process's presence becomes known (checked on SD or
+    // a logo saved), so renderers can redraw a logo that was missing
+    uint32_t presenceVersion() const;
+
+    size_t queueLength() const;
+    size_t inFlightCount() const;
+    Stats getStats() const;
+    String getStatus() const;
+
+private:
+    enum class State : uint8_t { UNCHECKED, PROBING, MISSING, IN_FLIGHT, PRESENT, FAILED };
+
+    struct Entry {
+        bool used = false;
+        State state = State::UNCHECKED;
+        uint8_t priority = NOT_WANTED;
+        uint32_t nameHash = 0;
+        uint32_t wantedAtMs = 0;
+        uint32_t retryAtMs = 0;
+        char processName[64] = {};
+    };
+
+    Probe probe;
+    Fetch fetch;
+    int maxInFlight;
+    uint32_t retryMs;
+
+    Entry entries[CAPACITY];
+    int inFlight = 0;
+    bool pumping = false;
+    uint32_t presence = 0;
+    Stats stats;
+    mutable portMUX_TYPE lock = portMUX_INITIALIZER_UNLOCKED;
+
+    Entry* findLocked(const char* processName, uint32_t hash);
+    Entry* insertLocked(const char* processName, uint32_t hash, uint32_t nowMs);
+    Entry* nextLocked(uint32_t nowMs, bool canFetch);
+    void onFetched(const char* processName, bool success, uint32_t nowMs);
+    static uint32_t hashName(const char* processName);
+    static bool isQueued(const Entry& entry, uint32_t nowMs);
+};
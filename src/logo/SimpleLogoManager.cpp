@@ -1,4 +1,5 @@
 #include "SimpleLogoManager.h"
+#include "LogoPrefetcher.h"
 #include "../hardware/SDManager.h"
 #include "../messaging/Message.h"
 #include "BSODHandler.h"
@@ -18,6 +19,26 @@ SimpleLogoManager &SimpleLogoManager::getInstance() {
     return *instance;
 }
 
+// The prefetcher's SD checks and requests go through this manager
+LogoPrefetcher &LogoPrefetcher::getInstance() {
+    static LogoPrefetcher instance(
+        [](const char *processName) {
+            return SimpleLogoManager::getInstance().hasLogo(processName);
+        },
+        [](const char *processName, Done done) {
+            SimpleLogoManager::getInstance().prefetchLogo(
+                processName,
+                [done](bool success, uint8_t *, size_t, const String &error) {
+                    if (!success) {
+                        ESP_LOGW(TAG, "Logo request failed: %s", error.c_str());
+                    }
+                    done(success, millis());
+                });
+        },
+        MESSAGING_LOGO_PREFETCH_MAX_IN_FLIGHT, MESSAGING_LOGO_PREFETCH_RETRY_MS);
+    return instance;
+}
+
 bool SimpleLogoManager::init() {
     ESP_LOGI(TAG, "Initializing SimpleLogoManager");
 
@@ -60,45 +81,12 @@ void SimpleLogoManager::deinit() {
     if (!initialized)
         return;
 
-    // Fail all pending requests
-    for (auto &[requestId, request] : pendingRequests) {
-        if (request.callback) {
-            request.callback(false, nullptr, 0, "System shutting down");
-        }
-    }
-    pendingRequests.clear();
-
+    // Outstanding requests are failed with CANCELLED when the correlation
+    // engine shuts down together with messaging
     initialized = false;
     ESP_LOGI(TAG, "SimpleLogoManager deinitialized");
 }
 
-void SimpleLogoManager::update() {
-    if (!initialized)
-        return;
-
-    unsigned long currentTime = millis();
-    std::vector<String> expiredRequests;
-
-    // Find expired requests
-    for (auto &[requestId, request] : pendingRequests) {
-        if ((currentTime - request.requestTime) > REQUEST_TIMEOUT_MS) {
-            expiredRequests.push_back(requestId);
-        }
-    }
-
-    // Process expired requests
-    for (const String &requestId : expiredRequests) {
-        auto it = pendingRequests.find(requestId);
-        if (it != pendingRequests.end()) {
-            if (it->second.callback) {
-                it->second.callback(false, nullptr, 0, "Request timed out");
-            }
-            pendingRequests.erase(it);
-            requestsTimedOut++;
-        }
-    }
-}
-
 bool SimpleLogoManager::requestLogo(const String &processName,
                                     LogoCallback callback) {
     if (!initialized) {
@@ -110,42 +98,66 @@ bool SimpleLogoManager::requestLogo(const String &processName,
     String sanitized = sanitizeProcessName(processName);
 
     // Check if logo already exists
-    if (hasLogo(sanitized)) {
-        String filePath = getLogoPath(sanitized);
-        size_t fileSize = Hardware::SD::getFileSize(filePath.c_str());
-
-        if (fileSize > 0 && fileSize <= 100000) {  // 100KB max
-            uint8_t *buffer = (uint8_t *)malloc(fileSize);
-            if (buffer) {
-                Hardware::SD::SDFileResult result =
-                    Hardware::SD::readFile(filePath.c_str(), (char *)buffer, fileSize);
-                if (result.success) {
-                    if (callback)
-                        callback(true, buffer, result.bytesProcessed, "");
-                    return true;
-                }
-                free(buffer);
-            }
-        }
+    if (hasLogo(sanitized) && readLogoFile(sanitized, callback)) {
+        return true;
     }
 
-    // Create asset request
-    auto msg = Messaging::Message::createAssetRequest(sanitized.c_str(), "");
+    issueAssetRequest(sanitized, callback, true);
+    return true;
+}
+
+bool SimpleLogoManager::prefetchLogo(const String &processName,
+                                     LogoCallback callback) {
+    if (!initialized) {
+        if (callback)
+            callback(false, nullptr, 0, "Not initialized");
+        return false;
+    }
 
-    // Track the request
-    LogoRequest request;
-    request.processName = sanitized;
-    request.requestId = msg.requestId;
-    request.callback = callback;
-    request.requestTime = millis();
+    issueAssetRequest(sanitizeProcessName(processName), callback, false);
+    return true;
+}
 
-    pendingRequests[msg.requestId] = request;
+void SimpleLogoManager::issueAssetRequest(const String &sanitized,
+                                          LogoCallback callback, bool wantData) {
+    // Create asset request - concurrent requests for the same process share
+    // one message and one response
+    auto msg = Messaging::Message::createAssetRequest(sanitized.c_str(), "");
+    uint32_t key = Messaging::CorrelationEngine::makeKey(
+        Messaging::Message::TYPE_ASSET_REQUEST, sanitized.c_str());
 
-    // Send the message
-    Messaging::sendMessage(msg);
+    Messaging::CorrelationEngine::getInstance().issue(
+        msg, key, MESSAGING_ASSET_REQUEST_TIMEOUT_MS,
+        [this, sanitized, callback, wantData](
+            Messaging::CorrelationEngine::Outcome outcome,
+            const Messaging::Message *response) {
+            onLogoRequestFinished(sanitized, callback, wantData, outcome, response);
+        });
 
     requestsSubmitted++;
-    return true;
+}
+
+bool SimpleLogoManager::readLogoFile(const String &processName,
+                                     LogoCallback callback) {
+    String filePath = getLogoPath(processName);
+    size_t fileSize = Hardware::SD::getFileSize(filePath.c_str());
+
+    if (fileSize > 0 && fileSize <= 100000) {  // 100KB max
+        uint8_t *buffer = (uint8_t *)malloc(fileSize);
+        if (buffer) {
+            Hardware::SD::SDFileResult result =
+                Hardware::SD::readFile(filePath.c_str(), (char *)buffer, fileSize);
+            if (result.success) {
+                if (callback)
+                    callback(true, buffer, result.bytesProcessed, "");
+                else
+                    free(buffer);
+                return true;
+            }
+            free(buffer);
+        }
+    }
+    return false;
 }
 
 bool SimpleLogoManager::hasLogo(const String &processName) {
@@ -171,7 +183,8 @@ String SimpleLogoManager::getLVGLPath(const String &processName) {
 String SimpleLogoManager::getStatus() const {
     String status = "SimpleLogoManager Status:\n";
     status += "- Initialized: " + String(initialized ? "Yes" : "No") + "\n";
-    status += "- Pending requests: " + String(pendingRequests.size()) + "\n";
+    status += "- Requests in flight (all types): " +
+              String(Messaging::CorrelationEngine::getInstance().getStats().inFlight) + "\n";
     status += "- Requests submitted: " + String(requestsSubmitted) + "\n";
     status += "- Responses received: " + String(responsesReceived) + "\n";
     status += "- Requests timed out: " + String(requestsTimedOut) + "\n";
@@ -184,18 +197,44 @@ void SimpleLogoManager::handleAssetResponse(const Messaging::Message &msg) {
              "handleAssetResponse: Processing asset response for requestId: %s",
              msg.requestId.c_str());
 
-    const auto &asset = msg.data.asset;
-
-    auto it = pendingRequests.find(msg.requestId);
-    if (it == pendingRequests.end()) {
-        ESP_LOGE(TAG, "handleAssetResponse: Unknown requestId: %s",
+    if (!Messaging::CorrelationEngine::getInstance().complete(msg.requestId, msg)) {
+        ESP_LOGE(TAG, "handleAssetResponse: Unknown or expired requestId: %s",
                  msg.requestId.c_str());
-        return;  // Unknown request
     }
+}
+
+void SimpleLogoManager::onLogoRequestFinished(
+    const String &processName, const LogoCallback &callback, bool wantData,
+    Messaging::CorrelationEngine::Outcome outcome,
+    const Messaging::Message *response) {
+    using Outcome = Messaging::CorrelationEngine::Outcome;
 
-    LogoRequest &request = it->second;
+    if (outcome != Outcome::COMPLETED) {
+        if (outcome == Outcome::TIMED_OUT) {
+            requestsTimedOut++;
+        }
+        if (callback) {
+            callback(false, nullptr, 0,
+                     outcome == Outcome::TIMED_OUT  ? "Request timed out"
+                     : outcome == Outcome::REJECTED ? "Too many requests in flight"
+                                                    : "System shutting down");
+        }
+        return;
+    }
+
+    // A deduplicated waiter - an earlier waiter already saved the file
+    if (hasLogo(processName) &&
+        (!wantData || readLogoFile(processName, callback))) {
+        if (!wantData && callback) {
+            callback(true, nullptr, 0, "");
+        }
+        responsesReceived++;
+        return;
+    }
+
+    const auto &asset = response->data.asset;
     ESP_LOGE(TAG, "handleAssetResponse: Found pending request for process: %s",
-             request.processName.c_str());
+             processName.c_str());
 
     if (asset.success && strlen(asset.assetDataBase64) > 0) {
         ESP_LOGE(TAG, "handleAssetResponse: Asset success, base64 data length: %d",
@@ -211,11 +250,10 @@ void SimpleLogoManager::handleAssetResponse(const Messaging::Message &msg) {
 
         if (!decodedData) {
             ESP_LOGE(TAG, "Failed to allocate memory for decoded PNG");
-            if (request.callback) {
-                request.callback(false, nullptr, 0, "Memory allocation failed");
+            if (callback) {
+                callback(false, nullptr, 0, "Memory allocation failed");
             }
             requestsFailed++;
-            pendingRequests.erase(it);
             return;
         }
 
@@ -227,11 +265,10 @@ void SimpleLogoManager::handleAssetResponse(const Messaging::Message &msg) {
         if (actualDecodedSize == 0) {
             ESP_LOGE(TAG, "Failed to decode base64 data");
             free(decodedData);
-            if (request.callback) {
-                request.callback(false, nullptr, 0, "Base64 decode failed");
+            if (callback) {
+                callback(false, nullptr, 0, "Base64 decode failed");
             }
             requestsFailed++;
-            pendingRequests.erase(it);
             return;
         }
 
@@ -239,7 +276,7 @@ void SimpleLogoManager::handleAssetResponse(const Messaging::Message &msg) {
                  actualDecodedSize);
 
         // Save PNG directly to SD card
-        String filePath = getLogoPath(request.processName);
+        String filePath = getLogoPath(processName);
         ESP_LOGE(TAG, "handleAssetResponse: Saving to file: %s", filePath.c_str());
 
         Hardware::SD::SDFileResult writeResult = Hardware::SD::writeBinaryFile(
@@ -251,8 +288,11 @@ void SimpleLogoManager::handleAssetResponse(const Messaging::Message &msg) {
                      "written: %d",
                      writeResult.bytesProcessed);
             // Success! Call callback with decoded data
-            if (request.callback) {
-                request.callback(true, decodedData, actualDecodedSize, "");
+            if (callback && wantData) {
+                callback(true, decodedData, actualDecodedSize, "");
+            } else if (callback) {
+                free(decodedData);
+                callback(true, nullptr, 0, "");
             } else {
                 // Free the data if no callback to consume it
                 free(decodedData);
@@ -263,8 +303,8 @@ void SimpleLogoManager::handleAssetResponse(const Messaging::Message &msg) {
                      writeResult.errorMessage);
             // Failed to save
             free(decodedData);
-            if (request.callback) {
-                request.callback(false, nullptr, 0, "Failed to save logo file");
+            if (callback) {
+                callback(false, nullptr, 0, "Failed to save logo file");
             }
             requestsFailed++;
         }
@@ -276,19 +316,13 @@ void SimpleLogoManager::handleAssetResponse(const Messaging::Message &msg) {
             strlen(asset.errorMessage) > 0 ? asset.errorMessage
                                            : "no error message");
         // Server reported failure
-        if (request.callback) {
+        if (callback) {
             String error = strlen(asset.errorMessage) > 0 ? String(asset.errorMessage)
                                                           : "Server error";
-            request.callback(false, nullptr, 0, error);
+            callback(false, nullptr, 0, error);
         }
         requestsFailed++;
     }
-
-    // Remove completed request
-    ESP_LOGE(TAG,
-             "handleAssetResponse: Removing completed request for process: %s",
-             request.processName.c_str());
-    pendingRequests.erase(it);
 }
 
 String SimpleLogoManager::getLogoPath(const String &processName) {
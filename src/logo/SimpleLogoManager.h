@@ -1,10 +1,10 @@
 #pragma once
 
 #include "../hardware/SDManager.h"
+#include "../messaging/CorrelationEngine.h"
 #include "../messaging/Message.h"
 #include <Arduino.h>
 #include <functional>
-#include <unordered_map>
 
 /**
  * SIMPLE LOGO MANAGER
@@ -27,10 +27,12 @@ public:
     
     bool init();
     void deinit();
-    void update();
     
     // Core operations
     bool requestLogo(const String& processName, LogoCallback callback);
+    // Like requestLogo, but never reads an existing file: success is
+    // reported with data == nullptr once the logo is on SD (LogoPrefetcher)
+    bool prefetchLogo(const String& processName, LogoCallback callback);
     bool hasLogo(const String& processName);
     bool deleteLogo(const String& processName);
     
@@ -45,25 +47,22 @@ private:
     static SimpleLogoManager* instance;
     bool initialized = false;
     
-    // Simple request tracking
-    struct LogoRequest {
-        String processName;
-        String requestId;
-        LogoCallback callback;
-        unsigned long requestTime;
-    };
-    std::unordered_map<String, LogoRequest> pendingRequests;
-    
-    // Stats
+    // Stats (in-flight tracking and timeouts live in CorrelationEngine)
     uint32_t requestsSubmitted = 0;
     uint32_t responsesReceived = 0;
     uint32_t requestsTimedOut = 0;
     uint32_t requestsFailed = 0;
     
-    static const unsigned long REQUEST_TIMEOUT_MS = 30000;
     static const char* LOGOS_DIR;
     
     void handleAssetResponse(const Messaging::Message& msg);
+    void issueAssetRequest(const String& processName, LogoCallback callback,
+                           bool wantData);
+    void onLogoRequestFinished(const String& processName, const LogoCallback& callback,
+                               bool wantData,
+                               Messaging::CorrelationEngine::Outcome outcome,
+                               const Messaging::Message* response);
+    bool readLogoFile(const String& processName, LogoCallback callback);
     String getLogoPath(const String& processName);
     String sanitizeProcessName(const String& processName);
     bool ensureLogosDirectory();
@@ -0,0 +1,388 @@
+#include "CorrelationEngine.h"
+#include "protocol/MessageConfig.h"
+#include <Hash.h>
+#include <esp_log.h>
+
+static const char *TAG = "Correlation";
+
+namespace Messaging {
+
+CorrelationEngine *CorrelationEngine::instance = nullptr;
+
+CorrelationEngine &CorrelationEngine::getInstance() {
+  if (!instance) {
+    instance = new CorrelationEngine();
+  }
+  return *instance;
+}
+
+bool CorrelationEngine::init() {
+  if (initialized) {
+    return true;
+  }
+
+  mutex = xSemaphoreCreateMutex();
+  if (!mutex) {
+    ESP_LOGE(TAG, "Failed to create correlation mutex");
+    return false;
+  }
+
+  for (int i = 0; i < WHEEL_SLOTS; i++) {
+    buckets[i] = -1;
+  }
+  currentTick = millis() / TICK_MS;
+  initialized = true;
+
+  ESP_LOGI(TAG, "Correlation engine ready: %d slots, %d x %lums wheel",
+           MAX_IN_FLIGHT, WHEEL_SLOTS, (unsigned long)TICK_MS);
+  return true;
+}
+
+void CorrelationEngine::deinit() {
+  if (!initialized) {
+    return;
+  }
+  cancelAll();
+  vSemaphoreDelete(mutex);
+  mutex = nullptr;
+  initialized = false;
+}
+
+uint32_t CorrelationEngine::makeKey(const char *type, const char *key) {
+  uint32_t hash = Hash::fnv1a(type, strlen(type));
+  hash = Hash::fnv1a(":", 1, hash);
+  hash = Hash::fnv1a(key, strlen(key), hash);
+  return hash ? hash : 1; // 0 means "no dedup"
+}
+
+// =============================================================================
+// ISSUE / COMPLETE
+// =============================================================================
+
+uint32_t CorrelationEngine::issue(Message &msg, uint32_t dedupKey,
+                                  uint32_t timeoutMs, Completion completion) {
+  if (!initialized) {
+    ESP_LOGW(TAG, "Not initialized - %s not sent", msg.type.c_str());
+    reject(completion);
+    return 0;
+  }
+
+  xSemaphoreTake(mutex, portMAX_DELAY);
+
+  if (dedupKey != 0) {
+    int existing = findByKey(dedupKey);
+    if (existing >= 0) {
+      if (completion) {
+        pool[existing].waiters.push_back(std::move(completion));
+      }
+      stats.deduplicated++;
+      uint32_t id = pool[existing].id;
+      xSemaphoreGive(mutex);
+      ESP_LOGD(TAG, "%s joined in-flight request %lu", msg.type.c_str(),
+               (unsigned long)id);
+      return id;
+    }
+  }
+
+  int index = -1;
+  for (int i = 0; i < MAX_IN_FLIGHT; i++) {
+    if (pool[i].id == 0) {
+      index = i;
+      break;
+    }
+  }
+
+  if (index < 0) {
+    stats.poolExhausted++;
+    xSemaphoreGive(mutex);
+    ESP_LOGW(TAG, "Correlation pool full - %s not sent", msg.type.c_str());
+    reject(completion);
+    return 0;
+  }
+
+  Entry &entry = pool[index];
+  entry.generation = (entry.generation + 1) & 0x7FFF;
+  if (entry.generation == 0) {
+    entry.generation = 1;
+  }
+  entry.id = ID_FLAG | ((uint32_t)entry.generation << SLOT_BITS) | index;
+  entry.dedupKey = dedupKey;
+  entry.issuedAt = millis();
+  entry.deadline = entry.issuedAt + timeoutMs;
+  entry.waiters.clear();
+  if (completion) {
+    entry.waiters.push_back(std::move(completion));
+  }
+  link(index);
+
+  stats.issued++;
+  stats.inFlight++;
+  if (stats.inFlight > stats.peakInFlight) {
+    stats.peakInFlight = stats.inFlight;
+  }
+
+  uint32_t id = entry.id;
+  xSemaphoreGive(mutex);
+
+  char requestId[Config::REQUEST_ID_MAX_LEN];
+  Config::formatRequestId(id, requestId, sizeof(requestId));
+  msg.requestId = requestId;
+  msg.send();
+
+  return id;
+}
+
+bool CorrelationEngine::complete(const String &requestId,
+                                 const Message &response) {
+  uint32_t id = Config::parseRequestId(requestId.c_str());
+  if (!initialized || !(id & ID_FLAG)) {
+    return false;
+  }
+
+  xSemaphoreTake(mutex, portMAX_DELAY);
+  int index = findSlot(id);
+  if (index < 0) {
+    stats.unmatchedResponses++;
+    xSemaphoreGive(mutex);
+    return false;
+  }
+  stats.completed++;
+  stats.totalLatencyMs += millis() - pool[index].issuedAt;
+  std::vector<Completion> waiters = release(index);
+  xSemaphoreGive(mutex);
+
+  finish(waiters, Outcome::COMPLETED, &response);
+  return true;
+}
+
+bool CorrelationEngine::completeByKey(uint32_t dedupKey,
+                                      const Message &response) {
+  if (!initialized || dedupKey == 0) {
+    return false;
+  }
+
+  xSemaphoreTake(mutex, portMAX_DELAY);
+  int index = findByKey(dedupKey);
+  if (index < 0) {
+    xSemaphoreGive(mutex);
+    return false;
+  }
+  stats.completed++;
+  stats.totalLatencyMs += millis() - pool[index].issuedAt;
+  std::vector<Completion> waiters = release(index);
+  xSemaphoreGive(mutex);
+
+  finish(waiters, Outcome::COMPLETED, &response);
+  return true;
+}
+
+bool CorrelationEngine::cancel(uint32_t id) {
+  if (!initialized) {
+    return false;
+  }
+
+  xSemaphoreTake(mutex, portMAX_DELAY);
+  int index = findSlot(id);
+  if (index < 0) {
+    xSemaphoreGive(mutex);
+    return false;
+  }
+  stats.cancelled++;
+  std::vector<Completion> waiters = release(index);
+  xSemaphoreGive(mutex);
+
+  finish(waiters, Outcome::CANCELLED, nullptr);
+  return true;
+}
+
+void CorrelationEngine::cancelAll() {
+  if (!initialized) {
+    return;
+  }
+
+  for (int i = 0; i < MAX_IN_FLIGHT; i++) {
+    xSemaphoreTake(mutex, portMAX_DELAY);
+    if (pool[i].id == 0) {
+      xSemaphoreGive(mutex);
+      continue;
+    }
+    stats.cancelled++;
+    std::vector<Completion> waiters = release(i);
+    xSemaphoreGive(mutex);
+
+    finish(waiters, Outcome::CANCELLED, nullptr);
+  }
+}
+
+bool CorrelationEngine::isInFlight(uint32_t dedupKey) {
+  if (!initialized) {
+    return false;
+  }
+  xSemaphoreTake(mutex, portMAX_DELAY);
+  bool found = findByKey(dedupKey) >= 0;
+  xSemaphoreGive(mutex);
+  return found;
+}
+
+// =============================================================================
+// DEADLINE WHEEL
+// =============================================================================
+
+void CorrelationEngine::update() {
+  if (!initialized) {
+    return;
+  }
+
+  uint32_t now = millis();
+  uint32_t targetTick = now / TICK_MS;
+  if (targetTick == currentTick) {
+    return;
+  }
+
+  std::vector<Completion> expiredWaiters[MAX_IN_FLIGHT];
+  int expiredCount = 0;
+
+  xSemaphoreTake(mutex, portMAX_DELAY);
+
+  // Visiting each bucket once is enough after a long stall, entries are
+  // checked against their absolute deadline
+  uint32_t steps = targetTick - currentTick;
+  if (steps > (uint32_t)WHEEL_SLOTS) {
+    steps = WHEEL_SLOTS;
+    currentTick = targetTick - WHEEL_SLOTS;
+  }
+
+  for (uint32_t step = 0; step < steps; step++) {
+    currentTick++;
+    int index = buckets[currentTick % WHEEL_SLOTS];
+    while (index >= 0) {
+      int next = pool[index].next;
+      if ((int32_t)(now - pool[index].deadline) >= 0) {
+        ESP_LOGW(TAG, "Request %lu timed out after %lums",
+                 (unsigned long)pool[index].id,
+                 (unsigned long)(now - pool[index].issuedAt));
+        stats.timedOut++;
+        expiredWaiters[expiredCount++] = release(index);
+      }
+      index = next;
+    }
+  }
+  xSemaphoreGive(mutex);
+
+  for (int i = 0; i < expiredCount; i++) {
+    finish(expiredWaiters[i], Outcome::TIMED_OUT, nullptr);
+  }
+}
+
+// =============================================================================
+// STATUS
+// =============================================================================
+
+CorrelationEngine::Stats CorrelationEngine::getStats() {
+  if (!initialized) {
+    return stats;
+  }
+  xSemaphoreTake(mutex, portMAX_DELAY);
+  Stats copy = stats;
+  xSemaphoreGive(mutex);
+  return copy;
+}
+
+String CorrelationEngine::getStatus() {
+  Stats s = getStats();
+  uint32_t resolved = s.completed + s.timedOut;
+  uint32_t timeoutPct = resolved ? (s.timedOut * 100) / resolved : 0;
+  uint32_t avgLatency = s.completed ? s.totalLatencyMs / s.completed : 0;
+
+  String status = "Correlation Status:\n";
+  status += "- In flight: " + String(s.inFlight) + " (peak " +
+            String(s.peakInFlight) + "/" + String(MAX_IN_FLIGHT) + ")\n";
+  status += "- Issued: " + String(s.issued) + ", deduplicated: " +
+            String(s.deduplicated) + "\n";
+  status += "- Completed: " + String(s.completed) + " (avg " +
+            String(avgLatency) + "ms)\n";
+  status += "- Timed out: " + String(s.timedOut) + " (" + String(timeoutPct) +
+            "%)\n";
+  status += "- Cancelled: " + String(s.cancelled) + ", unmatched: " +
+            String(s.unmatchedResponses) + ", pool full: " +
+            String(s.poolExhausted) + "\n";
+  return status;
+}
+
+// =============================================================================
+// PRIVATE - caller holds the mutex unless noted
+// =============================================================================
+
+int CorrelationEngine::findSlot(uint32_t id) const {
+  int index = id & SLOT_MASK;
+  if (index >= MAX_IN_FLIGHT || pool[index].id != id) {
+    return -1;
+  }
+  return index;
+}
+
+int CorrelationEngine::findByKey(uint32_t dedupKey) const {
+  // Pool is small and fixed, a scan beats maintaining a second index
+  for (int i = 0; i < MAX_IN_FLIGHT; i++) {
+    if (pool[i].id != 0 && pool[i].dedupKey == dedupKey) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+void CorrelationEngine::link(int index) {
+  Entry &entry = pool[index];
+  uint32_t tick = entry.deadline / TICK_MS;
+  if ((int32_t)(tick - currentTick) <= 0) {
+    tick = currentTick + 1;
+  }
+  entry.bucket = tick % WHEEL_SLOTS;
+  entry.prev = -1;
+  entry.next = buckets[entry.bucket];
+  if (entry.next >= 0) {
+    pool[entry.next].prev = index;
+  }
+  buckets[entry.bucket] = index;
+}
+
+void CorrelationEngine::unlink(int index) {
+  Entry &entry = pool[index];
+  if (entry.prev >= 0) {
+    pool[entry.prev].next = entry.next;
+  } else {
+    buckets[entry.bucket] = entry.next;
+  }
+  if (entry.next >= 0) {
+    pool[entry.next].prev = entry.prev;
+  }
+  entry.next = entry.prev = -1;
+}
+
+std::vector<CorrelationEngine::Completion>
+CorrelationEngine::release(int index) {
+  unlink(index);
+  Entry &entry = pool[index];
+  entry.id = 0;
+  entry.dedupKey = 0;
+  stats.inFlight--;
+  return std::move(entry.waiters);
+}
+
+// Called without the mutex held - completions may issue new requests
+void CorrelationEngine::reject(Completion &completion) {
+  if (completion) {
+    completion(Outcome::REJECTED, nullptr);
+  }
+}
+
+void CorrelationEngine::finish(std::vector<Completion> &waiters,
+                               Outcome outcome, const Message *response) {
+  for (auto &waiter : waiters) {
+    if (waiter) {
+      waiter(outcome, response);
+    }
+  }
+}
+
+} // namespace Messaging
@@ -0,0 +1,131 @@
+#pragma once
+
+#include "Message.h"
+#include <Arduino.h>
+#include <MessagingConfig.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <functional>
+#include <vector>
+
+namespace Messaging {
+
+/**
+ * REQUEST/RESPONSE CORRELATION
+ *
+ * Tracks outgoing requests until a matching response arrives or their
+ * deadline passes.
+ *
+ * - Correlation ids are compact integers: pool slot in the low bits, slot
+ *   generation above, bit 31 set so they never collide with untracked
+ *   Config::generateRequestId() values. Lookup is a direct pool index.
+ * - Requests with the same non-zero dedup key share one in-flight entry; the
+ *   message is only sent once and every caller's completion is invoked.
+ * - Deadlines live in a hashed timer wheel, expiry cost is proportional to
+ *   the bucket being visited rather than the number of in-flight requests.
+ *
+ * Completions run outside the internal lock, on whichever task completed or
+ * expired the request (normally the SerialEngine RXTX task on Core 1). Every
+ * issued completion runs exactly once; a request that cannot be tracked is
+ * not sent and completes REJECTED from inside issue().
+ */
+class CorrelationEngine {
+public:
+  enum class Outcome : uint8_t { COMPLETED, TIMED_OUT, CANCELLED, REJECTED };
+
+  // response is only non-null for COMPLETED
+  using Completion = std::function<void(Outcome outcome, const Message *response)>;
+
+  struct Stats {
+    uint32_t issued = 0;
+    uint32_t deduplicated = 0;
+    uint32_t completed = 0;
+    uint32_t timedOut = 0;
+    uint32_t cancelled = 0;
+    uint32_t unmatchedResponses = 0;
+    uint32_t poolExhausted = 0; // Rejected, pool full
+    uint32_t inFlight = 0;
+    uint32_t peakInFlight = 0;
+    uint32_t totalLatencyMs = 0; // Sum over completed requests
+  };
+
+  static CorrelationEngine &getInstance();
+
+  bool init();
+  void deinit();
+
+  // Assigns a correlation id to msg, sends it and tracks it until completion
+  // or timeout. If dedupKey is non-zero and an equal request is already in
+  // flight, msg is not sent and completion joins the existing request.
+  // Returns the correlation id. If the engine is not initialized or the pool
+  // is full, msg is not sent, completion runs with REJECTED before issue()
+  // returns, and 0 is returned.
+  uint32_t issue(Message &msg, uint32_t dedupKey, uint32_t timeoutMs,
+                 Completion completion);
+
+  // Resolve by the requestId string echoed back by the server
+  bool complete(const String &requestId, const Message &response);
+
+  // Resolve the in-flight request with this dedup key (for responses that do
+  // not echo a request id)
+  bool completeByKey(uint32_t dedupKey, const Message &response);
+
+  bool cancel(uint32_t id);
+  void cancelAll();
+
+  bool isInFlight(uint32_t dedupKey);
+
+  // Advance the deadline wheel - call frequently (RXTX loop)
+  void update();
+
+  Stats getStats();
+  String getStatus();
+
+  // Dedup key helper: FNV-1a over type and logical key
+  static uint32_t makeKey(const char *type, const char *key = "");
+
+private:
+  CorrelationEngine() = default;
+  static CorrelationEngine *instance;
+
+  static const int MAX_IN_FLIGHT = MESSAGING_CORRELATION_MAX_IN_FLIGHT;
+  static const int WHEEL_SLOTS = MESSAGING_CORRELATION_WHEEL_SLOTS;
+  static const uint32_t TICK_MS = MESSAGING_CORRELATION_TICK_MS;
+  static const uint32_t ID_FLAG = 0x80000000u;
+  static const uint32_t SLOT_BITS = 6;
+  static const uint32_t SLOT_MASK = (1u << SLOT_BITS) - 1;
+
+  static_assert(MAX_IN_FLIGHT <= (1 << SLOT_BITS),
+                "Correlation pool index must fit in SLOT_BITS");
+  static_assert(MAX_IN_FLIGHT < 127, "Wheel links are int8_t");
+
+  struct Entry {
+    uint32_t id = 0; // 0 = free
+    uint32_t dedupKey = 0;
+    uint32_t issuedAt = 0;
+    uint32_t deadline = 0;
+    uint16_t generation = 0;
+    uint8_t bucket = 0;
+    int8_t next = -1; // Wheel bucket links (pool indices)
+    int8_t prev = -1;
+    std::vector<Completion> waiters;
+  };
+
+  Entry pool[MAX_IN_FLIGHT];
+  int8_t buckets[WHEEL_SLOTS];
+  uint32_t currentTick = 0;
+  SemaphoreHandle_t mutex = nullptr;
+  Stats stats;
+  bool initialized = false;
+
+  int findSlot(uint32_t id) const;
+  int findByKey(uint32_t dedupKey) const;
+  void link(int index);
+  void unlink(int index);
+  std::vector<Completion> release(int index);
+  void finish(std::vector<Completion> &waiters, Outcome outcome,
+              const Message *response);
+  void reject(Completion &completion);
+};
+
+} // namespace Messaging
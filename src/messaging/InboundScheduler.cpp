@@ -0,0 +1,207 @@
+#include "InboundScheduler.h"
+#include "Message.h"
+#include <esp_log.h>
+#include <esp_timer.h>
+
+static const char *TAG = "InboundScheduler";
+
+namespace Messaging {
+
+using MessageProtocol::MessagePriority;
+
+InboundScheduler *InboundScheduler::instance = nullptr;
+
+static const char *PRIORITY_NAMES[InboundScheduler::CLASS_COUNT] = {
+    "low", "normal", "high", "critical"};
+
+InboundScheduler &InboundScheduler::getInstance() {
+  if (!instance) {
+    instance = new InboundScheduler();
+  }
+  return *instance;
+}
+
+// =============================================================================
+// CLASSIFICATION
+// =============================================================================
+
+MessagePriority InboundScheduler::priorityForType(const String &type) {
+  // Audio state and echoes of user actions - the user is watching the
+  // slider. One class, so they are applied in the order they arrived.
+  if (type == Message::TYPE_AUDIO_STATUS ||
+      type == Message::TYPE_VOLUME_CHANGE || type == Message::TYPE_SET_VOLUME ||
+      type == Message::TYPE_MUTE_TOGGLE ||
+      type == Message::TYPE_SET_DEFAULT_DEVICE) {
+    return MessagePriority::MSG_HIGH;
+  }
+  // Bulk: base64 decode and SD write per message
+  if (type == Message::TYPE_ASSET_RESPONSE) {
+    return MessagePriority::MSG_LOW;
+  }
+  return MessagePriority::MSG_NORMAL;
+}
+
+// Looks only at the messageType value, the full parse happens at dispatch
+MessagePriority InboundScheduler::classify(const String &json) {
+  int key = json.indexOf("\"messageType\"");
+  if (key < 0) {
+    return MessagePriority::MSG_NORMAL;
+  }
+  int colon = json.indexOf(':', key);
+  int open = colon < 0 ? -1 : json.indexOf('"', colon + 1);
+  int close = open < 0 ? -1 : json.indexOf('"', open + 1);
+  if (close < 0) {
+    return MessagePriority::MSG_NORMAL;
+  }
+  return priorityForType(Message::stringToType(json.substring(open + 1, close)));
+}
+
+// =============================================================================
+// QUEUEING / DISPATCH
+// =============================================================================
+
+bool InboundScheduler::enqueue(const String &json) {
+  int cls = static_cast<int>(classify(json));
+  ClassStats &classStats = stats[cls];
+
+  size_t bytes = json.length();
+  if (queues[cls].size() >= MESSAGING_INBOUND_QUEUE_DEPTH ||
+      (!queues[cls].empty() &&
+       queuedBytes[cls] + bytes > MESSAGING_INBOUND_QUEUE_BYTES)) {
+    classStats.dropped++;
+    ESP_LOGW(TAG, "%s queue full (%u messages, %u bytes) - message dropped",
+             PRIORITY_NAMES[cls], (unsigned)queues[cls].size(),
+             (unsigned)queuedBytes[cls]);
+    return false;
+  }
+
+  queues[cls].push_back({json, esp_timer_get_time()});
+  queuedBytes[cls] += bytes;
+  classStats.enqueued++;
+  if (queues[cls].size() > classStats.maxDepth) {
+    classStats.maxDepth = queues[cls].size();
+  }
+  if (queuedBytes[cls] > classStats.maxBytes) {
+    classStats.maxBytes = queuedBytes[cls];
+  }
+  return true;
+}
+
+size_t InboundScheduler::dispatch(uint32_t budgetUs, const Deliver &deliver) {
+  int64_t start = esp_timer_get_time();
+  size_t delivered = 0;
+
+  while (true) {
+    int64_t now = esp_timer_get_time();
+    int cls = pickClass(now);
+    if (cls < 0) {
+      break;
+    }
+
+    Pending item = std::move(queues[cls].front());
+    queues[cls].pop_front();
+    queuedBytes[cls] -= item.json.length();
+    deliver(item.json);
+    delivered++;
+
+    now = esp_timer_get_time();
+    ClassStats &classStats = stats[cls];
+    uint32_t latency = static_cast<uint32_t>(now - item.enqueuedAt);
+    classStats.dispatched++;
+    classStats.totalLatencyUs += latency;
+    if (latency > classStats.maxLatencyUs) {
+      classStats.maxLatencyUs = latency;
+    }
+
+    // Give RX a chance to pick up newer (possibly more urgent) messages
+    if (now - start >= budgetUs) {
+      break;
+    }
+  }
+
+  return delivered;
+}
+
+int InboundScheduler::pickClass(int64_t now) {
+  // Aged messages first, oldest wins
+  int aged = -1;
+  int64_t oldest = now - (int64_t)MESSAGING_INBOUND_MAX_WAIT_MS * 1000;
+  for (int cls = 0; cls < CLASS_COUNT; cls++) {
+    if (!queues[cls].empty() && queues[cls].front().enqueuedAt < oldest) {
+      oldest = queues[cls].front().enqueuedAt;
+      aged = cls;
+    }
+  }
+
+  int top = -1;
+  for (int cls = CLASS_COUNT - 1; cls >= 0; cls--) {
+    if (!queues[cls].empty()) {
+      top = cls;
+      break;
+    }
+  }
+  if (top < 0) {
+    return -1;
+  }
+
+  if (aged >= 0 && aged != top) {
+    stats[aged].promoted++;
+    streak = 0;
+    return aged;
+  }
+
+  int lower = -1;
+  for (int cls = top - 1; cls >= 0; cls--) {
+    if (!queues[cls].empty()) {
+      lower = cls;
+      break;
+    }
+  }
+  if (lower < 0) {
+    streak = 0;
+    return top;
+  }
+
+  if (++streak > MESSAGING_INBOUND_MAX_STREAK) {
+    stats[lower].promoted++;
+    streak = 0;
+    return lower;
+  }
+  return top;
+}
+
+bool InboundScheduler::hasPending() const { return pendingCount() > 0; }
+
+size_t InboundScheduler::pendingCount() const {
+  size_t count = 0;
+  for (const auto &queue : queues) {
+    count += queue.size();
+  }
+  return count;
+}
+
+void InboundScheduler::resetStats() {
+  for (int cls = 0; cls < CLASS_COUNT; cls++) {
+    stats[cls] = ClassStats();
+  }
+}
+
+String InboundScheduler::getStatus() const {
+  String status = "Inbound Scheduler:\n";
+  for (int cls = CLASS_COUNT - 1; cls >= 0; cls--) {
+    const ClassStats &s = stats[cls];
+    if (s.enqueued == 0) {
+      continue;
+    }
+    uint32_t avg = s.dispatched ? s.totalLatencyUs / s.dispatched : 0;
+    status += "- " + String(PRIORITY_NAMES[cls]) + ": " +
+              String(s.dispatched) + "/" + String(s.enqueued) +
+              " dispatched, latency avg " + String(avg) + "us max " +
+              String(s.maxLatencyUs) + "us, depth " + String(s.maxDepth) +
+              " (" + String(s.maxBytes) + " bytes), promoted " +
+              String(s.promoted) + ", dropped " + String(s.dropped) + "\n";
+  }
+  return status;
+}
+
+} // namespace Messaging
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <Arduino.h>
+#include <MessageProtocol.h>
+#include <MessagingConfig.h>
+#include <deque>
+#include <functional>
+
+namespace Messaging {
+
+/**
+ * INBOUND PRIORITY SCHEDULER
+ *
+ * Decoded JSON messages are classified by messageType into one queue per
+ * MessageProtocol::MessagePriority and handed to the router highest class
+ * first, so a user-visible VOLUME_CHANGE echo is not stuck behind a burst of
+ * ASSET_RESPONSE handling (base64 decode + SD write).
+ *
+ * Messages that carry audio state (AUDIO_STATUS, VOLUME_CHANGE, SET_VOLUME,
+ * MUTE_TOGGLE, SET_DEFAULT_DEVICE) share one class, so they stay in arrival
+ * order: an older status can never be applied after a newer volume change.
+ * Only bulk traffic is demoted.
+ *
+ * Each class holds at most MESSAGING_INBOUND_QUEUE_DEPTH messages and
+ * MESSAGING_INBOUND_QUEUE_BYTES of JSON; an empty class always takes one
+ * message, however large.
+ *
+ * Starvation protection for bulk work:
+ * - After MESSAGING_INBOUND_MAX_STREAK dispatches in a row from a higher
+ *   class while a lower one is waiting, the next lower class gets one slot.
+ * - A message waiting longer than MESSAGING_INBOUND_MAX_WAIT_MS is served
+ *   next regardless of class (oldest first).
+ *
+ * Not thread safe: enqueue() and dispatch() both run on the SerialEngine
+ * RXTX task.
+ */
+class InboundScheduler {
+public:
+  using Priority = MessageProtocol::MessagePriority;
+  using Deliver = std::function<void(const String &json)>;
+
+  static const int CLASS_COUNT = 4; // One per MessagePriority value
+
+  struct ClassStats {
+    uint32_t enqueued = 0;
+    uint32_t dispatched = 0;
+    uint32_t dropped = 0;  // Queue full (count or bytes)
+    uint32_t promoted = 0; // Served ahead of a higher class
+    uint32_t maxDepth = 0;
+    uint32_t maxBytes = 0; // JSON queued at the peak
+    uint32_t maxLatencyUs = 0; // Enqueue to handler return
+    uint64_t totalLatencyUs = 0;
+  };
+
+  static InboundScheduler &getInstance();
+
+  // Standalone instances are only used by the unit tests
+  InboundScheduler() = default;
+
+  bool enqueue(const String &json);
+
+  // Deliver queued messages until budgetUs has elapsed; always delivers at
+  // least one if anything is queued. Returns the number delivered.
+  size_t dispatch(uint32_t budgetUs, const Deliver &deliver);
+
+  bool hasPending() const;
+  size_t pendingCount() const;
+
+  static Priority classify(const String &json);
+  static Priority priorityForType(const String &type);
+
+  const ClassStats &getStats(Priority priority) const {
+    return stats[static_cast<int>(priority)];
+  }
+  String getStatus() const;
+  void resetStats(); // Queued messages are kept
+
+private:
+  static InboundScheduler *instance;
+
+  struct Pending {
+    String json;
+    int64_t enqueuedAt;
+  };
+
+  std::deque<Pending> queues[CLASS_COUNT];
+  size_t queuedBytes[CLASS_COUNT] = {};
+  ClassStats stats[CLASS_COUNT];
+  uint32_t streak = 0;
+
+  int pickClass(int64_t now);
+};
+
+} // namespace Messaging
@@ -1,8 +1,8 @@
 #include "Message.h"
-#include "SimplifiedSerialEngine.h"
 #include "protocol/MessageConfig.h"
 #include <ArduinoJson.h>
 #include <MessagingConfig.h>
+#include <reflect_codec.hpp>
 
 static const char *TAG = "Message";
 
@@ -63,6 +63,19 @@ Message Message::createVolumeChange(const String &processName, int volume,
   return msg;
 }
 
+Message Message::createMuteToggle(const String &processName,
+                                  const String &deviceId) {
+  Message msg(TYPE_MUTE_TOGGLE);
+  msg.deviceId = deviceId.isEmpty() ? Config::getDeviceId() : deviceId;
+  msg.requestId = Config::generateRequestId();
+  msg.timestamp = millis();
+
+  strncpy(msg.data.volume.processName, processName.c_str(),
+          sizeof(msg.data.volume.processName) - 1);
+
+  return msg;
+}
+
 Message Message::createAudioStatus(const AudioData &audioData,
                                    const String &deviceId) {
   Message msg;
@@ -90,6 +103,8 @@ Message Message::createAssetResponse(const AssetData &assetData,
 // JSON SERIALIZATION - Direct and simple
 // =============================================================================
 
+namespace codec = reflective::codec;
+
 String Message::toJson() const {
   JsonDocument doc;
 
@@ -114,41 +129,24 @@ String Message::toJson() const {
     // For now, skip complex nested objects to avoid API issues
     // Sessions and default device can be added later if needed
   } else if (type == TYPE_ASSET_REQUEST) {
-    doc["processName"] = data.asset.processName;
+    doc["processName"] = (const char *)data.asset.processName;
   } else if (type == TYPE_ASSET_RESPONSE) {
-    doc["processName"] = data.asset.processName;
-    doc["success"] = data.asset.success;
-    doc["errorMessage"] = data.asset.errorMessage;
-    doc["assetData"] = data.asset.assetDataBase64;
-    doc["width"] = data.asset.width;
-    doc["height"] = data.asset.height;
-    doc["format"] = data.asset.format;
+    codec::encodeFields(doc.as<JsonObject>(), data.asset);
   } else if (type == TYPE_SET_VOLUME || type == TYPE_VOLUME_CHANGE) {
-    doc["processName"] = data.volume.processName;
-    doc["volume"] = data.volume.volume;
-    doc["target"] = data.volume.target;
+    codec::encodeFields(doc.as<JsonObject>(), data.volume);
+  } else if (type == TYPE_MUTE_TOGGLE) {
+    // Without processName the host toggles the default device, as before
+    if (strlen(data.volume.processName) > 0) {
+      doc["processName"] = (const char *)data.volume.processName;
+    }
   }
-  // GET_STATUS, MUTE_TOGGLE, SET_DEFAULT_DEVICE have no additional data
+  // GET_STATUS, SET_DEFAULT_DEVICE have no additional data
 
   String result;
   serializeJson(doc, result);
   return result;
 }
 
-// =============================================================================
-// STREAMLINED MESSAGE SENDING
-// =============================================================================
-
-void Message::send() const {
-  if (!isValid()) {
-    ESP_LOGW(TAG, "Cannot send invalid message");
-    return;
-  }
-
-  // Use the streamlined SerialEngine send method
-  SerialEngine::getInstance().send(*this);
-}
-
 // =============================================================================
 // JSON DESERIALIZATION
 // =============================================================================
@@ -187,79 +185,27 @@ Message Message::fromJson(const String &json) {
                               sizeof(msg.data.audio.originatingDeviceId), "");
 
     // Parse sessions array
-    if (doc.containsKey("sessions") && doc["sessions"].is<JsonArray>()) {
-      JsonArray sessions = doc["sessions"].as<JsonArray>();
-      msg.data.audio.sessionCount = 0;
-
-      for (JsonVariant sessionVariant : sessions) {
-        if (msg.data.audio.sessionCount >= 16)
-          break; // Max 16 sessions
-
-        JsonObject session = sessionVariant.as<JsonObject>();
-        auto &sessionData =
-            msg.data.audio.sessions[msg.data.audio.sessionCount];
-
-        sessionData.processId = session["processId"] | 0;
-        SAFE_JSON_EXTRACT_CSTRING(session, "processName",
-                                  sessionData.processName,
-                                  sizeof(sessionData.processName), "");
-        SAFE_JSON_EXTRACT_CSTRING(session, "displayName",
-                                  sessionData.displayName,
-                                  sizeof(sessionData.displayName), "");
-        SAFE_JSON_EXTRACT_FLOAT(session, "volume", sessionData.volume, 0.0f);
-        sessionData.isMuted = session["isMuted"] | false;
-        SAFE_JSON_EXTRACT_CSTRING(session, "state", sessionData.state,
-                                  sizeof(sessionData.state), "");
-
-        msg.data.audio.sessionCount++;
-      }
-    } else {
-      msg.data.audio.sessionCount = 0;
-    }
+    msg.data.audio.sessionCount = (int)codec::decodeArray(
+        doc["sessions"].as<JsonArrayConst>(), msg.data.audio.sessions);
 
     // Parse defaultDevice object
-    if (doc.containsKey("defaultDevice") &&
-        doc["defaultDevice"].is<JsonObject>()) {
-      JsonObject defaultDevice = doc["defaultDevice"].as<JsonObject>();
-      msg.data.audio.hasDefaultDevice = true;
-
-      SAFE_JSON_EXTRACT_CSTRING(
-          defaultDevice, "friendlyName",
-          msg.data.audio.defaultDevice.friendlyName,
-          sizeof(msg.data.audio.defaultDevice.friendlyName), "");
-      SAFE_JSON_EXTRACT_FLOAT(defaultDevice, "volume",
-                              msg.data.audio.defaultDevice.volume, 0.0f);
-      msg.data.audio.defaultDevice.isMuted = defaultDevice["isMuted"] | false;
-      SAFE_JSON_EXTRACT_CSTRING(
-          defaultDevice, "dataFlow", msg.data.audio.defaultDevice.dataFlow,
-          sizeof(msg.data.audio.defaultDevice.dataFlow), "");
-      SAFE_JSON_EXTRACT_CSTRING(
-          defaultDevice, "deviceRole", msg.data.audio.defaultDevice.deviceRole,
-          sizeof(msg.data.audio.defaultDevice.deviceRole), "");
-    } else {
-      msg.data.audio.hasDefaultDevice = false;
+    msg.data.audio.hasDefaultDevice = doc["defaultDevice"].is<JsonObject>();
+    if (msg.data.audio.hasDefaultDevice) {
+      codec::decodeValue(doc["defaultDevice"], msg.data.audio.defaultDevice);
     }
   } else if (msg.type == TYPE_ASSET_REQUEST) {
     SAFE_JSON_EXTRACT_CSTRING(doc, "processName", msg.data.asset.processName,
                               sizeof(msg.data.asset.processName), "");
   } else if (msg.type == TYPE_ASSET_RESPONSE) {
-    SAFE_JSON_EXTRACT_CSTRING(doc, "processName", msg.data.asset.processName,
-                              sizeof(msg.data.asset.processName), "");
-    SAFE_JSON_EXTRACT_BOOL(doc, "success", msg.data.asset.success, false);
-    SAFE_JSON_EXTRACT_CSTRING(doc, "errorMessage", msg.data.asset.errorMessage,
-                              sizeof(msg.data.asset.errorMessage), "");
-    SAFE_JSON_EXTRACT_CSTRING(doc, "assetData", msg.data.asset.assetDataBase64,
-                              sizeof(msg.data.asset.assetDataBase64), "");
-    SAFE_JSON_EXTRACT_INT(doc, "width", msg.data.asset.width, 0);
-    SAFE_JSON_EXTRACT_INT(doc, "height", msg.data.asset.height, 0);
-    SAFE_JSON_EXTRACT_CSTRING(doc, "format", msg.data.asset.format,
-                              sizeof(msg.data.asset.format), "");
+    codec::decodeFields(doc.as<JsonObjectConst>(), msg.data.asset);
   } else if (msg.type == TYPE_SET_VOLUME || msg.type == TYPE_VOLUME_CHANGE) {
+    codec::decodeFields(doc.as<JsonObjectConst>(), msg.data.volume);
+    if (msg.data.volume.target[0] == '\0') {
+      strcpy(msg.data.volume.target, "default");
+    }
+  } else if (msg.type == TYPE_MUTE_TOGGLE) {
     SAFE_JSON_EXTRACT_CSTRING(doc, "processName", msg.data.volume.processName,
                               sizeof(msg.data.volume.processName), "");
-    SAFE_JSON_EXTRACT_INT(doc, "volume", msg.data.volume.volume, 0);
-    SAFE_JSON_EXTRACT_CSTRING(doc, "target", msg.data.volume.target,
-                              sizeof(msg.data.volume.target), "default");
   }
 
   return msg;
@@ -370,7 +316,8 @@ String Message::toString() const {
   } else if (type == TYPE_GET_STATUS) {
     result += "  StatusRequest\n";
   } else if (type == TYPE_MUTE_TOGGLE) {
-    result += "  MuteToggle\n";
+    result += "  MuteToggle:\n";
+    result += "    ProcessName: '" + String(data.volume.processName) + "'\n";
   } else if (type == TYPE_SET_DEFAULT_DEVICE) {
     result += "  SetDefaultDevice\n";
   } else {
@@ -380,17 +327,4 @@ String Message::toString() const {
   return result;
 }
 
-// =============================================================================
-// MESSAGE ROUTER IMPLEMENTATION
-// =============================================================================
-
-void MessageRouter::send(const Message &msg) {
-  if (!msg.isValid()) {
-    ESP_LOGW(TAG, "Attempted to send invalid message");
-    return;
-  }
-
-  SerialEngine::getInstance().send(msg);
-}
-
 } // namespace Messaging
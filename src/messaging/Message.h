@@ -5,6 +5,7 @@
 #include <esp_log.h>
 #include <functional>
 #include <memory>
+#include <reflect.hpp>
 #include <unordered_map>
 
 namespace Messaging {
@@ -32,6 +33,8 @@ struct Message {
   uint32_t timestamp = 0;
 
   // Simple payload data - NEW FORMAT for complex audio status
+  // Payload structs declare their wire fields once; JSON and binary codecs
+  // are generated from these tables (see reflect_codec.hpp)
   struct SessionData {
     int processId;
     char processName[64];
@@ -39,6 +42,11 @@ struct Message {
     float volume;
     bool isMuted;
     char state[32];
+
+    REFLECT_DECLARE(SessionData, REFLECT_FIELD(processId),
+                    REFLECT_FIELD(processName), REFLECT_FIELD(displayName),
+                    REFLECT_FIELD(volume), REFLECT_FIELD(isMuted),
+                    REFLECT_FIELD(state))
   };
 
   struct DefaultDeviceData {
@@ -47,6 +55,10 @@ struct Message {
     bool isMuted;
     char dataFlow[16];
     char deviceRole[16];
+
+    REFLECT_DECLARE(DefaultDeviceData, REFLECT_FIELD(friendlyName),
+                    REFLECT_FIELD(volume), REFLECT_FIELD(isMuted),
+                    REFLECT_FIELD(dataFlow), REFLECT_FIELD(deviceRole))
   };
 
   struct AudioData {
@@ -68,12 +80,21 @@ struct Message {
     int width;
     int height;
     char format[16];
+
+    REFLECT_DECLARE(AssetData, REFLECT_FIELD(processName),
+                    REFLECT_FIELD(success), REFLECT_FIELD(errorMessage),
+                    REFLECT_FIELD_AS(assetDataBase64, "assetData"),
+                    REFLECT_FIELD(width), REFLECT_FIELD(height),
+                    REFLECT_FIELD(format))
   };
 
   struct VolumeData {
     char processName[64];
     int volume;
     char target[64]; // "default" or specific device
+
+    REFLECT_DECLARE(VolumeData, REFLECT_FIELD(processName),
+                    REFLECT_FIELD(volume), REFLECT_FIELD(target))
   };
 
   // Tagged union for payload
@@ -93,7 +114,8 @@ struct Message {
                messageType == TYPE_ASSET_RESPONSE) {
       initializeAssetData();
     } else if (messageType == TYPE_SET_VOLUME ||
-               messageType == TYPE_VOLUME_CHANGE) {
+               messageType == TYPE_VOLUME_CHANGE ||
+               messageType == TYPE_MUTE_TOGGLE) {
       initializeVolumeData();
     } else {
       initializeAudioData();
@@ -118,6 +140,8 @@ struct Message {
                                     const String &deviceId);
   static Message createVolumeChange(const String &processName, int volume,
                                     const String &deviceId);
+  static Message createMuteToggle(const String &processName,
+                                  const String &deviceId);
   static Message createAudioStatus(const AudioData &audioData,
                                    const String &deviceId);
   static Message createAssetResponse(const AssetData &assetData,
@@ -182,6 +206,9 @@ public:
   // Send message out via serial
   void send(const Message &msg);
 
+  // Send serialized messages together, in one batch frame where they fit
+  void sendGroup(const std::vector<String> &jsons);
+
   // Get handler count for status
   size_t getHandlerCount() const { return handlers.size(); }
 };
@@ -194,6 +221,10 @@ inline void sendMessage(const Message &msg) {
   MessageRouter::getInstance().send(msg);
 }
 
+inline void sendMessageGroup(const std::vector<String> &jsons) {
+  MessageRouter::getInstance().sendGroup(jsons);
+}
+
 inline void subscribe(const String &type,
                       std::function<void(const Message &)> handler) {
   MessageRouter::getInstance().subscribe(type, handler);
@@ -1,6 +1,8 @@
+#include "CorrelationEngine.h"
 #include "Message.h"
 #include "SimplifiedSerialEngine.h"
 #include <Arduino.h>
+#include <MessagingConfig.h>
 #include <esp_log.h>
 
 static const char *TAG = "MessagingInit";
@@ -13,6 +15,12 @@ bool initMessaging() {
   ESP_LOGI(TAG, "Current free heap: %d", ESP.getFreeHeap());
   ESP_LOGI(TAG, "Current stack watermark: %d", uxTaskGetStackHighWaterMark(NULL));
   
+  // Request/response tracking must exist before anything can be sent
+  if (!CorrelationEngine::getInstance().init()) {
+    ESP_LOGE(TAG, "Failed to initialize correlation engine");
+    return false;
+  }
+
   // Initialize the serial engine - that's it!
   ESP_LOGI(TAG, "Creating SerialEngine instance...");
   SerialEngine& engine = SerialEngine::getInstance();
@@ -44,7 +52,9 @@ bool initMessaging() {
 // Shutdown function
 void shutdownMessaging() {
   ESP_LOGI(TAG, "Shutting down messaging system");
+  WireCapture::getInstance().stop();
   SerialEngine::getInstance().stop();
+  CorrelationEngine::getInstance().deinit();
 }
 
 // Get status
@@ -56,10 +66,38 @@ String getMessagingStatus() {
   status += "- Messages sent: " + String(stats.messagesSent) + "\n";
   status += "- Parse errors: " + String(stats.parseErrors) + "\n";
   status += "- Framing errors: " + String(stats.framingErrors) + "\n";
+
+  const auto &wire = SerialEngine::getInstance().framer.getStatistics();
+  status += "- Batches sent: " + String(wire.batchesSent) + " (" +
+            String(wire.batchedMessagesSent) + " msgs), received: " +
+            String(wire.batchesReceived) + " (" +
+            String(wire.batchedMessagesReceived) + " msgs)\n";
+  if (wire.messagesSent > 0) {
+    status += "- TX bytes/message: " +
+              String(wire.bytesTransmitted / wire.messagesSent) + "\n";
+  }
+  if (stats.messagesReceived > 0) {
+    status += "- RX us/message: framer " +
+              String((uint32_t)(stats.framerUs / stats.messagesReceived)) +
+              ", parse " +
+              String((uint32_t)(stats.parseUs / stats.messagesReceived)) +
+              ", route " +
+              String((uint32_t)(stats.routeUs / stats.messagesReceived)) +
+              "\n";
+  }
   status += "- Active handlers: " +
             String(MessageRouter::getInstance().getHandlerCount()) + "\n";
+  status += CorrelationEngine::getInstance().getStatus();
+  status += InboundScheduler::getInstance().getStatus();
+  status += WireCapture::getInstance().getStatus();
 
   return status;
 }
 
+void resetMessagingStats() {
+  SerialEngine::getInstance().resetStats();
+  InboundScheduler::getInstance().resetStats();
+  ESP_LOGI(TAG, "Messaging statistics reset");
+}
+
 } // namespace Messaging
@@ -13,4 +13,9 @@ void shutdownMessaging();
 // Get status string
 String getMessagingStatus();
 
+// Zero the cumulative counters reported by getMessagingStatus(), so a
+// stretch of live traffic can be measured on its own. Call from the RXTX
+// task.
+void resetMessagingStats();
+
 }  // namespace Messaging
@@ -8,5 +8,33 @@ namespace Messaging {
 // Static member definitions
 SerialEngine* SerialEngine::instance = nullptr;
 SemaphoreHandle_t SerialEngine::serialMutex = nullptr;
+TaskHandle_t SerialEngine::debugTaskHandle = nullptr;
+
+// Outbound paths of Message and MessageRouter live here so Message.cpp stays
+// free of the transport and builds on the host
+void Message::send() const {
+    if (!isValid()) {
+        ESP_LOGW(TAG, "Cannot send invalid message");
+        return;
+    }
+
+    SerialEngine::getInstance().send(*this);
+}
+
+void MessageRouter::send(const Message& msg) {
+    if (!msg.isValid()) {
+        ESP_LOGW(TAG, "Attempted to send invalid message");
+        return;
+    }
+
+    SerialEngine::getInstance().send(msg);
+}
+
+void MessageRouter::sendGroup(const std::vector<String>& jsons) {
+    if (jsons.empty()) {
+        return;
+    }
+    SerialEngine::getInstance().sendGroup(jsons);
+}
 
 }  // namespace Messaging
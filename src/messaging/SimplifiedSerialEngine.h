@@ -1,10 +1,24 @@
 #pragma once
 
+#include "../application/audio/AudioManager.h"
+#include "../application/audio/AudioUI.h"
+#include "../application/ui/LVGLMessageHandler.h"
+#include "../application/ui/dialogs/UniversalDialog.h"
+#include "../application/ui/performance/InvalidationTrace.h"
+#include "../application/ui/performance/UIBenchmark.h"
+#include "../core/FrameScheduler.h"
+#include "../core/TaskManager.h"
+#include "CorrelationEngine.h"
+#include "InboundScheduler.h"
 #include "Message.h"
+#include "MessagingInit.h"
 #include "UiEventHandlers.h"
+#include "WireCapture.h"
 #include <Arduino.h>
 #include <BinaryProtocol.h>
+#include <MessagingConfig.h>
 #include <esp_log.h>
+#include <esp_timer.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/queue.h>
 #include <freertos/task.h>
@@ -91,6 +105,8 @@ class SerialEngine {
 
     // Inter-core message queue for stringified JSON messages
     QueueHandle_t txMessageQueue = nullptr;
+    // Held while a group is queued, so no frame is started half way through
+    SemaphoreHandle_t txGroupMutex = nullptr;
     static const int TX_QUEUE_SIZE = 20;
     static const int MAX_JSON_MESSAGE_SIZE = 2048;
 
@@ -107,6 +123,10 @@ class SerialEngine {
         uint32_t framingErrors = 0;
         uint32_t messagesQueued = 0;
         uint32_t queueOverflows = 0;
+        // Cumulative RX processing time per stage
+        uint64_t framerUs = 0;
+        uint64_t parseUs = 0;
+        uint64_t routeUs = 0;
     } stats;
 
     SerialEngine() = default;
@@ -245,6 +265,29 @@ class SerialEngine {
         stats.messagesSent++;
     }
 
+    // Send already serialized messages as one batch frame when the peer
+    // takes batches and they fit, so the host receives them together
+    void sendGroup(const std::vector<String> &jsons) {
+        if (!running) {
+            ESP_LOGW("SerialEngine", "Serial engine not running");
+            return;
+        }
+
+        if (xPortGetCoreID() == 1) {
+            sendGroupDirect(jsons);
+        } else {
+            // The TX task skips its pass while the group is being queued,
+            // then finds all of it waiting
+            xSemaphoreTake(txGroupMutex, portMAX_DELAY);
+            for (const String &json : jsons) {
+                enqueueJsonForTx(json);
+            }
+            xSemaphoreGive(txGroupMutex);
+        }
+
+        stats.messagesSent += jsons.size();
+    }
+
     // Send raw string (for compatibility and testing)
     void sendRaw(const String &data) {
         if (!running)
@@ -264,6 +307,18 @@ class SerialEngine {
     // Get statistics
     const Stats &getStats() const { return stats; }
 
+    // Messages waiting for the RXTX task to transmit them
+    size_t getTxQueueDepth() const {
+        return txMessageQueue ? uxQueueMessagesWaiting(txMessageQueue) : 0;
+    }
+
+    // Zero the RX/TX counters and stage times, framer included. Call from
+    // the RXTX task so no RX update is lost half way.
+    void resetStats() {
+        stats = Stats();
+        framer.resetStatistics();
+    }
+
     // Get serial mutex for external synchronization (e.g., CoreLoggingFilter)
     static SemaphoreHandle_t getSerialMutex() { return serialMutex; }
 
@@ -297,6 +352,13 @@ class SerialEngine {
             }
             ESP_LOGI("SerialEngine", "TX message queue initialized");
         }
+        if (txGroupMutex == nullptr) {
+            txGroupMutex = xSemaphoreCreateMutex();
+            if (txGroupMutex == nullptr) {
+                ESP_LOGE("SerialEngine", "Failed to create TX group mutex");
+                return false;
+            }
+        }
         return true;
     }
 
@@ -342,46 +404,96 @@ class SerialEngine {
 
         // Use the binary framer to encode the message - using class member buffer
         size_t frameLength = 0;
-        std::vector<uint8_t> binaryFrame;
-
         if (framer.encodeMessage(json, frameBuffer, sizeof(frameBuffer),
                                  frameLength)) {
-            binaryFrame.assign(frameBuffer, frameBuffer + frameLength);
+            writeFrame(frameBuffer, frameLength);
+        } else {
+            ESP_LOGW("SerialEngine", "Failed to frame message");
         }
+    }
 
-        if (!binaryFrame.empty()) {
-            ESP_LOGD("SerialEngine", "Binary frame size: %zu bytes",
-                     binaryFrame.size());
+    // Write one encoded frame to Serial
+    void writeFrame(const uint8_t *frame, size_t frameLength) {
+        ESP_LOGD("SerialEngine", "Binary frame size: %zu bytes", frameLength);
 
-            // CRITICAL: Protect Serial access with mutex to prevent race conditions
-            // between ESP_LOG (vprintf) and SerialEngine (Serial.write)
-            if (serialMutex && xSemaphoreTake(serialMutex, pdMS_TO_TICKS(100)) == pdTRUE) {
-                // Send the binary frame via Arduino Serial
-                size_t written = Serial.write(binaryFrame.data(), binaryFrame.size());
-                Serial.flush();
+        // CRITICAL: Protect Serial access with mutex to prevent race conditions
+        // between ESP_LOG (vprintf) and SerialEngine (Serial.write)
+        if (serialMutex && xSemaphoreTake(serialMutex, pdMS_TO_TICKS(100)) == pdTRUE) {
+            // Send the binary frame via Arduino Serial
+            size_t written = Serial.write(frame, frameLength);
+            Serial.flush();
 
-                xSemaphoreGive(serialMutex);
+            xSemaphoreGive(serialMutex);
 
-                if (written != binaryFrame.size()) {
-                    ESP_LOGW("SerialEngine", "Failed to write complete frame: %zu/%zu",
-                             written, binaryFrame.size());
-                } else {
-                    ESP_LOGD("SerialEngine", "Successfully sent %zu bytes", written);
-                }
+            WireCapture::getInstance().record(WireCapture::DIRECTION_TX, frame,
+                                              written);
+
+            if (written != frameLength) {
+                ESP_LOGW("SerialEngine", "Failed to write complete frame: %zu/%zu",
+                         written, frameLength);
             } else {
-                ESP_LOGW("SerialEngine", "Failed to acquire serial mutex for transmission");
+                ESP_LOGD("SerialEngine", "Successfully sent %zu bytes", written);
             }
         } else {
-            ESP_LOGW("SerialEngine", "Failed to frame message");
+            ESP_LOGW("SerialEngine", "Failed to acquire serial mutex for transmission");
         }
     }
 
+    // Core 1 side of sendGroup(): fill batch frames directly, a message that
+    // does not fit starts the next frame
+    void sendGroupDirect(const std::vector<String> &jsons) {
+        if (!isTxBatchingEnabled() || jsons.size() < 2) {
+            for (const String &json : jsons) {
+                sendJsonDirect(json);
+            }
+            return;
+        }
+
+        framer.beginBatch(frameBuffer, sizeof(frameBuffer));
+        for (const String &json : jsons) {
+            if (framer.getBatchCount() < MESSAGING_BATCH_MAX_MESSAGES &&
+                framer.addToBatch(json.c_str(), json.length())) {
+                continue;
+            }
+            size_t frameLength = framer.finishBatch();
+            if (frameLength > 0) {
+                writeFrame(frameBuffer, frameLength);
+            }
+            framer.beginBatch(frameBuffer, sizeof(frameBuffer));
+            if (!framer.addToBatch(json.c_str(), json.length())) {
+                // Too large for any batch - on its own
+                framer.finishBatch();
+                sendJsonDirect(json);
+                framer.beginBatch(frameBuffer, sizeof(frameBuffer));
+            }
+        }
+        size_t frameLength = framer.finishBatch();
+        if (frameLength > 0) {
+            writeFrame(frameBuffer, frameLength);
+        }
+    }
+
+    bool isTxBatchingEnabled() const {
+#if MESSAGING_BATCH_TX_MODE == 2
+        return true;
+#elif MESSAGING_BATCH_TX_MODE == 1
+        return framer.peerSupportsBatches();
+#else
+        return false;
+#endif
+    }
+
     // Process queued TX messages (called by Core 1 RXTX task)
     bool processTxMessageQueue() {
         if (!txMessageQueue) {
             return false;
         }
 
+        // A group is being queued - take it whole on the next pass
+        if (xSemaphoreTake(txGroupMutex, 0) != pdTRUE) {
+            return false;
+        }
+
         bool processedMessages = false;
         char queueBuffer[MAX_JSON_MESSAGE_SIZE];
 
@@ -389,6 +501,32 @@ class SerialEngine {
             processedMessages = true;
             queueBuffer[MAX_JSON_MESSAGE_SIZE - 1] = '\0';  // Ensure null termination
 
+            // Whatever else is already queued rides in the same frame: one
+            // header, CRC, mutex take and flush instead of one per message
+            if (isTxBatchingEnabled() && uxQueueMessagesWaiting(txMessageQueue) > 0) {
+                framer.beginBatch(frameBuffer, sizeof(frameBuffer));
+                if (framer.addToBatch(queueBuffer, strlen(queueBuffer))) {
+                    // Peek first so a message that does not fit stays queued
+                    // for the next frame
+                    while (framer.getBatchCount() < MESSAGING_BATCH_MAX_MESSAGES &&
+                           xQueuePeek(txMessageQueue, queueBuffer, 0) == pdTRUE) {
+                        queueBuffer[MAX_JSON_MESSAGE_SIZE - 1] = '\0';
+                        if (!framer.addToBatch(queueBuffer, strlen(queueBuffer))) {
+                            break;
+                        }
+                        xQueueReceive(txMessageQueue, queueBuffer, 0);
+                    }
+
+                    size_t batchCount = framer.getBatchCount();
+                    size_t frameLength = framer.finishBatch();
+                    ESP_LOGD("SerialEngine", "Sending batch of %zu messages: %zu bytes",
+                             batchCount, frameLength);
+                    writeFrame(frameBuffer, frameLength);
+                    continue;
+                }
+                framer.finishBatch();  // Nothing added - fall back to a single frame
+            }
+
             String json(queueBuffer);
             ESP_LOGD("SerialEngine", "Processing queued message: %d bytes",
                      json.length());
@@ -396,9 +534,234 @@ class SerialEngine {
             sendJsonDirect(json);
         }
 
+        xSemaphoreGive(txGroupMutex);
         return processedMessages;
     }
 
+    // =========================================================================
+    // DEBUG COMMANDS
+    // =========================================================================
+
+    struct DebugCommand {
+        const char *name;
+        void (*handler)(void);
+        bool detached = false;  // Runs for seconds, so not on the RXTX task
+    };
+
+    // One detached command at a time; it runs in a one-shot task on core 1
+    // below the RXTX priority, so RX keeps draining and requests do not
+    // time out while it waits on LVGL
+    static TaskHandle_t debugTaskHandle;
+
+    static void debugCommandTask(void *param) {
+        const DebugCommand *command = static_cast<const DebugCommand *>(param);
+        command->handler();
+        ESP_LOGI("SerialEngine", "DEBUG CMD '%s' finished", command->name);
+        debugTaskHandle = nullptr;
+        vTaskDelete(NULL);
+    }
+
+    static void runDebugCommand(const DebugCommand &command) {
+        if (!command.detached) {
+            command.handler();
+            return;
+        }
+        if (debugTaskHandle != nullptr) {
+            ESP_LOGW("SerialEngine", "A debug command is still running, '%s' dropped",
+                     command.name);
+            return;
+        }
+        BaseType_t result = xTaskCreatePinnedToCore(
+            debugCommandTask, "DebugCmd", 8192, const_cast<DebugCommand *>(&command),
+            1, &debugTaskHandle, 1);
+        if (result != pdPASS) {
+            ESP_LOGE("SerialEngine", "Failed to create debug command task: %d", result);
+            debugTaskHandle = nullptr;
+        }
+    }
+
+    // Typed as "<name> <argument>"
+    struct ArgumentCommand {
+        const char *name;
+        void (*handler)(const String &argument);
+    };
+
+    static int trimLineEnding(const uint8_t *data, int len) {
+        while (len > 0 && (data[len - 1] == '\r' || data[len - 1] == '\n')) {
+            len--;
+        }
+        return len;
+    }
+
+    // True when the received bytes are exactly 'name', line ending ignored
+    static bool matchesCommand(const uint8_t *data, int len, const char *name) {
+        len = trimLineEnding(data, len);
+        size_t nameLength = strlen(name);
+        return len == (int)nameLength && memcmp(data, name, nameLength) == 0;
+    }
+
+    // True when the received bytes are 'name', a space and a non-empty
+    // printable argument, which is returned without the line ending
+    static bool matchesArgumentCommand(const uint8_t *data, int len,
+                                       const char *name, String &argument) {
+        len = trimLineEnding(data, len);
+        int nameLength = strlen(name);
+        if (len <= nameLength + 1 || memcmp(data, name, nameLength) != 0 ||
+            data[nameLength] != ' ') {
+            return false;
+        }
+        for (int i = nameLength + 1; i < len; i++) {
+            if (data[i] < 0x20 || data[i] > 0x7E) {
+                return false;
+            }
+        }
+        argument = String(reinterpret_cast<const char *>(data) + nameLength + 1)
+                       .substring(0, len - nameLength - 1);
+        return true;
+    }
+
+    // TEST: message type mapping of a parsed status message
+    static void runMessageTypeTest() {
+        ESP_LOGI("SerialEngine", "=== MESSAGE TYPE MAPPING TEST ===");
+        String testJson =
+            "{\"messageType\":\"STATUS_MESSAGE\","
+            "\"deviceId\":\"TEST\",\"timestamp\":123456}";
+        ESP_LOGI("SerialEngine", "Test JSON: %s", testJson.c_str());
+
+        auto testMsg = Messaging::Message::fromJson(testJson);
+        ESP_LOGI("SerialEngine", "Parsed type: %s", testMsg.type.c_str());
+        ESP_LOGI("SerialEngine", "Expected: %s",
+                 Messaging::Message::TYPE_AUDIO_STATUS);
+        ESP_LOGI("SerialEngine", "Match: %s",
+                 (testMsg.type == Messaging::Message::TYPE_AUDIO_STATUS) ? "YES"
+                                                                         : "NO");
+    }
+
+    // DEBUG: LVGL message queue RAM and timings, widget binding render
+    // passes, frame budgets and dialogs
+    static void logUiStats() {
+        ESP_LOGI("SerialEngine", "%s",
+                 Application::LVGLMessageHandler::getStatus().c_str());
+        ESP_LOGI("SerialEngine", "%s",
+                 Application::Audio::AudioUI::getInstance().getStatus().c_str());
+        ESP_LOGI("SerialEngine", "%s",
+                 Application::FrameScheduler::getStatus().c_str());
+        ESP_LOGI("SerialEngine", "%s",
+                 UI::Dialog::UniversalDialog::getStatus().c_str());
+    }
+
+#if UI_INVALIDATION_TRACE_ENABLED
+    enum TraceCommand { TRACE_TOGGLE, TRACE_REPORT, TRACE_HEATMAP };
+
+    static void runTraceCommand(TraceCommand which) {
+        if (!Application::TaskManager::lvglTryLock(500)) {
+            ESP_LOGW("SerialEngine", "LVGL busy, invalidation trace command dropped");
+            return;
+        }
+        namespace Trace = Application::InvalidationTrace;
+        if (which == TRACE_TOGGLE) {
+            Trace::isRunning() ? Trace::stop() : Trace::start();
+        } else if (which == TRACE_HEATMAP) {
+            Trace::showHeatMap(!Trace::isHeatMapShown());
+        }
+        String text = which == TRACE_REPORT ? Trace::getReport() : String();
+        Application::TaskManager::lvglUnlock();
+        if (which == TRACE_REPORT) {
+            ESP_LOGI("SerialEngine", "%s", text.c_str());
+        }
+    }
+#endif
+
+    // On-device self tests, typed as "selftest <name>". test/test_ui_headless
+    // runs the same ones on the host against an 800x480 memory display
+    static const DebugCommand *findSelfTest(const String &name) {
+        static const DebugCommand selfTests[] = {
+            // Redundant updates through the LVGL mailboxes
+            {"uiflood", [] { Application::LVGLMessageHandler::runMailboxStressTest(); }, true},
+            // State overview opens and refreshes
+            {"overview", [] { Application::LVGLMessageHandler::runStateOverviewBenchmark(); }, true},
+            // Pooled dialog opens and their LVGL heap use
+            {"dialogs", [] { UI::Dialog::UniversalDialog::runPoolBenchmark(); }, true},
+            // Render benchmark scenarios on the main screen
+            {"uibench", [] { Application::UIBenchmark::runScenarios(); }, true},
+        };
+
+        for (const DebugCommand &test : selfTests) {
+            if (name == test.name) {
+                return &test;
+            }
+        }
+        return nullptr;
+    }
+
+    static void runSelfTest(const String &name) {
+        const DebugCommand *test = findSelfTest(name);
+        if (!test) {
+            ESP_LOGW("SerialEngine", "No self test named '%s'", name.c_str());
+            return;
+        }
+        runDebugCommand(*test);
+    }
+
+    // Every debug command; "test" is checked after these so it stays exact
+    static const DebugCommand *findDebugCommand(const uint8_t *data, int len) {
+        static const DebugCommand commands[] = {
+            {"msgtest", runMessageTypeTest},
+            // Wire capture to SD, and the live RX stage timings
+            {"capstart", [] { WireCapture::getInstance().start(); }},
+            {"capstop", [] { WireCapture::getInstance().stop(); }},
+            {"wirestats", [] { ESP_LOGI("SerialEngine", "%s", getMessagingStatus().c_str()); }},
+            {"wirereset", [] { resetMessagingStats(); }},
+#if UI_INVALIDATION_TRACE_ENABLED
+            // LVGL invalidation recording, its ranked report and the heat map
+            {"invtrace", [] { runTraceCommand(TRACE_TOGGLE); }},
+            {"invreport", [] { runTraceCommand(TRACE_REPORT); }},
+            {"heatmap", [] { runTraceCommand(TRACE_HEATMAP); }},
+#endif
+            {"uistats", logUiStats},
+            // Named volume/mute scenes on SD
+            {"scenelist", [] {
+                 bool listed = Application::Audio::SceneStore::getInstance().list(
+                     [](const char *name) { ESP_LOGI("SerialEngine", "Scene: %s", name); });
+                 if (!listed) {
+                     ESP_LOGW("SerialEngine", "No scenes (SD card unavailable)");
+                 }
+             }},
+        };
+
+        for (const DebugCommand &command : commands) {
+            if (matchesCommand(data, len, command.name)) {
+                return &command;
+            }
+        }
+        return nullptr;
+    }
+
+    static const ArgumentCommand *findArgumentCommand(const uint8_t *data, int len,
+                                                      String &argument) {
+        static const ArgumentCommand commands[] = {
+            {"selftest", runSelfTest},
+            // Store the current volumes and mutes, or apply them as one change
+            {"scenesave", [](const String &name) {
+                 bool saved = Application::Audio::AudioManager::getInstance().saveScene(name);
+                 ESP_LOGI("SerialEngine", "Scene '%s' %s", name.c_str(),
+                          saved ? "saved" : "not saved");
+             }},
+            {"sceneapply", [](const String &name) {
+                 bool applied = Application::Audio::AudioManager::getInstance().applyScene(name);
+                 ESP_LOGI("SerialEngine", "Scene '%s' %s", name.c_str(),
+                          applied ? "applied" : "not applied");
+             }},
+        };
+
+        for (const ArgumentCommand &command : commands) {
+            if (matchesArgumentCommand(data, len, command.name, argument)) {
+                return &command;
+            }
+        }
+        return nullptr;
+    }
+
     // Task wrapper
     static void rxtxTaskWrapper(void *param) {
         static_cast<SerialEngine *>(param)->rxtxTask();
@@ -427,6 +790,8 @@ class SerialEngine {
 
                 if (len > 0) {
                     ESP_LOGI("SerialEngine", "Received %d bytes", len);
+                    WireCapture::getInstance().record(WireCapture::DIRECTION_RX, data,
+                                                      len);
 
                     // Optional: Print hex (max 32 bytes)
                     char hexBuf[3 * 32 + 1] = {};
@@ -435,16 +800,20 @@ class SerialEngine {
                     }
                     ESP_LOGI("SerialEngine", "First 32 bytes: %s", hexBuf);
 
-                    // Check for "test" command in printable ASCII
-                    bool isTest = false;
-                    for (int i = 0; i <= len - 4; i++) {
-                        if (memcmp(&data[i], "test", 4) == 0) {
-                            isTest = true;
-                            break;
-                        }
-                    }
-
-                    if (isTest) {
+                    // Debug commands typed into the serial monitor must be the
+                    // whole input; anything else is protocol data for the framer
+                    const DebugCommand *command = findDebugCommand(data, len);
+                    String argument;
+                    const ArgumentCommand *argumentCommand =
+                        command ? nullptr : findArgumentCommand(data, len, argument);
+                    if (command) {
+                        ESP_LOGI("SerialEngine", "DEBUG CMD '%s'", command->name);
+                        runDebugCommand(*command);
+                    } else if (argumentCommand) {
+                        ESP_LOGI("SerialEngine", "DEBUG CMD '%s %s'", argumentCommand->name,
+                                 argument.c_str());
+                        argumentCommand->handler(argument);
+                    } else if (matchesCommand(data, len, "test")) {
                         ESP_LOGI("SerialEngine",
                                  "DEBUG CMD 'test' DETECTED, injecting test payload...");
 
@@ -459,38 +828,20 @@ class SerialEngine {
                     } else {
                         processIncomingData(data, len);
                     }
-
-                    // TEST: Check if "msgtest" command is received for message type
-                    // mapping test
-                    bool isMsgTest = false;
-                    for (int i = 0; i <= len - 7; i++) {
-                        if (memcmp(&data[i], "msgtest", 7) == 0) {
-                            isMsgTest = true;
-                            break;
-                        }
-                    }
-
-                    if (isMsgTest) {
-                        ESP_LOGI("SerialEngine", "=== MESSAGE TYPE MAPPING TEST ===");
-                        String testJson =
-                            "{\"messageType\":\"STATUS_MESSAGE\","
-                            "\"deviceId\":\"TEST\",\"timestamp\":123456}";
-                        ESP_LOGI("SerialEngine", "Test JSON: %s", testJson.c_str());
-
-                        auto testMsg = Messaging::Message::fromJson(testJson);
-                        ESP_LOGI("SerialEngine", "Parsed type: %s", testMsg.type.c_str());
-                        ESP_LOGI("SerialEngine", "Expected: %s",
-                                 Messaging::Message::TYPE_AUDIO_STATUS);
-                        ESP_LOGI("SerialEngine", "Match: %s",
-                                 (testMsg.type == Messaging::Message::TYPE_AUDIO_STATUS)
-                                     ? "YES"
-                                     : "NO");
-                    }
                 }
             }
 
+            // Run inbound handlers, most urgent first, within a time budget so
+            // RX is polled again before a bulk burst is fully drained
+            InboundScheduler &scheduler = InboundScheduler::getInstance();
+            scheduler.dispatch(MESSAGING_INBOUND_DISPATCH_BUDGET_US,
+                               [this](const String &json) { deliverJson(json); });
+
+            // Expire overdue requests before sending anything new
+            CorrelationEngine::getInstance().update();
+
             // Handle outgoing messages (TX) - process queued JSON messages
-            bool hasMessages = processTxMessageQueue();
+            bool hasMessages = processTxMessageQueue() || scheduler.hasPending();
 
             if (!hasMessages) {
                 // No messages processed, short delay to prevent tight loop
@@ -519,7 +870,9 @@ class SerialEngine {
                  length);
 
         // Use the binary protocol framer to decode messages
+        int64_t stageStart = esp_timer_get_time();
         std::vector<String> messages = framer.processIncomingBytes(data, length);
+        stats.framerUs += esp_timer_get_time() - stageStart;
 
         ESP_LOGI("SerialEngine", "Binary framer returned %zu messages",
                  messages.size());
@@ -537,14 +890,8 @@ class SerialEngine {
                 if (isValidJson) {
                     stats.messagesReceived++;
 
-                    // Parse and route the message - avoid creating additional string
-                    // copies
-                    auto parsed = Messaging::Message::fromJson(jsonStr);
-                    ESP_LOGI("SerialEngine", "Parsed message type: %s, device: %.20s",
-                             parsed.type.c_str(), parsed.deviceId.c_str());
-
-                    // Route valid messages to handlers
-                    Messaging::MessageRouter::getInstance().route(parsed);
+                    // Parsed and routed by priority from rxtxTask
+                    InboundScheduler::getInstance().enqueue(jsonStr);
                 } else {
                     stats.parseErrors++;
                     ESP_LOGW("SerialEngine",
@@ -554,6 +901,20 @@ class SerialEngine {
             }
         }
     }
+
+    // Parse and route one message (InboundScheduler delivery callback)
+    void deliverJson(const String &jsonStr) {
+        int64_t stageStart = esp_timer_get_time();
+        auto parsed = Messaging::Message::fromJson(jsonStr);
+        stats.parseUs += esp_timer_get_time() - stageStart;
+        ESP_LOGI("SerialEngine", "Parsed message type: %s, device: %.20s",
+                 parsed.type.c_str(), parsed.deviceId.c_str());
+
+        // Route valid messages to handlers
+        stageStart = esp_timer_get_time();
+        Messaging::MessageRouter::getInstance().route(parsed);
+        stats.routeUs += esp_timer_get_time() - stageStart;
+    }
 };
 
 // Global instance accessor for compatibility
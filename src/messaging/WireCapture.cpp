@@ -0,0 +1,236 @@
+#include "WireCapture.h"
+#include "../hardware/SDManager.h"
+#include <esp_log.h>
+#include <esp_timer.h>
+
+static const char *TAG = "WireCapture";
+
+namespace Messaging {
+
+WireCapture *WireCapture::instance = nullptr;
+
+static const uint8_t CAPTURE_FILE_HEADER[8] = {'U', 'M', 'X', 'W',
+                                               'C', 'A', 'P', 1};
+
+WireCapture &WireCapture::getInstance() {
+  if (!instance) {
+    instance = new WireCapture();
+  }
+  return *instance;
+}
+
+bool WireCapture::start(const char *filePath) {
+  if (capturing || flushTaskHandle) {
+    ESP_LOGW(TAG, "Capture already running: %s", path);
+    return false;
+  }
+
+  if (!Hardware::SD::isMounted()) {
+    ESP_LOGW(TAG, "SD card not mounted - capture unavailable");
+    return false;
+  }
+
+  strncpy(path, filePath, sizeof(path) - 1);
+  path[sizeof(path) - 1] = '\0';
+
+  // Make sure the parent directory exists
+  char directory[sizeof(path)];
+  strncpy(directory, path, sizeof(directory));
+  char *slash = strrchr(directory, '/');
+  if (slash && slash != directory) {
+    *slash = '\0';
+    if (!Hardware::SD::ensureDirectory(directory)) {
+      ESP_LOGE(TAG, "Failed to create capture directory %s", directory);
+      return false;
+    }
+  }
+
+  Hardware::SD::SDFileResult result = Hardware::SD::writeBinaryFile(
+      path, CAPTURE_FILE_HEADER, sizeof(CAPTURE_FILE_HEADER), false);
+  if (!result.success) {
+    ESP_LOGE(TAG, "Failed to create capture file %s: %s", path,
+             result.errorMessage);
+    return false;
+  }
+
+  for (int i = 0; i < 2; i++) {
+    if (!buffers[i]) {
+      buffers[i] = static_cast<uint8_t *>(malloc(BUFFER_SIZE));
+    }
+    fill[i] = 0;
+  }
+  if (!buffers[0] || !buffers[1]) {
+    ESP_LOGE(TAG, "Failed to allocate %u byte capture buffers",
+             (unsigned)BUFFER_SIZE);
+    free(buffers[0]);
+    free(buffers[1]);
+    buffers[0] = buffers[1] = nullptr;
+    return false;
+  }
+
+  active = 0;
+  stats = Stats();
+  stopRequested = false;
+
+  BaseType_t taskResult =
+      xTaskCreatePinnedToCore(flushTaskWrapper, "WireCapture", 4096, this, 1,
+                              &flushTaskHandle, 0);
+  if (taskResult != pdPASS) {
+    ESP_LOGE(TAG, "Failed to create capture flush task: %d", taskResult);
+    flushTaskHandle = nullptr;
+    return false;
+  }
+
+  capturing = true;
+  ESP_LOGI(TAG, "Capturing wire traffic to %s (2 x %u byte buffers)", path,
+           (unsigned)BUFFER_SIZE);
+  return true;
+}
+
+void WireCapture::stop() {
+  if (!flushTaskHandle) {
+    return;
+  }
+
+  portENTER_CRITICAL(&lock);
+  capturing = false;
+  portEXIT_CRITICAL(&lock);
+
+  // The flush task writes whatever is left and exits
+  stopRequested = true;
+  xTaskNotifyGive(flushTaskHandle);
+  for (int i = 0; i < 200 && flushTaskHandle; i++) {
+    vTaskDelay(pdMS_TO_TICKS(10));
+  }
+  if (flushTaskHandle) {
+    ESP_LOGW(TAG, "Flush task did not finish - keeping capture buffers");
+    return;
+  }
+
+  free(buffers[0]);
+  free(buffers[1]);
+  buffers[0] = buffers[1] = nullptr;
+
+  ESP_LOGI(TAG, "Capture stopped: %lu records, %lu bytes, %lu dropped",
+           (unsigned long)stats.records, (unsigned long)stats.bytes,
+           (unsigned long)stats.droppedRecords);
+}
+
+void WireCapture::record(Direction direction, const uint8_t *data,
+                         size_t length) {
+  if (!capturing || !data || length == 0) {
+    return;
+  }
+
+  size_t needed = RECORD_HEADER_SIZE + length;
+  if (length > 0xFFFF || needed > BUFFER_SIZE) {
+    stats.droppedRecords++;
+    return;
+  }
+
+  uint32_t timestamp = static_cast<uint32_t>(esp_timer_get_time());
+  uint16_t length16 = static_cast<uint16_t>(length);
+  bool rotated = false;
+
+  portENTER_CRITICAL(&lock);
+  if (!capturing) {
+    portEXIT_CRITICAL(&lock);
+    return;
+  }
+
+  if (fill[active] + needed > BUFFER_SIZE) {
+    if (fill[active ^ 1] != 0) {
+      // Flush task has not caught up - drop rather than block the caller
+      stats.droppedRecords++;
+      portEXIT_CRITICAL(&lock);
+      return;
+    }
+    active ^= 1;
+    rotated = true;
+  }
+
+  uint8_t *out = buffers[active] + fill[active];
+  memcpy(out, &timestamp, sizeof(timestamp));
+  memcpy(out + 4, &length16, sizeof(length16));
+  out[6] = direction;
+  out[7] = 0;
+  memcpy(out + RECORD_HEADER_SIZE, data, length);
+  fill[active] += needed;
+  stats.records++;
+  stats.bytes += length;
+  portEXIT_CRITICAL(&lock);
+
+  if (rotated) {
+    xTaskNotifyGive(flushTaskHandle);
+  }
+}
+
+String WireCapture::getStatus() const {
+  String status = "Wire Capture:\n";
+  status += "- State: " + String(capturing ? "capturing to " : "idle") +
+            String(capturing ? path : "") + "\n";
+  status += "- Records: " + String(stats.records) + " (" +
+            String(stats.bytes) + " bytes), dropped: " +
+            String(stats.droppedRecords) + "\n";
+  status += "- Flushes: " + String(stats.flushes) +
+            ", write errors: " + String(stats.writeErrors) + "\n";
+  return status;
+}
+
+// =============================================================================
+// BACKGROUND FLUSH
+// =============================================================================
+
+void WireCapture::flushTaskWrapper(void *param) {
+  static_cast<WireCapture *>(param)->flushTask();
+}
+
+void WireCapture::flushTask() {
+  while (!stopRequested) {
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(MESSAGING_WIRE_CAPTURE_FLUSH_MS));
+
+    // Rotate a partially filled buffer out so quiet periods still reach the
+    // card within one flush interval
+    portENTER_CRITICAL(&lock);
+    if (fill[active ^ 1] == 0 && fill[active] > 0) {
+      active ^= 1;
+    }
+    portEXIT_CRITICAL(&lock);
+
+    flushStandby();
+  }
+
+  // Capture is stopped, nothing writes to the buffers any more
+  flushStandby();
+  active ^= 1;
+  flushStandby();
+
+  flushTaskHandle = nullptr;
+  vTaskDelete(NULL);
+}
+
+void WireCapture::flushStandby() {
+  portENTER_CRITICAL(&lock);
+  int standby = active ^ 1;
+  size_t length = fill[standby];
+  portEXIT_CRITICAL(&lock);
+
+  if (length == 0) {
+    return;
+  }
+
+  Hardware::SD::SDFileResult result =
+      Hardware::SD::writeBinaryFile(path, buffers[standby], length, true);
+  if (result.success) {
+    stats.flushes++;
+  } else {
+    stats.writeErrors++;
+    ESP_LOGW(TAG, "Capture write failed: %s", result.errorMessage);
+  }
+
+  portENTER_CRITICAL(&lock);
+  fill[standby] = 0;
+  portEXIT_CRITICAL(&lock);
+}
+
+} // namespace Messaging
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <Arduino.h>
+#include <MessagingConfig.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+namespace Messaging {
+
+/**
+ * WIRE CAPTURE
+ *
+ * Records raw serial traffic to SD so field problems can be replayed
+ * offline (tools/wire_replay, the [env:wire_replay] host program) and
+ * inspected (scripts/wire_replay.py).
+ *
+ * File layout (little-endian):
+ *   header: "UMXWCAP" + version byte (1)
+ *   record: [u32 timestamp_us][u16 length][u8 direction][u8 reserved][bytes]
+ *
+ * timestamp_us is the low 32 bits of esp_timer_get_time() and wraps every
+ * ~71 minutes; readers unwrap it. RX records are the chunks exactly as read
+ * from the UART, TX records are complete encoded frames.
+ *
+ * record() only copies into one of two preallocated buffers under a short
+ * critical section. A low priority task on Core 0 writes full buffers (and
+ * partially filled ones every MESSAGING_WIRE_CAPTURE_FLUSH_MS) to SD, so the
+ * RXTX task never waits on the card. If both buffers are full the record is
+ * dropped and counted rather than blocking.
+ */
+class WireCapture {
+public:
+  enum Direction : uint8_t { DIRECTION_RX = 1, DIRECTION_TX = 2 };
+
+  struct Stats {
+    uint32_t records = 0;
+    uint32_t bytes = 0;
+    uint32_t droppedRecords = 0;
+    uint32_t flushes = 0;
+    uint32_t writeErrors = 0;
+  };
+
+  static WireCapture &getInstance();
+
+  bool start(const char *path = MESSAGING_WIRE_CAPTURE_PATH);
+  void stop();
+  bool isCapturing() const { return capturing; }
+
+  // Safe to call from any task; cheap no-op while not capturing
+  void record(Direction direction, const uint8_t *data, size_t length);
+
+  Stats getStats() const { return stats; }
+  String getStatus() const;
+
+private:
+  WireCapture() = default;
+  static WireCapture *instance;
+
+  static const size_t BUFFER_SIZE = MESSAGING_WIRE_CAPTURE_BUFFER_SIZE;
+  static const size_t RECORD_HEADER_SIZE = 8;
+
+  uint8_t *buffers[2] = {nullptr, nullptr};
+  size_t fill[2] = {0, 0};
+  int active = 0;
+  portMUX_TYPE lock = portMUX_INITIALIZER_UNLOCKED;
+
+  char path[64] = {};
+  TaskHandle_t flushTaskHandle = nullptr;
+  volatile bool capturing = false;
+  volatile bool stopRequested = false;
+  Stats stats;
+
+  static void flushTaskWrapper(void *param);
+  void flushTask();
+  void flushStandby();
+};
+
+} // namespace Messaging
@@ -1,6 +1,7 @@
 #include "MessageConfig.h"
 #include "hardware/DeviceManager.h"
 #include <MessageProtocol.h>
+#include <atomic>
 
 namespace Messaging {
 namespace Config {
@@ -61,8 +62,27 @@ const char* TRANSPORT_NAME_SERIAL = "Serial";
 // HELPER FUNCTIONS
 // =============================================================================
 
+static const char* REQUEST_ID_PREFIX = "esp32_";
+static const size_t REQUEST_ID_PREFIX_LEN = 6;
+
 String generateRequestId() {
-    return "esp32_" + String(millis());
+    // Sequence instead of millis() so ids stay unique within the same tick.
+    // Bit 31 is reserved for CorrelationEngine ids.
+    static std::atomic<uint32_t> sequence{0};
+    char buffer[REQUEST_ID_MAX_LEN];
+    formatRequestId((++sequence) & 0x7FFFFFFF, buffer, sizeof(buffer));
+    return String(buffer);
+}
+
+void formatRequestId(uint32_t id, char* buffer, size_t bufferSize) {
+    snprintf(buffer, bufferSize, "%s%lu", REQUEST_ID_PREFIX, (unsigned long)id);
+}
+
+uint32_t parseRequestId(const char* requestId) {
+    if (!requestId || strncmp(requestId, REQUEST_ID_PREFIX, REQUEST_ID_PREFIX_LEN) != 0) {
+        return 0;
+    }
+    return strtoul(requestId + REQUEST_ID_PREFIX_LEN, nullptr, 10);
 }
 
 String getDeviceId() {
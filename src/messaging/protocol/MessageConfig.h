@@ -58,7 +58,12 @@ extern const unsigned long MESSAGE_LOG_TRUNCATE_LENGTH;
 // Network transports not currently available
 extern const char* TRANSPORT_NAME_SERIAL;
 
+// Request ids are "esp32_<n>" on the wire, n is a compact integer
+static const size_t REQUEST_ID_MAX_LEN = 20;
+
 String generateRequestId();
+void formatRequestId(uint32_t id, char* buffer, size_t bufferSize);
+uint32_t parseRequestId(const char* requestId);  // 0 if not one of ours
 String getDeviceId();
 }  // namespace Config
 }  // namespace Messaging
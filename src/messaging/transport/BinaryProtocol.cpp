@@ -15,7 +15,11 @@ namespace BinaryProtocol {
 uint16_t CRC16Calculator::calculate(const uint8_t *data, size_t length) {
   // Use the working CRC-16-MODBUS algorithm from previous SerialBridge
   // implementation
-  uint16_t crc = 0xFFFF;
+  return update(0xFFFF, data, length);
+}
+
+uint16_t CRC16Calculator::update(uint16_t crc, const uint8_t *data,
+                                 size_t length) {
   for (size_t i = 0; i < length; i++) {
     crc ^= data[i];
     for (int j = 0; j < 8; j++) {
@@ -91,7 +95,10 @@ bool validateFrame(const uint8_t *frame, size_t frameLength) {
 BinaryProtocolFramer::BinaryProtocolFramer()
     : currentState_(ReceiveState::WaitingForStart), headerBufferSize_(0),
       payloadBufferSize_(0), expectedPayloadLength_(0), expectedCrc_(0),
-      messageType_(0), messageStartTime_(0), isEscapeNext_(false) {
+      messageType_(0), messageStartTime_(0), isEscapeNext_(false),
+      peerSupportsBatches_(false), batchBuffer_(nullptr), batchCapacity_(0),
+      batchPosition_(0), batchPayloadLength_(0), batchCrc_(0xFFFF),
+      batchCount_(0) {
 
   ESP_LOGD(TAG, "BinaryProtocolFramer initialized");
 }
@@ -187,17 +194,144 @@ bool BinaryProtocolFramer::encodeMessage(const String &jsonPayload,
                                          uint8_t *outputBuffer,
                                          size_t bufferSize,
                                          size_t &frameLength) {
-  auto frame = encodeMessage(jsonPayload);
-  if (frame.empty() || frame.size() > bufferSize) {
-    frameLength = 0;
+  frameLength = 0;
+  if (jsonPayload.isEmpty() || jsonPayload.length() > MAX_PAYLOAD_SIZE) {
+    ESP_LOGE(TAG, "Invalid JSON payload size: %u", jsonPayload.length());
+    return false;
+  }
+
+  const uint8_t *payloadBytes =
+      reinterpret_cast<const uint8_t *>(jsonPayload.c_str());
+  size_t payloadLength = jsonPayload.length();
+
+  // Encode straight into the caller's buffer, no intermediate vector
+  size_t required =
+      1 + HEADER_SIZE + escapedLength(payloadBytes, payloadLength) + 1;
+  if (required > bufferSize) {
+    ESP_LOGE(TAG, "Frame of %zu bytes does not fit buffer of %zu", required,
+             bufferSize);
+    return false;
+  }
+
+  uint16_t crc = CRC16Calculator::calculate(payloadBytes, payloadLength);
+  outputBuffer[0] = MSG_START_MARKER;
+  writeHeader(outputBuffer + 1, payloadLength, crc, JSON_MESSAGE_TYPE);
+  size_t position = 1 + HEADER_SIZE;
+  position += writeEscaped(payloadBytes, payloadLength, outputBuffer + position);
+  outputBuffer[position++] = MSG_END_MARKER;
+
+  statistics_.incrementMessagesSent();
+  statistics_.addBytesTransmitted(position);
+
+  frameLength = position;
+  return true;
+}
+
+// =============================================================================
+// BATCH ENCODING
+// =============================================================================
+
+void BinaryProtocolFramer::beginBatch(uint8_t *outputBuffer,
+                                      size_t bufferSize) {
+  batchBuffer_ = outputBuffer;
+  batchCapacity_ = bufferSize;
+  batchPosition_ = 1 + HEADER_SIZE; // Header is filled in by finishBatch()
+  batchPayloadLength_ = 0;
+  batchCrc_ = 0xFFFF;
+  batchCount_ = 0;
+}
+
+bool BinaryProtocolFramer::addToBatch(const char *json, size_t length) {
+  if (!batchBuffer_ || !json || length == 0 || length > 0xFFFF) {
     return false;
   }
 
-  std::copy(frame.begin(), frame.end(), outputBuffer);
-  frameLength = frame.size();
+  // The receiver buffers the whole unescaped payload
+  if (batchPayloadLength_ + BATCH_RECORD_HEADER_SIZE + length >
+      MAX_PAYLOAD_SIZE) {
+    return false;
+  }
+
+  uint8_t recordHeader[BATCH_RECORD_HEADER_SIZE];
+  Utils::uint16ToLEBytes(static_cast<uint16_t>(length), recordHeader);
+  const uint8_t *bytes = reinterpret_cast<const uint8_t *>(json);
+
+  size_t required = escapedLength(recordHeader, BATCH_RECORD_HEADER_SIZE) +
+                    escapedLength(bytes, length);
+  if (batchPosition_ + required + 1 > batchCapacity_) { // +1 end marker
+    return false;
+  }
+
+  batchPosition_ += writeEscaped(recordHeader, BATCH_RECORD_HEADER_SIZE,
+                                 batchBuffer_ + batchPosition_);
+  batchPosition_ += writeEscaped(bytes, length, batchBuffer_ + batchPosition_);
+  batchCrc_ =
+      CRC16Calculator::update(batchCrc_, recordHeader, BATCH_RECORD_HEADER_SIZE);
+  batchCrc_ = CRC16Calculator::update(batchCrc_, bytes, length);
+  batchPayloadLength_ += BATCH_RECORD_HEADER_SIZE + length;
+  batchCount_++;
   return true;
 }
 
+size_t BinaryProtocolFramer::finishBatch() {
+  if (!batchBuffer_ || batchCount_ == 0) {
+    batchBuffer_ = nullptr;
+    return 0;
+  }
+
+  batchBuffer_[0] = MSG_START_MARKER;
+  writeHeader(batchBuffer_ + 1, batchPayloadLength_, batchCrc_,
+              BATCH_MESSAGE_TYPE);
+  batchBuffer_[batchPosition_++] = MSG_END_MARKER;
+
+  statistics_.messagesSent += batchCount_;
+  statistics_.addBytesTransmitted(batchPosition_);
+  statistics_.addBatchSent(batchCount_);
+
+  ESP_LOGD(TAG, "Encoded batch: %zu messages, %lu bytes payload -> %zu bytes",
+           batchCount_, batchPayloadLength_, batchPosition_);
+
+  batchBuffer_ = nullptr;
+  return batchPosition_;
+}
+
+size_t BinaryProtocolFramer::escapedLength(const uint8_t *data,
+                                           size_t length) {
+  size_t escaped = length;
+  for (size_t i = 0; i < length; i++) {
+    uint8_t byte = data[i];
+    if (byte == MSG_START_MARKER || byte == MSG_END_MARKER ||
+        byte == MSG_ESCAPE_CHAR) {
+      escaped++;
+    }
+  }
+  return escaped;
+}
+
+size_t BinaryProtocolFramer::writeEscaped(const uint8_t *data, size_t length,
+                                          uint8_t *output) {
+  size_t position = 0;
+  for (size_t i = 0; i < length; i++) {
+    uint8_t byte = data[i];
+    if (byte == MSG_START_MARKER || byte == MSG_END_MARKER ||
+        byte == MSG_ESCAPE_CHAR) {
+      output[position++] = MSG_ESCAPE_CHAR;
+      output[position++] = byte ^ MSG_ESCAPE_XOR;
+    } else {
+      output[position++] = byte;
+    }
+  }
+  return position;
+}
+
+// Header fields are not escaped - the receiver reads them by count
+void BinaryProtocolFramer::writeHeader(uint8_t *frame, uint32_t payloadLength,
+                                       uint16_t crc, uint8_t type) {
+  Utils::uint32ToLEBytes(payloadLength, frame);
+  Utils::uint16ToLEBytes(crc, frame + 4);
+  frame[6] = type;
+}
+
 bool BinaryProtocolFramer::transmitMessageDirect(
     const String &jsonPayload, std::function<bool(uint8_t)> writeByteFunc) {
   if (jsonPayload.isEmpty()) {
@@ -353,12 +487,16 @@ BinaryProtocolFramer::processIncomingBytes(const uint8_t *data, size_t length) {
             TAG,
             "Found end marker - payload complete: %zu bytes (expected %lu)",
             payloadBufferSize_, expectedPayloadLength_);
-        String decodedMessage = processCompleteMessage();
-        if (!decodedMessage.isEmpty()) {
-          messages.push_back(decodedMessage);
-          statistics_.incrementMessagesReceived();
-          statistics_.addBytesReceived(payloadBufferSize_ + HEADER_SIZE +
-                                       2); // +2 for start/end markers
+        if (messageType_ == BATCH_MESSAGE_TYPE) {
+          processCompleteBatch(messages);
+        } else {
+          String decodedMessage = processCompleteMessage();
+          if (!decodedMessage.isEmpty()) {
+            messages.push_back(decodedMessage);
+            statistics_.incrementMessagesReceived();
+            statistics_.addBytesReceived(payloadBufferSize_ + HEADER_SIZE +
+                                         2); // +2 for start/end markers
+          }
         }
         resetStateMachine();
       } else {
@@ -463,13 +601,14 @@ void BinaryProtocolFramer::processPayloadByte(uint8_t byte) {
   }
 }
 
-String BinaryProtocolFramer::processCompleteMessage() {
+// Escape state, length and CRC checks shared by every frame type
+bool BinaryProtocolFramer::verifyCompletePayload() {
   // CRITICAL CHECK: Verify we're not in the middle of an escape sequence
   if (isEscapeNext_) {
     ESP_LOGI(TAG, "Message ended with incomplete escape sequence - missing "
                   "escaped byte");
     statistics_.incrementFramingErrors();
-    return String();
+    return false;
   }
 
   // Verify we have the exact expected payload length
@@ -478,36 +617,10 @@ String BinaryProtocolFramer::processCompleteMessage() {
              payloadBufferSize_, expectedPayloadLength_);
 
     statistics_.incrementFramingErrors();
-    return String();
-  }
-
-  // Handle empty payload case
-  if (expectedPayloadLength_ == 0) {
-    ESP_LOGD(TAG, "Processing empty payload message");
-
-    // Still verify CRC for empty payload
-    uint16_t calculatedCrc = CRC16Calculator::calculate(nullptr, 0);
-    if (calculatedCrc != expectedCrc_) {
-      ESP_LOGI(TAG,
-               "CRC mismatch for empty payload - calculated 0x%04X, expected "
-               "0x%04X",
-               calculatedCrc, expectedCrc_);
-      statistics_.incrementCrcErrors();
-      return String();
-    }
-
-    // Verify message type
-    if (messageType_ != JSON_MESSAGE_TYPE) {
-      ESP_LOGI(TAG, "Unsupported message type for empty payload: 0x%02X",
-               messageType_);
-      statistics_.incrementFramingErrors();
-      return String();
-    }
-
-    return String(""); // Return empty but valid string
+    return false;
   }
 
-  // Calculate CRC16 of the received payload
+  // Calculate CRC16 of the received payload (also valid for empty payloads)
   uint16_t calculatedCrc =
       CRC16Calculator::calculate(payloadBuffer_, payloadBufferSize_);
 
@@ -517,46 +630,35 @@ String BinaryProtocolFramer::processCompleteMessage() {
              calculatedCrc, expectedCrc_);
 
     statistics_.incrementCrcErrors();
-    return String();
+    return false;
   }
 
-  // Verify message type
-  if (messageType_ != JSON_MESSAGE_TYPE) {
-    ESP_LOGI(TAG, "Unsupported message type: 0x%02X (expected 0x%02X)",
-             messageType_, JSON_MESSAGE_TYPE);
-    statistics_.incrementFramingErrors();
-    return String();
-  }
+  return true;
+}
 
+bool BinaryProtocolFramer::isValidJsonPayload(const uint8_t *data,
+                                              size_t length) {
   // Validate that payload contains valid UTF-8/ASCII for JSON
-  for (size_t i = 0; i < payloadBufferSize_; i++) {
-    uint8_t byte = payloadBuffer_[i];
+  for (size_t i = 0; i < length; i++) {
+    uint8_t byte = data[i];
     // Allow printable ASCII, whitespace, and basic UTF-8 start bytes
     if (byte == 0 ||
         (byte < 32 && byte != '\t' && byte != '\n' && byte != '\r')) {
       ESP_LOGI(TAG, "Invalid character in JSON payload at position %zu: 0x%02X",
                i, byte);
       statistics_.incrementFramingErrors();
-      return String();
+      return false;
     }
   }
 
-  // Convert payload to JSON string with proper memory management
-  String jsonMessage;
-  jsonMessage.reserve(payloadBufferSize_ + 1); // +1 for null terminator
-
-  // Use const char* constructor for efficiency
-  jsonMessage = String(reinterpret_cast<const char *>(payloadBuffer_),
-                       payloadBufferSize_);
-
   // Basic JSON validation - check for balanced braces
   int braceCount = 0;
   int bracketCount = 0;
   bool inString = false;
   bool escaped = false;
 
-  for (size_t i = 0; i < jsonMessage.length(); i++) {
-    char c = jsonMessage.charAt(i);
+  for (size_t i = 0; i < length; i++) {
+    char c = static_cast<char>(data[i]);
 
     if (!inString) {
       if (c == '{')
@@ -585,13 +687,93 @@ String BinaryProtocolFramer::processCompleteMessage() {
              "JSON validation failed - braces: %d, brackets: %d, inString: %s",
              braceCount, bracketCount, inString ? "true" : "false");
     statistics_.incrementFramingErrors();
+    return false;
+  }
+
+  return true;
+}
+
+String BinaryProtocolFramer::processCompleteMessage() {
+  if (!verifyCompletePayload()) {
+    return String();
+  }
+
+  // Verify message type
+  if (messageType_ != JSON_MESSAGE_TYPE) {
+    ESP_LOGI(TAG, "Unsupported message type: 0x%02X (expected 0x%02X)",
+             messageType_, JSON_MESSAGE_TYPE);
+    statistics_.incrementFramingErrors();
+    return String();
+  }
+
+  // Handle empty payload case
+  if (expectedPayloadLength_ == 0) {
+    ESP_LOGD(TAG, "Processing empty payload message");
+    return String(""); // Return empty but valid string
+  }
+
+  if (!isValidJsonPayload(payloadBuffer_, payloadBufferSize_)) {
     return String();
   }
 
   ESP_LOGD(TAG, "Successfully decoded message: %zu bytes, CRC OK",
            payloadBufferSize_);
 
-  return jsonMessage;
+  // Use const char* constructor for efficiency
+  return String(reinterpret_cast<const char *>(payloadBuffer_),
+                payloadBufferSize_);
+}
+
+// One CRC check for the whole frame, then each record is appended in order.
+// A record table that does not add up to the payload length drops the whole
+// batch; a single record that fails JSON validation only drops that record.
+void BinaryProtocolFramer::processCompleteBatch(std::vector<String> &messages) {
+  if (!verifyCompletePayload()) {
+    return;
+  }
+
+  size_t firstMessage = messages.size();
+  size_t offset = 0;
+  uint32_t count = 0;
+  bool truncated = false;
+
+  while (offset < payloadBufferSize_) {
+    if (payloadBufferSize_ - offset < BATCH_RECORD_HEADER_SIZE) {
+      truncated = true;
+      break;
+    }
+    uint16_t recordLength = Utils::bytesToUInt16LE(payloadBuffer_ + offset);
+    offset += BATCH_RECORD_HEADER_SIZE;
+    if (recordLength > payloadBufferSize_ - offset) {
+      truncated = true;
+      break;
+    }
+
+    const uint8_t *record = payloadBuffer_ + offset;
+    offset += recordLength;
+    if (recordLength == 0 || !isValidJsonPayload(record, recordLength)) {
+      continue;
+    }
+    messages.push_back(
+        String(reinterpret_cast<const char *>(record), recordLength));
+    count++;
+  }
+
+  if (truncated) {
+    ESP_LOGI(TAG, "Malformed batch record table at offset %zu of %zu", offset,
+             payloadBufferSize_);
+    messages.erase(messages.begin() + firstMessage, messages.end());
+    statistics_.incrementFramingErrors();
+    return;
+  }
+
+  peerSupportsBatches_ = true;
+  statistics_.messagesReceived += count;
+  statistics_.addBatchReceived(count);
+  statistics_.addBytesReceived(payloadBufferSize_ + HEADER_SIZE + 2);
+
+  ESP_LOGD(TAG, "Decoded batch: %lu messages, %zu bytes, CRC OK",
+           (unsigned long)count, payloadBufferSize_);
 }
 
 bool BinaryProtocolFramer::isTimeout() const {
@@ -0,0 +1,184 @@
+#pragma once
+
+// Host stand-in for the parts of the Arduino core the tested modules use:
+// String, the millis()/micros() clock and constrain(). Only for the native
+// test envs in platformio.ini.
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include <esp_log.h>
+
+class String {
+public:
+  String() = default;
+  String(const char *text) : value(text ? text : "") {}
+  String(const char *text, size_t length) : value(text, length) {}
+  String(const std::string &text) : value(text) {}
+  explicit String(char c) : value(1, c) {}
+  explicit String(int number) : value(std::to_string(number)) {}
+  explicit String(unsigned int number) : value(std::to_string(number)) {}
+  explicit String(long number) : value(std::to_string(number)) {}
+  explicit String(unsigned long number) : value(std::to_string(number)) {}
+  explicit String(long long number) : value(std::to_string(number)) {}
+  explicit String(unsigned long long number) : value(std::to_string(number)) {}
+  explicit String(double number, unsigned int decimals = 2) {
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), "%.*f", (int)decimals, number);
+    value = buffer;
+  }
+
+  const char *c_str() const { return value.c_str(); }
+  unsigned int length() const { return (unsigned int)value.size(); }
+  bool isEmpty() const { return value.empty(); }
+  bool reserve(unsigned int size) {
+    value.reserve(size);
+    return true;
+  }
+
+  char charAt(unsigned int index) const {
+    return index < value.size() ? value[index] : '\0';
+  }
+  char operator[](unsigned int index) const { return charAt(index); }
+
+  int indexOf(char c, unsigned int from = 0) const {
+    return position(value.find(c, from));
+  }
+  int indexOf(const String &text, unsigned int from = 0) const {
+    return position(value.find(text.value, from));
+  }
+  int lastIndexOf(char c) const { return position(value.rfind(c)); }
+
+  String substring(unsigned int from) const {
+    return from < value.size() ? String(value.substr(from)) : String();
+  }
+  String substring(unsigned int from, unsigned int to) const {
+    if (from > to) {
+      std::swap(from, to);
+    }
+    return from < value.size() ? String(value.substr(from, to - from))
+                               : String();
+  }
+
+  bool startsWith(const String &prefix) const {
+    return value.compare(0, prefix.value.size(), prefix.value) == 0;
+  }
+  bool endsWith(const String &suffix) const {
+    return value.size() >= suffix.value.size() &&
+           value.compare(value.size() - suffix.value.size(),
+                         suffix.value.size(), suffix.value) == 0;
+  }
+  bool equals(const String &other) const { return value == other.value; }
+
+  long toInt() const { return strtol(value.c_str(), nullptr, 10); }
+  float toFloat() const { return strtof(value.c_str(), nullptr); }
+
+  void remove(unsigned int index) { remove(index, (unsigned int)-1); }
+  void remove(unsigned int index, unsigned int count) {
+    if (index < value.size()) {
+      value.erase(index, count);
+    }
+  }
+  void trim() {
+    size_t first = value.find_first_not_of(" \t\r\n");
+    size_t last = value.find_last_not_of(" \t\r\n");
+    value = first == std::string::npos
+                ? std::string()
+                : value.substr(first, last - first + 1);
+  }
+
+  bool concat(const String &text) {
+    value += text.value;
+    return true;
+  }
+  bool concat(const char *text) {
+    value += text ? text : "";
+    return true;
+  }
+  bool concat(char c) {
+    value += c;
+    return true;
+  }
+
+  String &operator+=(const String &text) {
+    value += text.value;
+    return *this;
+  }
+  String &operator+=(const char *text) {
+    value += text ? text : "";
+    return *this;
+  }
+  String &operator+=(char c) {
+    value += c;
+    return *this;
+  }
+
+  // Print-style output, so ArduinoJson can serialize into a String
+  size_t write(uint8_t c) {
+    value += static_cast<char>(c);
+    return 1;
+  }
+  size_t write(const uint8_t *data, size_t size) {
+    value.append(reinterpret_cast<const char *>(data), size);
+    return size;
+  }
+
+  bool operator==(const String &other) const { return value == other.value; }
+  bool operator==(const char *other) const {
+    return value == (other ? other : "");
+  }
+  bool operator!=(const String &other) const { return !(*this == other); }
+  bool operator!=(const char *other) const { return !(*this == other); }
+  bool operator<(const String &other) const { return value < other.value; }
+
+private:
+  std::string value;
+
+  static int position(size_t found) {
+    return found == std::string::npos ? -1 : (int)found;
+  }
+};
+
+inline String operator+(const String &a, const String &b) {
+  String sum(a);
+  sum += b;
+  return sum;
+}
+inline String operator+(const String &a, const char *b) {
+  String sum(a);
+  sum += b;
+  return sum;
+}
+inline String operator+(const char *a, const String &b) {
+  String sum(a);
+  sum += b;
+  return sum;
+}
+inline String operator+(const String &a, char b) {
+  String sum(a);
+  sum += b;
+  return sum;
+}
+
+// Milliseconds/microseconds since the test program started
+inline unsigned long micros() {
+  static const auto start = std::chrono::steady_clock::now();
+  return (unsigned long)std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+inline unsigned long millis() { return micros() / 1000; }
+inline void delay(unsigned long ms) {
+  std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+inline void delayMicroseconds(unsigned int us) {
+  std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+#define constrain(amt, low, high)                                              \
+  ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
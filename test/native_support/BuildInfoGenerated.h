@@ -0,0 +1,20 @@
+#pragma once
+
+// Stands in for the header scripts/get_build_info.py writes to include/,
+// which is used instead when it exists
+
+#define FIRMWARE_BUILD_NUMBER "native"
+#define GIT_BRANCH "native"
+#define BUILD_TIMESTAMP_NUM "00000000_000000"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+static const char *getGitCommitHash() { return FIRMWARE_BUILD_NUMBER; }
+static const char *getGitBranch() { return GIT_BRANCH; }
+static const char *getBuildTimestampNum() { return BUILD_TIMESTAMP_NUM; }
+
+#ifdef __cplusplus
+}
+#endif
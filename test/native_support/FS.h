@@ -0,0 +1,16 @@
+#pragma once
+
+// The File type SDManager.h declares its file functions with; never opened
+// on the host
+
+namespace fs {
+
+class File {
+public:
+  explicit operator bool() const { return false; }
+  void close() {}
+};
+
+} // namespace fs
+
+using fs::File;
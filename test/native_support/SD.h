@@ -0,0 +1,13 @@
+#pragma once
+
+// Card types SDManager.h reports; the host has no card
+
+#include <FS.h>
+
+typedef enum {
+  CARD_NONE,
+  CARD_MMC,
+  CARD_SD,
+  CARD_SDHC,
+  CARD_UNKNOWN
+} sdcard_type_t;
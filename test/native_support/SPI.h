@@ -0,0 +1,3 @@
+#pragma once
+
+// Named by SDManager.h only; nothing of it is used on the host
@@ -0,0 +1,6 @@
+#pragma once
+
+// DisplayManager.h includes the board driver for LVGL; the headless test
+// creates its own display
+
+#include <lvgl.h>
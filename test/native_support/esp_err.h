@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+
+typedef int esp_err_t;
+
+#define ESP_OK 0
+#define ESP_FAIL -1
+#define ESP_ERR_NVS_NOT_FOUND 0x1102
+#define ESP_ERR_NVS_INVALID_LENGTH 0x110c
+
+inline const char *esp_err_to_name(esp_err_t err) {
+  switch (err) {
+  case ESP_OK:
+    return "ESP_OK";
+  case ESP_ERR_NVS_NOT_FOUND:
+    return "ESP_ERR_NVS_NOT_FOUND";
+  case ESP_ERR_NVS_INVALID_LENGTH:
+    return "ESP_ERR_NVS_INVALID_LENGTH";
+  default:
+    return "ESP_FAIL";
+  }
+}
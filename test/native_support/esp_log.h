@@ -0,0 +1,35 @@
+#pragma once
+
+// ESP-IDF logging on the host: warnings and errors go to stderr, info to
+// stdout, debug and verbose are compiled out. Define LOG_LOCAL_LEVEL to
+// ESP_LOG_WARN to drop info as well.
+
+#include <cstdio>
+
+#define ESP_LOG_NONE 0
+#define ESP_LOG_ERROR 1
+#define ESP_LOG_WARN 2
+#define ESP_LOG_INFO 3
+
+#ifndef LOG_LOCAL_LEVEL
+#define LOG_LOCAL_LEVEL ESP_LOG_INFO
+#endif
+
+#define ESP_LOGE(tag, format, ...)                                             \
+  fprintf(stderr, "E [%s] " format "\n", tag, ##__VA_ARGS__)
+#define ESP_LOGW(tag, format, ...)                                             \
+  fprintf(stderr, "W [%s] " format "\n", tag, ##__VA_ARGS__)
+#if LOG_LOCAL_LEVEL >= ESP_LOG_INFO
+#define ESP_LOGI(tag, format, ...)                                             \
+  printf("I [%s] " format "\n", tag, ##__VA_ARGS__)
+#else
+#define ESP_LOGI(tag, format, ...)                                             \
+  do {                                                                         \
+  } while (0)
+#endif
+#define ESP_LOGD(tag, format, ...)                                             \
+  do {                                                                         \
+  } while (0)
+#define ESP_LOGV(tag, format, ...)                                             \
+  do {                                                                         \
+  } while (0)
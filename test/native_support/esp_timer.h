@@ -0,0 +1,7 @@
+#pragma once
+
+#include <Arduino.h>
+#include <cstdint>
+
+// Microseconds since the test program started, like since boot on the device
+inline int64_t esp_timer_get_time() { return (int64_t)micros(); }
@@ -0,0 +1,33 @@
+#pragma once
+
+// FreeRTOS primitives the tested modules use, on std::thread
+
+#include <atomic>
+#include <cstdint>
+
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t TickType_t;
+
+#define pdTRUE 1
+#define pdFALSE 0
+#define pdPASS 1
+#define pdFAIL 0
+#define portMAX_DELAY 0xFFFFFFFFu
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+#define portTICK_PERIOD_MS 1
+
+// Critical sections are a spinlock, as on the dual-core ESP32
+struct portMUX_TYPE {
+  std::atomic_flag locked = ATOMIC_FLAG_INIT;
+};
+#define portMUX_INITIALIZER_UNLOCKED                                           \
+  {}
+
+inline void portENTER_CRITICAL(portMUX_TYPE *mux) {
+  while (mux->locked.test_and_set(std::memory_order_acquire)) {
+  }
+}
+inline void portEXIT_CRITICAL(portMUX_TYPE *mux) {
+  mux->locked.clear(std::memory_order_release);
+}
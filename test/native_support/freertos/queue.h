@@ -0,0 +1,52 @@
+#pragma once
+
+// Fixed-size item queues, copied in and out like FreeRTOS does. The
+// timeouts are ignored: a full queue refuses, an empty one returns at once.
+
+#include <freertos/FreeRTOS.h>
+
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+struct NativeQueue {
+  size_t length;
+  size_t itemSize;
+  std::deque<std::vector<uint8_t>> items;
+  std::mutex lock;
+};
+
+typedef NativeQueue *QueueHandle_t;
+
+inline QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize) {
+  return new NativeQueue{length, itemSize, {}, {}};
+}
+
+inline void vQueueDelete(QueueHandle_t queue) { delete queue; }
+
+inline BaseType_t xQueueSend(QueueHandle_t queue, const void *item,
+                             TickType_t) {
+  std::lock_guard<std::mutex> guard(queue->lock);
+  if (queue->items.size() >= queue->length) {
+    return pdFALSE;
+  }
+  const uint8_t *bytes = static_cast<const uint8_t *>(item);
+  queue->items.emplace_back(bytes, bytes + queue->itemSize);
+  return pdTRUE;
+}
+
+inline BaseType_t xQueueReceive(QueueHandle_t queue, void *item, TickType_t) {
+  std::lock_guard<std::mutex> guard(queue->lock);
+  if (queue->items.empty()) {
+    return pdFALSE;
+  }
+  memcpy(item, queue->items.front().data(), queue->itemSize);
+  queue->items.pop_front();
+  return pdTRUE;
+}
+
+inline UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue) {
+  std::lock_guard<std::mutex> guard(queue->lock);
+  return (UBaseType_t)queue->items.size();
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+// Mutexes on std::recursive_timed_mutex; a tick is a millisecond, as in
+// pdMS_TO_TICKS()
+
+#include <freertos/FreeRTOS.h>
+
+#include <chrono>
+#include <mutex>
+
+typedef std::recursive_timed_mutex *SemaphoreHandle_t;
+
+inline SemaphoreHandle_t xSemaphoreCreateMutex() {
+  return new std::recursive_timed_mutex();
+}
+
+inline SemaphoreHandle_t xSemaphoreCreateRecursiveMutex() {
+  return new std::recursive_timed_mutex();
+}
+
+inline void vSemaphoreDelete(SemaphoreHandle_t semaphore) { delete semaphore; }
+
+inline BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore,
+                                 TickType_t ticks) {
+  return semaphore->try_lock_for(std::chrono::milliseconds(ticks)) ? pdTRUE
+                                                                   : pdFALSE;
+}
+
+inline BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore) {
+  semaphore->unlock();
+  return pdTRUE;
+}
+
+#define xSemaphoreTakeRecursive xSemaphoreTake
+#define xSemaphoreGiveRecursive xSemaphoreGive
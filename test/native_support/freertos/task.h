@@ -0,0 +1,25 @@
+#pragma once
+
+// Tasks on the host. There is no scheduler: nothing is created, and
+// vTaskDelay() is defined by the test env that needs it (the headless UI
+// test runs LVGL in it, as the LVGL task would during the delay).
+
+#include <freertos/FreeRTOS.h>
+
+typedef void *TaskHandle_t;
+typedef void (*TaskFunction_t)(void *);
+
+#define tskIDLE_PRIORITY 0
+#define configMAX_PRIORITIES 25
+
+void vTaskDelay(TickType_t ticks);
+
+inline BaseType_t xTaskCreate(TaskFunction_t, const char *, uint32_t, void *,
+                              UBaseType_t, TaskHandle_t *handle) {
+  if (handle) {
+    *handle = nullptr;
+  }
+  return pdFAIL;
+}
+
+inline void vTaskDelete(TaskHandle_t) {}
@@ -0,0 +1,9 @@
+#pragma once
+
+// The device LVGL configuration with the FreeRTOS binding taken out: the
+// headless UI test runs LVGL on its own thread, with no scheduler
+
+#include "../../include/lv_conf.h"
+
+#undef LV_USE_OS
+#define LV_USE_OS LV_OS_NONE
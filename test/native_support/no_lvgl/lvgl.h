@@ -0,0 +1,9 @@
+#pragma once
+
+// Only the LVGL types that UiEventHandlers.h names; audio state code is
+// tested without a display. The headless UI env builds the real LVGL and
+// leaves this directory off its include path
+
+typedef struct _lv_obj_t lv_obj_t;
+typedef struct _lv_event_t lv_event_t;
+typedef int lv_event_code_t;
@@ -0,0 +1,97 @@
+#pragma once
+
+// NVS blob storage in memory. Everything lives for the whole test program;
+// a test starts clean with nvs_erase_all() on its namespace.
+
+#include <esp_err.h>
+
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+typedef uint32_t nvs_handle_t;
+
+typedef enum { NVS_READONLY, NVS_READWRITE } nvs_open_mode_t;
+
+namespace native_nvs {
+
+using Namespace = std::map<std::string, std::vector<uint8_t>>;
+
+inline std::vector<std::pair<std::string, Namespace>> &store() {
+  static std::vector<std::pair<std::string, Namespace>> namespaces;
+  return namespaces;
+}
+
+// Handles are the namespace index + 1
+inline Namespace *find(nvs_handle_t handle) {
+  return handle > 0 && handle <= store().size() ? &store()[handle - 1].second
+                                                : nullptr;
+}
+
+} // namespace native_nvs
+
+inline esp_err_t nvs_open(const char *name, nvs_open_mode_t mode,
+                          nvs_handle_t *handle) {
+  auto &namespaces = native_nvs::store();
+  for (size_t i = 0; i < namespaces.size(); i++) {
+    if (namespaces[i].first == name) {
+      *handle = i + 1;
+      return ESP_OK;
+    }
+  }
+  if (mode == NVS_READONLY) {
+    return ESP_ERR_NVS_NOT_FOUND;
+  }
+  namespaces.push_back({name, {}});
+  *handle = namespaces.size();
+  return ESP_OK;
+}
+
+inline void nvs_close(nvs_handle_t) {}
+
+inline esp_err_t nvs_commit(nvs_handle_t handle) {
+  return native_nvs::find(handle) ? ESP_OK : ESP_FAIL;
+}
+
+inline esp_err_t nvs_get_blob(nvs_handle_t handle, const char *key,
+                              void *out, size_t *length) {
+  native_nvs::Namespace *space = native_nvs::find(handle);
+  if (!space) {
+    return ESP_FAIL;
+  }
+  auto entry = space->find(key);
+  if (entry == space->end()) {
+    return ESP_ERR_NVS_NOT_FOUND;
+  }
+  if (!out) {
+    *length = entry->second.size();
+    return ESP_OK;
+  }
+  if (*length < entry->second.size()) {
+    return ESP_ERR_NVS_INVALID_LENGTH;
+  }
+  memcpy(out, entry->second.data(), entry->second.size());
+  *length = entry->second.size();
+  return ESP_OK;
+}
+
+inline esp_err_t nvs_set_blob(nvs_handle_t handle, const char *key,
+                              const void *value, size_t length) {
+  native_nvs::Namespace *space = native_nvs::find(handle);
+  if (!space) {
+    return ESP_FAIL;
+  }
+  const uint8_t *bytes = static_cast<const uint8_t *>(value);
+  (*space)[key].assign(bytes, bytes + length);
+  return ESP_OK;
+}
+
+inline esp_err_t nvs_erase_all(nvs_handle_t handle) {
+  native_nvs::Namespace *space = native_nvs::find(handle);
+  if (!space) {
+    return ESP_FAIL;
+  }
+  space->clear();
+  return ESP_OK;
+}
@@ -0,0 +1,3 @@
+#pragma once
+
+// Named by BootManager.h only; nothing of it is used on the host
@@ -0,0 +1,133 @@
+// AudioEventBus: coalescing in QUEUED delivery, events raised from a handler
+// and queue overflow into a full refresh
+
+#include <AudioEventBus.h>
+#include <unity.h>
+
+#include <memory>
+#include <vector>
+
+using namespace Application::Audio;
+
+namespace {
+
+std::unique_ptr<AudioEventBus> bus;
+std::vector<AudioStateChangeEvent> received;
+AudioEventBus::SubscriberId ui = AudioEventBus::INVALID_SUBSCRIBER;
+
+void subscribeQueued() {
+  ui = bus->subscribe(
+      [](const AudioStateChangeEvent &event) { received.push_back(event); },
+      AudioEventBus::Delivery::QUEUED);
+}
+
+} // namespace
+
+void setUp() {
+  bus = std::make_unique<AudioEventBus>();
+  received.clear();
+}
+
+void tearDown() { bus.reset(); }
+
+void test_volume_events_coalesce_per_device() {
+  subscribeQueued();
+  int immediate = 0;
+  bus->subscribe([&](const AudioStateChangeEvent &) { immediate++; },
+                 AudioEventBus::Delivery::IMMEDIATE);
+
+  // A drag's worth of volume echoes for two devices
+  for (int volume = 0; volume < 30; volume++) {
+    bus->raise(AudioStateChangeEvent::volumeChanged("spotify.exe", volume));
+    bus->raise(AudioStateChangeEvent::volumeChanged("chrome.exe", 100 - volume));
+  }
+  bus->deliver(ui);
+
+  TEST_ASSERT_EQUAL(2, received.size());
+  TEST_ASSERT_EQUAL_STRING("spotify.exe", received[0].deviceName.c_str());
+  TEST_ASSERT_EQUAL(29, received[0].volume);
+  TEST_ASSERT_EQUAL(71, received[1].volume);
+  TEST_ASSERT_EQUAL(60, immediate);
+}
+
+void test_devices_updated_absorbs_selections() {
+  subscribeQueued();
+
+  bus->raise(AudioStateChangeEvent::selectionChanged("spotify.exe"));
+  bus->raise(AudioStateChangeEvent::devicesUpdated());
+  bus->raise(AudioStateChangeEvent::selectionChanged("discord.exe"));
+  bus->raise(AudioStateChangeEvent::devicesUpdated());
+
+  TEST_ASSERT_EQUAL(1, bus->deliver(ui));
+  TEST_ASSERT_EQUAL(AudioStateChangeEvent::DEVICES_UPDATED, received[0].type);
+  TEST_ASSERT_EQUAL(3, bus->getStats().coalesced);
+}
+
+void test_tab_changes_keep_the_latest_tab() {
+  subscribeQueued();
+
+  bus->raise(AudioStateChangeEvent::tabChanged(Events::UI::TabState::SINGLE));
+  bus->raise(AudioStateChangeEvent::tabChanged(Events::UI::TabState::BALANCE));
+  bus->deliver(ui);
+
+  TEST_ASSERT_EQUAL(1, received.size());
+  TEST_ASSERT_TRUE(received[0].tab == Events::UI::TabState::BALANCE);
+}
+
+// Like AudioUI re-running auto-selection from its handler: the new event
+// waits for the next pass instead of recursing
+void test_event_raised_while_handling_waits_for_the_next_pass() {
+  bool reentered = false;
+  ui = bus->subscribe(
+      [&](const AudioStateChangeEvent &event) {
+        received.push_back(event);
+        if (!reentered) {
+          reentered = true;
+          bus->raise(AudioStateChangeEvent::selectionChanged("chrome.exe"));
+        }
+      },
+      AudioEventBus::Delivery::QUEUED);
+
+  bus->raise(AudioStateChangeEvent::devicesUpdated());
+
+  TEST_ASSERT_EQUAL(1, bus->deliver(ui));
+  TEST_ASSERT_EQUAL(1, received.size());
+  TEST_ASSERT_EQUAL(1, bus->pendingCount(ui));
+  TEST_ASSERT_EQUAL(1, bus->deliver(ui));
+  TEST_ASSERT_EQUAL(AudioStateChangeEvent::SELECTION_CHANGED, received[1].type);
+}
+
+void test_overflow_collapses_into_a_full_refresh() {
+  subscribeQueued();
+
+  for (int i = 0; i < AudioEventBus::QUEUE_DEPTH + 4; i++) {
+    bus->raise(AudioStateChangeEvent::muteChanged(String("proc") + String(i)));
+  }
+  bus->deliver(ui);
+
+  TEST_ASSERT_FALSE(received.empty());
+  TEST_ASSERT_EQUAL(AudioStateChangeEvent::DEVICES_UPDATED, received[0].type);
+  TEST_ASSERT_LESS_OR_EQUAL(5, received.size());
+  TEST_ASSERT_EQUAL(1, bus->getStats().overflows);
+}
+
+void test_identical_events_are_queued_once() {
+  subscribeQueued();
+
+  bus->raise(AudioStateChangeEvent::muteChanged("vlc.exe"));
+  bus->raise(AudioStateChangeEvent::muteChanged("vlc.exe"));
+  bus->raise(AudioStateChangeEvent::muteChanged("zoom.exe"));
+
+  TEST_ASSERT_EQUAL(2, bus->pendingCount(ui));
+}
+
+int main(int, char **) {
+  UNITY_BEGIN();
+  RUN_TEST(test_volume_events_coalesce_per_device);
+  RUN_TEST(test_devices_updated_absorbs_selections);
+  RUN_TEST(test_tab_changes_keep_the_latest_tab);
+  RUN_TEST(test_event_raised_while_handling_waits_for_the_next_pass);
+  RUN_TEST(test_overflow_collapses_into_a_full_refresh);
+  RUN_TEST(test_identical_events_are_queued_once);
+  return UNITY_END();
+}
@@ -0,0 +1,195 @@
+// Scenes: applying one to a status as a single change, the commands it
+// yields, skipped targets, capture, and the scene file format
+
+#include <AudioScenes.h>
+#include <MessagingConfig.h>
+#include <unity.h>
+
+#include <memory>
+
+using namespace Application::Audio;
+
+namespace {
+
+const char *const SESSION_NAMES[SessionTable::CAPACITY] = {
+    "chrome.exe",   "firefox.exe", "spotify.exe",  "discord.exe",
+    "steam.exe",    "vlc.exe",     "teams.exe",    "zoom.exe",
+    "obs64.exe",    "slack.exe",   "msedge.exe",   "foobar2000.exe",
+    "explorer.exe", "code.exe",    "winamp.exe",   "audiodg.exe"};
+
+std::unique_ptr<AudioStatus> status;
+std::unique_ptr<Scene> scene;
+
+// 16 sessions: new volumes everywhere, every other one muted
+void fillNightScene() {
+  memset(scene.get(), 0, sizeof(Scene));
+  strncpy(scene->name, "night", sizeof(scene->name) - 1);
+  for (int i = 0; i < SessionTable::CAPACITY; i++) {
+    SceneTarget &target = scene->targets[scene->targetCount++];
+    strncpy(target.processName, SESSION_NAMES[i],
+            sizeof(target.processName) - 1);
+    target.volume = static_cast<uint8_t>(5 * i + 1);
+    target.isMuted = i % 2;
+  }
+}
+
+SceneTarget &addDefaultDeviceTarget(int volume, bool muted) {
+  SceneTarget &target = scene->targets[scene->targetCount++];
+  memset(&target, 0, sizeof(target));
+  target.volume = volume;
+  target.isMuted = muted;
+  return target;
+}
+
+} // namespace
+
+void setUp() {
+  status = std::make_unique<AudioStatus>();
+  for (int i = 0; i < SessionTable::CAPACITY; i++) {
+    status->sessions.put(SESSION_NAMES[i], SESSION_NAMES[i], 50, false,
+                         "Active", 1000);
+  }
+  status->hasDefaultDevice = true;
+  status->defaultDevice.friendlyName = "Speakers (USB Audio)";
+  status->defaultDevice.volume = 50;
+  scene = std::make_unique<Scene>();
+  fillNightScene();
+}
+
+void tearDown() {
+  status.reset();
+  scene.reset();
+}
+
+void test_scene_sets_every_target() {
+  SceneResult result = applySceneToStatus(*scene, *status);
+
+  TEST_ASSERT_EQUAL(SessionTable::CAPACITY, result.applied);
+  TEST_ASSERT_EQUAL(0, result.missing);
+  for (int i = 0; i < SessionTable::CAPACITY; i++) {
+    DeviceHandle device = status->sessions.find(SESSION_NAMES[i]);
+    TEST_ASSERT_EQUAL(5 * i + 1, status->sessions.volume(device));
+    TEST_ASSERT_EQUAL(i % 2 == 1, status->sessions.isMuted(device));
+  }
+}
+
+// Every target changes volume, every other one its mute as well; the
+// commands go to the host together, so they must fit one batch frame
+void test_scene_yields_one_command_per_changed_value() {
+  uint32_t volumes = 0;
+  uint32_t mutes = 0;
+  applySceneToStatus(*scene, *status,
+                     [&](const SceneTarget &, uint8_t changes) {
+                       volumes += (changes & SessionChanges::VOLUME) ? 1 : 0;
+                       mutes += (changes & SessionChanges::MUTE) ? 1 : 0;
+                     });
+
+  TEST_ASSERT_EQUAL(SessionTable::CAPACITY, volumes);
+  TEST_ASSERT_EQUAL(SessionTable::CAPACITY / 2, mutes);
+  TEST_ASSERT_LESS_OR_EQUAL(MESSAGING_BATCH_MAX_MESSAGES, volumes + mutes);
+}
+
+void test_reapplying_a_scene_changes_nothing() {
+  applySceneToStatus(*scene, *status);
+
+  int calls = 0;
+  SceneResult result = applySceneToStatus(
+      *scene, *status, [&](const SceneTarget &, uint8_t) { calls++; });
+
+  TEST_ASSERT_EQUAL(0, result.applied);
+  TEST_ASSERT_EQUAL(0, calls);
+}
+
+void test_missing_process_is_skipped_and_default_device_set() {
+  status->sessions.remove(status->sessions.find(SESSION_NAMES[0]));
+  addDefaultDeviceTarget(20, true);
+
+  SceneResult result = applySceneToStatus(*scene, *status);
+
+  TEST_ASSERT_EQUAL(1, result.missing);
+  TEST_ASSERT_EQUAL(scene->targetCount - 1, result.applied);
+  TEST_ASSERT_EQUAL(20, status->defaultDevice.volume);
+  TEST_ASSERT_TRUE(status->defaultDevice.isMuted);
+}
+
+void test_default_device_target_without_a_default_device_is_missing() {
+  status->hasDefaultDevice = false;
+  addDefaultDeviceTarget(20, false);
+
+  SceneResult result = applySceneToStatus(*scene, *status);
+
+  TEST_ASSERT_EQUAL(1, result.missing);
+  TEST_ASSERT_EQUAL(50, status->defaultDevice.volume);
+}
+
+void test_volumes_above_100_are_clamped() {
+  scene->targets[3].volume = 250;
+
+  applySceneToStatus(*scene, *status);
+
+  TEST_ASSERT_EQUAL(100, status->sessions.volume(
+                             status->sessions.find(SESSION_NAMES[3])));
+}
+
+void test_captured_scene_restores_the_status() {
+  applySceneToStatus(*scene, *status);
+  status->defaultDevice.volume = 33;
+  auto captured = std::make_unique<Scene>();
+  captureScene(*status, "evening", *captured);
+
+  TEST_ASSERT_EQUAL_STRING("evening", captured->name);
+  TEST_ASSERT_EQUAL(SessionTable::CAPACITY + 1, captured->targetCount);
+  TEST_ASSERT_EQUAL_STRING(
+      "", captured->targets[SessionTable::CAPACITY].processName);
+
+  // Back to the defaults, then the captured scene puts everything back
+  setUp();
+  applySceneToStatus(*captured, *status);
+  for (int i = 0; i < SessionTable::CAPACITY; i++) {
+    DeviceHandle device = status->sessions.find(SESSION_NAMES[i]);
+    TEST_ASSERT_EQUAL(5 * i + 1, status->sessions.volume(device));
+  }
+  TEST_ASSERT_EQUAL(33, status->defaultDevice.volume);
+}
+
+void test_scene_blob_round_trips_and_rejects_corruption() {
+  addDefaultDeviceTarget(20, true);
+  std::unique_ptr<uint8_t[]> blob(new uint8_t[SceneStore::MAX_BLOB_SIZE]);
+  auto loaded = std::make_unique<Scene>();
+
+  size_t size =
+      SceneStore::encode(*scene, blob.get(), SceneStore::MAX_BLOB_SIZE);
+  TEST_ASSERT_GREATER_THAN(0, size);
+  TEST_ASSERT_TRUE(SceneStore::decode(blob.get(), size, *loaded));
+  TEST_ASSERT_EQUAL_STRING("night", loaded->name);
+  TEST_ASSERT_EQUAL(scene->targetCount, loaded->targetCount);
+  TEST_ASSERT_EQUAL_MEMORY(scene->targets, loaded->targets,
+                           sizeof(SceneTarget) * scene->targetCount);
+
+  blob[size - 1] ^= 0x5A;
+  TEST_ASSERT_FALSE(SceneStore::decode(blob.get(), size, *loaded));
+}
+
+void test_scene_names_are_file_safe() {
+  TEST_ASSERT_TRUE(SceneStore::isValidName("movie_night-2"));
+  TEST_ASSERT_FALSE(SceneStore::isValidName("../x"));
+  TEST_ASSERT_FALSE(SceneStore::isValidName("a b"));
+  TEST_ASSERT_FALSE(SceneStore::isValidName(""));
+  TEST_ASSERT_FALSE(SceneStore::isValidName(nullptr));
+  TEST_ASSERT_FALSE(
+      SceneStore::isValidName("a_name_longer_than_thirty_one_chars"));
+}
+
+int main(int, char **) {
+  UNITY_BEGIN();
+  RUN_TEST(test_scene_sets_every_target);
+  RUN_TEST(test_scene_yields_one_command_per_changed_value);
+  RUN_TEST(test_reapplying_a_scene_changes_nothing);
+  RUN_TEST(test_missing_process_is_skipped_and_default_device_set);
+  RUN_TEST(test_default_device_target_without_a_default_device_is_missing);
+  RUN_TEST(test_volumes_above_100_are_clamped);
+  RUN_TEST(test_captured_scene_restores_the_status);
+  RUN_TEST(test_scene_blob_round_trips_and_rejects_corruption);
+  RUN_TEST(test_scene_names_are_file_safe);
+  return UNITY_END();
+}
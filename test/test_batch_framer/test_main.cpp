@@ -0,0 +1,152 @@
+// BATCH_MESSAGE_TYPE frames through BinaryProtocolFramer: encode, decode,
+// escaping, capacity and corruption
+
+#include <BinaryProtocol.h>
+#include <unity.h>
+
+#include <memory>
+#include <vector>
+
+using namespace BinaryProtocol;
+
+namespace {
+
+const size_t BUFFER_SIZE = MAX_PAYLOAD_SIZE + 1024;
+
+// The framer holds an 8KB receive buffer, keep it off the stack
+std::unique_ptr<BinaryProtocolFramer> makeFramer() {
+  return std::make_unique<BinaryProtocolFramer>();
+}
+
+String message(int i) {
+  return String("{\"messageType\":\"SET_VOLUME\",\"volume\":") + String(i) +
+         "}";
+}
+
+} // namespace
+
+void setUp() {}
+void tearDown() {}
+
+void test_batch_decodes_to_the_messages_in_order() {
+  auto sender = makeFramer();
+  auto receiver = makeFramer();
+  std::vector<uint8_t> frame(BUFFER_SIZE);
+
+  sender->beginBatch(frame.data(), frame.size());
+  for (int i = 0; i < 8; i++) {
+    String json = message(i);
+    TEST_ASSERT_TRUE(sender->addToBatch(json.c_str(), json.length()));
+  }
+  TEST_ASSERT_EQUAL(8, sender->getBatchCount());
+  size_t length = sender->finishBatch();
+  TEST_ASSERT_GREATER_THAN(0, length);
+
+  std::vector<String> received =
+      receiver->processIncomingBytes(frame.data(), length);
+  TEST_ASSERT_EQUAL(8, received.size());
+  for (int i = 0; i < 8; i++) {
+    TEST_ASSERT_TRUE(received[i] == message(i));
+  }
+  TEST_ASSERT_EQUAL(1, receiver->getStatistics().batchesReceived);
+  TEST_ASSERT_EQUAL(8, receiver->getStatistics().batchedMessagesReceived);
+  TEST_ASSERT_TRUE(receiver->peerSupportsBatches());
+}
+
+void test_batch_costs_less_than_single_frames() {
+  auto framer = makeFramer();
+  std::vector<uint8_t> frame(BUFFER_SIZE);
+  String json = message(50);
+
+  size_t single = 0;
+  TEST_ASSERT_TRUE(
+      framer->encodeMessage(json, frame.data(), frame.size(), single));
+
+  framer->beginBatch(frame.data(), frame.size());
+  for (int i = 0; i < 16; i++) {
+    framer->addToBatch(json.c_str(), json.length());
+  }
+  size_t batch = framer->finishBatch();
+  TEST_ASSERT_LESS_THAN(16 * single, batch);
+}
+
+void test_payload_bytes_that_look_like_markers_are_escaped() {
+  auto sender = makeFramer();
+  auto receiver = makeFramer();
+  std::vector<uint8_t> frame(BUFFER_SIZE);
+  const char json[] = "{\"name\":\"\x7E\x7D\x7F\"}";
+
+  sender->beginBatch(frame.data(), frame.size());
+  sender->addToBatch(json, strlen(json));
+  sender->addToBatch(json, strlen(json));
+  size_t length = sender->finishBatch();
+
+  std::vector<String> received =
+      receiver->processIncomingBytes(frame.data(), length);
+  TEST_ASSERT_EQUAL(2, received.size());
+  TEST_ASSERT_EQUAL_STRING(json, received[1].c_str());
+}
+
+void test_message_that_does_not_fit_is_left_for_the_next_frame() {
+  auto framer = makeFramer();
+  std::vector<uint8_t> frame(256);
+  String json = message(1);
+
+  framer->beginBatch(frame.data(), frame.size());
+  size_t added = 0;
+  while (framer->addToBatch(json.c_str(), json.length())) {
+    added++;
+  }
+  TEST_ASSERT_GREATER_THAN(0, added);
+  TEST_ASSERT_EQUAL(added, framer->getBatchCount());
+
+  size_t length = framer->finishBatch();
+  TEST_ASSERT_LESS_OR_EQUAL(frame.size(), length);
+  auto receiver = makeFramer();
+  TEST_ASSERT_EQUAL(added,
+                    receiver->processIncomingBytes(frame.data(), length).size());
+}
+
+void test_empty_batch_produces_no_frame() {
+  auto framer = makeFramer();
+  std::vector<uint8_t> frame(BUFFER_SIZE);
+  framer->beginBatch(frame.data(), frame.size());
+  TEST_ASSERT_EQUAL(0, framer->finishBatch());
+}
+
+void test_corrupted_batch_is_dropped_whole() {
+  auto sender = makeFramer();
+  auto receiver = makeFramer();
+  std::vector<uint8_t> frame(BUFFER_SIZE);
+
+  sender->beginBatch(frame.data(), frame.size());
+  for (int i = 0; i < 4; i++) {
+    String json = message(i);
+    sender->addToBatch(json.c_str(), json.length());
+  }
+  size_t length = sender->finishBatch();
+  frame[length / 2] ^= 0x01;
+
+  TEST_ASSERT_EQUAL(0, receiver->processIncomingBytes(frame.data(), length).size());
+  TEST_ASSERT_EQUAL(1, receiver->getStatistics().crcErrors);
+
+  // The receiver resynchronizes on the next frame
+  String json = message(9);
+  size_t single = 0;
+  sender->encodeMessage(json, frame.data(), frame.size(), single);
+  std::vector<String> received =
+      receiver->processIncomingBytes(frame.data(), single);
+  TEST_ASSERT_EQUAL(1, received.size());
+  TEST_ASSERT_TRUE(received[0] == json);
+}
+
+int main(int, char **) {
+  UNITY_BEGIN();
+  RUN_TEST(test_batch_decodes_to_the_messages_in_order);
+  RUN_TEST(test_batch_costs_less_than_single_frames);
+  RUN_TEST(test_payload_bytes_that_look_like_markers_are_escaped);
+  RUN_TEST(test_message_that_does_not_fit_is_left_for_the_next_frame);
+  RUN_TEST(test_empty_batch_produces_no_frame);
+  RUN_TEST(test_corrupted_batch_is_dropped_whole);
+  return UNITY_END();
+}
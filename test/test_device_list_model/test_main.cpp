@@ -0,0 +1,137 @@
+// DeviceListModel: the inserts and removals it reports must turn the shown
+// dropdown options into the new list, for 8, 32 and 128 sessions
+
+#include <DeviceListModel.h>
+#include <unity.h>
+
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+using namespace Application::Audio;
+
+namespace {
+
+const size_t LIST_MAX = 128;
+using List = DeviceListModel<LIST_MAX>;
+
+char names[LIST_MAX][16];
+const char *full[LIST_MAX];
+const char *without[LIST_MAX]; // One session gone, half way down
+
+std::unique_ptr<List> model;
+std::vector<const char *> shown;
+List::Changes changes;
+
+// Update the model to 'list' and apply what it reports to 'shown'
+void update(const char *const *list, size_t count) {
+  changes = model->update(
+      list, count, [](List::Op op, size_t position, const char *name) {
+        if (op == List::Op::INSERT) {
+          shown.insert(shown.begin() + position, name);
+        } else {
+          shown.erase(shown.begin() + position);
+        }
+      });
+}
+
+void assertShown(const char *const *list, size_t count) {
+  TEST_ASSERT_EQUAL(count, shown.size());
+  TEST_ASSERT_EQUAL(count, model->size());
+  for (size_t i = 0; i < count; i++) {
+    TEST_ASSERT_EQUAL_STRING(list[i], shown[i]);
+  }
+}
+
+void dropSession(size_t count, size_t gone) {
+  for (size_t i = 0, j = 0; i < count; i++) {
+    if (i != gone) {
+      without[j++] = names[i];
+    }
+  }
+}
+
+void checkMembershipChanges(size_t count) {
+  dropSession(count, count / 2);
+
+  update(full, count);
+  assertShown(full, count);
+  TEST_ASSERT_EQUAL(count, changes.inserted);
+
+  update(full, count);
+  TEST_ASSERT_TRUE(changes.empty());
+
+  update(without, count - 1);
+  assertShown(without, count - 1);
+  TEST_ASSERT_EQUAL(0, changes.inserted);
+  TEST_ASSERT_EQUAL(1, changes.removed);
+
+  update(full, count);
+  assertShown(full, count);
+  TEST_ASSERT_EQUAL(1, changes.inserted);
+  TEST_ASSERT_EQUAL(0, changes.removed);
+
+  update(full, 0);
+  assertShown(full, 0);
+  TEST_ASSERT_EQUAL(count, changes.removed);
+}
+
+} // namespace
+
+void setUp() {
+  for (size_t i = 0; i < LIST_MAX; i++) {
+    snprintf(names[i], sizeof(names[i]), "proc%03u.exe",
+             static_cast<unsigned>(i));
+    full[i] = names[i];
+  }
+  model = std::make_unique<List>();
+  shown.clear();
+}
+
+void tearDown() { model.reset(); }
+
+void test_8_sessions_fill_churn_and_empty() { checkMembershipChanges(8); }
+
+void test_32_sessions_fill_churn_and_empty() { checkMembershipChanges(32); }
+
+void test_128_sessions_fill_churn_and_empty() {
+  checkMembershipChanges(LIST_MAX);
+}
+
+void test_reordered_list_is_rebuilt_in_the_new_order() {
+  const char *reversed[8];
+  for (int i = 0; i < 8; i++) {
+    reversed[i] = names[7 - i];
+  }
+
+  update(full, 8);
+  update(reversed, 8);
+
+  assertShown(reversed, 8);
+  TEST_ASSERT_EQUAL(changes.inserted, changes.removed);
+}
+
+void test_names_beyond_capacity_are_ignored() {
+  DeviceListModel<4> small;
+  size_t reported = 0;
+
+  DeviceListModel<4>::Changes result = small.update(
+      full, 8, [&](DeviceListModel<4>::Op, size_t, const char *) {
+        reported++;
+      });
+
+  TEST_ASSERT_EQUAL(4, small.size());
+  TEST_ASSERT_EQUAL(4, result.inserted);
+  TEST_ASSERT_EQUAL(4, reported);
+}
+
+int main(int, char **) {
+  UNITY_BEGIN();
+  RUN_TEST(test_8_sessions_fill_churn_and_empty);
+  RUN_TEST(test_32_sessions_fill_churn_and_empty);
+  RUN_TEST(test_128_sessions_fill_churn_and_empty);
+  RUN_TEST(test_reordered_list_is_rebuilt_in_the_new_order);
+  RUN_TEST(test_names_beyond_capacity_are_ignored);
+  return UNITY_END();
+}
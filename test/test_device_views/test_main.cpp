@@ -0,0 +1,125 @@
+// SessionTable views used by the device list renders: joined dropdown
+// options and in-place iteration, without copies or heap use
+
+#include <AudioData.h>
+#include <unity.h>
+
+#include <cstdlib>
+#include <memory>
+#include <new>
+
+using namespace Application::Audio;
+
+// Counts every heap allocation in the program, see the no-copy test
+static size_t allocations = 0;
+
+void *operator new(size_t size) {
+  allocations++;
+  if (void *block = std::malloc(size ? size : 1)) {
+    return block;
+  }
+  throw std::bad_alloc();
+}
+void operator delete(void *block) noexcept { std::free(block); }
+void operator delete(void *block, size_t) noexcept { std::free(block); }
+
+namespace {
+
+const char *const SESSION_NAMES[SessionTable::CAPACITY] = {
+    "chrome.exe",   "firefox.exe", "spotify.exe",  "discord.exe",
+    "steam.exe",    "vlc.exe",     "teams.exe",    "zoom.exe",
+    "obs64.exe",    "slack.exe",   "msedge.exe",   "foobar2000.exe",
+    "explorer.exe", "code.exe",    "winamp.exe",   "audiodg.exe"};
+
+char options[SessionTable::CAPACITY * SessionTable::NAME_SIZE];
+
+std::unique_ptr<AudioStatus> status;
+
+// What AudioUI built before the views: a copy of every session and a
+// String joined from it
+String copiedOptions() {
+  std::vector<AudioLevel> devices = status->getAudioLevels();
+  String joined = "";
+  for (size_t i = 0; i < devices.size(); i++) {
+    if (i > 0) {
+      joined += "\n";
+    }
+    joined += devices[i].processName;
+  }
+  return joined;
+}
+
+} // namespace
+
+void setUp() {
+  status = std::make_unique<AudioStatus>();
+  for (int i = 0; i < SessionTable::CAPACITY; i++) {
+    status->sessions.put(SESSION_NAMES[i], SESSION_NAMES[i], i * 5, false,
+                         "Active", 0);
+  }
+}
+
+void tearDown() { status.reset(); }
+
+void test_joined_options_match_the_copied_list() {
+  size_t length =
+      status->sessions.joinProcessNames(options, sizeof(options), '\n');
+
+  String expected = copiedOptions();
+  TEST_ASSERT_EQUAL_STRING(expected.c_str(), options);
+  TEST_ASSERT_EQUAL(expected.length(), length);
+}
+
+void test_views_do_not_allocate() {
+  size_t before = allocations;
+  status->sessions.joinProcessNames(options, sizeof(options), '\n');
+  int volumeSum = 0;
+  for (SessionTable::Entry session : status->sessions) {
+    volumeSum += session.volume();
+  }
+
+  TEST_ASSERT_EQUAL(0, allocations - before);
+  // 0 + 5 + ... + 75
+  TEST_ASSERT_EQUAL(600, volumeSum);
+}
+
+void test_iteration_visits_sessions_in_option_order() {
+  status->sessions.joinProcessNames(options, sizeof(options), '\n');
+
+  String rebuilt;
+  for (SessionTable::Entry session : status->sessions) {
+    if (rebuilt.length() > 0) {
+      rebuilt += "\n";
+    }
+    rebuilt += session.processName();
+  }
+  TEST_ASSERT_EQUAL_STRING(options, rebuilt.c_str());
+}
+
+void test_join_stops_at_the_last_name_that_fits() {
+  char small[24];
+  size_t length = status->sessions.joinProcessNames(small, sizeof(small), '|');
+
+  // Sorted: audiodg.exe, chrome.exe, code.exe, ...
+  TEST_ASSERT_EQUAL_STRING("audiodg.exe|chrome.exe", small);
+  TEST_ASSERT_EQUAL(22, length);
+}
+
+void test_empty_table_joins_to_an_empty_string() {
+  status->clear();
+  options[0] = 'x';
+
+  TEST_ASSERT_EQUAL(0, status->sessions.joinProcessNames(options,
+                                                         sizeof(options), '\n'));
+  TEST_ASSERT_EQUAL_STRING("", options);
+}
+
+int main(int, char **) {
+  UNITY_BEGIN();
+  RUN_TEST(test_joined_options_match_the_copied_list);
+  RUN_TEST(test_views_do_not_allocate);
+  RUN_TEST(test_iteration_visits_sessions_in_option_order);
+  RUN_TEST(test_join_stops_at_the_last_name_that_fits);
+  RUN_TEST(test_empty_table_joins_to_an_empty_string);
+  return UNITY_END();
+}
@@ -0,0 +1,139 @@
+// InboundScheduler: class ordering under an asset flood, the starvation
+// guard, arrival order within a class and the per-class byte cap
+
+#include <MessagingConfig.h>
+#include <messaging/InboundScheduler.h>
+#include <unity.h>
+
+using namespace Messaging;
+
+namespace {
+
+const String ASSET =
+    "{\"messageType\":\"ASSET_RESPONSE\",\"processName\":\"test\"}";
+const String VOLUME = "{\"messageType\":\"VOLUME_CHANGE\","
+                      "\"processName\":\"test\",\"volume\":50}";
+const String STATUS = "{\"messageType\":\"STATUS_MESSAGE\"}";
+
+// Records where the first asset and the last volume echo were delivered.
+// Asset handlers are slow on the device (base64 decode and an SD write), so
+// each delivery costs time and the dispatch budget runs out part way.
+struct DeliveryLog {
+  int position = 0;
+  int firstAsset = -1;
+  int lastVolume = -1;
+
+  InboundScheduler::Deliver deliver() {
+    return [this](const String &json) {
+      bool isAsset = json == ASSET;
+      delayMicroseconds(isAsset ? 2000 : 50);
+      if (isAsset && firstAsset < 0) {
+        firstAsset = position;
+      } else if (!isAsset) {
+        lastVolume = position;
+      }
+      position++;
+    };
+  }
+};
+
+void drain(InboundScheduler &scheduler,
+           const InboundScheduler::Deliver &deliver) {
+  while (scheduler.hasPending()) {
+    scheduler.dispatch(MESSAGING_INBOUND_DISPATCH_BUDGET_US, deliver);
+  }
+}
+
+} // namespace
+
+void setUp() {}
+void tearDown() {}
+
+void test_volume_echoes_overtake_an_asset_flood() {
+  const int assets = 20;
+  const int volumes = 5;
+  InboundScheduler scheduler;
+  DeliveryLog log;
+
+  for (int i = 0; i < assets; i++) {
+    scheduler.enqueue(ASSET);
+    if (i % 4 == 3) {
+      scheduler.enqueue(VOLUME);
+    }
+  }
+  drain(scheduler, log.deliver());
+
+  TEST_ASSERT_EQUAL(assets + volumes, log.position);
+  TEST_ASSERT_EQUAL(volumes - 1, log.lastVolume);
+}
+
+void test_bulk_work_is_not_starved() {
+  InboundScheduler scheduler;
+  DeliveryLog log;
+
+  for (int i = 0; i < 20; i++) {
+    scheduler.enqueue(VOLUME);
+  }
+  scheduler.enqueue(ASSET);
+  drain(scheduler, log.deliver());
+
+  TEST_ASSERT_EQUAL(21, log.position);
+  TEST_ASSERT_GREATER_OR_EQUAL(0, log.firstAsset);
+  TEST_ASSERT_LESS_OR_EQUAL(MESSAGING_INBOUND_MAX_STREAK, log.firstAsset);
+  TEST_ASSERT_EQUAL(
+      1, scheduler.getStats(MessageProtocol::MessagePriority::MSG_LOW).promoted);
+}
+
+void test_status_and_volume_keep_arrival_order() {
+  InboundScheduler scheduler;
+  String sequence;
+
+  for (int i = 0; i < 6; i++) {
+    scheduler.enqueue(i % 2 ? VOLUME : STATUS);
+  }
+  drain(scheduler,
+        [&](const String &json) { sequence += json == VOLUME ? "V" : "S"; });
+
+  TEST_ASSERT_EQUAL_STRING("SVSVSV", sequence.c_str());
+}
+
+void test_large_assets_are_capped_by_bytes() {
+  InboundScheduler scheduler;
+  String bigAsset = ASSET;
+  while (bigAsset.length() < MESSAGING_INBOUND_QUEUE_BYTES / 4 + 1) {
+    bigAsset += " ";
+  }
+
+  int accepted = 0;
+  for (int i = 0; i < MESSAGING_INBOUND_QUEUE_DEPTH; i++) {
+    accepted += scheduler.enqueue(bigAsset);
+  }
+
+  const auto &low =
+      scheduler.getStats(MessageProtocol::MessagePriority::MSG_LOW);
+  TEST_ASSERT_EQUAL(3, accepted);
+  TEST_ASSERT_EQUAL(MESSAGING_INBOUND_QUEUE_DEPTH - 3, low.dropped);
+  TEST_ASSERT_LESS_OR_EQUAL(MESSAGING_INBOUND_QUEUE_BYTES, low.maxBytes);
+}
+
+void test_an_empty_class_takes_one_oversized_message() {
+  InboundScheduler scheduler;
+  String hugeAsset = ASSET;
+  while (hugeAsset.length() <= MESSAGING_INBOUND_QUEUE_BYTES) {
+    hugeAsset += " ";
+  }
+
+  TEST_ASSERT_TRUE(scheduler.enqueue(hugeAsset));
+  TEST_ASSERT_FALSE(scheduler.enqueue(ASSET));
+  TEST_ASSERT_EQUAL(1, scheduler.pendingCount());
+}
+
+int main(int, char **) {
+  UNITY_BEGIN();
+  RUN_TEST(test_volume_echoes_overtake_an_asset_flood);
+  RUN_TEST(test_bulk_work_is_not_starved);
+  RUN_TEST(test_status_and_volume_keep_arrival_order);
+  RUN_TEST(test_large_assets_are_capped_by_bytes);
+  RUN_TEST(test_an_empty_class_takes_one_oversized_message);
+  return UNITY_END();
+}
@@ -0,0 +1,146 @@
+// LogoPrefetcher with a fake SD and host: one check per process, visibility
+// order, the in-flight cap, retries and presence answered from the table
+
+#include <logo/LogoPrefetcher.h>
+#include <unity.h>
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace {
+
+const int SESSIONS = 10;
+const uint32_t RETRY_MS = 5000;
+
+const char *const SESSION_NAMES[SESSIONS] = {
+    "chrome.exe", "firefox.exe", "spotify.exe", "discord.exe", "steam.exe",
+    "vlc.exe",    "teams.exe",   "zoom.exe",    "obs64.exe",   "slack.exe"};
+
+// audiodg.exe is on SD but never wanted, so never checked
+std::vector<String> onSd;
+std::vector<String> requested;
+std::vector<std::pair<String, LogoPrefetcher::Done>> outstanding;
+size_t maxOutstanding = 0;
+std::unique_ptr<LogoPrefetcher> prefetcher;
+
+// Selected device first, then dropdown order (it appears twice)
+const char *names[SESSIONS + 1];
+
+// The host answers one request at a time, 100 ms apart; slack.exe fails
+uint32_t answerAll(uint32_t now) {
+  while (!outstanding.empty()) {
+    auto next = outstanding.front();
+    outstanding.erase(outstanding.begin());
+    next.second(next.first != "slack.exe", now);
+    now += 100;
+  }
+  return now;
+}
+
+} // namespace
+
+void setUp() {
+  onSd = {"firefox.exe", "steam.exe", "vlc.exe", "audiodg.exe"};
+  requested.clear();
+  outstanding.clear();
+  maxOutstanding = 0;
+  prefetcher = std::make_unique<LogoPrefetcher>(
+      [](const char *processName) {
+        return std::find(onSd.begin(), onSd.end(), String(processName)) !=
+               onSd.end();
+      },
+      [](const char *processName, LogoPrefetcher::Done done) {
+        requested.push_back(processName);
+        outstanding.push_back({processName, done});
+        maxOutstanding = std::max(maxOutstanding, outstanding.size());
+      },
+      2, RETRY_MS);
+
+  names[0] = "zoom.exe";
+  for (int i = 0; i < SESSIONS; i++) {
+    names[i + 1] = SESSION_NAMES[i];
+  }
+}
+
+void tearDown() { prefetcher.reset(); }
+
+void test_repeated_updates_check_each_process_once() {
+  for (int pass = 0; pass < 4; pass++) {
+    prefetcher->prioritise(names, SESSIONS + 1, pass * 10);
+  }
+
+  LogoPrefetcher::Stats stats = prefetcher->getStats();
+  TEST_ASSERT_EQUAL(SESSIONS, stats.probes);
+  TEST_ASSERT_EQUAL(3, stats.hits);
+  TEST_ASSERT_EQUAL(2, requested.size());
+}
+
+void test_selected_device_is_requested_first() {
+  prefetcher->prioritise(names, SESSIONS + 1, 0);
+
+  TEST_ASSERT_EQUAL(2, requested.size());
+  TEST_ASSERT_EQUAL_STRING("zoom.exe", requested[0].c_str());
+  TEST_ASSERT_EQUAL_STRING("chrome.exe", requested[1].c_str());
+}
+
+void test_requests_stay_within_the_in_flight_cap() {
+  prefetcher->prioritise(names, SESSIONS + 1, 0);
+  uint32_t presenceBefore = prefetcher->presenceVersion();
+  answerAll(100);
+
+  LogoPrefetcher::Stats stats = prefetcher->getStats();
+  TEST_ASSERT_EQUAL(2, maxOutstanding);
+  TEST_ASSERT_EQUAL(6, stats.fetched);
+  TEST_ASSERT_EQUAL(1, stats.failures);
+  // Each saved logo must reach the renderers, a failure changes nothing
+  TEST_ASSERT_EQUAL(6, prefetcher->presenceVersion() - presenceBefore);
+}
+
+void test_failed_request_waits_for_its_retry() {
+  prefetcher->prioritise(names, SESSIONS + 1, 0);
+  uint32_t now = answerAll(100);
+  size_t before = requested.size();
+
+  prefetcher->prioritise(names, SESSIONS + 1, now);
+  TEST_ASSERT_EQUAL(before, requested.size());
+
+  prefetcher->prioritise(names, SESSIONS + 1, now + RETRY_MS);
+  TEST_ASSERT_EQUAL(before + 1, requested.size());
+  TEST_ASSERT_EQUAL_STRING("slack.exe", requested.back().c_str());
+}
+
+void test_presence_needs_no_sd_check() {
+  prefetcher->prioritise(names, SESSIONS + 1, 0);
+  answerAll(100);
+  uint32_t probes = prefetcher->getStats().probes;
+
+  TEST_ASSERT_TRUE(prefetcher->hasLogo("zoom.exe"));
+  TEST_ASSERT_TRUE(prefetcher->hasLogo("vlc.exe"));
+  // Never wanted, so never checked, although it is on SD
+  TEST_ASSERT_FALSE(prefetcher->hasLogo("audiodg.exe"));
+  TEST_ASSERT_EQUAL(probes, prefetcher->getStats().probes);
+}
+
+void test_unlisted_processes_are_not_fetched() {
+  prefetcher->prioritise(names, SESSIONS + 1, 0);
+  const char *onlyVlc[] = {"vlc.exe"};
+  prefetcher->prioritise(onlyVlc, 1, 10);
+
+  // zoom.exe and chrome.exe were already in flight, nothing else follows
+  answerAll(100);
+  TEST_ASSERT_EQUAL(2, requested.size());
+  TEST_ASSERT_EQUAL(0, prefetcher->queueLength());
+}
+
+int main(int, char **) {
+  UNITY_BEGIN();
+  RUN_TEST(test_repeated_updates_check_each_process_once);
+  RUN_TEST(test_selected_device_is_requested_first);
+  RUN_TEST(test_requests_stay_within_the_in_flight_cap);
+  RUN_TEST(test_failed_request_waits_for_its_retry);
+  RUN_TEST(test_presence_needs_no_sd_check);
+  RUN_TEST(test_unlisted_processes_are_not_fetched);
+  return UNITY_END();
+}
@@ -0,0 +1,205 @@
+// Generated JSON and binary codecs (reflect_codec.hpp) on the wire payload
+// structs of Message.h
+
+#include <ArduinoJson.h>
+#include <messaging/Message.h>
+#include <reflect_codec.hpp>
+#include <unity.h>
+
+#include <memory>
+#include <string>
+
+using Messaging::Message;
+namespace codec = reflective::codec;
+
+namespace {
+
+// Fill every field with a value derived from its position so a dropped or
+// swapped field is detectable after a round trip
+template <typename T> void fillSample(T &value) {
+  int index = 0;
+  reflective::for_each_field<T>([&](std::string_view name, auto member) {
+    auto &field = value.*member;
+    using F = std::remove_reference_t<decltype(field)>;
+    index++;
+    if constexpr (std::is_same_v<std::remove_extent_t<F>, char>) {
+      snprintf(field, sizeof(field), "%.*s_%d", (int)name.size(), name.data(),
+               index);
+    } else if constexpr (std::is_same_v<F, bool>) {
+      field = true;
+    } else if constexpr (std::is_floating_point_v<F>) {
+      field = index + 0.5f;
+    } else if constexpr (std::is_arithmetic_v<F>) {
+      field = index * 7;
+    }
+  });
+}
+
+// Name of the first field that differs, nullptr if all match
+template <typename T>
+const char *firstDifference(const T &expected, const T &actual) {
+  const char *different = nullptr;
+  reflective::for_each_field<T>([&](std::string_view name, auto member) {
+    const auto &a = expected.*member;
+    const auto &b = actual.*member;
+    using F = std::remove_cv_t<std::remove_reference_t<decltype(a)>>;
+    bool same;
+    if constexpr (std::is_same_v<std::remove_extent_t<F>, char>) {
+      same = strcmp(a, b) == 0;
+    } else {
+      same = a == b;
+    }
+    if (!same && !different) {
+      different = name.data();
+    }
+  });
+  return different;
+}
+
+template <typename T> void checkJsonRoundTrip() {
+  // AssetData is ~4.3KB, keep the samples off the stack
+  auto source = std::make_unique<T>();
+  auto decoded = std::make_unique<T>();
+  fillSample(*source);
+
+  JsonDocument doc;
+  codec::encodeFields(doc.to<JsonObject>(), *source);
+  std::string json;
+  serializeJson(doc, json);
+
+  JsonDocument parsed;
+  TEST_ASSERT_FALSE(deserializeJson(parsed, json));
+  codec::decodeFields(parsed.as<JsonObjectConst>(), *decoded);
+  TEST_ASSERT_NULL(firstDifference(*source, *decoded));
+}
+
+template <typename T> void checkBinaryRoundTrip() {
+  auto source = std::make_unique<T>();
+  auto decoded = std::make_unique<T>();
+  std::vector<uint8_t> buffer(sizeof(T) * 2);
+  fillSample(*source);
+
+  size_t written = codec::toBinary(*source, buffer.data(), buffer.size());
+  TEST_ASSERT_GREATER_THAN(0, written);
+  TEST_ASSERT_EQUAL(written, codec::fromBinary(*decoded, buffer.data(), written));
+  TEST_ASSERT_NULL(firstDifference(*source, *decoded));
+}
+
+struct Sample {
+  int count;
+  char name[8];
+
+  REFLECT_DECLARE(Sample, REFLECT_FIELD(count), REFLECT_FIELD(name))
+};
+
+// Same fields, one renamed: a different layout for persisted data
+struct RenamedSample {
+  int count;
+  char label[8];
+
+  REFLECT_DECLARE(RenamedSample, REFLECT_FIELD(count), REFLECT_FIELD(label))
+};
+
+const uint32_t MAGIC = 0x54534554; // "TEST"
+
+} // namespace
+
+void setUp() {}
+void tearDown() {}
+
+void test_payloads_round_trip_through_json() {
+  checkJsonRoundTrip<Message::SessionData>();
+  checkJsonRoundTrip<Message::DefaultDeviceData>();
+  checkJsonRoundTrip<Message::VolumeData>();
+  checkJsonRoundTrip<Message::AssetData>();
+}
+
+void test_payloads_round_trip_through_binary() {
+  checkBinaryRoundTrip<Message::SessionData>();
+  checkBinaryRoundTrip<Message::DefaultDeviceData>();
+  checkBinaryRoundTrip<Message::VolumeData>();
+  checkBinaryRoundTrip<Message::AssetData>();
+}
+
+void test_json_uses_wire_names() {
+  Message::AssetData asset = {};
+  strcpy(asset.assetDataBase64, "iVBORw0KGgo=");
+
+  JsonDocument doc;
+  codec::encodeFields(doc.to<JsonObject>(), asset);
+  TEST_ASSERT_EQUAL_STRING("iVBORw0KGgo=", doc["assetData"].as<const char *>());
+  TEST_ASSERT_TRUE(doc["assetDataBase64"].isNull());
+}
+
+void test_json_decode_keeps_missing_fields_empty_and_truncates_strings() {
+  JsonDocument doc;
+  TEST_ASSERT_FALSE(deserializeJson(
+      doc, "{\"count\":3,\"name\":\"much too long for eight\"}"));
+  Sample sample = {};
+  codec::decodeFields(doc.as<JsonObjectConst>(), sample);
+  TEST_ASSERT_EQUAL(3, sample.count);
+  TEST_ASSERT_EQUAL_STRING("much to", sample.name);
+
+  TEST_ASSERT_FALSE(deserializeJson(doc, "{\"count\":4}"));
+  Sample missing = {};
+  codec::decodeFields(doc.as<JsonObjectConst>(), missing);
+  TEST_ASSERT_EQUAL(4, missing.count);
+  TEST_ASSERT_EQUAL_STRING("", missing.name);
+}
+
+void test_counted_arrays_stop_at_capacity() {
+  Sample items[3] = {};
+  for (int i = 0; i < 3; i++) {
+    items[i].count = i;
+  }
+
+  JsonDocument doc;
+  JsonArray array = doc.to<JsonArray>();
+  codec::encodeArray(array, items, 5); // Clamped to 3
+  Sample decoded[2] = {};
+  TEST_ASSERT_EQUAL(2, codec::decodeArray(doc.as<JsonArrayConst>(), decoded));
+  TEST_ASSERT_EQUAL(1, decoded[1].count);
+}
+
+void test_binary_rejects_overflow_and_truncation() {
+  Sample sample = {7, "abc"};
+  uint8_t buffer[32];
+  TEST_ASSERT_EQUAL(0, codec::toBinary(sample, buffer, 4));
+
+  size_t written = codec::toBinary(sample, buffer, sizeof(buffer));
+  Sample decoded = {};
+  TEST_ASSERT_EQUAL(0, codec::fromBinary(decoded, buffer, written - 1));
+}
+
+void test_blobs_check_magic_schema_and_checksum() {
+  Sample sample = {7, "abc"};
+  uint8_t blob[64];
+  size_t size = codec::toBlob(sample, MAGIC, blob, sizeof(blob));
+  TEST_ASSERT_GREATER_THAN(sizeof(codec::BlobHeader), size);
+
+  Sample decoded = {};
+  TEST_ASSERT_TRUE(codec::fromBlob(decoded, MAGIC, blob, size));
+  TEST_ASSERT_EQUAL(7, decoded.count);
+  TEST_ASSERT_EQUAL_STRING("abc", decoded.name);
+
+  TEST_ASSERT_FALSE(codec::fromBlob(decoded, MAGIC + 1, blob, size));
+  RenamedSample renamed = {};
+  TEST_ASSERT_FALSE(codec::fromBlob(renamed, MAGIC, blob, size));
+  TEST_ASSERT_NOT_EQUAL(codec::schemaHash<Sample>(),
+                        codec::schemaHash<RenamedSample>());
+
+  blob[size - 1] ^= 0x01;
+  TEST_ASSERT_FALSE(codec::fromBlob(decoded, MAGIC, blob, size));
+}
+
+int main(int, char **) {
+  UNITY_BEGIN();
+  RUN_TEST(test_payloads_round_trip_through_json);
+  RUN_TEST(test_payloads_round_trip_through_binary);
+  RUN_TEST(test_json_uses_wire_names);
+  RUN_TEST(test_json_decode_keeps_missing_fields_empty_and_truncates_strings);
+  RUN_TEST(test_counted_arrays_stop_at_capacity);
+  RUN_TEST(test_binary_rejects_overflow_and_truncation);
+  RUN_TEST(test_blobs_check_magic_schema_and_checksum);
+  return UNITY_END();
+}
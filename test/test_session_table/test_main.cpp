@@ -0,0 +1,155 @@
+// SessionTable: handles across status updates, membership versions, name
+// order and the no-allocation guarantee
+
+#include <AudioData.h>
+#include <unity.h>
+
+#include <cstdlib>
+#include <memory>
+#include <new>
+
+using namespace Application::Audio;
+
+// Every heap allocation in the test program is counted, so a test can check
+// that a code path allocates nothing
+static size_t allocations = 0;
+
+void *operator new(size_t size) {
+  allocations++;
+  if (void *block = std::malloc(size ? size : 1)) {
+    return block;
+  }
+  throw std::bad_alloc();
+}
+void operator delete(void *block) noexcept { std::free(block); }
+void operator delete(void *block, size_t) noexcept { std::free(block); }
+
+namespace {
+
+const char *const SESSION_NAMES[SessionTable::CAPACITY] = {
+    "chrome.exe",   "firefox.exe", "spotify.exe",  "discord.exe",
+    "steam.exe",    "vlc.exe",     "teams.exe",    "zoom.exe",
+    "obs64.exe",    "slack.exe",   "msedge.exe",   "foobar2000.exe",
+    "explorer.exe", "code.exe",    "winamp.exe",   "audiodg.exe"};
+
+AudioLevel makeLevel(int i) {
+  AudioLevel level;
+  level.processName = SESSION_NAMES[i];
+  level.friendlyName = SESSION_NAMES[i];
+  level.volume = i * 5;
+  level.state = "Active";
+  return level;
+}
+
+void fill(SessionTable &table) {
+  for (int i = 0; i < SessionTable::CAPACITY; i++) {
+    table.put(SESSION_NAMES[i], SESSION_NAMES[i], i * 5, false, "Active", 0);
+  }
+}
+
+} // namespace
+
+void setUp() {}
+void tearDown() {}
+
+void test_handles_survive_an_update_and_expire_with_their_session() {
+  AudioStatus live;
+  for (int i = 0; i < 4; i++) {
+    live.addOrUpdateDevice(makeLevel(i));
+  }
+  DeviceHandle kept = live.findDevice("spotify.exe");
+  DeviceHandle dropped = live.findDevice("firefox.exe");
+
+  // Next status: firefox gone, a new process takes its slot
+  AudioStatus next;
+  for (int i : {0, 2, 3, 4}) {
+    next.addOrUpdateDevice(makeLevel(i));
+  }
+  next.sessions.setVolume(next.findDevice("spotify.exe"), 77);
+  live.sessions.syncFrom(next.sessions);
+
+  TEST_ASSERT_TRUE(live.sessions.isValid(kept));
+  TEST_ASSERT_EQUAL(77, live.sessions.volume(kept));
+  TEST_ASSERT_FALSE(live.sessions.isValid(dropped));
+  TEST_ASSERT_EQUAL(dropped.index, live.sessions.find("steam.exe").index);
+  // chrome, discord, spotify
+  TEST_ASSERT_EQUAL(2, live.sessions.positionOf(kept));
+}
+
+void test_clear_changes_membership_once() {
+  AudioStatus live;
+  for (int i = 0; i < 4; i++) {
+    live.addOrUpdateDevice(makeLevel(i));
+  }
+  DeviceHandle handle = live.findDevice("chrome.exe");
+
+  uint32_t membership = live.sessions.membershipVersion();
+  live.clear();
+  TEST_ASSERT_NOT_EQUAL(membership, live.sessions.membershipVersion());
+  TEST_ASSERT_FALSE(live.sessions.isValid(handle));
+
+  membership = live.sessions.membershipVersion();
+  live.clear();
+  TEST_ASSERT_EQUAL(membership, live.sessions.membershipVersion());
+}
+
+void test_field_changes_keep_membership() {
+  SessionTable table;
+  fill(table);
+  uint32_t membership = table.membershipVersion();
+
+  table.setVolume(table.find("vlc.exe"), 10);
+  table.setMuted(table.find("vlc.exe"), true);
+
+  TEST_ASSERT_EQUAL(membership, table.membershipVersion());
+}
+
+void test_iteration_follows_process_name_order() {
+  SessionTable table;
+  fill(table);
+
+  TEST_ASSERT_EQUAL(SessionTable::CAPACITY, table.size());
+  for (size_t i = 1; i < table.size(); i++) {
+    TEST_ASSERT_LESS_THAN(
+        0, strcmp(table.processName(table.handleAt(i - 1)),
+                  table.processName(table.handleAt(i))));
+  }
+}
+
+void test_full_table_rejects_a_new_session() {
+  SessionTable table;
+  fill(table);
+
+  TEST_ASSERT_TRUE(table.full());
+  TEST_ASSERT_TRUE(
+      table.put("extra.exe", "extra.exe", 50, false, "Active", 0).isNull());
+  TEST_ASSERT_TRUE(table.find("extra.exe").isNull());
+}
+
+void test_filling_and_updating_do_not_allocate() {
+  auto incoming = std::make_unique<AudioStatus>();
+  auto live = std::make_unique<AudioStatus>();
+
+  size_t before = allocations;
+  fill(incoming->sessions);
+  live->sessions.syncFrom(incoming->sessions);
+  incoming->sessions.setVolume(incoming->sessions.handleAt(3), 42);
+  live->sessions.syncFrom(incoming->sessions);
+  for (const char *name : SESSION_NAMES) {
+    TEST_ASSERT_FALSE(live->sessions.find(name).isNull());
+  }
+
+  TEST_ASSERT_EQUAL(0, allocations - before);
+  TEST_ASSERT_EQUAL(42, live->sessions.volume(live->sessions.handleAt(3)));
+}
+
+int main(int, char **) {
+  UNITY_BEGIN();
+  RUN_TEST(test_handles_survive_an_update_and_expire_with_their_session);
+  RUN_TEST(test_clear_changes_membership_once);
+  RUN_TEST(test_field_changes_keep_membership);
+  RUN_TEST(test_iteration_follows_process_name_order);
+  RUN_TEST(test_full_table_rejects_a_new_session);
+  RUN_TEST(test_filling_and_updating_do_not_allocate);
+  return UNITY_END();
+}
@@ -0,0 +1,116 @@
+// SnapshotPublisher across threads. Run under ThreadSanitizer with
+// `pio test -e native_tsan`; `pio test -e native` runs it without.
+
+#include <SnapshotPublisher.h>
+#include <unity.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using Application::Audio::SnapshotPublisher;
+
+namespace {
+
+// Every word carries the version, so a torn value shows as a mismatch
+struct Value {
+  static const int WORDS = 64;
+  uint32_t version = 0;
+  uint32_t words[WORDS] = {};
+};
+
+void fill(Value &next, uint32_t version) {
+  next.version = version;
+  for (uint32_t &word : next.words) {
+    word = version;
+  }
+}
+
+} // namespace
+
+void setUp() {}
+void tearDown() {}
+
+void test_publish_skipped_while_every_other_slot_is_pinned() {
+  SnapshotPublisher<Value, 3> publisher;
+  TEST_ASSERT_TRUE(publisher.publish([](Value &next) { fill(next, 1); }));
+  auto first = publisher.acquire();
+  TEST_ASSERT_TRUE(publisher.publish([](Value &next) { fill(next, 2); }));
+  auto second = publisher.acquire();
+
+  // The third slot is still free, so one more publish fits
+  TEST_ASSERT_TRUE(publisher.publish([](Value &next) { fill(next, 3); }));
+  auto third = publisher.acquire();
+  TEST_ASSERT_FALSE(publisher.publish([](Value &next) { fill(next, 4); }));
+  TEST_ASSERT_EQUAL_UINT32(1, publisher.getStats().skipped);
+  TEST_ASSERT_EQUAL_UINT32(3, publisher.acquire()->version);
+
+  // Releasing an outdated reader lets the next publish through
+  first = {};
+  TEST_ASSERT_TRUE(publisher.publish([](Value &next) { fill(next, 4); }));
+  TEST_ASSERT_EQUAL_UINT32(4, publisher.acquire()->version);
+  TEST_ASSERT_EQUAL_UINT32(2, second->version);
+  TEST_ASSERT_EQUAL_UINT32(3, third->version);
+}
+
+void test_readers_never_see_a_torn_or_older_value() {
+  SnapshotPublisher<Value, 4> publisher;
+  std::atomic<bool> done{false};
+  std::atomic<uint32_t> torn{0};
+  std::atomic<uint32_t> backwards{0};
+  std::atomic<uint32_t> reads{0};
+  const uint32_t PUBLISHES = 20000;
+
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 3; i++) {
+    readers.emplace_back([&] {
+      uint32_t last = 0;
+      while (!done.load()) {
+        auto snapshot = publisher.acquire();
+        uint32_t version = snapshot->version;
+        for (uint32_t word : snapshot->words) {
+          if (word != version) {
+            torn.fetch_add(1);
+            break;
+          }
+        }
+        if (version < last) {
+          backwards.fetch_add(1);
+        }
+        last = version;
+        reads.fetch_add(1);
+      }
+    });
+  }
+
+  // Single writer, started once a reader runs so they overlap; a skipped
+  // publish is carried by the next one
+  while (reads.load() == 0) {
+    std::this_thread::yield();
+  }
+  uint32_t published = 0;
+  for (uint32_t version = 1; version <= PUBLISHES; version++) {
+    published += publisher.publish(
+        [version](Value &next) { fill(next, version); });
+  }
+  while (!publisher.publish([](Value &next) { fill(next, PUBLISHES + 1); })) {
+    std::this_thread::yield();
+  }
+  done.store(true);
+  for (std::thread &reader : readers) {
+    reader.join();
+  }
+
+  TEST_ASSERT_EQUAL_UINT32(0, torn.load());
+  TEST_ASSERT_EQUAL_UINT32(0, backwards.load());
+  TEST_ASSERT_GREATER_THAN(0, reads.load());
+  TEST_ASSERT_EQUAL_UINT32(PUBLISHES + 1, publisher.acquire()->version);
+  TEST_ASSERT_EQUAL_UINT32(published + 1, publisher.getStats().published);
+}
+
+int main(int, char **) {
+  UNITY_BEGIN();
+  RUN_TEST(test_publish_skipped_while_every_other_slot_is_pinned);
+  RUN_TEST(test_readers_never_see_a_torn_or_older_value);
+  return UNITY_END();
+}
@@ -0,0 +1,198 @@
+// AudioStateCache: blob round trip of sessions, default device, tab and
+// selections, rejected blobs, and the debounced NVS save
+
+#include <AudioStateCache.h>
+#include <nvs.h>
+#include <unity.h>
+
+#include <memory>
+
+using namespace Application::Audio;
+
+namespace {
+
+const char *const SESSION_NAMES[] = {"chrome.exe", "firefox.exe",
+                                     "spotify.exe", "discord.exe",
+                                     "steam.exe",  "vlc.exe"};
+
+// Heap: the states and the cache buffers are several KB each
+std::unique_ptr<AudioStateCache> cache;
+std::unique_ptr<AudioAppState> saved;
+std::unique_ptr<AudioAppState> restored;
+std::unique_ptr<uint8_t[]> blob;
+
+void fillSaved() {
+  SessionTable &sessions = saved->currentStatus.sessions;
+  for (int i = 0; i < 6; i++) {
+    sessions.put(SESSION_NAMES[i], SESSION_NAMES[i], 10 * i, i % 2, "Active",
+                 1000);
+  }
+  saved->currentStatus.hasDefaultDevice = true;
+  saved->currentStatus.defaultDevice.friendlyName = "Speakers (USB Audio)";
+  saved->currentStatus.defaultDevice.volume = 42;
+  saved->currentTab = Events::UI::TabState::BALANCE;
+  saved->selectedSingleDevice = sessions.find("spotify.exe");
+  saved->selectedDevice1 = sessions.find("chrome.exe");
+  saved->selectedDevice2 = sessions.find("discord.exe");
+}
+
+size_t encodeSaved() {
+  return cache->encode(*saved, blob.get(), AudioStateCache::MAX_BLOB_SIZE);
+}
+
+} // namespace
+
+void setUp() {
+  nvs_handle_t handle;
+  nvs_open("audio_cache", NVS_READWRITE, &handle);
+  nvs_erase_all(handle);
+  nvs_close(handle);
+
+  cache = std::make_unique<AudioStateCache>();
+  saved = std::make_unique<AudioAppState>();
+  restored = std::make_unique<AudioAppState>();
+  blob = std::make_unique<uint8_t[]>(AudioStateCache::MAX_BLOB_SIZE);
+  fillSaved();
+}
+
+void tearDown() {
+  cache.reset();
+  saved.reset();
+  restored.reset();
+  blob.reset();
+}
+
+void test_sessions_come_back_marked_stale() {
+  size_t size = encodeSaved();
+  TEST_ASSERT_GREATER_THAN(0, size);
+  TEST_ASSERT_TRUE(cache->decode(blob.get(), size, *restored));
+
+  const SessionTable &back = restored->currentStatus.sessions;
+  DeviceHandle discord = back.find("discord.exe");
+  TEST_ASSERT_EQUAL(6, back.size());
+  TEST_ASSERT_EQUAL(30, back.volume(discord));
+  TEST_ASSERT_TRUE(back.isMuted(discord));
+  TEST_ASSERT_TRUE(back.isStale(discord));
+  TEST_ASSERT_TRUE(restored->fromCache);
+}
+
+void test_default_device_comes_back_marked_stale() {
+  size_t size = encodeSaved();
+  TEST_ASSERT_TRUE(cache->decode(blob.get(), size, *restored));
+
+  const AudioStatus &status = restored->currentStatus;
+  TEST_ASSERT_TRUE(status.hasDefaultDevice);
+  TEST_ASSERT_EQUAL(42, status.defaultDevice.volume);
+  TEST_ASSERT_TRUE(status.defaultDevice.stale);
+  TEST_ASSERT_EQUAL_STRING("Speakers (USB Audio)",
+                           status.defaultDevice.friendlyName.c_str());
+}
+
+void test_tab_and_selections_come_back() {
+  size_t size = encodeSaved();
+  TEST_ASSERT_TRUE(cache->decode(blob.get(), size, *restored));
+
+  const SessionTable &back = restored->currentStatus.sessions;
+  TEST_ASSERT_TRUE(restored->currentTab == Events::UI::TabState::BALANCE);
+  TEST_ASSERT_EQUAL_STRING("spotify.exe",
+                           back.processName(restored->selectedSingleDevice));
+  TEST_ASSERT_TRUE(restored->selectedDevice1 == back.find("chrome.exe"));
+  TEST_ASSERT_TRUE(restored->selectedDevice2 == back.find("discord.exe"));
+  TEST_ASSERT_TRUE(restored->primaryAudioDevice.isNull());
+}
+
+// A rejected blob leaves the state it was decoded into alone
+void test_damaged_and_foreign_blobs_are_rejected() {
+  size_t size = encodeSaved();
+  TEST_ASSERT_TRUE(cache->decode(blob.get(), size, *restored));
+
+  blob[size - 1] ^= 0x5A;
+  TEST_ASSERT_FALSE(cache->decode(blob.get(), size, *restored));
+  blob[size - 1] ^= 0x5A;
+  TEST_ASSERT_FALSE(cache->decode(blob.get(), size - 1, *restored));
+
+  reflective::codec::BlobHeader header;
+  memcpy(&header, blob.get(), sizeof(header));
+  header.schema ^= 1;
+  memcpy(blob.get(), &header, sizeof(header));
+  TEST_ASSERT_FALSE(cache->decode(blob.get(), size, *restored));
+
+  TEST_ASSERT_EQUAL(6, restored->currentStatus.sessions.size());
+}
+
+void test_restore_without_a_stored_state_fails() {
+  TEST_ASSERT_FALSE(cache->restore(*restored));
+  TEST_ASSERT_FALSE(cache->getStats().restored);
+}
+
+void test_saved_state_restores_through_nvs() {
+  TEST_ASSERT_TRUE(cache->save(*saved));
+
+  AudioStateCache reader;
+  TEST_ASSERT_TRUE(reader.restore(*restored));
+  TEST_ASSERT_EQUAL(6, restored->currentStatus.sessions.size());
+  TEST_ASSERT_TRUE(reader.getStats().restored);
+}
+
+void test_identical_save_skips_the_write() {
+  TEST_ASSERT_TRUE(cache->save(*saved));
+  TEST_ASSERT_TRUE(cache->save(*saved));
+
+  TEST_ASSERT_EQUAL(1, cache->getStats().writes);
+  TEST_ASSERT_EQUAL(1, cache->getStats().unchanged);
+}
+
+void test_service_waits_for_the_state_to_settle() {
+  const uint32_t QUIET_MS = MESSAGING_STATE_CACHE_DEBOUNCE_MS;
+
+  saved->version = 1;
+  cache->service(*saved, 0);
+  cache->service(*saved, QUIET_MS - 1);
+  TEST_ASSERT_EQUAL(0, cache->getStats().writes);
+
+  // Another change restarts the quiet period
+  saved->version = 2;
+  cache->service(*saved, QUIET_MS - 1);
+  cache->service(*saved, QUIET_MS + 100);
+  TEST_ASSERT_EQUAL(0, cache->getStats().writes);
+
+  cache->service(*saved, 2 * QUIET_MS);
+  TEST_ASSERT_EQUAL(1, cache->getStats().writes);
+}
+
+void test_service_saves_a_busy_state_after_the_max_delay() {
+  uint32_t now = 0;
+  for (uint32_t version = 1;
+       now <= MESSAGING_STATE_CACHE_MAX_DELAY_MS; version++, now += 1000) {
+    saved->version = version;
+    saved->currentStatus.sessions.setVolume(
+        saved->currentStatus.sessions.find("vlc.exe"), version % 100);
+    cache->service(*saved, now);
+  }
+
+  TEST_ASSERT_EQUAL(1, cache->getStats().writes);
+}
+
+void test_service_ignores_an_unconfirmed_cached_state() {
+  saved->fromCache = true;
+  saved->version = 1;
+  cache->service(*saved, 0);
+  cache->service(*saved, MESSAGING_STATE_CACHE_MAX_DELAY_MS);
+
+  TEST_ASSERT_EQUAL(0, cache->getStats().writes);
+}
+
+int main(int, char **) {
+  UNITY_BEGIN();
+  RUN_TEST(test_sessions_come_back_marked_stale);
+  RUN_TEST(test_default_device_comes_back_marked_stale);
+  RUN_TEST(test_tab_and_selections_come_back);
+  RUN_TEST(test_damaged_and_foreign_blobs_are_rejected);
+  RUN_TEST(test_restore_without_a_stored_state_fails);
+  RUN_TEST(test_saved_state_restores_through_nvs);
+  RUN_TEST(test_identical_save_skips_the_write);
+  RUN_TEST(test_service_waits_for_the_state_to_settle);
+  RUN_TEST(test_service_saves_a_busy_state_after_the_max_delay);
+  RUN_TEST(test_service_ignores_an_unconfirmed_cached_state);
+  return UNITY_END();
+}
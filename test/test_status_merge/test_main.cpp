@@ -0,0 +1,158 @@
+// Merging status updates into a live AudioStatus: the change events each
+// shape of update produces and whether the device lists must be rebuilt
+
+#include <AudioData.h>
+#include <unity.h>
+
+#include <memory>
+
+using namespace Application::Audio;
+
+namespace {
+
+const char *const SESSION_NAMES[SessionTable::CAPACITY] = {
+    "chrome.exe",   "firefox.exe", "spotify.exe",  "discord.exe",
+    "steam.exe",    "vlc.exe",     "teams.exe",    "zoom.exe",
+    "obs64.exe",    "slack.exe",   "msedge.exe",   "foobar2000.exe",
+    "explorer.exe", "code.exe",    "winamp.exe",   "audiodg.exe"};
+
+struct MergeResult {
+  int events = 0;
+  int volumeEvents = 0;
+  int muteEvents = 0;
+  int membershipEvents = 0;
+  int infoEvents = 0;
+  bool listRebuild = false; // Dropdown options would be rebuilt
+  String lastDevice;
+};
+
+std::unique_ptr<AudioStatus> live;
+std::unique_ptr<AudioStatus> incoming;
+
+AudioLevel makeLevel(int i) {
+  AudioLevel level;
+  level.processName = SESSION_NAMES[i];
+  level.friendlyName = SESSION_NAMES[i];
+  level.volume = i * 5;
+  level.state = "Active";
+  return level;
+}
+
+MergeResult merge() {
+  MergeResult result;
+  uint32_t membership = live->sessions.membershipVersion();
+
+  SessionChanges changes;
+  live->sessions.syncFrom(incoming->sessions, &changes);
+  forEachChangeEvent(*live, changes, [&result](const AudioStateChangeEvent &event) {
+    result.events++;
+    result.lastDevice = event.deviceName;
+    if (event.type == AudioStateChangeEvent::VOLUME_CHANGED) {
+      result.volumeEvents++;
+    } else if (event.type == AudioStateChangeEvent::MUTE_CHANGED) {
+      result.muteEvents++;
+    } else if (event.type == AudioStateChangeEvent::SESSION_ADDED ||
+               event.type == AudioStateChangeEvent::SESSION_REMOVED) {
+      result.membershipEvents++;
+    } else if (event.type == AudioStateChangeEvent::SESSION_UPDATED) {
+      result.infoEvents++;
+    }
+  });
+  result.listRebuild = live->sessions.membershipVersion() != membership;
+  return result;
+}
+
+} // namespace
+
+// Each test starts from a live status that already holds every session
+void setUp() {
+  live = std::make_unique<AudioStatus>();
+  incoming = std::make_unique<AudioStatus>();
+  for (int i = 0; i < SessionTable::CAPACITY; i++) {
+    incoming->addOrUpdateDevice(makeLevel(i));
+  }
+  live->sessions.syncFrom(incoming->sessions);
+}
+
+void tearDown() {
+  live.reset();
+  incoming.reset();
+}
+
+void test_first_status_adds_every_session() {
+  live->clear();
+
+  MergeResult result = merge();
+
+  TEST_ASSERT_EQUAL(SessionTable::CAPACITY, result.events);
+  TEST_ASSERT_EQUAL(SessionTable::CAPACITY, result.membershipEvents);
+  TEST_ASSERT_TRUE(result.listRebuild);
+}
+
+void test_identical_status_raises_nothing() {
+  MergeResult result = merge();
+
+  TEST_ASSERT_EQUAL(0, result.events);
+  TEST_ASSERT_FALSE(result.listRebuild);
+}
+
+// The wholesale replacement this merge superseded raised DEVICES_UPDATED
+// here, which rebuilt all three dropdowns, the volume display and the
+// default label
+void test_one_volume_change_is_one_event() {
+  incoming->sessions.setVolume(incoming->findDevice("spotify.exe"), 63);
+
+  MergeResult result = merge();
+
+  TEST_ASSERT_EQUAL(1, result.events);
+  TEST_ASSERT_EQUAL(1, result.volumeEvents);
+  TEST_ASSERT_FALSE(result.listRebuild);
+  TEST_ASSERT_EQUAL_STRING("spotify.exe", result.lastDevice.c_str());
+}
+
+void test_mute_change_is_one_event() {
+  incoming->sessions.setMuted(incoming->findDevice("zoom.exe"), true);
+
+  MergeResult result = merge();
+
+  TEST_ASSERT_EQUAL(1, result.events);
+  TEST_ASSERT_EQUAL(1, result.muteEvents);
+  TEST_ASSERT_FALSE(result.listRebuild);
+}
+
+void test_replaced_session_is_one_removal_and_one_addition() {
+  incoming->removeDevice("vlc.exe");
+  AudioLevel level = makeLevel(0);
+  level.processName = "mpv.exe";
+  incoming->addOrUpdateDevice(level);
+
+  MergeResult result = merge();
+
+  TEST_ASSERT_EQUAL(2, result.events);
+  TEST_ASSERT_EQUAL(2, result.membershipEvents);
+  TEST_ASSERT_TRUE(result.listRebuild);
+}
+
+void test_rename_alone_reaches_the_ui() {
+  AudioLevel level = makeLevel(0);
+  level.friendlyName = "Google Chrome";
+  incoming->addOrUpdateDevice(level);
+
+  MergeResult result = merge();
+
+  TEST_ASSERT_EQUAL(1, result.events);
+  TEST_ASSERT_EQUAL(1, result.infoEvents);
+  TEST_ASSERT_FALSE(result.listRebuild);
+  TEST_ASSERT_EQUAL_STRING("chrome.exe", result.lastDevice.c_str());
+}
+
+int main(int, char **) {
+  UNITY_BEGIN();
+  RUN_TEST(test_first_status_adds_every_session);
+  RUN_TEST(test_identical_status_raises_nothing);
+  RUN_TEST(test_one_volume_change_is_one_event);
+  RUN_TEST(test_mute_change_is_one_event);
+  RUN_TEST(test_replaced_session_is_one_removal_and_one_addition);
+  RUN_TEST(test_rename_alone_reaches_the_ui);
+  return UNITY_END();
+}
@@ -0,0 +1,172 @@
+// Headless UI: the SquareLine screens, LVGLMessageHandler and the on-device
+// UI self tests on an 800x480 memory display, driven by a virtual LVGL tick
+
+#include <application/audio/AudioManager.h>
+#include <application/ui/LVGLMessageHandler.h>
+#include <application/ui/dialogs/UniversalDialog.h>
+#include <application/ui/performance/UIBenchmark.h>
+#include <core/FrameScheduler.h>
+#include <core/TaskManager.h>
+#include <hardware/DeviceManager.h>
+#include <hardware/SDManager.h>
+#include <VolumeWidgetMacros.h>
+#include <lvgl.h>
+#include <ui/ui.h>
+#include <unity.h>
+
+#include <cstdint>
+#include <vector>
+
+using namespace Application;
+
+namespace {
+
+uint16_t frameBuffer[DISPLAY_WIDTH * DISPLAY_HEIGHT]; // RGB565
+uint32_t flushes = 0;
+bool handlerStarted = false;
+
+void flush(lv_display_t *display, const lv_area_t *, uint8_t *) {
+  flushes++;
+  lv_display_flush_ready(display);
+}
+
+void pumpMs(uint32_t ms) { vTaskDelay(pdMS_TO_TICKS(ms)); }
+
+} // namespace
+
+// One lvglTask pass per UI_TASK_PERIOD_MS of the delay. The tick advances
+// by the period however long the host took, so every run renders the same
+// frames.
+void vTaskDelay(TickType_t ticks) {
+  TickType_t passes = ticks / UI_TASK_PERIOD_MS;
+  if (passes == 0) {
+    passes = 1;
+  }
+  for (TickType_t pass = 0; pass < passes; pass++) {
+    FrameScheduler::beginPass();
+    lv_tick_inc(UI_TASK_PERIOD_MS);
+    lv_timer_handler();
+    FrameScheduler::endPass();
+  }
+}
+
+// The tests and LVGL share one thread, the lock has nothing to guard
+namespace Application {
+namespace TaskManager {
+void lvglLock(void) {}
+void lvglUnlock(void) {}
+bool lvglTryLock(uint32_t) { return true; }
+} // namespace TaskManager
+} // namespace Application
+
+// No card and no chip to ask
+namespace Hardware {
+namespace SD {
+bool mount(void) { return false; }
+bool isMounted(void) { return false; }
+bool format(void) { return false; }
+SDCardInfo getCardInfo(void) {
+  SDCardInfo info;
+  RESET_CARD_INFO(info);
+  info.status = SD_STATUS_NOT_INITIALIZED;
+  return info;
+}
+} // namespace SD
+
+namespace Device {
+uint32_t getFreeHeap(void) { return 0; }
+uint32_t getPsramSize(void) { return 0; }
+uint32_t getCpuFrequency(void) { return 0; }
+unsigned long getMillis(void) { return millis(); }
+} // namespace Device
+} // namespace Hardware
+
+// An audio manager that was never initialized: no devices, master tab
+namespace Application {
+namespace Audio {
+AudioManager &AudioManager::getInstance() {
+  static AudioManager instance;
+  return instance;
+}
+const char *AudioManager::getTabName(Events::UI::TabState) const {
+  return "Master";
+}
+} // namespace Audio
+} // namespace Application
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_main_screen_renders() {
+  TEST_ASSERT_TRUE(handlerStarted);
+  TEST_ASSERT_TRUE(lv_screen_active() == ui_screenMain);
+
+  uint32_t before = flushes;
+  lv_obj_invalidate(ui_screenMain);
+  pumpMs(LV_DEF_REFR_PERIOD * 2);
+  TEST_ASSERT_GREATER_THAN_UINT32(before, flushes);
+}
+
+void test_volume_update_reaches_the_slider() {
+  int shown = VOLUME_WIDGET_GET_VALUE(ui_primaryVolumeSlider);
+  int volume = shown == 42 ? 43 : 42;
+  TEST_ASSERT_TRUE(LVGLMessageHandler::updateMasterVolume(volume));
+  pumpMs(50);
+  shown = VOLUME_WIDGET_GET_VALUE(ui_primaryVolumeSlider);
+  TEST_ASSERT_EQUAL_INT(volume, shown);
+}
+
+void test_mailbox_flood() {
+  TEST_ASSERT_TRUE(LVGLMessageHandler::runMailboxStressTest());
+}
+
+void test_state_overview_reopens() {
+  TEST_ASSERT_TRUE(LVGLMessageHandler::runStateOverviewBenchmark());
+}
+
+void test_dialog_pool() {
+  TEST_ASSERT_TRUE(UI::Dialog::UniversalDialog::runPoolBenchmark());
+}
+
+// The first run builds what later runs reuse (overview, dialog pool), the
+// two after it must match frame for frame
+void test_benchmark_scenarios_repeat() {
+  std::vector<UIBenchmark::ScenarioResult> first, second;
+  TEST_ASSERT_TRUE(UIBenchmark::runScenarios());
+  TEST_ASSERT_TRUE(UIBenchmark::runScenarios(&first));
+  TEST_ASSERT_TRUE(UIBenchmark::runScenarios(&second));
+
+  TEST_ASSERT_FALSE(first.empty());
+  TEST_ASSERT_EQUAL_UINT32(first.size(), second.size());
+  for (size_t i = 0; i < first.size(); i++) {
+    const UIBenchmark::ScenarioResult &a = first[i], &b = second[i];
+    TEST_ASSERT_EQUAL_STRING(a.name, b.name);
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(a.steps, b.steps, a.name);
+    TEST_ASSERT_GREATER_THAN_UINT32_MESSAGE(0, a.frames, a.name);
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(a.frames, b.frames, a.name);
+    TEST_ASSERT_TRUE_MESSAGE(a.areaPx == b.areaPx, a.name);
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(a.maxAreaPx, b.maxAreaPx, a.name);
+    TEST_ASSERT_EQUAL_INT32_MESSAGE(a.memPeakBytes, b.memPeakBytes, a.name);
+    TEST_ASSERT_EQUAL_INT32_MESSAGE(a.memAfterBytes, b.memAfterBytes, a.name);
+  }
+}
+
+int main(int, char **) {
+  lv_init();
+  lv_display_t *display = lv_display_create(DISPLAY_WIDTH, DISPLAY_HEIGHT);
+  lv_display_set_buffers(display, frameBuffer, nullptr, sizeof(frameBuffer),
+                         LV_DISPLAY_RENDER_MODE_PARTIAL);
+  lv_display_set_flush_cb(display, flush);
+  ui_init();
+  handlerStarted = LVGLMessageHandler::init();
+
+  UNITY_BEGIN();
+  RUN_TEST(test_main_screen_renders);
+  RUN_TEST(test_volume_update_reaches_the_slider);
+  RUN_TEST(test_mailbox_flood);
+  RUN_TEST(test_state_overview_reopens);
+  RUN_TEST(test_dialog_pool);
+  RUN_TEST(test_benchmark_scenarios_repeat);
+  return UNITY_END();
+}
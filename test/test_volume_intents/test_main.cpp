@@ -0,0 +1,149 @@
+// VolumeIntentTable: late statuses held at the intended volume, echoes that
+// confirm, timeouts, and a scene's one-intent-per-command case
+
+#include <VolumeIntents.h>
+#include <unity.h>
+
+using Application::Audio::VolumeIntentTable;
+
+namespace {
+
+const uint32_t TIMEOUT_MS = 1500;
+
+struct IntentStep {
+  uint32_t atMs;
+  bool send;             // true: user sets volume, false: host status arrives
+  int volume;
+  const char *requestId; // Sent id, or the id a status echoes ("" for none)
+};
+
+// A drag whose statuses arrive late, then a command the host never applies
+const IntentStep TIMELINE[] = {
+    {0, true, 60, "r1"},     {50, false, 30, ""},    {90, true, 70, "r2"},
+    {140, false, 60, "r1"},  {200, false, 70, "r2"}, {1000, true, 80, "r3"},
+    {1100, false, 40, ""},   {1600, false, 40, ""},  {2600, false, 40, ""},
+};
+
+struct Replay {
+  uint32_t rawJumps = 0;    // Statuses off the user's value, applied as is
+  uint32_t intentJumps = 0; // The same through the intent table
+};
+
+// A displayed jump-back is a status that moves the slider off the value the
+// user last set
+Replay replay(VolumeIntentTable &intents) {
+  const char *device = "spotify.exe";
+  Replay result;
+  int userVolume = 30;
+  for (const IntentStep &step : TIMELINE) {
+    if (step.send) {
+      userVolume = step.volume;
+      intents.record(device, step.requestId, step.volume, step.atMs);
+      continue;
+    }
+    intents.acknowledge(step.requestId, step.atMs);
+    int shown = intents.reconcile(device, step.volume, step.atMs);
+    intents.sweep(step.atMs);
+    result.rawJumps += step.volume != userVolume;
+    result.intentJumps += shown != userVolume;
+  }
+  return result;
+}
+
+} // namespace
+
+void setUp() {}
+void tearDown() {}
+
+// Only the never-applied command may snap back, and only after timing out
+void test_stale_statuses_are_held_at_the_intent() {
+  VolumeIntentTable intents(TIMEOUT_MS);
+  Replay result = replay(intents);
+
+  TEST_ASSERT_EQUAL(5, result.rawJumps);
+  TEST_ASSERT_EQUAL(1, result.intentJumps);
+  TEST_ASSERT_EQUAL(4, intents.getStats().held);
+}
+
+void test_echo_of_the_newest_request_confirms() {
+  VolumeIntentTable intents(TIMEOUT_MS);
+  replay(intents);
+
+  VolumeIntentTable::Stats stats = intents.getStats();
+  TEST_ASSERT_EQUAL(1, stats.acknowledged);
+  TEST_ASSERT_EQUAL(110, stats.latencyMaxMs);
+}
+
+void test_unapplied_command_times_out() {
+  VolumeIntentTable intents(TIMEOUT_MS);
+  replay(intents);
+
+  VolumeIntentTable::Stats stats = intents.getStats();
+  TEST_ASSERT_EQUAL(1, stats.timeouts);
+  TEST_ASSERT_EQUAL(1, stats.jumpBacks);
+  TEST_ASSERT_EQUAL(0, intents.size());
+}
+
+void test_echo_of_an_older_request_does_not_confirm() {
+  VolumeIntentTable intents(TIMEOUT_MS);
+  intents.record("vlc.exe", "a", 40, 0);
+  intents.record("vlc.exe", "b", 50, 10);
+
+  TEST_ASSERT_FALSE(intents.acknowledge("a", 20));
+  TEST_ASSERT_EQUAL(50, intents.reconcile("vlc.exe", 40, 20));
+  TEST_ASSERT_TRUE(intents.hasPending("vlc.exe"));
+}
+
+void test_sweep_expires_intents_of_vanished_devices() {
+  VolumeIntentTable intents(TIMEOUT_MS);
+  intents.record("vlc.exe", "a", 40, 0);
+  intents.record("zoom.exe", "b", 50, 0);
+
+  // Statuses that only report vlc.exe: zoom.exe is never reconciled, so
+  // only the sweep can end its intent
+  intents.reconcile("vlc.exe", 30, 100);
+  intents.sweep(100);
+  TEST_ASSERT_TRUE(intents.hasPending("zoom.exe"));
+
+  intents.sweep(TIMEOUT_MS);
+  TEST_ASSERT_FALSE(intents.hasPending("zoom.exe"));
+  TEST_ASSERT_EQUAL(2, intents.getStats().timeouts);
+}
+
+// One command per device in a single frame, a stale status, then echoes of
+// one command each; the others stay held until theirs arrives
+void test_scene_intents_confirm_one_command_at_a_time() {
+  const char *devices[] = {"chrome.exe", "firefox.exe", "spotify.exe"};
+  const char *requests[] = {"s0", "s1", "s2"};
+  VolumeIntentTable scene(TIMEOUT_MS);
+  for (int i = 0; i < 3; i++) {
+    scene.record(devices[i], requests[i], 20 + i, 0);
+  }
+  for (int i = 0; i < 3; i++) {
+    TEST_ASSERT_EQUAL(20 + i, scene.reconcile(devices[i], 90, 50));
+  }
+
+  scene.acknowledge("s0", 120);
+  scene.reconcile(devices[0], 20, 120);
+  for (int i = 1; i < 3; i++) {
+    TEST_ASSERT_EQUAL(20 + i, scene.reconcile(devices[i], 90, 120));
+  }
+  for (int i = 1; i < 3; i++) {
+    scene.acknowledge(requests[i], 130);
+    scene.reconcile(devices[i], 20 + i, 130);
+  }
+
+  TEST_ASSERT_EQUAL(3, scene.getStats().acknowledged);
+  TEST_ASSERT_EQUAL(0, scene.size());
+}
+
+int main(int, char **) {
+  UNITY_BEGIN();
+  RUN_TEST(test_stale_statuses_are_held_at_the_intent);
+  RUN_TEST(test_echo_of_the_newest_request_confirms);
+  RUN_TEST(test_unapplied_command_times_out);
+  RUN_TEST(test_echo_of_an_older_request_does_not_confirm);
+  RUN_TEST(test_sweep_expires_intents_of_vanished_devices);
+  RUN_TEST(test_scene_intents_confirm_one_command_at_a_time);
+  return UNITY_END();
+}
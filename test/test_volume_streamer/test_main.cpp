@@ -0,0 +1,161 @@
+// VolumeStreamer on a simulated clock: rate bound, coalescing, a saturated
+// link and the value a drag ends on
+
+#include <VolumeStreamer.h>
+#include <unity.h>
+
+#include <climits>
+#include <vector>
+
+using Application::Audio::VolumeStreamer;
+
+namespace {
+
+const uint32_t RATE_HZ = 30;
+const int64_t INTERVAL_US = 1000000 / RATE_HZ;
+const int64_t DRAG_US = 2000000;
+const int FINAL_VOLUME = 80;
+
+struct DragResult {
+  uint32_t sent = 0;
+  int64_t minGapUs = INT64_MAX;
+  int lastVolume = -1;
+  int64_t finalDelayUs = -1; // Release to final value on the wire
+  VolumeStreamer::Stats stats;
+};
+
+// 2 s drag from 20 to 80 with a slider event every 8 ms and the UI timer
+// polling every 5 ms. busyFrom/busyUntil mark when the link reports
+// saturation.
+DragResult simulateDrag(uint32_t rateHz, int64_t busyFrom, int64_t busyUntil) {
+  DragResult result;
+  int64_t now = 0;
+  int64_t lastSend = -1;
+  VolumeStreamer streamer(
+      rateHz,
+      [&](const String &, int volume) {
+        if (lastSend >= 0 && now - lastSend < result.minGapUs) {
+          result.minGapUs = now - lastSend;
+        }
+        lastSend = now;
+        result.sent++;
+        result.lastVolume = volume;
+      },
+      [&]() { return now >= busyFrom && now < busyUntil; });
+
+  streamer.begin("spotify.exe", 20, now);
+  for (now = 0; now < DRAG_US; now += 1000) {
+    if (now % 8000 == 0) {
+      streamer.update(20 + (int)(now * 60 / DRAG_US), now);
+    }
+    if (now % 5000 == 0) {
+      streamer.poll(now);
+    }
+  }
+
+  int64_t releasedAt = now;
+  uint32_t sentBefore = result.sent;
+  streamer.end(FINAL_VOLUME, now);
+  for (; streamer.hasPending() && now < releasedAt + 1000000; now += 1000) {
+    if (now % 5000 == 0) {
+      streamer.poll(now);
+    }
+  }
+  if (result.sent > sentBefore && result.lastVolume == FINAL_VOLUME) {
+    result.finalDelayUs = lastSend - releasedAt;
+  }
+  result.stats = streamer.getStats();
+  return result;
+}
+
+void assertFinalValueSent(const DragResult &result) {
+  TEST_ASSERT_EQUAL(FINAL_VOLUME, result.lastVolume);
+  TEST_ASSERT_GREATER_OR_EQUAL(0, result.finalDelayUs);
+  TEST_ASSERT_LESS_OR_EQUAL(INTERVAL_US, result.finalDelayUs);
+}
+
+} // namespace
+
+void setUp() {}
+void tearDown() {}
+
+void test_free_link_drag_respects_the_rate_bound() {
+  DragResult result = simulateDrag(RATE_HZ, 0, 0);
+
+  TEST_ASSERT_GREATER_OR_EQUAL(INTERVAL_US, result.minGapUs);
+  TEST_ASSERT_LESS_OR_EQUAL(2 * RATE_HZ + 1, result.sent);
+  TEST_ASSERT_GREATER_THAN(0, result.stats.suppressed);
+  assertFinalValueSent(result);
+}
+
+// Saturated for the second half including the release: intermediates are
+// held back, the final value still goes out
+void test_busy_link_holds_intermediates_but_not_the_final_value() {
+  DragResult result = simulateDrag(RATE_HZ, DRAG_US / 2, INT64_MAX);
+
+  TEST_ASSERT_GREATER_THAN(0, result.stats.linkBusy);
+  TEST_ASSERT_LESS_OR_EQUAL(RATE_HZ + 1, result.sent);
+  TEST_ASSERT_GREATER_OR_EQUAL(INTERVAL_US, result.minGapUs);
+  assertFinalValueSent(result);
+}
+
+void test_rate_zero_sends_only_on_release() {
+  DragResult result = simulateDrag(0, 0, 0);
+
+  TEST_ASSERT_EQUAL(1, result.sent);
+  TEST_ASSERT_EQUAL(FINAL_VOLUME, result.lastVolume);
+  TEST_ASSERT_EQUAL(0, result.finalDelayUs);
+}
+
+void test_unchanged_values_are_not_sent() {
+  std::vector<int> sent;
+  VolumeStreamer streamer(
+      RATE_HZ, [&](const String &, int volume) { sent.push_back(volume); },
+      nullptr);
+
+  // The drag starts and ends on the current volume
+  streamer.begin("vlc.exe", 40, 0);
+  streamer.update(40, INTERVAL_US);
+  streamer.end(40, 2 * INTERVAL_US);
+
+  TEST_ASSERT_EQUAL(0, sent.size());
+  TEST_ASSERT_FALSE(streamer.hasPending());
+  TEST_ASSERT_FALSE(streamer.isDragging());
+}
+
+void test_updates_outside_a_drag_are_ignored() {
+  std::vector<int> sent;
+  VolumeStreamer streamer(
+      RATE_HZ, [&](const String &, int volume) { sent.push_back(volume); },
+      nullptr);
+
+  streamer.update(70, INTERVAL_US);
+  streamer.end(70, 2 * INTERVAL_US);
+
+  TEST_ASSERT_EQUAL(0, sent.size());
+  TEST_ASSERT_EQUAL(0, streamer.getStats().drags);
+}
+
+void test_ms_until_due_counts_down_the_interval() {
+  VolumeStreamer streamer(RATE_HZ, [](const String &, int) {}, nullptr);
+
+  streamer.begin("vlc.exe", 40, 0);
+  streamer.update(50, INTERVAL_US);
+  streamer.update(60, INTERVAL_US + 1000);
+
+  TEST_ASSERT_TRUE(streamer.hasPending());
+  // 32.3 ms left, rounded up so the timer never fires early
+  TEST_ASSERT_EQUAL(33, streamer.msUntilDue(INTERVAL_US + 1000));
+  TEST_ASSERT_EQUAL(0, streamer.msUntilDue(2 * INTERVAL_US));
+}
+
+int main(int, char **) {
+  UNITY_BEGIN();
+  RUN_TEST(test_free_link_drag_respects_the_rate_bound);
+  RUN_TEST(test_busy_link_holds_intermediates_but_not_the_final_value);
+  RUN_TEST(test_rate_zero_sends_only_on_release);
+  RUN_TEST(test_unchanged_values_are_not_sent);
+  RUN_TEST(test_updates_outside_a_drag_are_ignored);
+  RUN_TEST(test_ms_until_due_counts_down_the_interval);
+  return UNITY_END();
+}
@@ -0,0 +1,217 @@
+// Replays the RX side of a WireCapture file on the host through the same
+// chain the RXTX task runs: BinaryProtocolFramer -> InboundScheduler ->
+// Message::fromJson -> MessageRouter, and reports the time per stage.
+//
+//   pio run -e wire_replay
+//   .pio/build/wire_replay/program capture.ucap [repeat]
+//
+// Every message type gets a counting router handler, so the route figure is
+// the router itself; the device handlers are not part of the replay.
+
+#include <BinaryProtocol.h>
+#include <MessagingConfig.h>
+#include <messaging/InboundScheduler.h>
+#include <messaging/Message.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace Messaging;
+
+namespace {
+
+const char CAPTURE_MAGIC[] = "UMXWCAP";
+const uint8_t CAPTURE_VERSION = 1;
+const size_t CAPTURE_HEADER_SIZE = 8;
+const size_t RECORD_HEADER_SIZE = 8;
+const uint8_t DIRECTION_RX = 1;
+
+struct Record {
+  uint64_t timestampUs; // Unwrapped
+  uint8_t direction;
+  std::vector<uint8_t> bytes;
+};
+
+struct StageTimes {
+  uint64_t framerNs = 0;
+  uint64_t parseNs = 0;
+  uint64_t routeNs = 0;
+  uint32_t messages = 0;
+  uint32_t invalid = 0;
+};
+
+uint64_t nowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+uint32_t readLe(const uint8_t *data, size_t size) {
+  uint32_t value = 0;
+  for (size_t i = size; i > 0; i--) {
+    value = (value << 8) | data[i - 1];
+  }
+  return value;
+}
+
+bool readCapture(const char *path, std::vector<Record> &records) {
+  FILE *file = fopen(path, "rb");
+  if (!file) {
+    fprintf(stderr, "%s: cannot open\n", path);
+    return false;
+  }
+  std::vector<uint8_t> data;
+  uint8_t chunk[4096];
+  size_t read;
+  while ((read = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+    data.insert(data.end(), chunk, chunk + read);
+  }
+  fclose(file);
+
+  if (data.size() < CAPTURE_HEADER_SIZE ||
+      memcmp(data.data(), CAPTURE_MAGIC, 7) != 0) {
+    fprintf(stderr, "%s: not a wire capture\n", path);
+    return false;
+  }
+  if (data[7] != CAPTURE_VERSION) {
+    fprintf(stderr, "%s: unsupported capture version %u\n", path, data[7]);
+    return false;
+  }
+
+  // The stamps are the low 32 bits of esp_timer_get_time()
+  uint64_t base = 0;
+  uint32_t last = 0;
+  size_t offset = CAPTURE_HEADER_SIZE;
+  while (offset + RECORD_HEADER_SIZE <= data.size()) {
+    uint32_t stamp = readLe(&data[offset], 4);
+    uint16_t length = readLe(&data[offset + 4], 2);
+    uint8_t direction = data[offset + 6];
+    offset += RECORD_HEADER_SIZE;
+    if (offset + length > data.size()) {
+      fprintf(stderr, "warning: truncated record at offset %zu\n", offset);
+      break;
+    }
+    if (!records.empty() && stamp < last) {
+      base += 1ull << 32;
+    }
+    last = stamp;
+    records.push_back({base + stamp, direction,
+                       std::vector<uint8_t>(&data[offset],
+                                            &data[offset] + length)});
+    offset += length;
+  }
+  return true;
+}
+
+// One pass over the RX records, as SerialEngine::processIncomingData and
+// deliverJson do it: frame each chunk, queue the valid JSON, then dispatch
+// within the RXTX loop budget
+void replay(const std::vector<Record> &records, StageTimes &times) {
+  BinaryProtocol::BinaryProtocolFramer framer;
+  InboundScheduler scheduler;
+  MessageRouter &router = MessageRouter::getInstance();
+
+  InboundScheduler::Deliver deliver = [&](const String &json) {
+    uint64_t start = nowNs();
+    Message parsed = Message::fromJson(json);
+    times.parseNs += nowNs() - start;
+
+    start = nowNs();
+    router.route(parsed);
+    times.routeNs += nowNs() - start;
+  };
+
+  for (const Record &record : records) {
+    if (record.direction != DIRECTION_RX) {
+      continue;
+    }
+    uint64_t start = nowNs();
+    std::vector<String> messages =
+        framer.processIncomingBytes(record.bytes.data(), record.bytes.size());
+    times.framerNs += nowNs() - start;
+
+    for (const String &json : messages) {
+      if (json.startsWith("{") && json.endsWith("}") && json.length() > 10) {
+        times.messages++;
+        scheduler.enqueue(json);
+      } else {
+        times.invalid++;
+      }
+    }
+    scheduler.dispatch(MESSAGING_INBOUND_DISPATCH_BUDGET_US, deliver);
+  }
+  while (scheduler.hasPending()) {
+    scheduler.dispatch(MESSAGING_INBOUND_DISPATCH_BUDGET_US, deliver);
+  }
+
+  const BinaryProtocol::ProtocolStatistics &wire = framer.getStatistics();
+  times.invalid += wire.framingErrors + wire.crcErrors +
+                   wire.bufferOverflowErrors;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  if (argc < 2 || argc > 3) {
+    fprintf(stderr, "usage: %s <capture.ucap> [repeat]\n", argv[0]);
+    return 2;
+  }
+  int repeat = argc == 3 ? atoi(argv[2]) : 1;
+  if (repeat < 1) {
+    repeat = 1;
+  }
+
+  std::vector<Record> records;
+  if (!readCapture(argv[1], records)) {
+    return 1;
+  }
+  size_t rxRecords = 0;
+  size_t rxBytes = 0;
+  for (const Record &record : records) {
+    if (record.direction == DIRECTION_RX) {
+      rxRecords++;
+      rxBytes += record.bytes.size();
+    }
+  }
+  uint64_t span = records.empty()
+                      ? 0
+                      : records.back().timestampUs - records.front().timestampUs;
+  printf("%zu records over %.3f s, %zu RX (%zu bytes)\n", records.size(),
+         span / 1e6, rxRecords, rxBytes);
+
+  std::map<std::string, uint32_t> routed;
+  const char *const types[] = {
+      Message::TYPE_AUDIO_STATUS,  Message::TYPE_VOLUME_CHANGE,
+      Message::TYPE_MUTE_TOGGLE,   Message::TYPE_ASSET_REQUEST,
+      Message::TYPE_ASSET_RESPONSE, Message::TYPE_GET_STATUS,
+      Message::TYPE_SET_VOLUME,    Message::TYPE_SET_DEFAULT_DEVICE};
+  for (const char *type : types) {
+    MessageRouter::getInstance().subscribe(
+        type, [&routed](const Message &msg) { routed[msg.type.c_str()]++; });
+  }
+
+  StageTimes times;
+  for (int pass = 0; pass < repeat; pass++) {
+    replay(records, times);
+  }
+
+  printf("RX messages: %lu, rejected: %lu (over %d pass%s)\n",
+         (unsigned long)times.messages, (unsigned long)times.invalid, repeat,
+         repeat == 1 ? "" : "es");
+  for (const auto &entry : routed) {
+    printf("  %-24s %lu\n", entry.first.c_str(),
+           (unsigned long)(entry.second / repeat));
+  }
+  if (times.messages > 0) {
+    printf("ns/message: framer %llu, parse %llu, route %llu\n",
+           (unsigned long long)(times.framerNs / times.messages),
+           (unsigned long long)(times.parseNs / times.messages),
+           (unsigned long long)(times.routeNs / times.messages));
+  }
+  return 0;
+}